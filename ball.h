@@ -1,7 +1,7 @@
 /* Program name: ball.h
 *  Author: Cory Knoll
-*  Date Last Modified: 5/7/2019
-*  Description: Simulate a bounding ball object
+*  Date Last Modified: 10/17/2026
+*  Description: Scene item that mirrors a bouncing ball body of the physics world
     ====================================================================
 	FUNCTIONS:
 	+ void collide(Vec2D, QGraphicsItem*) - Handle collision with another object
@@ -9,23 +9,24 @@
 	+ void setVelocity(double, double) - Set the velocity of the ball
 	+ Vec2D getVelocity() const - return velocity vector
 	+ double getRadius() const - return the radius of the ball
-	+ void move(double) - Move the ball along its velocity vector, detect/handle collisions, calculate new velocity due to gravity
-	+ Ball(double = 0, double = 0, double = 10, double = 0) - Constructor - Pass coordinates and diameter of circle to QGraphicsEllipseItem constructor and set invMass
+	+ void move(double) - Move the ball along its velocity vector, calculate new velocity due to gravity
+	+ void syncPosition() - Mirror the position of the ball's body in the world into the scene
+	+ void syncPosition(const std::vector<double>&, const std::vector<double>&, double) - Mirror the ball's body into the scene, blended from its center in saved x and y coordinates by a fraction of a step
+	+ Ball(World*, int = 0) - Constructor - Pass diameter of the world's ball to QGraphicsEllipseItem constructor and mirror its position
 	+ ~Ball() - Destructor
-	- void gravity(double) - Adjust velocity due to acceleration of gravity
     ====================================================================
 	VARAIBLES:
-	- Vec2D velocity - represent the x and y components of the ball's velocity
-	- double inverseMass - represent the inverse mass (mass^(-1)) of an object (to be used for moveable object collision)
-	- double radius - radius of the ball
+	- World *world - The physics world that owns the ball's body
+	- int index - Index of the ball's body in the world
 */
 
 #ifndef BALL_H
 #define BALL_H
 
 #include <QGraphicsEllipseItem>
+#include <vector>
 #include "vec2d.h"
-#include "velocitytext.h"
+#include "world.h"
 
 class Ball : public QGraphicsEllipseItem
 {
@@ -41,17 +42,18 @@ public:
 	double getRadius() const;
 		//return the radius of the ball
 	void move(double);
-		//Move the ball along its velocity vector, detect/handle collisions, calculate new velocity due to gravity
-	Ball(double = 0, double = 0, double = 10, double = 0);
-		//Constructor - Pass coordinates and diameter of circle to QGraphicsEllipseItem constructor and set invMass
+		//Move the ball along its velocity vector, calculate new velocity due to gravity
+	void syncPosition();
+		//Mirror the position of the ball's body in the world into the scene
+	void syncPosition(const std::vector<double>&, const std::vector<double>&, double);
+		//Mirror the ball's body into the scene, blended from its center in saved x and y coordinates by a fraction of a step
+	Ball(World*, int = 0);
+		//Constructor - Pass diameter of the world's ball to QGraphicsEllipseItem constructor and mirror its position
 	~Ball();
 		//Destructor
 private:
-	void gravity(double);
-		//Adjust velocity due to acceleration of gravity
-	Vec2D velocity;		//represent the x and y components of the ball's velocity
-	double inverseMass;	//represent the inverse mass (mass^(-1)) of an object (to be used for moveable object collision)
-	double radius;		//radius of the ball
+	World *world;	//The physics world that owns the ball's body
+	int index;		//Index of the ball's body in the world
 };
 
 #endif //BALL_H
@@ -0,0 +1,1748 @@
+/* Program name: benchmark.cpp
+*  Author: Cory Knoll
+*  Date Last Modified: 10/17/2026
+*  Description: Command line program that measures the speed of the physics engine, writes the results as JSON and compares them with a baseline (build as its own executable, no window is opened)
+	================================================================
+	FUNCTIONS:
+	+ int main(int, char**) - Run the benchmarks (benchmark [-filter text] [-json file] [-baseline file] [-tolerance percent]) and print the results, return 1 if any got worse than the baseline by more than the tolerance or a check a benchmark makes failed
+	- double secondsSince(Clock::time_point) - return the seconds elapsed since a point in time
+	- void record(const std::string&, double, const char*, bool) - Keep a result of a benchmark for the JSON file and the comparison with a baseline
+	- bool selected(const char*) - return true if a group of benchmarks is to be run
+	- void fail(const std::string&) - Print a check a benchmark made that came out wrong and count it, so the run fails
+	- bool writeResults(const std::string&) - Write every result kept to a JSON file, return false if it can't be written
+	- bool readResults(const std::string&, std::vector<BenchResult>&) - Read the results of a JSON file this program wrote, return false if it can't be read
+	- int compareResults(const std::vector<BenchResult>&, double) - Print how every result changed from a baseline, return the number that got worse by more than a tolerance (percent)
+	- void fillWorld(World&, int) - Add a number of balls with scattered positions and velocities to an empty world
+	- void benchIntegration(int, int) - Compare bodies per second of the per-object Ball::move path and the batch integration kernel
+	- void generateLevel(int, LevelData&) - Build a walled level with a grid of a number of obstacle blocks
+	- void benchLargeLevel(int, int) - Measure the time per frame of a shot through a generated level
+	- void benchLevelLoad(int, int) - Compare the time to load a generated level from a text level file and from a mapped compiled level file
+	- void benchLevelSwitch(int) - Compare the time to switch to a generated level read on the spot and preloaded in the background, and the time to restart it
+	- void benchPreview(int, int) - Measure the time to predict the path of shots at every angle through a generated level, with and without the aim preview's time budget
+	- void generatePiles(int, int, LevelData&) - Build a level of separate open boxes, each holding a pile of a number of balls
+	- void benchIslands(int, int, int) - Compare the time per frame of a level of many piles solved with 1, 2, 4, ... threads up to one per core
+	- void generateStacks(int, int, LevelData&) - Build a floor with a number of columns of a number of boxes with mass stacked on it
+	- void benchStacks(int, int, int) - Measure the time per frame of columns of stacked boxes with mass kept awake and left to sleep once at rest, and how far the boxes sank into each other and moved
+	- void benchReplay(int, int, int) - Measure the size of the replay of a run through a level of many piles, the time to re-simulate it and to seek to frames of it
+	- void generateMovers(int, int, LevelData&) - Build a walled level with a grid of a number of blocks moving along every kind of path and a number of balls scattered between them
+	- void benchMovers(int, int, int) - Measure the time per frame of a level of many moving blocks, compare refitting the hierarchy over them with rebuilding it every frame, and fail if a ball ends a frame inside a block
+	- void benchSnapshot(int, int, int) - Measure the time to snapshot and restore a level of many piles, and compare branching what-if runs from a snapshot with reloading the level, checking a branch replays the run exactly
+	- void benchVectorMath(int, int) - Compare vectors per second reflected with the old out-of-line vector class and with Vec2 of doubles and floats
+	- Vec2D legacyCollide(Vec2D, Vec2D) - return the velocity of a ball after bouncing off a surface the way the physics did before bounce() (angles and per-axis damping)
+	- void benchResponse(int, int) - Compare contacts per second resolved with the old angle-based response, bounce() one at a time and bounceBatch(), and check they agree
+	- bool legacyLinesCross(double, double, double, double, double, double, double, double) - Determines if two line segments cross one another (the old narrowphase)
+	- bool legacyLineCornerCollide(double, double, double, double, double, double, double, double&) - Determines if a line comes within a radius of a corner point (the old narrowphase)
+	- bool legacySweep(Vec2D, Vec2D, double, const SweepBox&, double, SweepHit&) - Find when a ball first touches a box with the old series of edge and corner tests, return false if it doesn't
+	- double exactCornerToi(Vec2D, Vec2D, double, Vec2D) - return the portion of a trajectory at which a ball first touches a corner, worked out in long double as the reference the kernels are held to (-1 if it never does)
+	- void benchSweep(int, int) - Check sweepCircleBox() against the old narrowphase on the trajectories of shots through lvl1-lvl3 and compare their speed and the batch test's
+	- void benchCollisionKernels(int, int) - Measure the time per call of every test of the collision pipeline on ball/block pairs that miss, graze and hit
+	- void benchShots(int, int) - Measure the time per frame and per shot of a fan of full shots through lvl1-lvl3
+	- void benchEvents(int, int, int) - Compare the time per shot of a fan of shots through lvl1-lvl3 played for up to a number of frames frame by frame, jumping from event to event and jumping only over the frames nothing is in reach in, the events handled per frame played and how often each agrees with the frames on the goal
+	- void benchBigSteps(int, int, int) - Play a fan of shots through lvl1-lvl3 in steps of many frames along straight lines and along parabolas, and compare the time per frame, the collision queries per frame, the shots that end a step inside a block and how often they agree on the goal with the game's single frame steps along straight lines
+	- void generateShapes(int, int, LevelData&) - Build the walled level of generateLevel() with its obstacles as blocks, as axis-aligned polygons or as boxes rotated by 30 degrees
+	- void benchShapes(int, int, int) - Compare the time per call of the box narrowphase called directly, through the shape pair table and as a polygon, and the time per frame of a fan of shots through a generated level whose obstacles are blocks, polygons and rotated boxes
+	============================================================================
+	VARIABLES:
+	- std::vector<BenchResult> results - Every result kept so far, in the order the benchmarks ran
+	- std::string filter - Only the groups of benchmarks whose name contains this are run (every group when empty)
+	- int failures - Checks the benchmarks made that came out wrong
+	============================================================================
+	JSON FILE FORMAT (one result a line, so a baseline can be diffed and read back without a JSON library):
+	  {
+	    "results": [
+	      {"name": group.size.measure, "value": number, "unit": text, "better": "higher" or "lower"},
+	      ...
+	    ]
+	  }
+	============================================================================
+	STRUCTS:
+	- BenchResult - one number a benchmark measured, named so the same measurement of another run can be found
+	============================================================================
+	CLASSES:
+	- LegacyVec2D - the vector class the physics used before Vec2, with its accessors kept out of line the way a separate file kept them
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+#include "ball.h"
+#include "compiledlevel.h"
+#include "eventsim.h"
+#include "levelpreloader.h"
+#include "narrowphase.h"
+#include "replay.h"
+#include "response.h"
+#include "snapshot.h"
+#include "sweep.h"
+#include "trajectory.h"
+#include "world.h"
+
+#define BENCH_TOLERANCE 10.0	//Default percent a result may get worse than its baseline before it counts as a regression
+#define SHOT_FRAMES 600			//Most frames a shot of benchShots() is played for if it never hits the goal
+#define SHAPE_BLOCKS 0			//Obstacles of generateShapes() are blocks
+#define SHAPE_AXIS_POLYGONS 1	//Obstacles of generateShapes() are polygons with the corners of the blocks
+#define SHAPE_ROTATED_BOXES 2	//Obstacles of generateShapes() are boxes the size of the blocks rotated by 30 degrees
+#define MAX_VELOCITY 50.0
+
+typedef std::chrono::steady_clock Clock;
+
+struct BenchResult
+{
+	std::string name;	//group, size and measurement, e.g. "level.1000.frame"
+	double value;		//the number measured
+	std::string unit;	//what the number counts
+	bool higherBetter;	//a larger number is an improvement (a rate) rather than a regression (a time or a size)
+};
+
+static std::vector<BenchResult> results;	//Every result kept so far, in the order the benchmarks ran
+static std::string filter;					//Only the groups of benchmarks whose name contains this are run (every group when empty)
+static int failures = 0;					//Checks the benchmarks made that came out wrong
+
+//the old vector class lived in its own file, so a caller in another file could never inline its accessors; keep them out of line here too
+#if defined(_MSC_VER)
+#define NOINLINE __declspec(noinline)
+#else
+#define NOINLINE __attribute__((noinline))
+#endif
+
+class LegacyVec2D
+{
+public:
+	NOINLINE void setXY(double newX, double newY) { x = newX; y = newY; }
+		//set value of x and y
+	NOINLINE void getVectorComponents(double &retX, double &retY) const { retX = x; retY = y; }
+		//return values of x and y
+	LegacyVec2D() { x = 0; y = 0; }
+		//Constructor, initial vector [0,0]
+private:
+	double x;	//x component of the vector
+	double y;	//y component of the vector
+};
+
+//return the seconds elapsed since a point in time
+static double secondsSince(Clock::time_point start)
+{
+	return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+//Keep a result of a benchmark for the JSON file and the comparison with a baseline
+static void record(const std::string &name, double value, const char *unit, bool higherBetter)
+{
+	BenchResult result = { name, value, unit, higherBetter };
+	results.push_back(result);
+}
+
+//return true if a group of benchmarks is to be run
+static bool selected(const char *group)
+{
+	return filter.empty() || std::string(group).find(filter) != std::string::npos;
+}
+
+//Print a check a benchmark made that came out wrong and count it, so the run fails
+static void fail(const std::string &what)
+{
+	printf("FAILED: %s\n", what.c_str());
+	failures++;
+}
+
+//Write every result kept to a JSON file, return false if it can't be written
+static bool writeResults(const std::string &fileName)
+{
+	FILE *file = fopen(fileName.c_str(), "w");
+	if (!file)
+		return false;
+	fprintf(file, "{\n\t\"results\": [\n");
+	for (size_t i = 0; i < results.size(); i++)
+		fprintf(file, "\t\t{\"name\": \"%s\", \"value\": %.9g, \"unit\": \"%s\", \"better\": \"%s\"}%s\n", results[i].name.c_str(), results[i].value,
+			results[i].unit.c_str(), results[i].higherBetter ? "higher" : "lower", i + 1 < results.size() ? "," : "");
+	fprintf(file, "\t]\n}\n");
+	return fclose(file) == 0;
+}
+
+//Read the results of a JSON file this program wrote, return false if it can't be read
+static bool readResults(const std::string &fileName, std::vector<BenchResult> &baseline)
+{
+	//only the lines writeResults() writes are understood, one result each; anything else (the brackets) is skipped
+	FILE *file = fopen(fileName.c_str(), "r");
+	if (!file)
+		return false;
+	baseline.clear();
+	char line[512], name[256], unit[64], better[16];
+	double value;
+	while (fgets(line, sizeof(line), file))
+		if (sscanf(line, " {\"name\": \"%255[^\"]\", \"value\": %lf, \"unit\": \"%63[^\"]\", \"better\": \"%15[^\"]\"", name, &value, unit, better) == 4)
+		{
+			BenchResult result = { name, value, unit, strcmp(better, "higher") == 0 };
+			baseline.push_back(result);
+		}
+	fclose(file);
+	return !baseline.empty();
+}
+
+//Print how every result changed from a baseline, return the number that got worse by more than a tolerance (percent)
+static int compareResults(const std::vector<BenchResult> &baseline, double tolerance)
+{
+	int regressions = 0, improvements = 0, unmatched = 0;
+	printf("\ncompared with the baseline (tolerance %.1f%%):\n", tolerance);
+	for (const BenchResult &result : results)
+	{
+		auto base = std::find_if(baseline.begin(), baseline.end(), [&result](const BenchResult &other) { return other.name == result.name; });
+		if (base == baseline.end() || base->value == 0)
+		{
+			printf("\t%-40s %14.6g %-10s (not in the baseline)\n", result.name.c_str(), result.value, result.unit.c_str());
+			unmatched++;
+			continue;
+		}
+
+		//a change is better or worse depending on which way the measurement improves, so a rate going down and a time going up
+		//are both regressions
+		double change = (result.value - base->value) / base->value * 100;
+		double gain = result.higherBetter ? change : -change;
+		const char *verdict = "";
+		if (gain < -tolerance)
+		{
+			verdict = "REGRESSION";
+			regressions++;
+		}
+		else if (gain > tolerance)
+		{
+			verdict = "improved";
+			improvements++;
+		}
+		printf("\t%-40s %14.6g -> %14.6g %-10s %+8.1f%% %s\n", result.name.c_str(), base->value, result.value, result.unit.c_str(), change, verdict);
+	}
+	printf("%d regressions, %d improvements, %d results not in the baseline\n", regressions, improvements, unmatched);
+	return regressions;
+}
+
+//Add a number of balls with scattered positions and velocities to an empty world
+static void fillWorld(World &world, int count)
+{
+	//keep the balls well away from the (empty) goal block at the origin so every one of them flies freely; immovable balls (inverse mass 0)
+	//can't push each other either, so as gravity speeds them up they never start colliding and only the integration is measured
+	srand(1);
+	for (int i = 0; i < count; i++)
+	{
+		int index = world.addBall(1000 + rand() % 5000, 1000 + rand() % 5000, 10, 0);
+		world.setBallVelocity(index, rand() % 21 - 10, rand() % 21 - 10);
+	}
+}
+
+//Compare bodies per second of the per-object Ball::move path and the batch integration kernel
+static void benchIntegration(int count, int frames)
+{
+	//per-object path: each ball moves itself and mirrors its position into its scene item
+	World objectWorld;
+	fillWorld(objectWorld, count);
+	std::vector<Ball*> balls;
+	for (int i = 0; i < count; i++)
+		balls.push_back(new Ball(&objectWorld, i));
+	Clock::time_point start = Clock::now();
+	for (int frame = 0; frame < frames; frame++)
+		for (Ball *ball : balls)
+			ball->move(1.0);
+	double objectSeconds = secondsSince(start);
+	for (Ball *ball : balls)
+		delete ball;
+
+	//batch path: the world finds nothing in the way of any ball and moves them all with the kernel
+	World batchWorld;
+	fillWorld(batchWorld, count);
+	start = Clock::now();
+	for (int frame = 0; frame < frames; frame++)
+		batchWorld.step(1.0);
+	double batchSeconds = secondsSince(start);
+
+	//kernel alone, without the per-ball collision queries around it
+	BodyStore store = batchWorld.getBodies();
+	std::vector<double> portion(count, 1.0);
+	start = Clock::now();
+	for (int frame = 0; frame < frames; frame++)
+		store.integrate(portion.data());
+	double kernelSeconds = secondsSince(start);
+
+	double updates = (double)count * frames;
+	printf("integration %7d bodies: Ball::move %12.0f bodies/s | World::step %12.0f bodies/s | kernel %12.0f bodies/s (%.1fx)\n",
+		count, updates / objectSeconds, updates / batchSeconds, updates / kernelSeconds, objectSeconds / kernelSeconds);
+	std::string name = "integration." + std::to_string(count);
+	record(name + ".Ball::move", updates / objectSeconds, "bodies/s", true);
+	record(name + ".World::step", updates / batchSeconds, "bodies/s", true);
+	record(name + ".kernel", updates / kernelSeconds, "bodies/s", true);
+}
+
+//Build a walled level with a grid of a number of obstacle blocks
+static void generateLevel(int blockCount, LevelData &level)
+{
+	//square grid of 20x20 blocks on a 60 unit pitch, leaving room for the ball to pass between them
+	int columns = (int)ceil(sqrt((double)blockCount));
+	double side = 60.0 * columns + 80;
+	BlockData walls[4] = { { 0, 0, 40, side, 0, 0 }, { 40, 0, side - 80, 40, 0, 0 }, { side - 40, 0, 40, side, 0, 0 }, { 40, side - 40, side - 80, 40, 0, 0 } };
+
+	level.playerBall.x = 60;
+	level.playerBall.y = 60;
+	level.playerBall.radius = 10;
+	level.playerBall.invMass = 0.5;
+	level.goalBlock.x = side - 100;
+	level.goalBlock.y = side - 100;
+	level.goalBlock.width = 50;
+	level.goalBlock.height = 50;
+	level.goalBlock.invMass = 0;
+	level.blocks.assign(walls, walls + 4);
+	for (int i = 0; i < blockCount; i++)
+	{
+		BlockData block = { 80.0 + 60 * (i % columns), 80.0 + 60 * (i / columns), 20, 20, 0, 0 };
+		level.blocks.push_back(block);
+	}
+}
+
+//Measure the time per frame of a shot through a generated level
+static void benchLargeLevel(int blockCount, int frames)
+{
+	LevelData level;
+	generateLevel(blockCount, level);
+	Clock::time_point start = Clock::now();
+	World world;
+	world.loadLevel(level);
+	double loadSeconds = secondsSince(start);
+
+	world.setBallVelocity(0, 37, 23);
+	start = Clock::now();
+	int frame;
+	for (frame = 0; frame < frames && !world.step(1.0); frame++);
+	double stepSeconds = secondsSince(start);
+	printf("level %8d blocks: load %9.3f ms | %9.3f us/frame over %d frames\n", blockCount, loadSeconds * 1e3, stepSeconds * 1e6 / (frame + 1), frame + 1);
+	std::string name = "level." + std::to_string(blockCount);
+	record(name + ".load", loadSeconds * 1e3, "ms", false);
+	record(name + ".frame", stepSeconds * 1e6 / (frame + 1), "us", false);
+}
+
+//Compare the time to load a generated level from a text level file and from a mapped compiled level file
+static void benchLevelLoad(int blockCount, int repeats)
+{
+	LevelData level;
+	generateLevel(blockCount, level);
+	const char *textName = "benchlevel.txt";
+	const char *compiledName = "benchlevel.bin";
+	if (!saveLevelFile(textName, level) || !compileLevel(level, compiledName))
+	{
+		printf("load %8d blocks: can't write the level files\n", blockCount);
+		return;
+	}
+
+	//best of several loads, so both formats are measured with the file already in the page cache
+	double textSeconds = HUGE_VAL, parseSeconds = HUGE_VAL, compiledSeconds = HUGE_VAL, mapSeconds = HUGE_VAL;
+	int nodes = 0;
+	for (int repeat = 0; repeat < repeats; repeat++)
+	{
+		Clock::time_point start = Clock::now();
+		LevelData parsed;
+		loadLevelFile(textName, parsed);
+		parseSeconds = std::min(parseSeconds, secondsSince(start));
+		World textWorld;
+		textWorld.loadLevel(parsed);
+		textSeconds = std::min(textSeconds, secondsSince(start));
+
+		start = Clock::now();
+		MappedLevel mapped;
+		mapped.open(compiledName);
+		mapSeconds = std::min(mapSeconds, secondsSince(start));
+		World compiledWorld;
+		compiledWorld.loadLevel(mapped.getView());
+		compiledSeconds = std::min(compiledSeconds, secondsSince(start));
+		nodes = mapped.getView().nodeCount;
+	}
+	printf("load %8d blocks: text %9.3f ms (parse %9.3f) | compiled %8.3f ms (map+check %7.3f, index %s) | %.1fx\n", blockCount,
+		textSeconds * 1e3, parseSeconds * 1e3, compiledSeconds * 1e3, mapSeconds * 1e3, nodes > 0 ? "mapped" : "rebuilt", textSeconds / compiledSeconds);
+	std::string name = "load." + std::to_string(blockCount);
+	record(name + ".text", textSeconds * 1e3, "ms", false);
+	record(name + ".compiled", compiledSeconds * 1e3, "ms", false);
+	remove(textName);
+	remove(compiledName);
+}
+
+//Compare the time to switch to a generated level read on the spot and preloaded in the background, and the time to restart it
+static void benchLevelSwitch(int blockCount)
+{
+	//the preloader finds levels by number, so the generated level is written under a number no real level uses
+	const int levelNumber = 9000;
+	LevelData level;
+	generateLevel(blockCount, level);
+	if (!saveLevelFile(levelFileName(levelNumber), level) || !compileLevel(level, compiledLevelFileName(levelNumber)))
+	{
+		printf("switch %6d blocks: can't write the level files\n", blockCount);
+		return;
+	}
+	World world;
+	MappedLevel levelMap;
+	LevelView view;
+	LevelPreloader preloader;
+
+	//on the spot: nothing was requested, so take() reads and indexes the level itself
+	Clock::time_point start = Clock::now();
+	preloader.take(levelNumber, world, levelMap, view);
+	double syncSeconds = secondsSince(start);
+
+	//preloaded: the level is requested, the current one is played for a while (long enough for the worker to finish), then taken
+	preloader.request(levelNumber);
+	world.setBallVelocity(0, 37, 23);
+	start = Clock::now();
+	while (secondsSince(start) < 2 * syncSeconds + 0.01)
+		world.step(1.0);
+	start = Clock::now();
+	preloader.take(levelNumber, world, levelMap, view);
+	double takeSeconds = secondsSince(start);
+
+	world.setBallVelocity(0, 37, 23);
+	for (int frame = 0; frame < 100; frame++)
+		world.step(1.0);
+	start = Clock::now();
+	world.restart();
+	double restartSeconds = secondsSince(start);
+	printf("switch %6d blocks: on the spot %9.3f ms | preloaded %7.3f ms | restart %7.3f ms\n", blockCount, syncSeconds * 1e3,
+		takeSeconds * 1e3, restartSeconds * 1e3);
+	std::string name = "switch." + std::to_string(blockCount);
+	record(name + ".spot", syncSeconds * 1e3, "ms", false);
+	record(name + ".preloaded", takeSeconds * 1e3, "ms", false);
+	record(name + ".restart", restartSeconds * 1e3, "ms", false);
+	remove(levelFileName(levelNumber).c_str());
+	remove(compiledLevelFileName(levelNumber).c_str());
+}
+
+//Measure the time to predict the path of shots at every angle through a generated level, with and without the aim preview's time budget
+static void benchPreview(int blockCount, int steps)
+{
+	LevelData level;
+	generateLevel(blockCount, level);
+	World world;
+	world.loadLevel(level);
+	std::vector<Vec2D> path;
+
+	//one shot per degree at half power, the way the aim preview sees them while the player turns the launcher
+	double fullSeconds = 0, worstSeconds = 0, budgetSeconds = 0, worstBudgetSeconds = 0;
+	long long fullSteps = 0, budgetSteps = 0;
+	for (int angle = 0; angle < 360; angle++)
+	{
+		Vec2D velocity = Vec2D(cos(angle * 3.14159 / 180), sin(angle * 3.14159 / 180)) * 25;
+		Clock::time_point start = Clock::now();
+		predictTrajectory(world, velocity, steps, HUGE_VAL, path);
+		double seconds = secondsSince(start);
+		fullSeconds += seconds;
+		worstSeconds = std::max(worstSeconds, seconds);
+		fullSteps += path.size() - 1;
+
+		start = Clock::now();
+		predictTrajectory(world, velocity, steps, 1e-3, path);
+		seconds = secondsSince(start);
+		budgetSeconds += seconds;
+		worstBudgetSeconds = std::max(worstBudgetSeconds, seconds);
+		budgetSteps += path.size() - 1;
+	}
+	printf("preview %7d blocks: %7.3f ms avg, %7.3f ms worst, %5.1f steps | 1 ms budget: %7.3f ms avg, %7.3f ms worst, %5.1f steps\n", blockCount,
+		fullSeconds * 1e3 / 360, worstSeconds * 1e3, fullSteps / 360.0, budgetSeconds * 1e3 / 360, worstBudgetSeconds * 1e3, budgetSteps / 360.0);
+	std::string name = "preview." + std::to_string(blockCount);
+	record(name + ".avg", fullSeconds * 1e3 / 360, "ms", false);
+	record(name + ".budget_worst", worstBudgetSeconds * 1e3, "ms", false);
+}
+
+//Build a level of separate open boxes, each holding a pile of a number of balls
+static void generatePiles(int boxCount, int ballsPerBox, LevelData &level)
+{
+	//the boxes are far enough apart that no ball can reach the next box, so every box ends up as one or more islands of its own
+	int columns = (int)ceil(sqrt((double)boxCount));
+	level.playerBall.x = -1000;
+	level.playerBall.y = -1000;
+	level.playerBall.radius = 10;
+	level.playerBall.invMass = 0.5;
+	level.goalBlock.x = -2000;
+	level.goalBlock.y = -2000;
+	level.goalBlock.width = 10;
+	level.goalBlock.height = 10;
+	level.goalBlock.invMass = 0;
+	level.blocks.clear();
+	level.balls.clear();
+	srand(1);
+	for (int i = 0; i < boxCount; i++)
+	{
+		double left = 300.0 * (i % columns), top = 300.0 * (i / columns);
+		BlockData box[3] = { { left, top, 20, 280, 0, 0 }, { left + 260, top, 20, 280, 0, 0 }, { left, top + 260, 280, 20, 0, 0 } };
+		level.blocks.insert(level.blocks.end(), box, box + 3);
+		for (int j = 0; j < ballsPerBox; j++)
+		{
+			BallData ball = { left + 40 + 22.0 * (j % 10), top + 40 + 22.0 * (j / 10), (double)(rand() % 11 - 5), (double)(rand() % 11 - 5), 10, 1 };
+			level.balls.push_back(ball);
+		}
+	}
+}
+
+//Compare the time per frame of a level of many piles solved with 1, 2, 4, ... threads up to one per core
+static void benchIslands(int boxCount, int ballsPerBox, int frames)
+{
+	LevelData level;
+	generatePiles(boxCount, ballsPerBox, level);
+	int cores = std::max(1, (int)std::thread::hardware_concurrency());
+	double singleSeconds = 0;
+	for (int threads = 1; ; threads = std::min(2 * threads, cores))
+	{
+		World world;
+		world.loadLevel(level);
+		world.setThreadCount(threads);
+		Clock::time_point start = Clock::now();
+		for (int frame = 0; frame < frames; frame++)
+			world.step(1.0);
+		double seconds = secondsSince(start);
+		if (threads == 1)
+			singleSeconds = seconds;
+		const ContactStats &stats = world.getContactStats();
+		printf("islands %6d balls %3d threads: %5d islands | %9.3f ms/frame (%.2fx) | %lld contacts, budget hit %lld times (%lld slides), at most %d per island\n", world.getBallCount(), threads,
+			world.getIslandCount(), seconds * 1e3 / frames, singleSeconds / seconds, stats.contacts, stats.budgetHits, stats.budgetSlides, stats.maxContacts);
+		record("islands." + std::to_string(world.getBallCount()) + "." + std::to_string(threads) + "threads", seconds * 1e3 / frames, "ms", false);
+		if (threads == cores)
+			break;
+	}
+}
+
+//Build a walled level with a grid of a number of blocks moving along every kind of path and a number of balls scattered between them
+static void generateMovers(int moverCount, int ballCount, LevelData &level)
+{
+	//every mover stays 20 units inside its cell of a 100 unit pitch, so however it moves there is room for a ball between it and the
+	//next one or a wall (a ball squeezed between two blocks has nowhere to go); some go round in a few frames, faster than the balls
+	int columns = (int)ceil(sqrt((double)moverCount));
+	double side = 100.0 * columns + 80;
+	BlockData walls[4] = { { 0, 0, 40, side, 0, 0 }, { 40, 0, side - 80, 40, 0, 0 }, { side - 40, 0, 40, side, 0, 0 }, { 40, side - 40, side - 80, 40, 0, 0 } };
+
+	level.playerBall.x = 60;
+	level.playerBall.y = 60;
+	level.playerBall.radius = 10;
+	level.playerBall.invMass = 0.5;
+	level.goalBlock.x = -2000;
+	level.goalBlock.y = -2000;
+	level.goalBlock.width = 10;
+	level.goalBlock.height = 10;
+	level.goalBlock.invMass = 0;
+	level.blocks.assign(walls, walls + 4);
+	level.balls.clear();
+	level.movers.clear();
+	srand(1);
+	for (int i = 0; i < moverCount; i++)
+	{
+		double left = 40.0 + 100 * (i % columns), top = 40.0 + 100 * (i / columns);
+		MoverData mover = { left + 20, top + 45, 20, 10, 40, 0, (double)(4 + rand() % 120), (rand() % 100) / 100.0, i % MOVER_KINDS, 0 };
+		if (mover.kind == MOVER_CIRCULAR)
+		{
+			mover.x = left + 40;
+			mover.dx = 20;
+			mover.dy = 20;
+		}
+		level.movers.push_back(mover);
+	}
+	for (int i = 0; i < ballCount; i++)
+	{
+		BallData ball = { 90 + 100.0 * (i % columns), 52 + 100.0 * (i / columns), (double)(rand() % 11 - 5), (double)(rand() % 11 - 5), 6, 1 };
+		level.balls.push_back(ball);
+	}
+}
+
+//Measure the time per frame of a level of many moving blocks, compare refitting the hierarchy over them with rebuilding it every frame, and fail if a ball ends a frame inside a block
+static void benchMovers(int moverCount, int ballCount, int frames)
+{
+	LevelData level;
+	generateMovers(moverCount, ballCount, level);
+	World world;
+	world.loadLevel(level);
+
+	//a ball whose center ends a frame inside a moving block went through its side, which the swept tests are there to prevent
+	int inside = 0;
+	Clock::time_point start = Clock::now();
+	double checkSeconds = 0;
+	for (int frame = 0; frame < frames; frame++)
+	{
+		world.step(1.0);
+		Clock::time_point checkStart = Clock::now();
+		for (int i = 0; i < world.getMoverCount(); i++)
+		{
+			BlockBody mover = world.getMover(i, world.getTime());
+			for (int j = 0; j < world.getBallCount(); j++)
+				if (world.getBallX(j) > mover.xMin && world.getBallX(j) < mover.xMax && world.getBallY(j) > mover.yMin && world.getBallY(j) < mover.yMax)
+					inside++;
+		}
+		checkSeconds += secondsSince(checkStart);
+	}
+	double stepSeconds = secondsSince(start) - checkSeconds;
+
+	//the same motion applied to a hierarchy of the same blocks, once by moving its leaves and refitting, once by building it again
+	std::vector<BlockBody> bodies(moverCount);
+	for (int i = 0; i < moverCount; i++)
+		bodies[i] = world.getMover(i, 0);
+	BVH refitTree, buildTree;
+	refitTree.build(bodies);
+	start = Clock::now();
+	for (int frame = 1; frame <= frames; frame++)
+	{
+		for (int i = 0; i < moverCount; i++)
+		{
+			BlockBody mover = world.getMover(i, frame);
+			refitTree.moveBlock(i, mover.xMin, mover.yMin, mover.xMax, mover.yMax);
+		}
+		refitTree.refit();
+	}
+	double refitSeconds = secondsSince(start);
+	start = Clock::now();
+	for (int frame = 1; frame <= frames; frame++)
+	{
+		for (int i = 0; i < moverCount; i++)
+			bodies[i] = world.getMover(i, frame);
+		buildTree.build(bodies);
+	}
+	double buildSeconds = secondsSince(start);
+
+	printf("movers %6d blocks %5d balls: %9.3f ms/frame | refit %9.3f us, rebuild %9.3f us a frame (%.2fx)\n", moverCount, ballCount, stepSeconds * 1e3 / frames,
+		refitSeconds * 1e6 / frames, buildSeconds * 1e6 / frames, buildSeconds / refitSeconds);
+	if (inside > 0)
+		fail("movers " + std::to_string(moverCount) + ": a ball ended a frame inside a moving block " + std::to_string(inside) + " times");
+	std::string name = "movers." + std::to_string(moverCount);
+	record(name + ".frame", stepSeconds * 1e3 / frames, "ms", false);
+	record(name + ".refit", refitSeconds * 1e6 / frames, "us", false);
+	record(name + ".rebuild", buildSeconds * 1e6 / frames, "us", false);
+}
+
+//Build a floor with a number of columns of a number of boxes with mass stacked on it
+static void generateStacks(int columns, int rows, LevelData &level)
+{
+	//every box rests exactly on the one under it (its bounds take in the outline), a box apart from the next column, so a stack that
+	//holds still doesn't move at all
+	double pitch = 20 + BLOCK_OUTLINE_WIDTH - 1;
+	level.playerBall.x = -1000;
+	level.playerBall.y = -1000;
+	level.playerBall.radius = 10;
+	level.playerBall.invMass = 0.5;
+	level.goalBlock.x = -2000;
+	level.goalBlock.y = -2000;
+	level.goalBlock.width = 10;
+	level.goalBlock.height = 10;
+	level.goalBlock.invMass = 0;
+	level.balls.clear();
+	level.movers.clear();
+	level.blocks.clear();
+	BlockData floor = { 0, 900, 40.0 * columns + 40, 40, 0, 0 };
+	level.blocks.push_back(floor);
+	for (int column = 0; column < columns; column++)
+		for (int row = 0; row < rows; row++)
+		{
+			BlockData box = { 30.0 + 40 * column, 900 - pitch * (row + 1), 20, 20, 1, 0 };
+			level.blocks.push_back(box);
+		}
+}
+
+//Measure the time per frame of columns of stacked boxes with mass kept awake and left to sleep once at rest, and how far the boxes sank into each other and moved
+static void benchStacks(int columns, int rows, int frames)
+{
+	LevelData level;
+	generateStacks(columns, rows, level);
+	int count = columns * rows;
+	//the solver is timed with the stacks kept awake, then with them left to sleep the way the game leaves them
+	const char *modes[2] = { "awake", "asleep" };
+	for (int mode = 0; mode < 2; mode++)
+	{
+		World world;
+		world.loadLevel(level);
+		world.setBlockSleeping(mode == 1);
+		const std::vector<BlockBody> &boxes = world.getDynamicBlocks();
+		std::vector<BlockBody> start = boxes;
+
+		//the first box of a column is at the bottom and every box follows the one under it, so a box sinking into the one under
+		//it shows as the two overlapping; a box that moved at all shows in the drift, which a stack at rest keeps near 0
+		long long contacts = 0;
+		Clock::time_point begin = Clock::now();
+		for (int frame = 0; frame < frames; frame++)
+		{
+			world.step(1.0);
+			contacts += world.getSolverContactCount();
+		}
+		double seconds = secondsSince(begin);
+		double overlap = 0, drift = 0;
+		for (int i = 0; i < count; i++)
+		{
+			drift = std::max(drift, std::max(fabs(boxes[i].xMin - start[i].xMin), fabs(boxes[i].yMin - start[i].yMin)));
+			if (i % rows > 0)
+				overlap = std::max(overlap, boxes[i].yMax - boxes[i - 1].yMin);
+		}
+
+		printf("stack  %6d boxes %-6s: %9.3f ms/frame | %6.1f contacts a frame | deepest overlap %8.3f, drift %9.3f\n", count, modes[mode], seconds * 1e3 / frames,
+			(double)contacts / frames, overlap, drift);
+		std::string name = "stack." + std::to_string(count) + "." + modes[mode];
+		record(name + ".frame", seconds * 1e3 / frames, "ms", false);
+		record(name + ".overlap", overlap, "units", false);
+		record(name + ".drift", drift, "units", false);
+	}
+}
+
+//Measure the size of the replay of a run through a level of many piles, the time to re-simulate it and to seek to frames of it
+static void benchReplay(int boxCount, int ballsPerBox, int frames)
+{
+	LevelData level;
+	generatePiles(boxCount, ballsPerBox, level);
+	World world;
+	world.loadLevel(level);
+	world.setThreadCount(1);
+
+	//record a run the way the game does: a launch, a pause in the middle, a keyframe every REPLAY_KEYFRAME_INTERVAL frames
+	ReplayRecorder recorder;
+	recorder.begin(0, world);
+	Vec2D velocity = Vec2D(cos(315 * 3.14159 / 180), sin(315 * 3.14159 / 180)) * 15;
+	world.setBallVelocity(0, velocity.x, velocity.y);
+	recorder.launch(315, 15);
+	Clock::time_point start = Clock::now();
+	for (int frame = 0; frame < frames; frame++)
+	{
+		world.step(1.0);
+		recorder.step(world);
+		if (frame == frames / 2)
+		{
+			recorder.pause();
+			recorder.resume();
+		}
+	}
+	double playSeconds = secondsSince(start);
+	recorder.finish();
+
+	ReplayPlayer player;
+	player.decode(recorder.getData());
+	int goalFrame, desyncFrame;
+	start = Clock::now();
+	player.simulate(world, goalFrame, desyncFrame);
+	double simulateSeconds = secondsSince(start);
+
+	//seek to frames spread over the run, in no particular order
+	int seeks = 100;
+	srand(1);
+	start = Clock::now();
+	for (int i = 0; i < seeks; i++)
+		player.seek(world, rand() % (frames + 1));
+	double seekSeconds = secondsSince(start);
+	printf("replay %6d balls, %5d frames: %7zu bytes (%6.1f per frame, %6.1f per keyframe per ball) | played %8.2f ms, re-simulated %8.2f ms%s | seek %7.3f ms avg\n",
+		world.getBallCount(), frames, recorder.getData().size(), (double)recorder.getData().size() / frames,
+		(double)recorder.getData().size() / std::max(1, player.getKeyframeCount()) / world.getBallCount(), playSeconds * 1e3,
+		simulateSeconds * 1e3, desyncFrame < 0 ? "" : " (DISAGREES)", seekSeconds * 1e3 / seeks);
+	std::string name = "replay." + std::to_string(world.getBallCount()) + "." + std::to_string(frames);
+	record(name + ".bytes", (double)recorder.getData().size(), "bytes", false);
+	record(name + ".simulate", simulateSeconds * 1e3, "ms", false);
+	record(name + ".seek", seekSeconds * 1e3 / seeks, "ms", false);
+}
+
+//Measure the time to snapshot and restore a level of many piles, and compare branching what-if runs from a snapshot with reloading the level, checking a branch replays the run exactly
+static void benchSnapshot(int boxCount, int ballsPerBox, int frames)
+{
+	LevelData level;
+	generatePiles(boxCount, ballsPerBox, level);
+	World world;
+	world.loadLevel(level);
+	world.setThreadCount(1);
+
+	//play a shot the way the game does, pushing every frame onto a rewind ring as long as the run
+	SnapshotRing ring;
+	ring.reset(frames, world);
+	SnapshotHeader header = { 0, 0, 315, 1, 15 };
+	Vec2D velocity = Vec2D(cos(315 * 3.14159 / 180), sin(315 * 3.14159 / 180)) * 15;
+	world.setBallVelocity(0, velocity.x, velocity.y);
+	double pushSeconds = 0;
+	for (int frame = 1; frame <= frames; frame++)
+	{
+		world.step(1.0);
+		header.frame = frame;
+		Clock::time_point start = Clock::now();
+		ring.push(header, world);
+		pushSeconds += secondsSince(start);
+	}
+	std::vector<unsigned long long> ending;
+	for (int i = 0; i < world.getBallCount(); i++)
+	{
+		Vec2D v = world.getBallVelocity(i);
+		double values[4] = { world.getBallX(i), world.getBallY(i), v.x, v.y };
+		for (double value : values)
+		{
+			unsigned long long bits;
+			memcpy(&bits, &value, sizeof(bits));
+			ending.push_back(bits);
+		}
+	}
+
+	//restore frames spread over the run, in no particular order
+	int restores = 1000;
+	srand(1);
+	Clock::time_point start = Clock::now();
+	for (int i = 0; i < restores; i++)
+		ring.restore(rand() % frames, header, world);
+	double restoreSeconds = secondsSince(start);
+
+	//what-ifs from the middle of the run: the playerBall's velocity is nudged and the rest of the run played out. The first branch
+	//keeps the velocity it had, so it has to end exactly where the run did
+	int branches = 20, middle = frames / 2;
+	bool exact = true;
+	start = Clock::now();
+	for (int branch = 0; branch < branches; branch++)
+	{
+		ring.restore(frames - middle, header, world);
+		Vec2D v = world.getBallVelocity(0);
+		world.setBallVelocity(0, v.x + branch, v.y - branch);
+		for (int frame = middle; frame < frames; frame++)
+			world.step(1.0);
+		if (branch == 0)
+			for (int i = 0; i < world.getBallCount(); i++)
+			{
+				Vec2D end = world.getBallVelocity(i);
+				double values[4] = { world.getBallX(i), world.getBallY(i), end.x, end.y };
+				exact = exact && memcmp(values, &ending[4 * i], sizeof(values)) == 0;
+			}
+	}
+	double branchSeconds = secondsSince(start);
+
+	//the same what-ifs without snapshots: load the level, play the shot up to the middle again, then nudge and play out the rest
+	start = Clock::now();
+	for (int branch = 0; branch < branches; branch++)
+	{
+		world.loadLevel(level);
+		world.setBallVelocity(0, velocity.x, velocity.y);
+		for (int frame = 0; frame < middle; frame++)
+			world.step(1.0);
+		Vec2D v = world.getBallVelocity(0);
+		world.setBallVelocity(0, v.x + branch, v.y - branch);
+		for (int frame = middle; frame < frames; frame++)
+			world.step(1.0);
+	}
+	double reloadSeconds = secondsSince(start);
+	printf("snapshot %6d balls: %7zu bytes | push %8.3f us, restore %8.3f us | %d what-ifs from frame %d: snapshot %8.2f ms, reload %8.2f ms (%.1fx)%s\n",
+		world.getBallCount(), world.getStateSize() + sizeof(SnapshotHeader), pushSeconds * 1e6 / frames, restoreSeconds * 1e6 / restores,
+		branches, middle, branchSeconds * 1e3, reloadSeconds * 1e3, reloadSeconds / branchSeconds, exact ? "" : " (DIVERGES)");
+	std::string name = "snapshot." + std::to_string(world.getBallCount());
+	record(name + ".push", pushSeconds * 1e6 / frames, "us", false);
+	record(name + ".restore", restoreSeconds * 1e6 / restores, "us", false);
+	record(name + ".branch", branchSeconds * 1e3 / branches, "ms", false);
+}
+
+//Compare vectors per second reflected with the old out-of-line vector class and with Vec2 of doubles and floats
+static void benchVectorMath(int count, int repeats)
+{
+	//the same velocities and unit normals in each representation
+	std::vector<LegacyVec2D> legacyVelocities(count), legacyNormals(count), legacyOut(count);
+	std::vector<Vec2D> velocities(count), normals(count), out(count);
+	std::vector<Vec2f> floatVelocities(count), floatNormals(count), floatOut(count);
+	srand(1);
+	for (int i = 0; i < count; i++)
+	{
+		velocities[i] = Vec2D(rand() % 101 - 50, rand() % 101 - 50);
+		normals[i] = Vec2D(rand() % 101 - 50, rand() % 101 - 50 + 0.5).normalized();
+		legacyVelocities[i].setXY(velocities[i].x, velocities[i].y);
+		legacyNormals[i].setXY(normals[i].x, normals[i].y);
+		floatVelocities[i] = Vec2f((float)velocities[i].x, (float)velocities[i].y);
+		floatNormals[i] = Vec2f((float)normals[i].x, (float)normals[i].y);
+	}
+
+	//old style: unpack every vector into locals, do the math by hand, pack the result back
+	Clock::time_point start = Clock::now();
+	for (int repeat = 0; repeat < repeats; repeat++)
+		for (int i = 0; i < count; i++)
+		{
+			double xVelocity, yVelocity, xNormal, yNormal;
+			legacyVelocities[i].getVectorComponents(xVelocity, yVelocity);
+			legacyNormals[i].getVectorComponents(xNormal, yNormal);
+			double along = xVelocity * xNormal + yVelocity * yNormal;
+			legacyOut[i].setXY(xVelocity - 2 * along * xNormal, yVelocity - 2 * along * yNormal);
+		}
+	double legacySeconds = secondsSince(start);
+
+	start = Clock::now();
+	for (int repeat = 0; repeat < repeats; repeat++)
+		for (int i = 0; i < count; i++)
+			out[i] = velocities[i].reflect(normals[i]);
+	double doubleSeconds = secondsSince(start);
+
+	start = Clock::now();
+	for (int repeat = 0; repeat < repeats; repeat++)
+		for (int i = 0; i < count; i++)
+			floatOut[i] = floatVelocities[i].reflect(floatNormals[i]);
+	double floatSeconds = secondsSince(start);
+
+	//both double versions must agree
+	double difference = 0;
+	for (int i = 0; i < count; i++)
+	{
+		double x, y;
+		legacyOut[i].getVectorComponents(x, y);
+		difference = std::max(difference, (Vec2D(x, y) - out[i]).length());
+	}
+	double reflections = (double)count * repeats;
+	printf("reflect %7d vectors: legacy Vec2D %12.0f /s | Vec2<double> %12.0f /s (%.1fx) | Vec2<float> %12.0f /s (%.1fx) | max difference %g\n",
+		count, reflections / legacySeconds, reflections / doubleSeconds, legacySeconds / doubleSeconds, reflections / floatSeconds, legacySeconds / floatSeconds, difference);
+	std::string name = "reflect." + std::to_string(count);
+	record(name + ".legacy", reflections / legacySeconds, "vectors/s", true);
+	record(name + ".double", reflections / doubleSeconds, "vectors/s", true);
+	record(name + ".float", reflections / floatSeconds, "vectors/s", true);
+}
+
+//return the velocity of a ball after bouncing off a surface the way the physics did before bounce() (angles and per-axis damping)
+static NOINLINE Vec2D legacyCollide(Vec2D velocity, Vec2D normal)
+{
+	double flippedVelocityAngle;	//the angle of the ball's velocity flipped 180 degrees as first step of collision reflection
+	double normalAngle;				//the angle of the collision normal
+
+	//determine angles of flipped velocity and collision normal
+	if (velocity.x < 0)
+		flippedVelocityAngle = atan(velocity.y / velocity.x);
+	else
+		flippedVelocityAngle = atan(velocity.y / velocity.x) + 3.14159265358979323846;
+	if (normal.x < 0)
+		normalAngle = atan(normal.y / normal.x) + 3.14159265358979323846;
+	else
+		normalAngle = atan(normal.y / normal.x);
+
+	//reflect velocity angle across the normal, then damp each axis by how much the normal points along it
+	flippedVelocityAngle += 2 * (normalAngle - flippedVelocityAngle);
+	double speed = velocity.length();
+	velocity = Vec2D((1 - 0.15 * fabs(normal.x)) * cos(flippedVelocityAngle) * speed, (1 - 0.15 * fabs(normal.y)) * sin(flippedVelocityAngle) * speed);
+	double intoNormal = velocity.dot(normal);
+	if (intoNormal < 0)
+		velocity -= normal * intoNormal;
+	return velocity;
+}
+
+//Compare contacts per second resolved with the old angle-based response, bounce() one at a time and bounceBatch(), and check they agree
+static void benchResponse(int count, int repeats)
+{
+	//balls hitting block edges (every fourth one a corner); the edge normals include the ones the old response got wrong: a ball moving
+	//straight up or down (x velocity 0), and a normal flipped from another one (x component -0)
+	Material material = { DEFAULT_RESTITUTION, DEFAULT_FRICTION };
+	const Vec2D edges[6] = { Vec2D(0, -1), Vec2D(0, 1), Vec2D(-1, 0), Vec2D(1, 0), -Vec2D(0, -1), -Vec2D(0, 1) };
+	BodyStore store;
+	std::vector<Vec2D> velocities(count), normals(count), out(count);
+	ContactBatch batch;
+	srand(1);
+	for (int i = 0; i < count; i++)
+	{
+		Vec2D normal = i % 4 == 3 ? Vec2D(rand() % 101 - 50, rand() % 101 - 50 + 0.5).normalized() : edges[rand() % 6];
+		Vec2D velocity(i % 8 == 0 ? 0 : rand() % 101 - 50, rand() % 101 - 50);
+		if (velocity.dot(normal) >= 0)
+			velocity = -velocity;
+		if (velocity.dot(normal) >= 0)
+			velocity = -normal * 5;
+		velocities[i] = velocity;
+		normals[i] = normal;
+		store.add(0, 0, 10, 1);
+		store.setVelocity(i, velocity);
+		batch.add(i, normal, material);
+	}
+	std::vector<Vec2D> legacyOut(count);
+
+	Clock::time_point start = Clock::now();
+	for (int repeat = 0; repeat < repeats; repeat++)
+		for (int i = 0; i < count; i++)
+			legacyOut[i] = legacyCollide(velocities[i], normals[i]);
+	double legacySeconds = secondsSince(start);
+
+	start = Clock::now();
+	for (int repeat = 0; repeat < repeats; repeat++)
+		for (int i = 0; i < count; i++)
+			out[i] = bounce(velocities[i], normals[i], material);
+	double singleSeconds = secondsSince(start);
+
+	//the batch bounces the stored velocities in place, so put them back before every pass (outside the timing)
+	double batchSeconds = 0;
+	std::vector<double> vx = store.vx, vy = store.vy;
+	for (int repeat = 0; repeat < repeats; repeat++)
+	{
+		store.vx = vx;
+		store.vy = vy;
+		start = Clock::now();
+		bounceBatch(store, batch);
+		batchSeconds += secondsSince(start);
+	}
+
+	//on block edges without friction the two responses are the same bounce, so they should agree wherever the old one worked
+	double difference = 0, batchDifference = 0;
+	int edgeContacts = 0, legacyWrong = 0;
+	for (int i = 0; i < count; i++)
+	{
+		batchDifference = std::max(batchDifference, (store.getVelocity(i) - out[i]).length());
+		if (i % 4 == 3)
+			continue;
+		edgeContacts++;
+		double legacyDifference = (legacyOut[i] - out[i]).length();
+		if (!(legacyDifference < 1e-9 * (1 + velocities[i].length())))
+			legacyWrong++;
+		else
+			difference = std::max(difference, legacyDifference);
+	}
+	double contacts = (double)count * repeats;
+	printf("response %6d contacts: legacy %12.0f /s | bounce %12.0f /s (%.1fx) | batch %12.0f /s (%.1fx) | max difference %g (batch %g), legacy wrong on %d of %d edge contacts\n",
+		count, contacts / legacySeconds, contacts / singleSeconds, legacySeconds / singleSeconds, contacts / batchSeconds, legacySeconds / batchSeconds, difference, batchDifference, legacyWrong, edgeContacts);
+	std::string name = "response." + std::to_string(count);
+	record(name + ".legacy", contacts / legacySeconds, "contacts/s", true);
+	record(name + ".bounce", contacts / singleSeconds, "contacts/s", true);
+	record(name + ".batch", contacts / batchSeconds, "contacts/s", true);
+}
+
+//Determines if two line segments cross one another (the old narrowphase)
+static bool legacyLinesCross(double x1, double y1, double x2, double y2, double x3, double y3, double x4, double y4)
+{
+	double denom = (y4 - y3)*(x2 - x1) - (x4 - x3)*(y2 - y1);
+	double numerA = (x4 - x3)*(y1 - y3) - (y4 - y3)*(x1 - x3);
+	double numerB = (x2 - x1)*(y1 - y3) - (y2 - y1)*(x1 - x3);
+	if (denom == 0)
+		return numerA == 0 && numerB == 0;
+	return (numerA / denom >= 0 && numerA / denom <= 1) && (numerB / denom >= 0 && numerB / denom <= 1);
+}
+
+//Determines if a line comes within a radius of a corner point (the old narrowphase)
+static bool legacyLineCornerCollide(double x1, double y1, double x2, double y2, double xCorner, double yCorner, double radius, double &subPortion)
+{
+	double A = pow(((y1 - y2) / (x1 - x2)), 2) + 1;
+	double B = 2 * (((y1 - y2) / (x1 - x2)) * (y1 - ((y1 - y2) / (x1 - x2))*x1 - yCorner) - xCorner);
+	double C = pow(xCorner, 2) + pow((y1 - yCorner - ((y1 - y2) / (x1 - x2))*x1), 2) - pow(radius, 2);
+	if (pow(B, 2) - 4 * A * C >= 0)
+	{
+		double quadratic1 = (-1 * B + sqrt(pow(B, 2) - 4 * A * C)) / (2 * A);
+		double quadratic2 = (-1 * B - sqrt(pow(B, 2) - 4 * A * C)) / (2 * A);
+		if ((quadratic1 - x1) / (x2 - x1) <= 1 && (quadratic1 - x1) / (x2 - x1) > 0.001 && (quadratic2 - x1) / (x2 - x1) <= 1 && (quadratic2 - x1) / (x2 - x1) > 0.001)
+		{
+			if (fabs(quadratic1 - x1) < fabs(quadratic2 - x1))
+				subPortion = (quadratic1 - x1) / (x2 - x1);
+			else
+				subPortion = (quadratic2 - x1) / (x2 - x1);
+			return true;
+		}
+		else if ((quadratic1 - x1) / (x2 - x1) <= 1 && (quadratic1 - x1) / (x2 - x1) > 0.001)
+		{
+			subPortion = (quadratic1 - x1) / (x2 - x1);
+			return true;
+		}
+		else if ((quadratic2 - x1) / (x2 - x1) <= 1 && (quadratic2 - x1) / (x2 - x1) > 0.001)
+		{
+			subPortion = (quadratic2 - x1) / (x2 - x1);
+			return true;
+		}
+	}
+	return false;
+}
+
+//Find when a ball first touches a box with the old series of edge and corner tests, return false if it doesn't
+static bool legacySweep(Vec2D center, Vec2D trajectory, double radius, const SweepBox &box, double maxToi, SweepHit &hit)
+{
+	double leftBorder = box.xMin - radius, rightBorder = box.xMax + radius;
+	double topBorder = box.yMin - radius, bottomBorder = box.yMax + radius;
+	Vec2D end = center + trajectory;
+	if ((center.x < leftBorder && end.x < leftBorder) || (center.x > rightBorder && end.x > rightBorder) || (center.y < topBorder && end.y < topBorder) || (center.y > bottomBorder && end.y > bottomBorder))
+		return false;
+
+	//the four edges in order: from the left, the top, the right and the bottom
+	const double border[4] = { leftBorder, topBorder, rightBorder, bottomBorder };
+	const bool fromOutside[4] = { center.x < leftBorder, center.y < topBorder, center.x > rightBorder, center.y > bottomBorder };
+	for (int edge = 0; edge < 4; edge++)
+	{
+		bool vertical = edge % 2 == 0;
+		bool crosses = vertical ? legacyLinesCross(center.x, center.y, end.x, end.y, border[edge], box.yMin, border[edge], box.yMax)
+			: legacyLinesCross(center.x, center.y, end.x, end.y, box.xMin, border[edge], box.xMax, border[edge]);
+		double toi = vertical ? (border[edge] - center.x) / trajectory.x : (border[edge] - center.y) / trajectory.y;
+		if (crosses && fromOutside[edge] && toi <= maxToi)
+		{
+			hit.toi = toi;
+			hit.normal = vertical ? Vec2D(edge == 0 ? -1 : 1, 0) : Vec2D(0, edge == 1 ? -1 : 1);
+			return true;
+		}
+	}
+
+	//then the four corners: top-left, top-right, bottom-left and bottom-right
+	for (int corner = 0; corner < 4; corner++)
+	{
+		Vec2D point(corner % 2 == 0 ? box.xMin : box.xMax, corner < 2 ? box.yMin : box.yMax);
+		bool beyond = (corner % 2 == 0 ? center.x < box.xMin : center.x > box.xMax) && (corner < 2 ? center.y < box.yMin : center.y > box.yMax);
+		double toi;
+		if (legacyLineCornerCollide(center.x, center.y, end.x, end.y, point.x, point.y, radius, toi) && beyond && toi < maxToi)
+		{
+			hit.toi = toi;
+			hit.normal = (center + trajectory * toi - point) / radius;
+			return true;
+		}
+	}
+	return false;
+}
+
+//return the portion of a trajectory at which a ball first touches a corner, worked out in long double as the reference the kernels are held to (-1 if it never does)
+static double exactCornerToi(Vec2D center, Vec2D trajectory, double radius, Vec2D point)
+{
+	long double x = (long double)center.x - point.x, y = (long double)center.y - point.y;
+	long double a = (long double)trajectory.x * trajectory.x + (long double)trajectory.y * trajectory.y;
+	long double b = x * trajectory.x + y * trajectory.y;
+	long double c = x * x + y * y - (long double)radius * radius;
+	long double discriminant = b * b - a * c;
+	if (a == 0 || discriminant < 0)
+		return -1;
+	return (double)((-b - sqrtl(discriminant)) / a);
+}
+
+//Check sweepCircleBox() against the old narrowphase on the trajectories of shots through lvl1-lvl3 and compare their speed and the batch test's
+static void benchSweep(int angles, int powers)
+{
+	//record the player ball at the start of every frame of a fan of shots through each level, with the blocks it was swept against
+	std::vector<Vec2D> centers, trajectories;
+	std::vector<double> radii;
+	std::vector<int> levelOf;
+	std::vector<SweepBoxes> levelBoxes;
+	for (int levelNumber = 1; levelNumber <= 3; levelNumber++)
+	{
+		LevelData level;
+		if (!loadLevelFile(levelFileName(levelNumber), level))
+		{
+			printf("sweep: %s not found, run from the folder holding the level files\n", levelFileName(levelNumber).c_str());
+			return;
+		}
+		World world;
+		world.loadLevel(level);
+		SweepBoxes boxes;
+		const BlockBody &goal = world.getGoalBlock();
+		SweepBox goalBox = { goal.xMin, goal.yMin, goal.xMax, goal.yMax };
+		boxes.add(goalBox);
+		for (int i = 0; i < world.getBlockCount(); i++)
+		{
+			const BlockBody &block = world.getBlock(i);
+			SweepBox box = { block.xMin, block.yMin, block.xMax, block.yMax };
+			boxes.add(box);
+		}
+		levelBoxes.push_back(boxes);
+
+		for (int angle = 0; angle < angles; angle++)
+			for (int power = 0; power < powers; power++)
+			{
+				world.loadLevel(level);
+				double direction = -3.14159265358979323846 * angle / angles;
+				world.setBallVelocity(0, cos(direction) * (5 + 3 * power), sin(direction) * (5 + 3 * power));
+				for (int frame = 0; frame < 600; frame++)
+				{
+					centers.push_back(Vec2D(world.getBallX(0), world.getBallY(0)));
+					trajectories.push_back(world.getBallVelocity(0));
+					radii.push_back(world.getBallRadius(0));
+					levelOf.push_back(levelNumber - 1);
+					if (world.step(1.0))
+						break;
+				}
+			}
+	}
+
+	//every ball/block query one by one: both kernels should find the same hits, except where the old one missed a corner or got
+	//one wrong. Its corner test works from the slope of the trajectory, which on a nearly vertical one loses the last digits of the
+	//time of impact (off by a few 1e-6 at worst), and it ignores a corner touched in the first 0.001 of the frame, taking the time
+	//the ball leaves it instead; a hit that differs is only put down to those when the new one matches the exact time
+	int misses = 0, same = 0, differ = 0, legacyOnly = 0, newOnly = 0, legacyRounded = 0, legacyLate = 0;
+	for (size_t i = 0; i < centers.size(); i++)
+	{
+		const SweepBoxes &boxes = levelBoxes[levelOf[i]];
+		for (int j = 0; j < boxes.size(); j++)
+		{
+			SweepBox box = { boxes.xMin[j], boxes.yMin[j], boxes.xMax[j], boxes.yMax[j] };
+			SweepHit legacyHit, newHit;
+			bool legacy = legacySweep(centers[i], trajectories[i], radii[i], box, 1, legacyHit);
+			bool found = sweepCircleBox(centers[i], trajectories[i], radii[i], box, 1, newHit);
+			if (!legacy && !found)
+				misses++;
+			else if (legacy && found && fabs(legacyHit.toi - newHit.toi) <= 1e-9 && (legacyHit.normal - newHit.normal).length() <= 1e-9)
+				same++;
+			else if (legacy && found)
+			{
+				//the corner hit is the one nearest where the new kernel has the ball touch the box
+				Vec2D touch = centers[i] + trajectories[i] * newHit.toi - newHit.normal * radii[i];
+				Vec2D corner(fabs(touch.x - box.xMin) < fabs(touch.x - box.xMax) ? box.xMin : box.xMax, fabs(touch.y - box.yMin) < fabs(touch.y - box.yMax) ? box.yMin : box.yMax);
+				double exact = exactCornerToi(centers[i], trajectories[i], radii[i], corner);
+				bool newExact = fabs(newHit.toi - exact) <= 1e-12;
+				if (newExact && exact < 0.001 && legacyHit.toi > exact)
+					legacyLate++;
+				else if (newExact && fabs(legacyHit.toi - exact) <= 1e-5 && (legacyHit.normal - newHit.normal).length() <= 1e-4)
+					legacyRounded++;
+				else
+					differ++;
+			}
+			else if (legacy)
+				legacyOnly++;
+			else
+				newOnly++;
+		}
+	}
+
+	//earliest hit of every recorded frame against all of its level's blocks: the old tests one by one, the new test one by one, the batch test
+	std::vector<int> all;
+	for (int j = 0; j < levelBoxes[2].size(); j++)
+		all.push_back(j);
+	int repeats = 20;
+	double hitSum[3] = { 0, 0, 0 };
+	double seconds[3];
+	for (int kernel = 0; kernel < 3; kernel++)
+	{
+		Clock::time_point start = Clock::now();
+		for (int repeat = 0; repeat < repeats; repeat++)
+			for (size_t i = 0; i < centers.size(); i++)
+			{
+				const SweepBoxes &boxes = levelBoxes[levelOf[i]];
+				SweepHit hit;
+				hit.toi = 1;
+				if (kernel == 2)
+					sweepCircleBoxes(centers[i], trajectories[i], radii[i], boxes, all.data(), boxes.size(), 1, hit);
+				else
+					for (int j = 0; j < boxes.size(); j++)
+					{
+						SweepBox box = { boxes.xMin[j], boxes.yMin[j], boxes.xMax[j], boxes.yMax[j] };
+						SweepHit candidate;
+						if (kernel == 0 ? legacySweep(centers[i], trajectories[i], radii[i], box, hit.toi, candidate) : sweepCircleBox(centers[i], trajectories[i], radii[i], box, hit.toi, candidate))
+							hit = candidate;
+					}
+				hitSum[kernel] += hit.toi;
+			}
+		seconds[kernel] = secondsSince(start);
+	}
+	double queries = (double)centers.size() * repeats;
+	printf("sweep %7zu frames: legacy %10.0f frames/s | sweepCircleBox %10.0f frames/s (%.1fx) | sweepCircleBoxes %10.0f frames/s (%.1fx)\n",
+		centers.size(), queries / seconds[0], queries / seconds[1], seconds[0] / seconds[1], queries / seconds[2], seconds[0] / seconds[2]);
+	printf("sweep ball/block queries: %d both miss | %d same hit | %d legacy corner rounded, %d legacy corner left late | %d hit differs | %d legacy only | %d new only (corners the old tests missed) | batch matches one by one: %s\n",
+		misses, same, legacyRounded, legacyLate, differ, legacyOnly, newOnly, hitSum[1] == hitSum[2] ? "yes" : "no");
+	if (differ > 0 || legacyOnly > 0)
+		fail("sweepCircleBox() disagrees with the old narrowphase on " + std::to_string(differ + legacyOnly) + " hits");
+	record("sweep.legacy", queries / seconds[0], "frames/s", true);
+	record("sweep.sweepCircleBox", queries / seconds[1], "frames/s", true);
+	record("sweep.sweepCircleBoxes", queries / seconds[2], "frames/s", true);
+}
+
+//Measure the time per call of every test of the collision pipeline on ball/block pairs that miss, graze and hit
+static void benchCollisionKernels(int count, int repeats)
+{
+	//one ball beside every block of a generated level, off to one side by up to two block widths and moving roughly at it (anywhere
+	//from not at all to well past it, give or take ten units a frame), so the pairs mix early-outs, near misses and hits
+	LevelData level;
+	generateLevel(count, level);
+	World world;
+	world.loadLevel(level);
+	srand(1);
+	for (int i = 0; i < count; i++)
+	{
+		const BlockBody &block = world.getBlock(i + 4);
+		double x = (block.xMin + block.xMax) / 2 + rand() % 81 - 40;
+		double y = (block.yMin + block.yMax) / 2 + (rand() % 2 ? 1 : -1) * (20 + rand() % 21);
+		int ball = world.addBall(x, y, 5, 1);
+		double reach = (rand() % 16) / 10.0;
+		world.setBallVelocity(ball, ((block.xMin + block.xMax) / 2 - x) * reach + rand() % 21 - 10, ((block.yMin + block.yMax) / 2 - y) * reach + rand() % 21 - 10);
+	}
+	std::vector<Ball*> balls;
+	for (int i = 0; i < count; i++)
+		balls.push_back(new Ball(&world, i + 1));
+
+	//the old narrowphase's line tests against the top edge and the top-left corner of each ball's block
+	double seconds[6];
+	long long found[6] = { 0, 0, 0, 0, 0, 0 };
+	Clock::time_point start = Clock::now();
+	for (int repeat = 0; repeat < repeats; repeat++)
+		for (int i = 0; i < count; i++)
+		{
+			const BlockBody &block = world.getBlock(i + 4);
+			double x = world.getBallX(i + 1), y = world.getBallY(i + 1);
+			Vec2D velocity = world.getBallVelocity(i + 1);
+			found[0] += legacyLinesCross(x, y, x + velocity.x, y + velocity.y, block.xMin, block.yMin, block.xMax, block.yMin);
+		}
+	seconds[0] = secondsSince(start);
+	start = Clock::now();
+	for (int repeat = 0; repeat < repeats; repeat++)
+		for (int i = 0; i < count; i++)
+		{
+			const BlockBody &block = world.getBlock(i + 4);
+			double x = world.getBallX(i + 1), y = world.getBallY(i + 1), toi;
+			Vec2D velocity = world.getBallVelocity(i + 1);
+			found[1] += legacyLineCornerCollide(x, y, x + velocity.x, y + velocity.y, block.xMin, block.yMin, world.getBallRadius(i + 1), toi);
+		}
+	seconds[1] = secondsSince(start);
+
+	//the world's test before the narrowphase and the narrowphase itself
+	start = Clock::now();
+	for (int repeat = 0; repeat < repeats; repeat++)
+		for (int i = 0; i < count; i++)
+			found[2] += world.blockReachable(i + 1, i + 4, 1.0);
+	seconds[2] = secondsSince(start);
+	start = Clock::now();
+	for (int repeat = 0; repeat < repeats; repeat++)
+		for (int i = 0; i < count; i++)
+		{
+			Vec2D normal;
+			double subPortion;
+			found[3] += world.detectBlock(i + 1, i + 4, 1.0, normal, subPortion);
+		}
+	seconds[3] = secondsSince(start);
+
+	//a ball item bouncing off a surface and moving a frame, each mirrored into its scene item the way the game once did every step
+	start = Clock::now();
+	for (int repeat = 0; repeat < repeats; repeat++)
+		for (int i = 0; i < count; i++)
+			balls[i]->collide(Vec2D(0, repeat % 2 ? 1 : -1), nullptr);
+	seconds[4] = secondsSince(start);
+	start = Clock::now();
+	for (int repeat = 0; repeat < repeats; repeat++)
+		for (Ball *ball : balls)
+			ball->move(1.0 / repeats);
+	seconds[5] = secondsSince(start);
+	for (Ball *ball : balls)
+		delete ball;
+
+	const char *names[6] = { "linesCross", "lineCornerCollide", "collisionPossible", "collisionDetect", "Ball::collide", "Ball::move" };
+	double calls = (double)count * repeats;
+	printf("kernels %6d pairs:", count);
+	for (int test = 0; test < 6; test++)
+	{
+		printf(" %s %6.1f ns%s", names[test], seconds[test] * 1e9 / calls, test < 5 ? " |" : "\n");
+		record("kernel." + std::string(names[test]), seconds[test] * 1e9 / calls, "ns", false);
+	}
+	printf("kernels %6d pairs: %.0f%% cross the edge, %.0f%% reach the corner, %.0f%% pass collisionPossible, %.0f%% hit\n", count,
+		found[0] * 100 / calls, found[1] * 100 / calls, found[2] * 100 / calls, found[3] * 100 / calls);
+}
+
+//Measure the time per frame and per shot of a fan of full shots through lvl1-lvl3
+static void benchShots(int angles, int powers)
+{
+	for (int levelNumber = 1; levelNumber <= 3; levelNumber++)
+	{
+		LevelData level;
+		if (!loadLevelFile(levelFileName(levelNumber), level))
+		{
+			printf("shots: %s not found, run from the folder holding the level files\n", levelFileName(levelNumber).c_str());
+			return;
+		}
+		World world;
+		world.loadLevel(level);
+		world.setThreadCount(1);
+
+		//every shot the way the game launches it, played until it hits the goal or SHOT_FRAMES run out
+		long long frames = 0;
+		int hits = 0;
+		Clock::time_point start = Clock::now();
+		for (int angle = 0; angle < angles; angle++)
+			for (int power = 1; power <= powers; power++)
+			{
+				int degrees = angle * 360 / angles;
+				world.restart();
+				Vec2D velocity = Vec2D(cos(degrees * 3.14159 / 180), sin(degrees * 3.14159 / 180)) * (MAX_VELOCITY * power / powers);
+				world.setBallVelocity(0, velocity.x, velocity.y);
+				for (int frame = 0; frame < SHOT_FRAMES; frame++)
+				{
+					frames++;
+					if (world.step(1.0))
+					{
+						hits++;
+						break;
+					}
+				}
+			}
+		double seconds = secondsSince(start);
+		int shots = angles * powers;
+		printf("shots lvl%d: %5d shots, %5d hit the goal | %9.3f us/frame | %8.3f ms/shot\n", levelNumber, shots, hits, seconds * 1e6 / frames,
+			seconds * 1e3 / shots);
+		std::string name = "shots.lvl" + std::to_string(levelNumber);
+		record(name + ".frame", seconds * 1e6 / frames, "us", false);
+		record(name + ".shot", seconds * 1e3 / shots, "ms", false);
+	}
+}
+
+//Compare the time per shot of a fan of shots through lvl1-lvl3 played for up to a number of frames frame by frame, jumping from event to event and jumping only over the frames nothing is in reach in, the events handled per frame played and how often each agrees with the frames on the goal
+static void benchEvents(int angles, int powers, int maxFrames)
+{
+	for (int levelNumber = 1; levelNumber <= 3; levelNumber++)
+	{
+		LevelData level;
+		if (!loadLevelFile(levelFileName(levelNumber), level))
+		{
+			printf("events: %s not found, run from the folder holding the level files\n", levelFileName(levelNumber).c_str());
+			return;
+		}
+		World world;
+		world.loadLevel(level);
+		world.setThreadCount(1);
+		EventSimulator simulator;
+
+		//every shot the way the game launches it, played frame by frame, from event to event and by EventSimulator::play(); all stop
+		//at the goal, and a miss runs every frame, so with a long budget most shots are long rollouts. The events' parabolas are a
+		//different model from the straight moves the game's frame steps make, and every shot they disagree on is a shot they get
+		//wrong; play() gives the game's answers, and any shot it disagrees on fails the run
+		long long frames = 0, events = 0;
+		int frameHits = 0, eventHits = 0, agreed = 0, playAgreed = 0;
+		double frameSeconds = 0, eventSeconds = 0, playSeconds = 0;
+		for (int angle = 0; angle < angles; angle++)
+			for (int power = 1; power <= powers; power++)
+			{
+				int degrees = angle * 360 / angles;
+				Vec2D velocity = Vec2D(cos(degrees * 3.14159 / 180), sin(degrees * 3.14159 / 180)) * (MAX_VELOCITY * power / powers);
+				Clock::time_point start = Clock::now();
+				world.restart();
+				world.setBallVelocity(0, velocity.x, velocity.y);
+				bool frameHit = false;
+				for (int frame = 0; frame < maxFrames && !frameHit; frame++)
+				{
+					frames++;
+					frameHit = world.step(1.0);
+				}
+				frameSeconds += secondsSince(start);
+
+				start = Clock::now();
+				world.restart();
+				world.setBallVelocity(0, velocity.x, velocity.y);
+				simulator.load(world);
+				bool eventHit = simulator.advance(maxFrames);
+				events += simulator.getEventCount();
+				eventSeconds += secondsSince(start);
+
+				start = Clock::now();
+				world.restart();
+				world.setBallVelocity(0, velocity.x, velocity.y);
+				bool playHit = simulator.play(world, maxFrames);
+				playSeconds += secondsSince(start);
+
+				frameHits += frameHit ? 1 : 0;
+				eventHits += eventHit ? 1 : 0;
+				agreed += frameHit == eventHit ? 1 : 0;
+				playAgreed += frameHit == playHit ? 1 : 0;
+			}
+		int shots = angles * powers;
+		printf("events lvl%d %6d frames: %5d shots, %5d / %5d hit the goal, %5.1f%% agree | frames %8.3f ms/shot | events %8.3f ms/shot (%5.1fx) | %.3f events/frame | play %8.3f ms/shot (%5.1fx), %5.1f%% agree\n",
+			levelNumber, maxFrames, shots, frameHits, eventHits, agreed * 100.0 / shots, frameSeconds * 1e3 / shots, eventSeconds * 1e3 / shots,
+			frameSeconds / eventSeconds, (double)events / frames, playSeconds * 1e3 / shots, frameSeconds / playSeconds, playAgreed * 100.0 / shots);
+		if (playAgreed < shots)
+			fail("events lvl" + std::to_string(levelNumber) + ": play() disagrees with the frames on " + std::to_string(shots - playAgreed) + " shots");
+		std::string name = "events.lvl" + std::to_string(levelNumber) + "." + std::to_string(maxFrames);
+		record(name + ".frames", frameSeconds * 1e3 / shots, "ms", false);
+		record(name + ".events", eventSeconds * 1e3 / shots, "ms", false);
+		record(name + ".speedup", frameSeconds / eventSeconds, "x", true);
+		record(name + ".agree", agreed * 100.0 / shots, "%", true);
+		record(name + ".play", playSeconds * 1e3 / shots, "ms", false);
+		record(name + ".playSpeedup", frameSeconds / playSeconds, "x", true);
+	}
+}
+
+//Play a fan of shots through lvl1-lvl3 in steps of many frames along straight lines and along parabolas, and compare the time per frame, the collision queries per frame, the shots that end a step inside a block and how often they agree on the goal with the game's single frame steps along straight lines
+static void benchBigSteps(int angles, int powers, int maxFrames)
+{
+	const int stepLengths[] = { 1, 10, 20, 50 };
+	for (int levelNumber = 1; levelNumber <= 3; levelNumber++)
+	{
+		LevelData level;
+		if (!loadLevelFile(levelFileName(levelNumber), level))
+		{
+			printf("bigstep: %s not found, run from the folder holding the level files\n", levelFileName(levelNumber).c_str());
+			return;
+		}
+		World world;
+		world.loadLevel(level);
+		world.setThreadCount(1);
+		int shots = angles * powers;
+		std::vector<char> reference(shots);
+		std::vector<int> candidates;
+
+		//every run is held against the game's: single frame steps along straight lines. A step along a straight line cuts the
+		//corners of the curve the ball falls along, more the longer the step; the parabola doesn't, but it only meets the frame
+		//steps at whole frames and misses the straight moves they make in between, so even at a frame per step some shots bounce
+		//off another way than the game's. A ball whose center ends a step inside a level block went through a side
+		for (int parabolic = 0; parabolic <= 1; parabolic++)
+			for (int stepLength : stepLengths)
+			{
+				world.setParabolicSteps(parabolic != 0);
+				world.resetContactStats();
+				int hits = 0, agreed = 0, inside = 0;
+				double seconds = 0, checkSeconds = 0;
+				for (int shot = 0; shot < shots; shot++)
+				{
+					int degrees = shot / powers * 360 / angles;
+					Vec2D velocity = Vec2D(cos(degrees * 3.14159 / 180), sin(degrees * 3.14159 / 180)) * (MAX_VELOCITY * (shot % powers + 1) / powers);
+					Clock::time_point start = Clock::now();
+					world.restart();
+					world.setBallVelocity(0, velocity.x, velocity.y);
+					bool hit = false, tunneled = false;
+					for (int frame = 0; frame < maxFrames && !hit; frame += stepLength)
+					{
+						hit = world.step(stepLength);
+						Clock::time_point checkStart = Clock::now();
+						double x = world.getBallX(0), y = world.getBallY(0);
+						world.getBlockTree().query(x, y, x, y, candidates);
+						for (int block : candidates)
+						{
+							const BlockBody &body = world.getBlock(block);
+							tunneled = tunneled || (x > body.xMin && x < body.xMax && y > body.yMin && y < body.yMax);
+						}
+						checkSeconds += secondsSince(checkStart);
+					}
+					seconds += secondsSince(start);
+					if (stepLength == 1 && !parabolic)
+						reference[shot] = hit;
+					hits += hit ? 1 : 0;
+					agreed += hit == (reference[shot] != 0) ? 1 : 0;
+					inside += tunneled ? 1 : 0;
+				}
+				seconds -= checkSeconds;
+
+				//every step of the ball makes one collision query, and every collision it resolves one more
+				const ContactStats &stats = world.getContactStats();
+				double frames = (double)stats.steps * stepLength;
+				const char *mode = parabolic ? "parabola" : "straight";
+				printf("bigstep lvl%d %s %2d frames/step: %5d shots, %5d hit the goal, %5.1f%% agree | %8.3f us/frame | %.3f queries/frame | %4d shots inside a block\n",
+					levelNumber, mode, stepLength, shots, hits, agreed * 100.0 / shots, seconds * 1e6 / frames, (stats.steps + stats.contacts) / frames, inside);
+				std::string name = "bigstep.lvl" + std::to_string(levelNumber) + "." + mode + "." + std::to_string(stepLength);
+				record(name + ".frame", seconds * 1e6 / frames, "us", false);
+				record(name + ".queries", (stats.steps + stats.contacts) / frames, "queries", false);
+				record(name + ".agree", agreed * 100.0 / shots, "%", true);
+				record(name + ".inside", inside, "shots", false);
+			}
+	}
+}
+
+//Build the walled level of generateLevel() with its obstacles as blocks, as axis-aligned polygons or as boxes rotated by 30 degrees
+static void generateShapes(int obstacleCount, int kind, LevelData &level)
+{
+	generateLevel(obstacleCount, level);
+	if (kind == SHAPE_BLOCKS)
+		return;
+	double angle = kind == SHAPE_ROTATED_BOXES ? 30 * 3.14159265358979323846 / 180 : 0;
+	for (int i = 4; i < (int)level.blocks.size(); i++)
+	{
+		const BlockData &block = level.blocks[i];
+		Vec2D center(block.x + block.width / 2, block.y + block.height / 2);
+		Vec2D across = Vec2D(cos(angle), sin(angle)) * (block.width / 2), down = Vec2D(-sin(angle), cos(angle)) * (block.height / 2);
+		Vec2D corners[4] = { center - across - down, center + across - down, center + across + down, center - across + down };
+		PolygonData polygon = PolygonData();
+		polygon.pointCount = 4;
+		for (int corner = 0; corner < 4; corner++)
+		{
+			polygon.x[corner] = corners[corner].x;
+			polygon.y[corner] = corners[corner].y;
+		}
+		level.polygons.push_back(polygon);
+	}
+	level.blocks.resize(4);
+}
+
+//Compare the time per call of the box narrowphase called directly, through the shape pair table and as a polygon, and the time per frame of a fan of shots through a generated level whose obstacles are blocks, polygons and rotated boxes
+static void benchShapes(int obstacleCount, int angles, int powers)
+{
+	//balls around a 20x20 box moving roughly at it, swept against it with sweepCircleBox() itself, through the table the world
+	//calls it through (which has to cost nothing, the blocks' fast path going through it), and as a polygon with the same corners
+	int count = 10000, repeats = 200;
+	std::vector<Vec2D> centers(count), velocities(count);
+	srand(1);
+	for (int i = 0; i < count; i++)
+	{
+		centers[i] = Vec2D(rand() % 81 - 40, (rand() % 2 ? 1 : -1) * (20 + rand() % 21));
+		velocities[i] = centers[i] * (-(rand() % 16) / 10.0) + Vec2D(rand() % 21 - 10, rand() % 21 - 10);
+	}
+	SweepBox box = { -10, -10, 10, 10 };
+	Vec2D points[4] = { Vec2D(-10, -10), Vec2D(10, -10), Vec2D(10, 10), Vec2D(-10, 10) };
+	Vec2D normals[4] = { Vec2D(0, -1), Vec2D(1, 0), Vec2D(0, 1), Vec2D(-1, 0) };
+	SweepPolygon polygon = { points, normals, 4, box, 0 };
+	double seconds[3];
+	std::vector<double> toi[3] = { std::vector<double>(count), std::vector<double>(count), std::vector<double>(count) };
+	Clock::time_point start = Clock::now();
+	for (int repeat = 0; repeat < repeats; repeat++)
+		for (int i = 0; i < count; i++)
+		{
+			SweepHit hit;
+			toi[0][i] = sweepCircleBox(centers[i], velocities[i], 5, box, 1, hit) ? hit.toi : -1;
+		}
+	seconds[0] = secondsSince(start);
+	start = Clock::now();
+	for (int repeat = 0; repeat < repeats; repeat++)
+		for (int i = 0; i < count; i++)
+		{
+			SweepMotion motion = { centers[i], velocities[i], Vec2D(), 5 };
+			SweepHit hit;
+			toi[1][i] = sweepShape<SHAPE_BOX>(motion, box, 1, hit) ? hit.toi : -1;
+		}
+	seconds[1] = secondsSince(start);
+	start = Clock::now();
+	for (int repeat = 0; repeat < repeats; repeat++)
+		for (int i = 0; i < count; i++)
+		{
+			SweepMotion motion = { centers[i], velocities[i], Vec2D(), 5 };
+			SweepHit hit;
+			toi[2][i] = sweepShape<SHAPE_POLYGON>(motion, polygon, 1, hit) ? hit.toi : -1;
+		}
+	seconds[2] = secondsSince(start);
+	const char *kernels[3] = { "direct", "table", "polygon" };
+	double calls = (double)count * repeats;
+	printf("shapes %6d pairs:", count);
+	for (int kernel = 0; kernel < 3; kernel++)
+	{
+		printf(" %s %6.1f ns%s", kernels[kernel], seconds[kernel] * 1e9 / calls, kernel < 2 ? " |" : "");
+		record("shapes.kernel." + std::string(kernels[kernel]), seconds[kernel] * 1e9 / calls, "ns", false);
+	}
+
+	//a ball grazing a side it moves along may count as touching it at the very end of the sweep for one test and not the other
+	int hits = 0, tableAgreed = 0, polygonAgreed = 0;
+	for (int i = 0; i < count; i++)
+	{
+		hits += toi[0][i] >= 0 ? 1 : 0;
+		tableAgreed += toi[1][i] == toi[0][i] ? 1 : 0;
+		polygonAgreed += fabs(toi[2][i] - toi[0][i]) < 1e-9 ? 1 : 0;
+	}
+	printf(" | %.0f%% hit, table agrees on %.2f%%, polygon on %.2f%%\n", hits * 100.0 / count, tableAgreed * 100.0 / count, polygonAgreed * 100.0 / count);
+	record("shapes.kernel.polygonAgree", polygonAgreed * 100.0 / count, "%", true);
+
+	//the same fan of shots through the same grid of obstacles, as blocks (the batch test over the block hierarchy), as polygons
+	//with the blocks' corners and as rotated boxes (the polygon hierarchy and the table's polygon routine)
+	const char *names[3] = { "blocks", "polygons", "rotated" };
+	for (int kind = SHAPE_BLOCKS; kind <= SHAPE_ROTATED_BOXES; kind++)
+	{
+		LevelData level;
+		generateShapes(obstacleCount, kind, level);
+		World world;
+		world.loadLevel(level);
+		world.setThreadCount(1);
+		long long frames = 0;
+		int hits = 0;
+		start = Clock::now();
+		for (int angle = 0; angle < angles; angle++)
+			for (int power = 1; power <= powers; power++)
+			{
+				int degrees = angle * 90 / angles;
+				world.restart();
+				Vec2D velocity = Vec2D(cos(degrees * 3.14159 / 180), sin(degrees * 3.14159 / 180)) * (MAX_VELOCITY * power / powers);
+				world.setBallVelocity(0, velocity.x, velocity.y);
+				for (int frame = 0; frame < SHOT_FRAMES; frame++)
+				{
+					frames++;
+					if (world.step(1.0))
+					{
+						hits++;
+						break;
+					}
+				}
+			}
+		double shotSeconds = secondsSince(start);
+		printf("shapes %6d %-8s: %5d shots, %5d hit the goal | %9.3f us/frame\n", obstacleCount, names[kind], angles * powers, hits, shotSeconds * 1e6 / frames);
+		record("shapes." + std::to_string(obstacleCount) + "." + names[kind] + ".frame", shotSeconds * 1e6 / frames, "us", false);
+	}
+}
+
+//Run the benchmarks (benchmark [-filter text] [-json file] [-baseline file] [-tolerance percent]) and print the results, return 1 if any got worse than the baseline by more than the tolerance or a check a benchmark makes failed
+int main(int argc, char *argv[])
+{
+	std::string jsonName, baselineName;
+	double tolerance = BENCH_TOLERANCE;
+	for (int i = 1; i < argc; i++)
+	{
+		std::string option = argv[i];
+		if (option == "-filter" && i + 1 < argc)
+			filter = argv[++i];
+		else if (option == "-json" && i + 1 < argc)
+			jsonName = argv[++i];
+		else if (option == "-baseline" && i + 1 < argc)
+			baselineName = argv[++i];
+		else if (option == "-tolerance" && i + 1 < argc)
+			tolerance = atof(argv[++i]);
+		else
+		{
+			printf("usage: %s [-filter text] [-json results.json] [-baseline baseline.json] [-tolerance percent]\n", argv[0]);
+			printf("groups: reflect response sweep kernel shapes integration shots events bigstep level load switch preview islands movers stack replay snapshot\n");
+			return 1;
+		}
+	}
+
+	//a baseline that can't be read fails before anything is measured, rather than after minutes of benchmarks
+	std::vector<BenchResult> baseline;
+	if (!baselineName.empty() && !readResults(baselineName, baseline))
+	{
+		printf("%s: can't be read or holds no results\n", baselineName.c_str());
+		return 1;
+	}
+
+	//microbenchmarks of single kernels first, then whole frames, shots and levels
+	if (selected("reflect"))
+		benchVectorMath(10000, 2000);
+	if (selected("response"))
+		benchResponse(10000, 2000);
+	if (selected("sweep"))
+		benchSweep(60, 10);
+	if (selected("kernel"))
+		benchCollisionKernels(10000, 1000);
+	if (selected("shapes"))
+	{
+		benchShapes(100, 18, 10);
+		benchShapes(10000, 18, 10);
+	}
+	if (selected("integration"))
+	{
+		benchIntegration(1000, 2000);
+		benchIntegration(10000, 200);
+		benchIntegration(100000, 20);
+	}
+	if (selected("shots"))
+		benchShots(72, 20);
+	if (selected("events"))
+	{
+		benchEvents(72, 20, SHOT_FRAMES);
+		benchEvents(36, 10, 20000);
+	}
+	if (selected("bigstep"))
+		benchBigSteps(72, 20, SHOT_FRAMES);
+	if (selected("level"))
+	{
+		benchLargeLevel(10, 2000);
+		benchLargeLevel(100, 2000);
+		benchLargeLevel(1000, 2000);
+		benchLargeLevel(10000, 2000);
+		benchLargeLevel(100000, 2000);
+		benchLargeLevel(1000000, 2000);
+	}
+	if (selected("load"))
+	{
+		benchLevelLoad(1000, 5);
+		benchLevelLoad(10000, 5);
+		benchLevelLoad(100000, 3);
+		benchLevelLoad(1000000, 3);
+	}
+	if (selected("switch"))
+	{
+		benchLevelSwitch(10000);
+		benchLevelSwitch(1000000);
+	}
+	if (selected("preview"))
+	{
+		benchPreview(100, 100);
+		benchPreview(10000, 100);
+		benchPreview(1000000, 100);
+	}
+	if (selected("islands"))
+		benchIslands(256, 20, 200);
+	if (selected("movers"))
+	{
+		benchMovers(100, 100, 600);
+		benchMovers(1000, 1000, 300);
+		benchMovers(10000, 1000, 100);
+	}
+	if (selected("stack"))
+	{
+		benchStacks(10, 10, 600);
+		benchStacks(20, 15, 600);
+		benchStacks(40, 15, 300);
+	}
+	if (selected("replay"))
+	{
+		benchReplay(1, 1, 2000);
+		benchReplay(1, 20, 2000);
+		benchReplay(16, 20, 600);
+	}
+	if (selected("snapshot"))
+	{
+		benchSnapshot(1, 1, 600);
+		benchSnapshot(1, 20, 600);
+		benchSnapshot(4, 20, 300);
+	}
+
+	if (!jsonName.empty() && !writeResults(jsonName))
+		printf("%s: can't be written\n", jsonName.c_str());
+	if (failures > 0)
+		printf("%d checks failed\n", failures);
+	if (!baseline.empty() && compareResults(baseline, tolerance) > 0)
+		return 1;
+	return failures > 0 ? 1 : 0;
+}
@@ -1,76 +1,70 @@
 /* Program name: block.cpp
 *  Author: Cory Knoll
-*  Date Last Modified: 5/7/2019
-*  Description: Simulate a block object (currently all stationary)
-    ================================================================
-    FUNCTIONS:
-	+ Vec2D collide() - Handle collision with another object
-	+ void setInvMass(double) - Set the inverse mass (>=0) of the block
-	+ void setVelocity(double, double) - Set the velocity of the ball
-	+ Vec2D getVelocity() - return velocity vector
-	+ void move() - /Move the block along its velocity vector, detect/handle collisions, calculate new velocity due to gravity
-	+ Block(double = 0, double = 0, double = 10, double = 10, double = 0) - Constructor - Pass coordinates, width and heigth to QGraphicsRectItem constructor and set invMass
+*  Date Last Modified: 10/17/2026
+*  Description: Scene item that mirrors a block of the physics world moving along its path or pushed around with its mass
+	================================================================
+	FUNCTIONS:
+	+ Vec2D getVelocity() const - return the velocity the block moves at
+	+ void syncPosition() - Mirror where the block's body is in the world into the scene
+	+ void syncPosition(double) - Mirror where the block's path has it at a time into the scene
+	+ void syncPosition(const std::vector<BlockBody>&, double) - Mirror the block's body into the scene, blended from where it was among saved blocks with mass by a fraction of a step
+	+ Block(World*, int = 0, bool = false) - Constructor - Pass size of the world's moving block (or block with mass) to QGraphicsRectItem constructor and mirror its position
 	+ ~Block() - Destructor
-	- void gravity() - Adjust velocity due to acceleration of gravity
 	===================================================================
 	VARIABLES:
-	- Vec2D velocity - represent the x and y components of the block's velocity
-	- double inverseMass - represent the inverse mass (mass^(-1)) of an object (to be used for moveable object collision)
+	- World *world - The physics world that moves the block
+	- int index - Index of the block among the world's moving blocks (or its blocks with mass)
+	- bool dynamic - The block is one of the world's blocks with mass rather than one moving along a path
 */
 
-//This object is only stationary. I had plans to make it moveable, but didn't have time before the deadline. Maybe in the future.
-//Much of this code will be nearly identical to ball.cpp when I'm done with it.
+//Only the blocks that move are items: the ones moving along a path (a function of the world's time) and the ones with mass, which
+//the world's solver moves; either way the world moves them and this item only mirrors it. The blocks that never move are painted
+//into the game's background instead
 #include "block.h"
-#include <QPainter>
 
-//Handle collision with another object
-Vec2D Block::collide()
+//return the velocity the block moves at
+Vec2D Block::getVelocity() const
 {
-	//hold open
-	return Vec2D();
+	BlockBody body = dynamic ? world->getDynamicBlocks()[index] : world->getMover(index, world->getTime());
+	return Vec2D(body.vx, body.vy);
 }
 
-//Adjust velocity due to acceleration of gravity
-void Block::gravity()
+//Mirror where the block's body is in the world into the scene
+void Block::syncPosition()
 {
-	//hold open
+	if (dynamic)
+		setPos(world->getDynamicBlocks()[index].xMin, world->getDynamicBlocks()[index].yMin);
+	else
+		syncPosition(world->getTime());
 }
 
-//Set the inverse mass (>=0) of the block
-void Block::setInvMass(double newInvMass)
+//Mirror where the block's path has it at a time into the scene
+void Block::syncPosition(double time)
 {
-	if (newInvMass >= 0)
-		inverseMass = newInvMass;
+	BlockBody body = world->getMover(index, time);
+	setPos(body.xMin, body.yMin);
 }
 
-//Set the velocity of the ball
-void Block::setVelocity(double xVect, double yVect)
+//Mirror the block's body into the scene, blended from where it was among saved blocks with mass by a fraction of a step
+void Block::syncPosition(const std::vector<BlockBody> &previous, double fraction)
 {
-	velocity.setX(xVect);
-	velocity.setY(yVect);
+	const BlockBody &body = world->getDynamicBlocks()[index];
+	setPos(previous[index].xMin + (body.xMin - previous[index].xMin) * fraction, previous[index].yMin + (body.yMin - previous[index].yMin) * fraction);
 }
 
-//return velocity vector
-Vec2D Block::getVelocity()
+//Constructor - Pass size of the world's moving block (or block with mass) to QGraphicsRectItem constructor and mirror its position
+//(a block with mass only has its collision bounds, which World::addBlock() stretched over the outline, so the outline comes back off)
+Block::Block(World *blockWorld, int blockIndex, bool blockDynamic)
+	: QGraphicsRectItem(0, 0, blockDynamic ? blockWorld->getDynamicBlocks()[blockIndex].xMax - blockWorld->getDynamicBlocks()[blockIndex].xMin - (BLOCK_OUTLINE_WIDTH - 1) : blockWorld->getMoverPath(blockIndex).width,
+		blockDynamic ? blockWorld->getDynamicBlocks()[blockIndex].yMax - blockWorld->getDynamicBlocks()[blockIndex].yMin - (BLOCK_OUTLINE_WIDTH - 1) : blockWorld->getMoverPath(blockIndex).height)
 {
-	//hold open
-	return Vec2D();
-}
-
-//Move the block along its velocity vector, detect/handle collisions, calculate new velocity due to gravity
-void Block::move()
-{
-	//hold open
-}
-
-//Constructor - Pass coordinates, width and heigth to QGraphicsRectItem constructor and set invMass
-Block::Block(double xCorner, double yCorner, double width, double height, double invMass) : QGraphicsRectItem(xCorner, yCorner, width, height)
-{
-	setInvMass(invMass);
+	world = blockWorld;
+	index = blockIndex;
+	dynamic = blockDynamic;
+	syncPosition();
 }
 
 //Destructor
 Block::~Block()
 {
-	//hold open
 }
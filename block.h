@@ -1,21 +1,20 @@
 /* Program name: block.h
 *  Author: Cory Knoll
-*  Date Last Modified: 5/7/2019
-*  Description: Simulate a block object (currently all stationary)
+*  Date Last Modified: 10/17/2026
+*  Description: Scene item that mirrors a block of the physics world moving along its path or pushed around with its mass
 	================================================================
 	FUNCTIONS:
-	+ Vec2D collide() - Handle collision with another object
-	+ void setInvMass(double) - Set the inverse mass (>=0) of the block
-	+ void setVelocity(double, double) - Set the velocity of the ball
-	+ Vec2D getVelocity() - return velocity vector
-	+ void move() - /Move the block along its velocity vector, detect/handle collisions, calculate new velocity due to gravity
-	+ Block(double = 0, double = 0, double = 10, double = 10, double = 0) - Constructor - Pass coordinates, width and heigth to QGraphicsRectItem constructor and set invMass
+	+ Vec2D getVelocity() const - return the velocity the block moves at
+	+ void syncPosition() - Mirror where the block's body is in the world into the scene
+	+ void syncPosition(double) - Mirror where the block's path has it at a time into the scene
+	+ void syncPosition(const std::vector<BlockBody>&, double) - Mirror the block's body into the scene, blended from where it was among saved blocks with mass by a fraction of a step
+	+ Block(World*, int = 0, bool = false) - Constructor - Pass size of the world's moving block (or block with mass) to QGraphicsRectItem constructor and mirror its position
 	+ ~Block() - Destructor
-	- void gravity() - Adjust velocity due to acceleration of gravity
 	===================================================================
 	VARIABLES:
-	- Vec2D velocity - represent the x and y components of the block's velocity
-	- double inverseMass - represent the inverse mass (mass^(-1)) of an object (to be used for moveable object collision)
+	- World *world - The physics world that moves the block
+	- int index - Index of the block among the world's moving blocks (or its blocks with mass)
+	- bool dynamic - The block is one of the world's blocks with mass rather than one moving along a path
 */
 
 #ifndef BLOCK_H
@@ -23,29 +22,27 @@
 
 #include <QGraphicsRectItem>
 #include "vec2d.h"
+#include "world.h"
 
 class Block : public QGraphicsRectItem
 {
 public:
-	Vec2D collide();
-		//Handle collision with another object
-	void setInvMass(double);
-		//Set the inverse mass (>=0) of the block
-	void setVelocity(double, double);
-		//Set the velocity of the ball
-	Vec2D getVelocity();
-		//return velocity vector
-	void move();
-		//Move the block along its velocity vector, detect/handle collisions, calculate new velocity due to gravity
-	Block(double = 0, double = 0, double = 10, double = 10, double = 0);
-		//Constructor - Pass coordinates, width and heigth to QGraphicsRectItem constructor and set invMass
+	Vec2D getVelocity() const;
+		//return the velocity the block moves at
+	void syncPosition();
+		//Mirror where the block's body is in the world into the scene
+	void syncPosition(double);
+		//Mirror where the block's path has it at a time into the scene
+	void syncPosition(const std::vector<BlockBody>&, double);
+		//Mirror the block's body into the scene, blended from where it was among saved blocks with mass by a fraction of a step
+	Block(World*, int = 0, bool = false);
+		//Constructor - Pass size of the world's moving block (or block with mass) to QGraphicsRectItem constructor and mirror its position
 	~Block();
 		//Destructor
 private:
-	void gravity();
-		//Adjust velocity due to acceleration of gravity
-	Vec2D velocity;		//represent the x and y components of the block's velocity
-	double inverseMass;//represent the inverse mass (mass^(-1)) of an object (to be used for moveable object collision)
+	World *world;	//The physics world that moves the block
+	int index;		//Index of the block among the world's moving blocks (or its blocks with mass)
+	bool dynamic;	//The block is one of the world's blocks with mass rather than one moving along a path
 };
 
-#endif //BLOCK_H
\ No newline at end of file
+#endif //BLOCK_H
@@ -0,0 +1,188 @@
+/* Program name: bodystore.cpp
+*  Author: Cory Knoll
+*  Date Last Modified: 10/17/2026
+*  Description: Structure-of-arrays storage for ball bodies with a vectorized integration and gravity kernel (no Qt dependency)
+	================================================================
+	FUNCTIONS:
+	+ int add(double, double, double, double) - Add a ball body at rest, return its index
+	+ void clear() - Remove all bodies
+	+ int size() const - return the number of bodies
+	+ BallBody get(int) const - return a copy of the state of one body
+	+ void set(int, const BallBody&) - overwrite the state of one body
+	+ Vec2D getPosition(int) const - return the position of the center of one body
+	+ Vec2D getVelocity(int) const - return the velocity of one body
+	+ void setPosition(int, Vec2D) - Set the position of the center of one body
+	+ void setVelocity(int, Vec2D) - Set the velocity of one body
+	+ void integrate(int, double) - Move one body along its velocity vector by a portion of a frame, calculate new velocity due to gravity
+	+ void integrate(const double*) - Move every body along its velocity vector by its own portion of a frame, calculate new velocities due to gravity (SSE/AVX with a scalar fallback)
+	+ void integrateParabola(int, double) - Move one body along the parabola through the places frame steps of its velocity put it by a portion of a frame, calculate new velocity due to gravity
+	+ void integrateParabola(const double*) - Move every body along the parabola through the places frame steps of its velocity put it by its own portion of a frame, calculate new velocities due to gravity (SSE/AVX with a scalar fallback)
+	============================================================================
+	VARIABLES:
+	+ std::vector<double> x - x coordinates of the centers of the bodies
+	+ std::vector<double> y - y coordinates of the centers of the bodies
+	+ std::vector<double> vx - x components of the velocities of the bodies
+	+ std::vector<double> vy - y components of the velocities of the bodies
+	+ std::vector<double> radius - radii of the bodies
+	+ std::vector<double> invMass - inverse masses of the bodies
+*/
+
+#include "bodystore.h"
+
+//pick the widest vector instruction set the compiler was allowed to target
+#if defined(__AVX__)
+#include <immintrin.h>
+#define BODYSTORE_AVX
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define BODYSTORE_SSE2
+#endif
+
+//Add a ball body at rest, return its index
+int BodyStore::add(double xCenter, double yCenter, double rad, double newInvMass)
+{
+	x.push_back(xCenter);
+	y.push_back(yCenter);
+	vx.push_back(0);
+	vy.push_back(0);
+	radius.push_back(rad);
+	invMass.push_back(newInvMass >= 0 ? newInvMass : 0);
+	return size() - 1;
+}
+
+//Remove all bodies
+void BodyStore::clear()
+{
+	x.clear();
+	y.clear();
+	vx.clear();
+	vy.clear();
+	radius.clear();
+	invMass.clear();
+}
+
+//return the number of bodies
+int BodyStore::size() const
+{
+	return (int)x.size();
+}
+
+//return a copy of the state of one body
+BallBody BodyStore::get(int index) const
+{
+	BallBody body = { x[index], y[index], vx[index], vy[index], radius[index], invMass[index] };
+	return body;
+}
+
+//overwrite the state of one body
+void BodyStore::set(int index, const BallBody &body)
+{
+	x[index] = body.x;
+	y[index] = body.y;
+	vx[index] = body.vx;
+	vy[index] = body.vy;
+	radius[index] = body.radius;
+	invMass[index] = body.invMass;
+}
+
+//Move one body along its velocity vector by a portion of a frame, calculate new velocity due to gravity
+void BodyStore::integrate(int index, double portion)
+{
+	setPosition(index, getPosition(index) + getVelocity(index) * portion);
+	vy[index] += portion * GRAVITY;
+}
+
+//Move every body along its velocity vector by its own portion of a frame, calculate new velocities due to gravity (SSE/AVX with a scalar fallback)
+void BodyStore::integrate(const double *portion)
+{
+	int count = size();
+	double *px = x.data(), *py = y.data(), *pvx = vx.data(), *pvy = vy.data();
+	int i = 0;
+
+	//same operations in the same order as the scalar path below, several bodies at a time
+#if defined(BODYSTORE_AVX)
+	const __m256d gravity = _mm256_set1_pd(GRAVITY);
+	for (; i + 4 <= count; i += 4)
+	{
+		__m256d step = _mm256_loadu_pd(portion + i);
+		__m256d velY = _mm256_loadu_pd(pvy + i);
+		_mm256_storeu_pd(px + i, _mm256_add_pd(_mm256_loadu_pd(px + i), _mm256_mul_pd(step, _mm256_loadu_pd(pvx + i))));
+		_mm256_storeu_pd(py + i, _mm256_add_pd(_mm256_loadu_pd(py + i), _mm256_mul_pd(step, velY)));
+		_mm256_storeu_pd(pvy + i, _mm256_add_pd(velY, _mm256_mul_pd(step, gravity)));
+	}
+#elif defined(BODYSTORE_SSE2)
+	const __m128d gravity = _mm_set1_pd(GRAVITY);
+	for (; i + 2 <= count; i += 2)
+	{
+		__m128d step = _mm_loadu_pd(portion + i);
+		__m128d velY = _mm_loadu_pd(pvy + i);
+		_mm_storeu_pd(px + i, _mm_add_pd(_mm_loadu_pd(px + i), _mm_mul_pd(step, _mm_loadu_pd(pvx + i))));
+		_mm_storeu_pd(py + i, _mm_add_pd(_mm_loadu_pd(py + i), _mm_mul_pd(step, velY)));
+		_mm_storeu_pd(pvy + i, _mm_add_pd(velY, _mm_mul_pd(step, gravity)));
+	}
+#endif
+
+	//scalar fallback for the remaining bodies (or all of them without SSE2)
+	for (; i < count; i++)
+	{
+		px[i] += portion[i] * pvx[i];
+		py[i] += portion[i] * pvy[i];
+		pvy[i] += portion[i] * GRAVITY;
+	}
+}
+
+//Move one body along the parabola through the places frame steps of its velocity put it by a portion of a frame, calculate new velocity due to gravity
+void BodyStore::integrateParabola(int index, double portion)
+{
+	//a frame step moves a body by its velocity and then adds a frame of gravity, so the places it reaches frame after frame lie on
+	//a parabola it starts along half a frame of gravity slower; moving along that parabola lands on the same places at whole
+	//frames, and any split of a frame into portions adds up to the same move
+	x[index] += portion * vx[index];
+	y[index] += portion * vy[index] + 0.5 * GRAVITY * portion * (portion - 1);
+	vy[index] += portion * GRAVITY;
+}
+
+//Move every body along the parabola through the places frame steps of its velocity put it by its own portion of a frame, calculate new velocities due to gravity (SSE/AVX with a scalar fallback)
+void BodyStore::integrateParabola(const double *portion)
+{
+	int count = size();
+	double *px = x.data(), *py = y.data(), *pvx = vx.data(), *pvy = vy.data();
+	int i = 0;
+
+	//same operations in the same order as the scalar path below, several bodies at a time
+#if defined(BODYSTORE_AVX)
+	const __m256d gravity = _mm256_set1_pd(GRAVITY);
+	const __m256d halfGravity = _mm256_set1_pd(0.5 * GRAVITY);
+	const __m256d one = _mm256_set1_pd(1);
+	for (; i + 4 <= count; i += 4)
+	{
+		__m256d step = _mm256_loadu_pd(portion + i);
+		__m256d velY = _mm256_loadu_pd(pvy + i);
+		__m256d curve = _mm256_mul_pd(_mm256_mul_pd(halfGravity, step), _mm256_sub_pd(step, one));
+		_mm256_storeu_pd(px + i, _mm256_add_pd(_mm256_loadu_pd(px + i), _mm256_mul_pd(step, _mm256_loadu_pd(pvx + i))));
+		_mm256_storeu_pd(py + i, _mm256_add_pd(_mm256_loadu_pd(py + i), _mm256_add_pd(_mm256_mul_pd(step, velY), curve)));
+		_mm256_storeu_pd(pvy + i, _mm256_add_pd(velY, _mm256_mul_pd(step, gravity)));
+	}
+#elif defined(BODYSTORE_SSE2)
+	const __m128d gravity = _mm_set1_pd(GRAVITY);
+	const __m128d halfGravity = _mm_set1_pd(0.5 * GRAVITY);
+	const __m128d one = _mm_set1_pd(1);
+	for (; i + 2 <= count; i += 2)
+	{
+		__m128d step = _mm_loadu_pd(portion + i);
+		__m128d velY = _mm_loadu_pd(pvy + i);
+		__m128d curve = _mm_mul_pd(_mm_mul_pd(halfGravity, step), _mm_sub_pd(step, one));
+		_mm_storeu_pd(px + i, _mm_add_pd(_mm_loadu_pd(px + i), _mm_mul_pd(step, _mm_loadu_pd(pvx + i))));
+		_mm_storeu_pd(py + i, _mm_add_pd(_mm_loadu_pd(py + i), _mm_add_pd(_mm_mul_pd(step, velY), curve)));
+		_mm_storeu_pd(pvy + i, _mm_add_pd(velY, _mm_mul_pd(step, gravity)));
+	}
+#endif
+
+	//scalar fallback for the remaining bodies (or all of them without SSE2)
+	for (; i < count; i++)
+	{
+		px[i] += portion[i] * pvx[i];
+		py[i] += portion[i] * pvy[i] + 0.5 * GRAVITY * portion[i] * (portion[i] - 1);
+		pvy[i] += portion[i] * GRAVITY;
+	}
+}
@@ -0,0 +1,117 @@
+/* Program name: bodystore.h
+*  Author: Cory Knoll
+*  Date Last Modified: 10/17/2026
+*  Description: Structure-of-arrays storage for ball bodies with a vectorized integration and gravity kernel (no Qt dependency)
+	================================================================
+	FUNCTIONS:
+	+ int add(double, double, double, double) - Add a ball body at rest, return its index
+	+ void clear() - Remove all bodies
+	+ int size() const - return the number of bodies
+	+ BallBody get(int) const - return a copy of the state of one body
+	+ void set(int, const BallBody&) - overwrite the state of one body
+	+ Vec2D getPosition(int) const - return the position of the center of one body
+	+ Vec2D getVelocity(int) const - return the velocity of one body
+	+ void setPosition(int, Vec2D) - Set the position of the center of one body
+	+ void setVelocity(int, Vec2D) - Set the velocity of one body
+	+ void integrate(int, double) - Move one body along its velocity vector by a portion of a frame, calculate new velocity due to gravity
+	+ void integrate(const double*) - Move every body along its velocity vector by its own portion of a frame, calculate new velocities due to gravity (SSE/AVX with a scalar fallback)
+	+ void integrateParabola(int, double) - Move one body along the parabola through the places frame steps of its velocity put it by a portion of a frame, calculate new velocity due to gravity
+	+ void integrateParabola(const double*) - Move every body along the parabola through the places frame steps of its velocity put it by its own portion of a frame, calculate new velocities due to gravity (SSE/AVX with a scalar fallback)
+	============================================================================
+	VARIABLES:
+	+ std::vector<double> x - x coordinates of the centers of the bodies
+	+ std::vector<double> y - y coordinates of the centers of the bodies
+	+ std::vector<double> vx - x components of the velocities of the bodies
+	+ std::vector<double> vy - y components of the velocities of the bodies
+	+ std::vector<double> radius - radii of the bodies
+	+ std::vector<double> invMass - inverse masses of the bodies
+	============================================================================
+	STRUCTS:
+	+ BallBody - center, velocity, radius and inverse mass of a single ball
+*/
+
+#ifndef BODYSTORE_H
+#define BODYSTORE_H
+
+#include <vector>
+#include "vec2d.h"
+
+#define GRAVITY 2.0		//Acceleration of gravity per frame
+
+struct BallBody
+{
+	double x;		//x coordinate of the center of the ball
+	double y;		//y coordinate of the center of the ball
+	double vx;		//x component of the ball's velocity
+	double vy;		//y component of the ball's velocity
+	double radius;	//radius of the ball
+	double invMass;	//inverse mass of the ball
+};
+
+class BodyStore
+{
+public:
+	int add(double, double, double, double);
+		//Add a ball body at rest, return its index
+	void clear();
+		//Remove all bodies
+	int size() const;
+		//return the number of bodies
+	BallBody get(int) const;
+		//return a copy of the state of one body
+	void set(int, const BallBody&);
+		//overwrite the state of one body
+	Vec2D getPosition(int) const;
+		//return the position of the center of one body
+	Vec2D getVelocity(int) const;
+		//return the velocity of one body
+	void setPosition(int, Vec2D);
+		//Set the position of the center of one body
+	void setVelocity(int, Vec2D);
+		//Set the velocity of one body
+	void integrate(int, double);
+		//Move one body along its velocity vector by a portion of a frame, calculate new velocity due to gravity
+	void integrate(const double*);
+		//Move every body along its velocity vector by its own portion of a frame, calculate new velocities due to gravity (SSE/AVX with a scalar fallback)
+	void integrateParabola(int, double);
+		//Move one body along the parabola through the places frame steps of its velocity put it by a portion of a frame, calculate new velocity due to gravity
+	void integrateParabola(const double*);
+		//Move every body along the parabola through the places frame steps of its velocity put it by its own portion of a frame, calculate new velocities due to gravity (SSE/AVX with a scalar fallback)
+	//Each component lives in its own contiguous array so the kernel can load several bodies per instruction
+	std::vector<double> x;			//x coordinates of the centers of the bodies
+	std::vector<double> y;			//y coordinates of the centers of the bodies
+	std::vector<double> vx;			//x components of the velocities of the bodies
+	std::vector<double> vy;			//y components of the velocities of the bodies
+	std::vector<double> radius;		//radii of the bodies
+	std::vector<double> invMass;	//inverse masses of the bodies
+};
+
+//the accessors below run in the inner loops of the collision code, so they're defined here where every caller can inline them
+
+//return the position of the center of one body
+inline Vec2D BodyStore::getPosition(int index) const
+{
+	return Vec2D(x[index], y[index]);
+}
+
+//return the velocity of one body
+inline Vec2D BodyStore::getVelocity(int index) const
+{
+	return Vec2D(vx[index], vy[index]);
+}
+
+//Set the position of the center of one body
+inline void BodyStore::setPosition(int index, Vec2D position)
+{
+	x[index] = position.x;
+	y[index] = position.y;
+}
+
+//Set the velocity of one body
+inline void BodyStore::setVelocity(int index, Vec2D velocity)
+{
+	vx[index] = velocity.x;
+	vy[index] = velocity.y;
+}
+
+#endif //BODYSTORE_H
@@ -0,0 +1,134 @@
+/* Program name: broadphase.cpp
+*  Author: Cory Knoll
+*  Date Last Modified: 10/17/2026
+*  Description: Sweep-and-prune broadphase that finds the pairs of balls whose swept boxes overlap, keeping its sorted axis list from frame to frame (no Qt dependency)
+	================================================================
+	FUNCTIONS:
+	+ void reset(int) - Forget the previous order and make room for a number of bodies
+	+ void setBox(int, double, double, double, double, bool) - Set the box a body can reach this frame and whether the body can be pushed
+	+ void findPairs(std::vector<BallPair>&) - Re-sort the axis list and find every pair of bodies whose boxes overlap and at least one of which can be pushed (ascending order)
+	+ SweepAndPrune() - Constructor, no bodies
+	+ ~SweepAndPrune() - Destructor
+	- double value(const Endpoint&) const - return the x coordinate of an endpoint
+	============================================================================
+	VARIABLES:
+	- std::vector<Endpoint> endpoints - Minimum and maximum x of every box, kept sorted along the x axis between frames
+	- std::vector<double> xMin - Left of the box of every body
+	- std::vector<double> yMin - Top of the box of every body
+	- std::vector<double> xMax - Right of the box of every body
+	- std::vector<double> yMax - Bottom of the box of every body
+	- std::vector<bool> movable - Whether each body can be pushed
+	- std::vector<int> active[2] - Immovable [0] and movable [1] bodies whose box is open at the current point of the sweep
+	- std::vector<int> activeSlot - Position of every open box's body in its active list
+*/
+
+#include <algorithm>
+#include "broadphase.h"
+
+//Forget the previous order and make room for a number of bodies
+void SweepAndPrune::reset(int count)
+{
+	xMin.assign(count, 0);
+	yMin.assign(count, 0);
+	xMax.assign(count, 0);
+	yMax.assign(count, 0);
+	movable.assign(count, true);
+	activeSlot.assign(count, 0);
+	endpoints.resize(2 * count);
+	for (int i = 0; i < count; i++)
+	{
+		endpoints[2 * i].body = i;
+		endpoints[2 * i].isMax = false;
+		endpoints[2 * i + 1].body = i;
+		endpoints[2 * i + 1].isMax = true;
+	}
+	active[0].clear();
+	active[1].clear();
+}
+
+//Set the box a body can reach this frame and whether the body can be pushed
+void SweepAndPrune::setBox(int body, double left, double top, double right, double bottom, bool canMove)
+{
+	movable[body] = canMove;
+	xMin[body] = left;
+	yMin[body] = top;
+	xMax[body] = right;
+	yMax[body] = bottom;
+}
+
+//return the x coordinate of an endpoint
+double SweepAndPrune::value(const Endpoint &endpoint) const
+{
+	return endpoint.isMax ? xMax[endpoint.body] : xMin[endpoint.body];
+}
+
+//Re-sort the axis list and find every pair of bodies whose boxes overlap and at least one of which can be pushed (ascending order)
+void SweepAndPrune::findPairs(std::vector<BallPair> &pairs)
+{
+	pairs.clear();
+
+	//bodies only move a little between frames, so last frame's order is nearly sorted and insertion sort runs in close to linear time
+	//(left ends sort before right ends at the same x so touching boxes still count as overlapping); when the order was shuffled
+	//after all (a fresh level, or every box growing at once), give up on it and sort from scratch
+	auto before = [this](const Endpoint &a, const Endpoint &b) { return value(a) < value(b) || (value(a) == value(b) && !a.isMax && b.isMax); };
+	size_t shiftsLeft = SORT_SHIFT_LIMIT * endpoints.size();
+	for (size_t i = 1; i < endpoints.size(); i++)
+	{
+		Endpoint moving = endpoints[i];
+		size_t j = i;
+		while (j > 0 && before(moving, endpoints[j - 1]))
+		{
+			endpoints[j] = endpoints[j - 1];
+			j--;
+		}
+		endpoints[j] = moving;
+		if (i - j > shiftsLeft)
+		{
+			std::sort(endpoints.begin(), endpoints.end(), before);
+			break;
+		}
+		shiftsLeft -= i - j;
+	}
+
+	//sweep along x: every box opened while another is still open overlaps it on x, so only y remains to be checked; two immovable
+	//bodies can never push each other, so an immovable box is only checked against the open movable ones
+	active[0].clear();
+	active[1].clear();
+	for (const Endpoint &endpoint : endpoints)
+	{
+		int body = endpoint.body;
+		std::vector<int> &own = active[movable[body]];
+		if (endpoint.isMax)
+		{
+			//swap the last open box into the closing box's place so closing takes the same time however many boxes are open
+			own[activeSlot[body]] = own.back();
+			activeSlot[own.back()] = activeSlot[body];
+			own.pop_back();
+		}
+		else
+		{
+			for (int list = movable[body] ? 0 : 1; list < 2; list++)
+				for (int other : active[list])
+					if (yMin[other] <= yMax[body] && yMin[body] <= yMax[other])
+					{
+						BallPair pair = { std::min(body, other), std::max(body, other) };
+						pairs.push_back(pair);
+					}
+			activeSlot[body] = (int)own.size();
+			own.push_back(body);
+		}
+	}
+
+	//report pairs in body order so the result doesn't depend on where the bodies happen to be along the axis
+	std::sort(pairs.begin(), pairs.end(), [](const BallPair &a, const BallPair &b) { return a.first < b.first || (a.first == b.first && a.second < b.second); });
+}
+
+//Constructor, no bodies
+SweepAndPrune::SweepAndPrune()
+{
+}
+
+//Destructor
+SweepAndPrune::~SweepAndPrune()
+{
+}
@@ -0,0 +1,73 @@
+/* Program name: broadphase.h
+*  Author: Cory Knoll
+*  Date Last Modified: 10/17/2026
+*  Description: Sweep-and-prune broadphase that finds the pairs of balls whose swept boxes overlap, keeping its sorted axis list from frame to frame (no Qt dependency)
+	================================================================
+	FUNCTIONS:
+	+ void reset(int) - Forget the previous order and make room for a number of bodies
+	+ void setBox(int, double, double, double, double, bool) - Set the box a body can reach this frame and whether the body can be pushed
+	+ void findPairs(std::vector<BallPair>&) - Re-sort the axis list and find every pair of bodies whose boxes overlap and at least one of which can be pushed (ascending order)
+	+ SweepAndPrune() - Constructor, no bodies
+	+ ~SweepAndPrune() - Destructor
+	- double value(const Endpoint&) const - return the x coordinate of an endpoint
+	============================================================================
+	VARIABLES:
+	- std::vector<Endpoint> endpoints - Minimum and maximum x of every box, kept sorted along the x axis between frames
+	- std::vector<double> xMin - Left of the box of every body
+	- std::vector<double> yMin - Top of the box of every body
+	- std::vector<double> xMax - Right of the box of every body
+	- std::vector<double> yMax - Bottom of the box of every body
+	- std::vector<bool> movable - Whether each body can be pushed
+	- std::vector<int> active[2] - Immovable [0] and movable [1] bodies whose box is open at the current point of the sweep
+	- std::vector<int> activeSlot - Position of every open box's body in its active list
+	============================================================================
+	STRUCTS:
+	+ BallPair - two bodies (first < second) that can collide this frame
+	- Endpoint - one end of a box along the x axis
+*/
+
+#ifndef BROADPHASE_H
+#define BROADPHASE_H
+
+#include <vector>
+
+#define SORT_SHIFT_LIMIT 8	//average number of places an endpoint may move per frame before the axis list is sorted from scratch
+
+struct BallPair
+{
+	int first;	//index of the lower numbered body
+	int second;	//index of the higher numbered body
+};
+
+class SweepAndPrune
+{
+public:
+	void reset(int);
+		//Forget the previous order and make room for a number of bodies
+	void setBox(int, double, double, double, double, bool);
+		//Set the box a body can reach this frame and whether the body can be pushed
+	void findPairs(std::vector<BallPair>&);
+		//Re-sort the axis list and find every pair of bodies whose boxes overlap and at least one of which can be pushed (ascending order)
+	SweepAndPrune();
+		//Constructor, no bodies
+	~SweepAndPrune();
+		//Destructor
+private:
+	struct Endpoint
+	{
+		int body;	//body the box belongs to
+		bool isMax;	//right end (true) or left end (false) of the box
+	};
+	double value(const Endpoint&) const;
+		//return the x coordinate of an endpoint
+	std::vector<Endpoint> endpoints;	//Minimum and maximum x of every box, kept sorted along the x axis between frames
+	std::vector<double> xMin;			//Left of the box of every body
+	std::vector<double> yMin;			//Top of the box of every body
+	std::vector<double> xMax;			//Right of the box of every body
+	std::vector<double> yMax;			//Bottom of the box of every body
+	std::vector<bool> movable;			//Whether each body can be pushed
+	std::vector<int> active[2];			//Immovable [0] and movable [1] bodies whose box is open at the current point of the sweep
+	std::vector<int> activeSlot;		//Position of every open box's body in its active list
+};
+
+#endif //BROADPHASE_H
@@ -0,0 +1,291 @@
+/* Program name: bvh.cpp
+*  Author: Cory Knoll
+*  Date Last Modified: 10/17/2026
+*  Description: Bounding volume hierarchy over the level blocks, built once per level to find the blocks a swept ball can reach, and refit in place over the blocks that moved (no Qt dependency)
+	================================================================
+	FUNCTIONS:
+	+ void build(const std::vector<BlockBody>&) - Build the hierarchy over the bounds of the blocks
+	+ bool attach(const Node*, int, const Leaf*, int, int) - Use a hierarchy over a number of blocks stored elsewhere (a mapped level file) in place without copying it, return false (and stay empty) if it isn't a valid hierarchy
+	+ void clear() - Remove every node from the hierarchy
+	+ void query(double, double, double, double, std::vector<int>&) const - Find the indices (ascending) of every block overlapping a box
+	+ void moveBlock(int, double, double, double, double) - Give a block of a hierarchy built here new bounds, leaving the nodes above it to the next refit
+	+ void refit() - Grow or shrink the nodes above every block moved since the last refit to fit their blocks again, children before parents
+	+ const Node* getNodes() const - return the nodes of the hierarchy, root first
+	+ int getNodeCount() const - return the number of nodes in the hierarchy
+	+ const Leaf* getLeaves() const - return the leaves of the hierarchy in leaf order
+	+ int getLeafCount() const - return the number of leaves in the hierarchy
+	+ BVH() - Constructor, empty hierarchy
+	+ ~BVH() - Destructor
+	- void buildNode(int, int, int) - Build a node over a range of leaves, splitting it in two until the leaves fit in a leaf node
+	- void boundLeaves(Node&, int, int) const - Set the bounds of a node to the bounds of a range of leaves
+	- void linkNodes() - Find the parent of every node and the leaf and leaf node of every block, which refitting walks up from
+	============================================================================
+	VARIABLES:
+	- std::vector<Node> nodes - The nodes of a hierarchy built here, root first and the two children of a branch next to each other
+	- std::vector<Leaf> leaves - Bounds and level index of the blocks in leaf order of a hierarchy built here
+	- const Node *sharedNodes - The nodes of an attached hierarchy, nullptr when the hierarchy was built here
+	- const Leaf *sharedLeaves - The leaves of an attached hierarchy
+	- int sharedNodeCount - Number of nodes of an attached hierarchy
+	- int sharedLeafCount - Number of leaves of an attached hierarchy
+	- std::vector<int> parents - Parent of every node (-1 for the root), found the first time a block is moved
+	- std::vector<int> leafOf - Leaf of every block
+	- std::vector<int> leafNode - Leaf node holding every leaf
+	- std::vector<unsigned char> stale - Whether every node is waiting for the next refit
+	- std::vector<int> staleNodes - The nodes waiting for the next refit
+*/
+
+#include <algorithm>
+#include "bvh.h"
+#include "world.h"
+
+//Build the hierarchy over the bounds of the blocks
+void BVH::build(const std::vector<BlockBody> &blocks)
+{
+	clear();
+	if (blocks.empty())
+		return;
+
+	leaves.resize(blocks.size());
+	for (size_t i = 0; i < blocks.size(); i++)
+	{
+		Leaf &leaf = leaves[i];
+		leaf.xMin = blocks[i].xMin;
+		leaf.yMin = blocks[i].yMin;
+		leaf.xMax = blocks[i].xMax;
+		leaf.yMax = blocks[i].yMax;
+		leaf.block = (int)i;
+	}
+
+	//a binary tree with at least one block per leaf never needs more than twice as many nodes as blocks
+	nodes.reserve(2 * blocks.size());
+	nodes.push_back(Node());
+	buildNode(0, 0, (int)leaves.size());
+}
+
+//Build a node over a range of leaves, splitting it in two until the leaves fit in a leaf node
+void BVH::buildNode(int nodeIndex, int first, int count)
+{
+	//bound every leaf in the range
+	Node node;
+	boundLeaves(node, first, count);
+
+	if (count <= BVH_LEAF_SIZE)
+	{
+		node.first = first;
+		node.count = count;
+		nodes[nodeIndex] = node;
+		return;
+	}
+
+	//split at the median center along the longer side of the node
+	bool splitX = node.xMax - node.xMin >= node.yMax - node.yMin;
+	int half = count / 2;
+	std::nth_element(leaves.begin() + first, leaves.begin() + first + half, leaves.begin() + first + count,
+		[splitX](const Leaf &a, const Leaf &b) { return splitX ? a.xMin + a.xMax < b.xMin + b.xMax : a.yMin + a.yMax < b.yMin + b.yMax; });
+
+	//children are stored next to each other so a branch only needs the index of the left one
+	node.first = (int)nodes.size();
+	node.count = 0;
+	nodes[nodeIndex] = node;
+	nodes.push_back(Node());
+	nodes.push_back(Node());
+	buildNode(node.first, first, half);
+	buildNode(node.first + 1, first + half, count - half);
+}
+
+//Set the bounds of a node to the bounds of a range of leaves
+void BVH::boundLeaves(Node &node, int first, int count) const
+{
+	node.xMin = leaves[first].xMin;
+	node.yMin = leaves[first].yMin;
+	node.xMax = leaves[first].xMax;
+	node.yMax = leaves[first].yMax;
+	for (int i = first + 1; i < first + count; i++)
+	{
+		node.xMin = std::min(node.xMin, leaves[i].xMin);
+		node.yMin = std::min(node.yMin, leaves[i].yMin);
+		node.xMax = std::max(node.xMax, leaves[i].xMax);
+		node.yMax = std::max(node.yMax, leaves[i].yMax);
+	}
+}
+
+//Give a block of a hierarchy built here new bounds, leaving the nodes above it to the next refit
+void BVH::moveBlock(int block, double xMin, double yMin, double xMax, double yMax)
+{
+	//an attached hierarchy is read-only (it's a mapped file), and only levels that move blocks ever need the links
+	if (sharedNodes)
+		return;
+	if (parents.size() != nodes.size())
+		linkNodes();
+	Leaf &leaf = leaves[leafOf[block]];
+	leaf.xMin = xMin;
+	leaf.yMin = yMin;
+	leaf.xMax = xMax;
+	leaf.yMax = yMax;
+
+	//mark the way up to the root, stopping at the first node another moved block already marked (the rest of the way is marked too)
+	for (int node = leafNode[leafOf[block]]; node >= 0 && !stale[node]; node = parents[node])
+	{
+		stale[node] = 1;
+		staleNodes.push_back(node);
+	}
+}
+
+//Grow or shrink the nodes above every block moved since the last refit to fit their blocks again, children before parents
+void BVH::refit()
+{
+	//children are always stored after their parent, so going through the marked nodes from the highest index down refits every
+	//node after both of its children; the nodes no moved block is under are never looked at, however large the hierarchy is
+	std::sort(staleNodes.begin(), staleNodes.end(), [](int a, int b) { return a > b; });
+	for (int index : staleNodes)
+	{
+		Node &node = nodes[index];
+		if (node.count > 0)
+			boundLeaves(node, node.first, node.count);
+		else
+		{
+			const Node &left = nodes[node.first];
+			const Node &right = nodes[node.first + 1];
+			node.xMin = std::min(left.xMin, right.xMin);
+			node.yMin = std::min(left.yMin, right.yMin);
+			node.xMax = std::max(left.xMax, right.xMax);
+			node.yMax = std::max(left.yMax, right.yMax);
+		}
+		stale[index] = 0;
+	}
+	staleNodes.clear();
+}
+
+//Find the parent of every node and the leaf and leaf node of every block, which refitting walks up from
+void BVH::linkNodes()
+{
+	parents.assign(nodes.size(), -1);
+	leafOf.assign(leaves.size(), 0);
+	leafNode.assign(leaves.size(), 0);
+	stale.assign(nodes.size(), 0);
+	staleNodes.clear();
+	for (int i = 0; i < (int)nodes.size(); i++)
+		if (nodes[i].count == 0)
+			parents[nodes[i].first] = parents[nodes[i].first + 1] = i;
+		else
+			for (int j = nodes[i].first; j < nodes[i].first + nodes[i].count; j++)
+				leafNode[j] = i;
+	for (int i = 0; i < (int)leaves.size(); i++)
+		leafOf[leaves[i].block] = i;
+}
+
+//Use a hierarchy over a number of blocks stored elsewhere (a mapped level file) in place without copying it, return false (and stay empty) if it isn't a valid hierarchy
+bool BVH::attach(const Node *storedNodes, int nodeCount, const Leaf *storedLeaves, int leafCount, int blockCount)
+{
+	clear();
+	if (nodeCount <= 0 || leafCount != blockCount || nodeCount > 2 * leafCount)
+		return nodeCount == 0 && blockCount == 0;
+
+	//a query trusts every index it follows, so check them once here: children come after their parent (so the walk ends), the
+	//tree is no deeper than the traversal stack, and every leaf range and block index is in bounds
+	std::vector<unsigned char> depth(nodeCount, 0);
+	for (int i = 0; i < nodeCount; i++)
+	{
+		const Node &node = storedNodes[i];
+		if (node.count == 0)
+		{
+			if (node.first <= i || node.first + 1 >= nodeCount || depth[i] + 2 > BVH_MAX_DEPTH)
+				return false;
+			depth[node.first] = depth[node.first + 1] = depth[i] + 1;
+		}
+		else if (node.count < 0 || node.first < 0 || node.first > leafCount - node.count)
+			return false;
+	}
+	for (int i = 0; i < leafCount; i++)
+		if (storedLeaves[i].block < 0 || storedLeaves[i].block >= blockCount)
+			return false;
+
+	sharedNodes = storedNodes;
+	sharedLeaves = storedLeaves;
+	sharedNodeCount = nodeCount;
+	sharedLeafCount = leafCount;
+	return true;
+}
+
+//Remove every node from the hierarchy
+void BVH::clear()
+{
+	nodes.clear();
+	leaves.clear();
+	parents.clear();
+	leafOf.clear();
+	leafNode.clear();
+	stale.clear();
+	staleNodes.clear();
+	sharedNodes = nullptr;
+	sharedLeaves = nullptr;
+	sharedNodeCount = 0;
+	sharedLeafCount = 0;
+}
+
+//Find the indices (ascending) of every block overlapping a box
+void BVH::query(double xMin, double yMin, double xMax, double yMax, std::vector<int> &found) const
+{
+	found.clear();
+	const Node *node = getNodes();
+	const Leaf *leaf = getLeaves();
+	if (getNodeCount() == 0)
+		return;
+
+	int stack[BVH_MAX_DEPTH];
+	int depth = 0;
+	stack[depth++] = 0;
+	while (depth > 0)
+	{
+		const Node &visit = node[stack[--depth]];
+		if (visit.xMin > xMax || visit.xMax < xMin || visit.yMin > yMax || visit.yMax < yMin)
+			continue;
+		if (visit.count == 0)
+		{
+			stack[depth++] = visit.first;
+			stack[depth++] = visit.first + 1;
+		}
+		else
+			for (int i = visit.first; i < visit.first + visit.count; i++)
+				if (!(leaf[i].xMin > xMax || leaf[i].xMax < xMin || leaf[i].yMin > yMax || leaf[i].yMax < yMin))
+					found.push_back(leaf[i].block);
+	}
+
+	//report blocks in level order so ties between equally early collisions resolve the same way as a linear scan
+	std::sort(found.begin(), found.end());
+}
+
+//return the nodes of the hierarchy, root first
+const BVH::Node* BVH::getNodes() const
+{
+	return sharedNodes ? sharedNodes : nodes.data();
+}
+
+//return the number of nodes in the hierarchy
+int BVH::getNodeCount() const
+{
+	return sharedNodes ? sharedNodeCount : (int)nodes.size();
+}
+
+//return the leaves of the hierarchy in leaf order
+const BVH::Leaf* BVH::getLeaves() const
+{
+	return sharedNodes ? sharedLeaves : leaves.data();
+}
+
+//return the number of leaves in the hierarchy
+int BVH::getLeafCount() const
+{
+	return sharedNodes ? sharedLeafCount : (int)leaves.size();
+}
+
+//Constructor, empty hierarchy
+BVH::BVH()
+{
+	clear();
+}
+
+//Destructor
+BVH::~BVH()
+{
+}
@@ -0,0 +1,110 @@
+/* Program name: bvh.h
+*  Author: Cory Knoll
+*  Date Last Modified: 10/17/2026
+*  Description: Bounding volume hierarchy over the level blocks, built once per level to find the blocks a swept ball can reach, and refit in place over the blocks that moved (no Qt dependency)
+	================================================================
+	FUNCTIONS:
+	+ void build(const std::vector<BlockBody>&) - Build the hierarchy over the bounds of the blocks
+	+ bool attach(const Node*, int, const Leaf*, int, int) - Use a hierarchy over a number of blocks stored elsewhere (a mapped level file) in place without copying it, return false (and stay empty) if it isn't a valid hierarchy
+	+ void clear() - Remove every node from the hierarchy
+	+ void query(double, double, double, double, std::vector<int>&) const - Find the indices (ascending) of every block overlapping a box
+	+ void moveBlock(int, double, double, double, double) - Give a block of a hierarchy built here new bounds, leaving the nodes above it to the next refit
+	+ void refit() - Grow or shrink the nodes above every block moved since the last refit to fit their blocks again, children before parents
+	+ const Node* getNodes() const - return the nodes of the hierarchy, root first
+	+ int getNodeCount() const - return the number of nodes in the hierarchy
+	+ const Leaf* getLeaves() const - return the leaves of the hierarchy in leaf order
+	+ int getLeafCount() const - return the number of leaves in the hierarchy
+	+ BVH() - Constructor, empty hierarchy
+	+ ~BVH() - Destructor
+	- void buildNode(int, int, int) - Build a node over a range of leaves, splitting it in two until the leaves fit in a leaf node
+	- void boundLeaves(Node&, int, int) const - Set the bounds of a node to the bounds of a range of leaves
+	- void linkNodes() - Find the parent of every node and the leaf and leaf node of every block, which refitting walks up from
+	============================================================================
+	VARIABLES:
+	- std::vector<Node> nodes - The nodes of a hierarchy built here, root first and the two children of a branch next to each other
+	- std::vector<Leaf> leaves - Bounds and level index of the blocks in leaf order of a hierarchy built here
+	- const Node *sharedNodes - The nodes of an attached hierarchy, nullptr when the hierarchy was built here
+	- const Leaf *sharedLeaves - The leaves of an attached hierarchy
+	- int sharedNodeCount - Number of nodes of an attached hierarchy
+	- int sharedLeafCount - Number of leaves of an attached hierarchy
+	- std::vector<int> parents - Parent of every node (-1 for the root), found the first time a block is moved
+	- std::vector<int> leafOf - Leaf of every block
+	- std::vector<int> leafNode - Leaf node holding every leaf
+	- std::vector<unsigned char> stale - Whether every node is waiting for the next refit
+	- std::vector<int> staleNodes - The nodes waiting for the next refit
+	============================================================================
+	STRUCTS:
+	+ Node - bounds of a node and either its first child or its range of leaves
+	+ Leaf - bounds of a block and its index in the level
+*/
+
+#ifndef BVH_H
+#define BVH_H
+
+#include <vector>
+
+#define BVH_LEAF_SIZE 4		//Maximum number of blocks stored in a leaf node
+#define BVH_MAX_DEPTH 64	//Size of the traversal stack (the median split keeps the depth near log2 of the block count)
+
+struct BlockBody;
+
+class BVH
+{
+public:
+	//the node and leaf layouts are also the layout of the prebuilt index in a compiled level file
+	struct Node
+	{
+		double xMin, yMin, xMax, yMax;	//bounds of every block below the node
+		int first;						//index of the left child (branch) or of the first leaf (leaf)
+		int count;						//number of leaves, 0 for a branch
+	};
+	struct Leaf
+	{
+		double xMin, yMin, xMax, yMax;	//bounds of the block
+		int block;						//index of the block in the level
+	};
+	void build(const std::vector<BlockBody>&);
+		//Build the hierarchy over the bounds of the blocks
+	bool attach(const Node*, int, const Leaf*, int, int);
+		//Use a hierarchy over a number of blocks stored elsewhere (a mapped level file) in place without copying it, return false (and stay empty) if it isn't a valid hierarchy
+	void clear();
+		//Remove every node from the hierarchy
+	void query(double, double, double, double, std::vector<int>&) const;
+		//Find the indices (ascending) of every block overlapping a box
+	void moveBlock(int, double, double, double, double);
+		//Give a block of a hierarchy built here new bounds, leaving the nodes above it to the next refit
+	void refit();
+		//Grow or shrink the nodes above every block moved since the last refit to fit their blocks again, children before parents
+	const Node* getNodes() const;
+		//return the nodes of the hierarchy, root first
+	int getNodeCount() const;
+		//return the number of nodes in the hierarchy
+	const Leaf* getLeaves() const;
+		//return the leaves of the hierarchy in leaf order
+	int getLeafCount() const;
+		//return the number of leaves in the hierarchy
+	BVH();
+		//Constructor, empty hierarchy
+	~BVH();
+		//Destructor
+private:
+	void buildNode(int, int, int);
+		//Build a node over a range of leaves, splitting it in two until the leaves fit in a leaf node
+	void boundLeaves(Node&, int, int) const;
+		//Set the bounds of a node to the bounds of a range of leaves
+	void linkNodes();
+		//Find the parent of every node and the leaf and leaf node of every block, which refitting walks up from
+	std::vector<Node> nodes;	//The nodes of a hierarchy built here, root first and the two children of a branch next to each other
+	std::vector<Leaf> leaves;	//Bounds and level index of the blocks in leaf order of a hierarchy built here
+	const Node *sharedNodes;	//The nodes of an attached hierarchy, nullptr when the hierarchy was built here
+	const Leaf *sharedLeaves;	//The leaves of an attached hierarchy
+	int sharedNodeCount;		//Number of nodes of an attached hierarchy
+	int sharedLeafCount;		//Number of leaves of an attached hierarchy
+	std::vector<int> parents;	//Parent of every node (-1 for the root), found the first time a block is moved
+	std::vector<int> leafOf;	//Leaf of every block
+	std::vector<int> leafNode;	//Leaf node holding every leaf
+	std::vector<unsigned char> stale;//Whether every node is waiting for the next refit
+	std::vector<int> staleNodes;//The nodes waiting for the next refit
+};
+
+#endif //BVH_H
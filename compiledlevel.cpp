@@ -0,0 +1,327 @@
+/* Program name: compiledlevel.cpp
+*  Author: Cory Knoll
+*  Date Last Modified: 10/17/2026
+*  Description: Compile level data into a versioned, checksummed binary level file with a prebuilt block hierarchy, and memory-map such a file so the world can use its records in place (no Qt dependency)
+	================================================================
+	FUNCTIONS:
+	+ std::string compiledLevelFileName(int) - return the name of the compiled data file for a level number
+	+ bool compileLevel(const LevelData&, const std::string&) - Write level data and a hierarchy over its blocks as a compiled level file, return false if the file can't be written
+	+ unsigned long long levelChecksum(const unsigned char*, size_t) - return the checksum of the payload of a compiled level file
+	+ bool open(const std::string&) - Map a compiled level file and check it, return false (and stay closed) if it can't be mapped or isn't a valid compiled level
+	+ void close() - Unmap the level file
+	+ void swap(MappedLevel&) - Exchange mapped level files with another mapped level (the records don't move, so views of them stay valid)
+	+ bool isOpen() const - return true if a level file is mapped
+	+ const LevelView& getView() const - return a view of the records of the mapped level
+	+ const CompiledLevelHeader& getHeader() const - return the header of the mapped level file
+	+ MappedLevel() - Constructor, nothing mapped
+	+ ~MappedLevel() - Destructor, unmap the level file
+	- bool check() - Check the header, sections, checksum and records of the mapped file and point the view at its records, return false if it isn't a valid compiled level
+	============================================================================
+	VARIABLES:
+	- const unsigned char *data - Start of the mapped level file, nullptr when nothing is mapped
+	- size_t size - Size of the mapped level file in bytes
+	- void *fileHandle - Handle of the open level file (Windows only)
+	- void *mappingHandle - Handle of the file mapping (Windows only)
+	- LevelView view - Where the records of the mapped level are
+	============================================================================
+	STRUCTS:
+	+ CompiledLevelHeader - what a compiled level file holds and where, and how to tell it's intact and was compiled for this build
+	============================================================================
+	CLASSES:
+	+ MappedLevel - a compiled level file mapped into memory for as long as the world uses its records
+*/
+
+#include <cstring>
+#include <fstream>
+#include <utility>
+#include <vector>
+#include "compiledlevel.h"
+#include "world.h"
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+//the records are used in place, so every section has to stay aligned for the doubles in them
+static_assert(sizeof(CompiledLevelHeader) % COMPILED_LEVEL_ALIGNMENT == 0, "compiled level header breaks section alignment");
+static_assert(sizeof(BallData) % COMPILED_LEVEL_ALIGNMENT == 0, "ball record breaks section alignment");
+static_assert(sizeof(BlockData) % COMPILED_LEVEL_ALIGNMENT == 0, "block record breaks section alignment");
+static_assert(sizeof(MaterialData) % COMPILED_LEVEL_ALIGNMENT == 0, "material record breaks section alignment");
+static_assert(sizeof(MoverData) % COMPILED_LEVEL_ALIGNMENT == 0, "moving block record breaks section alignment");
+static_assert(sizeof(PolygonData) % COMPILED_LEVEL_ALIGNMENT == 0, "polygon block record breaks section alignment");
+static_assert(sizeof(BVH::Node) % COMPILED_LEVEL_ALIGNMENT == 0, "hierarchy node breaks section alignment");
+static_assert(sizeof(BVH::Leaf) % COMPILED_LEVEL_ALIGNMENT == 0, "hierarchy leaf breaks section alignment");
+
+//return the name of the compiled data file for a level number
+std::string compiledLevelFileName(int levelNumber)
+{
+	return "lvl" + std::to_string(levelNumber) + ".bin";
+}
+
+//Write level data and a hierarchy over its blocks as a compiled level file, return false if the file can't be written
+bool compileLevel(const LevelData &level, const std::string &fileName)
+{
+	//build the hierarchy the same way loading the level does, so a mapped level gets the tree it would have built itself
+	World world;
+	world.loadLevel(level);
+	const BVH &tree = world.getBlockTree();
+
+	CompiledLevelHeader header = CompiledLevelHeader();
+	memcpy(header.magic, COMPILED_LEVEL_MAGIC, sizeof(header.magic));
+	header.version = COMPILED_LEVEL_VERSION;
+	header.byteOrder = COMPILED_LEVEL_BYTE_ORDER;
+	header.outlineWidth = BLOCK_OUTLINE_WIDTH;
+	header.ballSize = sizeof(BallData);
+	header.blockSize = sizeof(BlockData);
+	header.materialSize = sizeof(MaterialData);
+	header.nodeSize = sizeof(BVH::Node);
+	header.leafSize = sizeof(BVH::Leaf);
+	header.moverSize = sizeof(MoverData);
+	header.polygonSize = sizeof(PolygonData);
+	header.ballCount = (int)level.balls.size() + 1;
+	header.blockCount = (int)level.blocks.size() + 1;
+	header.materialCount = (int)level.materials.size();
+	header.nodeCount = tree.getNodeCount();
+	header.leafCount = tree.getLeafCount();
+	header.moverCount = (int)level.movers.size();
+	header.polygonCount = (int)level.polygons.size();
+
+	//the sections follow the header back to back (every record size is a multiple of the alignment), the playerBall and goalBlock
+	//leading their sections so the balls and blocks can be viewed as one array each
+	std::vector<unsigned char> payload;
+	auto append = [&payload](const void *records, size_t bytes)
+	{
+		const unsigned char *first = (const unsigned char*)records;
+		payload.insert(payload.end(), first, first + bytes);
+	};
+	header.ballOffset = sizeof(header) + payload.size();
+	append(&level.playerBall, sizeof(BallData));
+	append(level.balls.data(), level.balls.size() * sizeof(BallData));
+	header.blockOffset = sizeof(header) + payload.size();
+	append(&level.goalBlock, sizeof(BlockData));
+	append(level.blocks.data(), level.blocks.size() * sizeof(BlockData));
+	header.materialOffset = sizeof(header) + payload.size();
+	append(level.materials.data(), level.materials.size() * sizeof(MaterialData));
+	header.nodeOffset = sizeof(header) + payload.size();
+	append(tree.getNodes(), header.nodeCount * sizeof(BVH::Node));
+	header.leafOffset = sizeof(header) + payload.size();
+	append(tree.getLeaves(), header.leafCount * sizeof(BVH::Leaf));
+	header.moverOffset = sizeof(header) + payload.size();
+	append(level.movers.data(), level.movers.size() * sizeof(MoverData));
+	header.polygonOffset = sizeof(header) + payload.size();
+	append(level.polygons.data(), level.polygons.size() * sizeof(PolygonData));
+	header.payloadSize = payload.size();
+	header.checksum = levelChecksum(payload.data(), payload.size());
+
+	std::ofstream levelFile(fileName, std::ios::binary);
+	if (!levelFile.is_open())
+		return false;
+	levelFile.write((const char*)&header, sizeof(header));
+	levelFile.write((const char*)payload.data(), payload.size());
+	return levelFile.good();
+}
+
+//return the checksum of the payload of a compiled level file
+unsigned long long levelChecksum(const unsigned char *bytes, size_t count)
+{
+	//FNV-1a, but folding in eight bytes at a time: every load of a level runs it over the whole file, and a byte at a time
+	//would cost more than the rest of the load
+	unsigned long long hash = 14695981039346656037ull;
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8)
+	{
+		unsigned long long word;
+		memcpy(&word, bytes + i, 8);
+		hash = (hash ^ word) * 1099511628211ull;
+	}
+	for (; i < count; i++)
+		hash = (hash ^ bytes[i]) * 1099511628211ull;
+	return hash;
+}
+
+//Map a compiled level file and check it, return false (and stay closed) if it can't be mapped or isn't a valid compiled level
+bool MappedLevel::open(const std::string &fileName)
+{
+	close();
+#if defined(_WIN32)
+	HANDLE file = CreateFileA(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+		return false;
+	LARGE_INTEGER fileSize;
+	HANDLE mapping = nullptr;
+	if (GetFileSizeEx(file, &fileSize) && fileSize.QuadPart >= (LONGLONG)sizeof(CompiledLevelHeader))
+		mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	void *mapped = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+	if (!mapped)
+	{
+		if (mapping)
+			CloseHandle(mapping);
+		CloseHandle(file);
+		return false;
+	}
+	fileHandle = file;
+	mappingHandle = mapping;
+	data = (const unsigned char*)mapped;
+	size = (size_t)fileSize.QuadPart;
+#else
+	int file = ::open(fileName.c_str(), O_RDONLY);
+	if (file < 0)
+		return false;
+	struct stat status;
+	void *mapped = MAP_FAILED;
+	if (fstat(file, &status) == 0 && status.st_size >= (off_t)sizeof(CompiledLevelHeader))
+		mapped = mmap(nullptr, (size_t)status.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+	::close(file);	//the mapping keeps the file's pages reachable on its own
+	if (mapped == MAP_FAILED)
+		return false;
+	data = (const unsigned char*)mapped;
+	size = (size_t)status.st_size;
+#endif
+	if (!check())
+	{
+		close();
+		return false;
+	}
+	return true;
+}
+
+//Unmap the level file
+void MappedLevel::close()
+{
+	if (!data)
+		return;
+#if defined(_WIN32)
+	UnmapViewOfFile(data);
+	CloseHandle(mappingHandle);
+	CloseHandle(fileHandle);
+#else
+	munmap((void*)data, size);
+#endif
+	data = nullptr;
+	size = 0;
+	fileHandle = nullptr;
+	mappingHandle = nullptr;
+	view = LevelView();
+}
+
+//Exchange mapped level files with another mapped level (the records don't move, so views of them stay valid)
+void MappedLevel::swap(MappedLevel &other)
+{
+	std::swap(data, other.data);
+	std::swap(size, other.size);
+	std::swap(fileHandle, other.fileHandle);
+	std::swap(mappingHandle, other.mappingHandle);
+	std::swap(view, other.view);
+}
+
+//return true if a level file is mapped
+bool MappedLevel::isOpen() const
+{
+	return data != nullptr;
+}
+
+//return a view of the records of the mapped level
+const LevelView& MappedLevel::getView() const
+{
+	return view;
+}
+
+//return the header of the mapped level file
+const CompiledLevelHeader& MappedLevel::getHeader() const
+{
+	return *(const CompiledLevelHeader*)data;
+}
+
+//Check the header, sections, checksum and records of the mapped file and point the view at its records, return false if it isn't a valid compiled level
+bool MappedLevel::check()
+{
+	const CompiledLevelHeader &header = getHeader();
+	if (memcmp(header.magic, COMPILED_LEVEL_MAGIC, sizeof(header.magic)) != 0 || header.version != COMPILED_LEVEL_VERSION
+		|| header.byteOrder != COMPILED_LEVEL_BYTE_ORDER)
+		return false;
+
+	//records are used as they are, so they must have been written with this build's layouts (a compiler with different padding
+	//rules produces different sizes)
+	if (header.ballSize != sizeof(BallData) || header.blockSize != sizeof(BlockData) || header.materialSize != sizeof(MaterialData)
+		|| header.nodeSize != sizeof(BVH::Node) || header.leafSize != sizeof(BVH::Leaf) || header.moverSize != sizeof(MoverData)
+		|| header.polygonSize != sizeof(PolygonData))
+		return false;
+	if (header.ballCount < 1 || header.blockCount < 1 || header.materialCount < 0 || header.nodeCount < 0 || header.leafCount < 0
+		|| header.moverCount < 0 || header.polygonCount < 0)
+		return false;
+
+	//every section has to be aligned and lie inside the file, and nothing but the payload may follow the header
+	const unsigned long long offsets[] = { header.ballOffset, header.blockOffset, header.materialOffset, header.nodeOffset, header.leafOffset,
+		header.moverOffset, header.polygonOffset };
+	const unsigned long long bytes[] = { (unsigned long long)header.ballCount * header.ballSize, (unsigned long long)header.blockCount * header.blockSize,
+		(unsigned long long)header.materialCount * header.materialSize, (unsigned long long)header.nodeCount * header.nodeSize,
+		(unsigned long long)header.leafCount * header.leafSize, (unsigned long long)header.moverCount * header.moverSize,
+		(unsigned long long)header.polygonCount * header.polygonSize };
+	for (int i = 0; i < 7; i++)
+		if (offsets[i] % COMPILED_LEVEL_ALIGNMENT != 0 || offsets[i] < sizeof(header) || offsets[i] > size || bytes[i] > size - offsets[i])
+			return false;
+	if (header.payloadSize != size - sizeof(header) || header.checksum != levelChecksum(data + sizeof(header), size - sizeof(header)))
+		return false;
+
+	//the checksum catches a damaged file, not one written to get past it, so the records the world indexes with are held to what
+	//loadLevelFile() accepts
+	const MaterialData *materials = (const MaterialData*)(data + header.materialOffset);
+	for (int i = 0; i < header.materialCount; i++)
+		if (materials[i].number < 0 || materials[i].number >= MAX_MATERIALS)
+			return false;
+	const MoverData *movers = (const MoverData*)(data + header.moverOffset);
+	for (int i = 0; i < header.moverCount; i++)
+		if (movers[i].kind < 0 || movers[i].kind >= MOVER_KINDS)
+			return false;
+	const PolygonData *polygons = (const PolygonData*)(data + header.polygonOffset);
+	for (int i = 0; i < header.polygonCount; i++)
+		if (polygons[i].pointCount < 3 || polygons[i].pointCount > POLYGON_MAX_POINTS || !isConvex(polygons[i]))
+			return false;
+
+	view.playerBall = (const BallData*)(data + header.ballOffset);
+	view.balls = view.playerBall + 1;
+	view.ballCount = header.ballCount - 1;
+	view.goalBlock = (const BlockData*)(data + header.blockOffset);
+	view.blocks = view.goalBlock + 1;
+	view.blockCount = header.blockCount - 1;
+	view.movers = (const MoverData*)(data + header.moverOffset);
+	view.moverCount = header.moverCount;
+	view.polygons = (const PolygonData*)(data + header.polygonOffset);
+	view.polygonCount = header.polygonCount;
+	view.materials = (const MaterialData*)(data + header.materialOffset);
+	view.materialCount = header.materialCount;
+
+	//a hierarchy over bounds grown by another outline width would miss collisions, so the world builds its own instead (the
+	//world checks the hierarchy's indices when it attaches to it)
+	if (header.nodeCount > 0 && header.outlineWidth == BLOCK_OUTLINE_WIDTH)
+	{
+		view.nodes = (const BVH::Node*)(data + header.nodeOffset);
+		view.nodeCount = header.nodeCount;
+		view.leaves = (const BVH::Leaf*)(data + header.leafOffset);
+		view.leafCount = header.leafCount;
+	}
+	return true;
+}
+
+//Constructor, nothing mapped
+MappedLevel::MappedLevel()
+{
+	data = nullptr;
+	size = 0;
+	fileHandle = nullptr;
+	mappingHandle = nullptr;
+	view = LevelView();
+}
+
+//Destructor, unmap the level file
+MappedLevel::~MappedLevel()
+{
+	close();
+}
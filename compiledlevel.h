@@ -0,0 +1,127 @@
+/* Program name: compiledlevel.h
+*  Author: Cory Knoll
+*  Date Last Modified: 10/17/2026
+*  Description: Compile level data into a versioned, checksummed binary level file with a prebuilt block hierarchy, and memory-map such a file so the world can use its records in place (no Qt dependency)
+	================================================================
+	FUNCTIONS:
+	+ std::string compiledLevelFileName(int) - return the name of the compiled data file for a level number
+	+ bool compileLevel(const LevelData&, const std::string&) - Write level data and a hierarchy over its blocks as a compiled level file, return false if the file can't be written
+	+ unsigned long long levelChecksum(const unsigned char*, size_t) - return the checksum of the payload of a compiled level file
+	+ bool open(const std::string&) - Map a compiled level file and check it, return false (and stay closed) if it can't be mapped or isn't a valid compiled level
+	+ void close() - Unmap the level file
+	+ void swap(MappedLevel&) - Exchange mapped level files with another mapped level (the records don't move, so views of them stay valid)
+	+ bool isOpen() const - return true if a level file is mapped
+	+ const LevelView& getView() const - return a view of the records of the mapped level
+	+ const CompiledLevelHeader& getHeader() const - return the header of the mapped level file
+	+ MappedLevel() - Constructor, nothing mapped
+	+ ~MappedLevel() - Destructor, unmap the level file
+	- bool check() - Check the header, sections, checksum and records of the mapped file and point the view at its records, return false if it isn't a valid compiled level
+	============================================================================
+	VARIABLES:
+	- const unsigned char *data - Start of the mapped level file, nullptr when nothing is mapped
+	- size_t size - Size of the mapped level file in bytes
+	- void *fileHandle - Handle of the open level file (Windows only)
+	- void *mappingHandle - Handle of the file mapping (Windows only)
+	- LevelView view - Where the records of the mapped level are
+	============================================================================
+	COMPILED LEVEL FILE FORMAT (native byte order, every section 8-byte aligned and reached through the header's offsets):
+	  CompiledLevelHeader			- magic, version, byte order mark, record sizes, counts, section offsets, payload size and checksum
+	  BallData[ballCount]			- the playerBall, then the level's other balls
+	  BlockData[blockCount]			- the goalBlock, then the levelBlocks
+	  MaterialData[materialCount]	- the block materials, in the order the level lists them
+	  MoverData[moverCount]			- the blocks moving along paths
+	  PolygonData[polygonCount]		- the convex polygon blocks
+	  BVH::Node[nodeCount]			- the nodes of the prebuilt hierarchy over the levelBlocks, root first
+	  BVH::Leaf[leafCount]			- the leaves of the prebuilt hierarchy
+	============================================================================
+	STRUCTS:
+	+ CompiledLevelHeader - what a compiled level file holds and where, and how to tell it's intact and was compiled for this build
+	============================================================================
+	CLASSES:
+	+ MappedLevel - a compiled level file mapped into memory for as long as the world uses its records
+*/
+
+#ifndef COMPILEDLEVEL_H
+#define COMPILEDLEVEL_H
+
+#include <cstddef>
+#include <string>
+#include "bvh.h"
+#include "level.h"
+
+#define COMPILED_LEVEL_MAGIC "BLVLBIN"			//First eight bytes of a compiled level file (including the terminating zero)
+#define COMPILED_LEVEL_VERSION 3				//Version of the compiled level layout, raised whenever a record or the header changes
+#define COMPILED_LEVEL_BYTE_ORDER 0x01020304u	//Written in native byte order, so a file compiled on a machine of the other endianness is rejected
+#define COMPILED_LEVEL_ALIGNMENT 8				//Alignment of every section of a compiled level file
+
+struct CompiledLevelHeader
+{
+	char magic[8];					//COMPILED_LEVEL_MAGIC
+	unsigned int version;			//COMPILED_LEVEL_VERSION of the compiler
+	unsigned int byteOrder;			//COMPILED_LEVEL_BYTE_ORDER of the compiler
+	unsigned int outlineWidth;		//BLOCK_OUTLINE_WIDTH the hierarchy's bounds were computed with (a different one means rebuilding it)
+	unsigned int ballSize;			//size of a ball record
+	unsigned int blockSize;			//size of a block record
+	unsigned int materialSize;		//size of a material record
+	unsigned int nodeSize;			//size of a hierarchy node
+	unsigned int leafSize;			//size of a hierarchy leaf
+	unsigned int moverSize;			//size of a moving block record
+	unsigned int polygonSize;		//size of a polygon block record
+	int ballCount;					//number of ball records (the playerBall and the other balls)
+	int blockCount;					//number of block records (the goalBlock and the levelBlocks)
+	int materialCount;				//number of material records
+	int nodeCount;					//number of hierarchy nodes, 0 if the file has no hierarchy
+	int leafCount;					//number of hierarchy leaves
+	int moverCount;					//number of moving block records
+	int polygonCount;				//number of polygon block records
+	int reserved;					//zero, keeps the offsets 8-byte aligned
+	unsigned long long ballOffset;		//offset of the ball records from the start of the file
+	unsigned long long blockOffset;		//offset of the block records
+	unsigned long long materialOffset;	//offset of the material records
+	unsigned long long nodeOffset;		//offset of the hierarchy nodes
+	unsigned long long leafOffset;		//offset of the hierarchy leaves
+	unsigned long long moverOffset;		//offset of the moving block records
+	unsigned long long polygonOffset;	//offset of the polygon block records
+	unsigned long long payloadSize;		//number of bytes after the header
+	unsigned long long checksum;		//levelChecksum() of the bytes after the header
+};
+
+class MappedLevel
+{
+public:
+	bool open(const std::string&);
+		//Map a compiled level file and check it, return false (and stay closed) if it can't be mapped or isn't a valid compiled level
+	void close();
+		//Unmap the level file
+	void swap(MappedLevel&);
+		//Exchange mapped level files with another mapped level (the records don't move, so views of them stay valid)
+	bool isOpen() const;
+		//return true if a level file is mapped
+	const LevelView& getView() const;
+		//return a view of the records of the mapped level
+	const CompiledLevelHeader& getHeader() const;
+		//return the header of the mapped level file
+	MappedLevel();
+		//Constructor, nothing mapped
+	~MappedLevel();
+		//Destructor, unmap the level file
+private:
+	MappedLevel(const MappedLevel&) = delete;
+	MappedLevel& operator=(const MappedLevel&) = delete;
+	bool check();
+		//Check the header, sections, checksum and records of the mapped file and point the view at its records, return false if it isn't a valid compiled level
+	const unsigned char *data;	//Start of the mapped level file, nullptr when nothing is mapped
+	size_t size;				//Size of the mapped level file in bytes
+	void *fileHandle;			//Handle of the open level file (Windows only)
+	void *mappingHandle;		//Handle of the file mapping (Windows only)
+	LevelView view;				//Where the records of the mapped level are
+};
+
+std::string compiledLevelFileName(int);
+	//return the name of the compiled data file for a level number
+bool compileLevel(const LevelData&, const std::string&);
+	//Write level data and a hierarchy over its blocks as a compiled level file, return false if the file can't be written
+unsigned long long levelChecksum(const unsigned char*, size_t);
+	//return the checksum of the payload of a compiled level file
+
+#endif //COMPILEDLEVEL_H
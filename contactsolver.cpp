@@ -0,0 +1,262 @@
+/* Program name: contactsolver.cpp
+*  Author: Cory Knoll
+*  Date Last Modified: 10/17/2026
+*  Description: Sequential impulse solver for the contacts of the blocks with mass, warm-started with the impulses the same contacts needed the step before (no Qt dependency)
+	================================================================
+	FUNCTIONS:
+	+ void reset(int) - Drop every contact and every impulse kept, and size the cache for a number of blocks with mass
+	+ void add(const SolverContact&) - Add a contact of a block with mass to the ones the next solve() resolves
+	+ void solve(std::vector<BlockBody>&, double, const std::vector<unsigned char>&) - Change the velocities of the blocks with mass so none of the contacts added close over a portion of a frame, then keep the impulses for the next step (and the ones kept for the blocks asleep this step) and drop the contacts
+	+ void skip() - Resolve nothing this step (the blocks with mass are asleep), keeping the impulses for the step they wake in
+	+ const std::vector<CachedContact>& getCache() const - return the impulses kept from the last step, ascending by key
+	+ void setCache(const CachedContact*, int) - Replace the impulses kept with a number of saved ones (ascending by key, no more than the cache holds)
+	+ int getCacheCapacity() const - return the most contacts whose impulses are kept from one step to the next
+	+ void swapCache(ContactSolver&) - Exchange the impulses kept (and the size of the cache) with another solver, each keeping its settings
+	+ int getContactCount() const - return the number of contacts resolved by the last solve()
+	+ void setIterations(int) - Set the number of times every contact is resolved in a step
+	+ int getIterations() const - return the number of times every contact is resolved in a step
+	+ ContactSolver() - Constructor, no contacts and no cache
+	- void keepAsleep(const std::vector<unsigned char>&) - Drop the impulses kept for every contact but those of the blocks with mass asleep this step
+	- void push(std::vector<BlockBody>&, const SolverContact&, Vec2D) - Apply an impulse to the two blocks of a contact, along the normal to the first and against it to the second
+	- Vec2D relativeVelocity(const std::vector<BlockBody>&, const SolverContact&) - return how fast the first block of a contact moves away from the second
+	============================================================================
+	VARIABLES:
+	- std::vector<SolverContact> contacts - Contacts of the step being solved
+	- std::vector<CachedContact> cache - Impulses of the contacts of the last step, ascending by key
+	- std::vector<Vec2D> shifts - Distance every block with mass is moved by this step to push out its overlaps
+	- int capacity - Most contacts whose impulses are kept from one step to the next
+	- int iterations - Number of times every contact is resolved in a step
+	- int contactCount - Number of contacts resolved by the last solve()
+	============================================================================
+	STRUCTS:
+	+ SolverContact - a block with mass touching (or about to touch) another block, and the impulses it has taken so far
+	+ CachedContact - the impulses a contact took in a step, kept to start the same contact from the next step
+*/
+
+#include <algorithm>
+#include "contactsolver.h"
+#include "world.h"
+
+//Apply an impulse to the two blocks of a contact, along the normal to the first and against it to the second
+static inline void push(std::vector<BlockBody> &blocks, const SolverContact &contact, Vec2D impulse)
+{
+	BlockBody &first = blocks[contact.first];
+	first.vx += impulse.x * first.invMass;
+	first.vy += impulse.y * first.invMass;
+	if (contact.second >= 0)
+	{
+		BlockBody &second = blocks[contact.second];
+		second.vx -= impulse.x * second.invMass;
+		second.vy -= impulse.y * second.invMass;
+	}
+}
+
+//return how fast the first block of a contact moves away from the second
+static inline Vec2D relativeVelocity(const std::vector<BlockBody> &blocks, const SolverContact &contact)
+{
+	const BlockBody &first = blocks[contact.first];
+	Vec2D other = contact.second >= 0 ? Vec2D(blocks[contact.second].vx, blocks[contact.second].vy) : contact.velocity;
+	return Vec2D(first.vx, first.vy) - other;
+}
+
+//Drop every contact and every impulse kept, and size the cache for a number of blocks with mass
+void ContactSolver::reset(int blockCount)
+{
+	contacts.clear();
+	cache.clear();
+	capacity = SOLVER_CACHE_PER_BLOCK * std::max(blockCount, 0);
+	cache.reserve(capacity);
+	contactCount = 0;
+}
+
+//Add a contact of a block with mass to the ones the next solve() resolves
+void ContactSolver::add(const SolverContact &contact)
+{
+	contacts.push_back(contact);
+}
+
+//Change the velocities of the blocks with mass so none of the contacts added close over a portion of a frame, then keep the impulses for the next step and drop the contacts
+void ContactSolver::solve(std::vector<BlockBody> &blocks, double portion, const std::vector<unsigned char> &asleep)
+{
+	contactCount = (int)contacts.size();
+	if (contacts.empty() || portion <= 0)
+	{
+		contacts.clear();
+		keepAsleep(asleep);
+		return;
+	}
+
+	//the contacts are found in whatever order the hierarchies give them; solving them in key order makes a step depend on the
+	//blocks alone, and lines them up with the cache, which is in the same order
+	std::sort(contacts.begin(), contacts.end(), [](const SolverContact &a, const SolverContact &b) { return a.key < b.key; });
+	for (SolverContact &contact : contacts)
+	{
+		double invMass = blocks[contact.first].invMass + (contact.second >= 0 ? blocks[contact.second].invMass : 0);
+		contact.mass = 1 / invMass;
+
+		//the target lets a gap close this step but not be crossed, so a block can't pass through another however fast it goes (the
+		//contact is speculative); the iterations only meet it as far as they converge, which on a stack takes the impulses of the
+		//step before (see below). Blocks that hit hard enough bounce, as far as their restitution goes between closing the gap and
+		//bouncing back at once (blocks already sunk into each other don't); an overlap is pushed out a part at a time, by moving them
+		double closing = relativeVelocity(blocks, contact).dot(contact.normal);
+		contact.target = contact.gap > 0 ? -contact.gap / portion : 0;
+		if (closing < -SOLVER_BOUNCE_SPEED && contact.gap > -SOLVER_SLOP && closing * portion + contact.gap < 0)
+			contact.target = std::max(contact.target, -contact.restitution * closing - (1 + contact.restitution) * std::max(contact.gap, 0.0) / portion);
+		contact.correction = SOLVER_BAUMGARTE * std::max(-contact.gap - SOLVER_SLOP, 0.0);
+		contact.normalImpulse = 0;
+		contact.tangentImpulse = 0;
+		contact.shiftImpulse = 0;
+	}
+
+	//a contact that lasts needs about the impulse it needed the step before (a block resting on another, the weight of the
+	//blocks above it), so starting from that impulse leaves the iterations only the change to find, and a stack holds still.
+	//It isn't optional: started from nothing every step, the iterations leave a tall stack sinking a few units a frame, the
+	//overlap settles where pushing it out keeps up with that, and past half a box the blocks trade places and fall through the
+	//floor. The impulses go in only once every target is set, since a block pushed by them isn't closing in on anything
+	size_t cached = 0;
+	for (SolverContact &contact : contacts)
+	{
+		while (cached < cache.size() && cache[cached].key < contact.key)
+			cached++;
+		if (cached < cache.size() && cache[cached].key == contact.key)
+		{
+			contact.normalImpulse = cache[cached].normalImpulse;
+			contact.tangentImpulse = cache[cached].tangentImpulse;
+			Vec2D tangent(-contact.normal.y, contact.normal.x);
+			push(blocks, contact, contact.normal * contact.normalImpulse + tangent * contact.tangentImpulse);
+		}
+	}
+
+	//resolve every contact in turn, each seeing the velocities the ones before it left: the total impulse of a contact can only
+	//push the blocks apart, and friction can't take more than its coefficient times that impulse. push() and relativeVelocity()
+	//are inlined, since an impulse passed to a call went through memory and stalled the velocity read right after it
+	for (int iteration = 0; iteration < iterations; iteration++)
+	{
+		for (SolverContact &contact : contacts)
+		{
+			Vec2D tangent(-contact.normal.y, contact.normal.x);
+			double limit = contact.friction * contact.normalImpulse;
+			double tangentImpulse = std::min(std::max(contact.tangentImpulse - relativeVelocity(blocks, contact).dot(tangent) * contact.mass, -limit), limit);
+			push(blocks, contact, tangent * (tangentImpulse - contact.tangentImpulse));
+			contact.tangentImpulse = tangentImpulse;
+
+			double normalImpulse = std::max(contact.normalImpulse + (contact.target - relativeVelocity(blocks, contact).dot(contact.normal)) * contact.mass, 0.0);
+			push(blocks, contact, contact.normal * (normalImpulse - contact.normalImpulse));
+			contact.normalImpulse = normalImpulse;
+		}
+	}
+
+	//overlaps are pushed out the same way, but by moving the blocks rather than speeding them up (split impulses): pushing an
+	//overlap out that way would leave the blocks moving apart once it's gone, and a stack settling into itself would spring apart
+	shifts.assign(blocks.size(), Vec2D());
+	for (int iteration = 0; iteration < iterations; iteration++)
+	{
+		for (SolverContact &contact : contacts)
+		{
+			if (contact.correction <= 0)
+				continue;
+			Vec2D moved = shifts[contact.first] - (contact.second >= 0 ? shifts[contact.second] : Vec2D());
+			double shiftImpulse = std::max(contact.shiftImpulse + (contact.correction - moved.dot(contact.normal)) * contact.mass, 0.0);
+			Vec2D shift = contact.normal * (shiftImpulse - contact.shiftImpulse);
+			shifts[contact.first] = shifts[contact.first] + shift * blocks[contact.first].invMass;
+			if (contact.second >= 0)
+				shifts[contact.second] = shifts[contact.second] - shift * blocks[contact.second].invMass;
+			contact.shiftImpulse = shiftImpulse;
+		}
+	}
+	for (size_t i = 0; i < blocks.size(); i++)
+	{
+		blocks[i].xMin += shifts[i].x;
+		blocks[i].yMin += shifts[i].y;
+		blocks[i].xMax += shifts[i].x;
+		blocks[i].yMax += shifts[i].y;
+	}
+
+	//keep the impulses for the next step along with the ones a sleeping block's contacts kept (no contact solved has a sleeping block,
+	//so the two never share a key); past the cache's capacity (a fixed size, so a snapshot of the world is too) the contacts with
+	//the highest keys start cold
+	keepAsleep(asleep);
+	size_t kept = cache.size();
+	for (const SolverContact &contact : contacts)
+	{
+		CachedContact impulses = { contact.key, contact.normalImpulse, contact.tangentImpulse };
+		cache.push_back(impulses);
+	}
+	std::inplace_merge(cache.begin(), cache.begin() + kept, cache.end(), [](const CachedContact &a, const CachedContact &b) { return a.key < b.key; });
+	if ((int)cache.size() > capacity)
+		cache.resize(capacity);
+	contacts.clear();
+}
+
+//Drop the impulses kept for every contact but those of the blocks with mass asleep this step
+void ContactSolver::keepAsleep(const std::vector<unsigned char> &asleep)
+{
+	//a contact's key starts with the block with mass it belongs to
+	size_t kept = 0;
+	for (const CachedContact &contact : cache)
+	{
+		size_t block = (size_t)(contact.key >> 32);
+		if (block < asleep.size() && asleep[block])
+			cache[kept++] = contact;
+	}
+	cache.resize(kept);
+}
+
+//Resolve nothing this step (the blocks with mass are asleep), keeping the impulses for the step they wake in
+void ContactSolver::skip()
+{
+	contacts.clear();
+	contactCount = 0;
+}
+
+//return the impulses kept from the last step, ascending by key
+const std::vector<CachedContact>& ContactSolver::getCache() const
+{
+	return cache;
+}
+
+//Replace the impulses kept with a number of saved ones (ascending by key, no more than the cache holds)
+void ContactSolver::setCache(const CachedContact *saved, int count)
+{
+	cache.assign(saved, saved + std::max(0, std::min(count, capacity)));
+}
+
+//return the most contacts whose impulses are kept from one step to the next
+int ContactSolver::getCacheCapacity() const
+{
+	return capacity;
+}
+
+//Exchange the impulses kept (and the size of the cache) with another solver, each keeping its settings
+void ContactSolver::swapCache(ContactSolver &other)
+{
+	cache.swap(other.cache);
+	std::swap(capacity, other.capacity);
+	std::swap(contactCount, other.contactCount);
+}
+
+//return the number of contacts resolved by the last solve()
+int ContactSolver::getContactCount() const
+{
+	return contactCount;
+}
+
+//Set the number of times every contact is resolved in a step
+void ContactSolver::setIterations(int count)
+{
+	iterations = std::max(count, 1);
+}
+
+//return the number of times every contact is resolved in a step
+int ContactSolver::getIterations() const
+{
+	return iterations;
+}
+
+//Constructor, no contacts and no cache
+ContactSolver::ContactSolver()
+{
+	capacity = 0;
+	iterations = SOLVER_ITERATIONS;
+	contactCount = 0;
+}
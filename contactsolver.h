@@ -0,0 +1,111 @@
+/* Program name: contactsolver.h
+*  Author: Cory Knoll
+*  Date Last Modified: 10/17/2026
+*  Description: Sequential impulse solver for the contacts of the blocks with mass, warm-started with the impulses the same contacts needed the step before (no Qt dependency)
+	================================================================
+	FUNCTIONS:
+	+ void reset(int) - Drop every contact and every impulse kept, and size the cache for a number of blocks with mass
+	+ void add(const SolverContact&) - Add a contact of a block with mass to the ones the next solve() resolves
+	+ void solve(std::vector<BlockBody>&, double, const std::vector<unsigned char>&) - Change the velocities of the blocks with mass so none of the contacts added close over a portion of a frame, then keep the impulses for the next step (and the ones kept for the blocks asleep this step) and drop the contacts
+	+ void skip() - Resolve nothing this step (the blocks with mass are asleep), keeping the impulses for the step they wake in
+	+ const std::vector<CachedContact>& getCache() const - return the impulses kept from the last step, ascending by key
+	+ void setCache(const CachedContact*, int) - Replace the impulses kept with a number of saved ones (ascending by key, no more than the cache holds)
+	+ int getCacheCapacity() const - return the most contacts whose impulses are kept from one step to the next
+	+ void swapCache(ContactSolver&) - Exchange the impulses kept (and the size of the cache) with another solver, each keeping its settings
+	+ int getContactCount() const - return the number of contacts resolved by the last solve()
+	+ void setIterations(int) - Set the number of times every contact is resolved in a step
+	+ int getIterations() const - return the number of times every contact is resolved in a step
+	+ ContactSolver() - Constructor, no contacts and no cache
+	- void keepAsleep(const std::vector<unsigned char>&) - Drop the impulses kept for every contact but those of the blocks with mass asleep this step
+	============================================================================
+	VARIABLES:
+	- std::vector<SolverContact> contacts - Contacts of the step being solved
+	- std::vector<CachedContact> cache - Impulses of the contacts of the last step, ascending by key
+	- std::vector<Vec2D> shifts - Distance every block with mass is moved by this step to push out its overlaps
+	- int capacity - Most contacts whose impulses are kept from one step to the next
+	- int iterations - Number of times every contact is resolved in a step
+	- int contactCount - Number of contacts resolved by the last solve()
+	============================================================================
+	STRUCTS:
+	+ SolverContact - a block with mass touching (or about to touch) another block, and the impulses it has taken so far
+	+ CachedContact - the impulses a contact took in a step, kept to start the same contact from the next step
+*/
+
+#ifndef CONTACTSOLVER_H
+#define CONTACTSOLVER_H
+
+#include <vector>
+#include "vec2d.h"
+
+#define SOLVER_ITERATIONS 8			//Default number of times every contact is resolved in a step
+#define SOLVER_CACHE_PER_BLOCK 4	//Contacts per block with mass whose impulses are kept from one step to the next
+#define SOLVER_BAUMGARTE 0.2		//Portion of an overlap pushed out in a step
+#define SOLVER_SLOP 0.5				//Overlap left alone, so blocks resting on each other don't jitter in and out of touching
+#define SOLVER_BOUNCE_SPEED 4.0		//Closing speed below which blocks don't bounce off each other (two frames of gravity), so a stack comes to rest
+
+struct BlockBody;
+
+struct SolverContact
+{
+	int first;				//index of the block with mass the normal points towards
+	int second;				//index of the other block with mass, -1 for a body that doesn't give way (a level block, a moving one or a ball)
+	unsigned long long key;	//the two blocks and the side they touch on, the same from step to step while the contact lasts
+	Vec2D normal;			//unit normal from the second block to the first
+	double gap;				//distance between the blocks along the normal, below 0 when they overlap
+	double restitution;		//portion of their closing speed the blocks keep after bouncing off each other
+	double friction;		//Coulomb friction coefficient between the blocks
+	Vec2D velocity;			//velocity of a second block that doesn't give way
+	double mass;			//mass the impulses along the normal and the surface act on (both blocks)
+	double target;			//speed along the normal the blocks have to part at (below 0: may close at) by the end of the step
+	double correction;		//distance along the normal the blocks are moved apart by this step to push out an overlap
+	double normalImpulse;	//impulse along the normal taken so far this step
+	double tangentImpulse;	//impulse along the surface taken so far this step
+	double shiftImpulse;	//impulse along the normal moving the blocks apart (rather than speeding them up) taken so far this step
+};
+
+struct CachedContact
+{
+	unsigned long long key;	//the two blocks and the side they touch on
+	double normalImpulse;	//impulse along the normal the contact took
+	double tangentImpulse;	//impulse along the surface the contact took
+};
+
+class ContactSolver
+{
+public:
+	void reset(int);
+		//Drop every contact and every impulse kept, and size the cache for a number of blocks with mass
+	void add(const SolverContact&);
+		//Add a contact of a block with mass to the ones the next solve() resolves
+	void solve(std::vector<BlockBody>&, double, const std::vector<unsigned char>&);
+		//Change the velocities of the blocks with mass so none of the contacts added close over a portion of a frame, then keep the impulses for the next step (and the ones kept for the blocks asleep this step) and drop the contacts
+	void skip();
+		//Resolve nothing this step (the blocks with mass are asleep), keeping the impulses for the step they wake in
+	const std::vector<CachedContact>& getCache() const;
+		//return the impulses kept from the last step, ascending by key
+	void setCache(const CachedContact*, int);
+		//Replace the impulses kept with a number of saved ones (ascending by key, no more than the cache holds)
+	int getCacheCapacity() const;
+		//return the most contacts whose impulses are kept from one step to the next
+	void swapCache(ContactSolver&);
+		//Exchange the impulses kept (and the size of the cache) with another solver, each keeping its settings
+	int getContactCount() const;
+		//return the number of contacts resolved by the last solve()
+	void setIterations(int);
+		//Set the number of times every contact is resolved in a step
+	int getIterations() const;
+		//return the number of times every contact is resolved in a step
+	ContactSolver();
+		//Constructor, no contacts and no cache
+private:
+	void keepAsleep(const std::vector<unsigned char>&);
+		//Drop the impulses kept for every contact but those of the blocks with mass asleep this step
+	std::vector<SolverContact> contacts;//Contacts of the step being solved
+	std::vector<CachedContact> cache;	//Impulses of the contacts of the last step, ascending by key
+	std::vector<Vec2D> shifts;			//Distance every block with mass is moved by this step to push out its overlaps
+	int capacity;						//Most contacts whose impulses are kept from one step to the next
+	int iterations;						//Number of times every contact is resolved in a step
+	int contactCount;					//Number of contacts resolved by the last solve()
+};
+
+#endif //CONTACTSOLVER_H
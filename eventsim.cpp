@@ -0,0 +1,489 @@
+/* Program name: eventsim.cpp
+*  Author: Cory Knoll
+*  Date Last Modified: 10/17/2026
+*  Description: Event-driven simulation of a world's balls: between contacts every ball follows an exact parabola, so the simulation jumps from one predicted collision to the next instead of stepping frame by frame, for headless batch runs over static levels (no Qt dependency). The parabolas only meet the world's frames at whole frames, so advance() only approximates the game; play() uses them only to find the frames in which nothing is in reach and gives the game's own answers
+	================================================================
+	FUNCTIONS:
+	+ bool load(const World&) - Take the balls of a world where they are and the level's blocks, goal block and materials by reference, return false (and hold nothing) if the level has moving blocks, blocks with mass or polygon blocks
+	+ bool advance(double) - Jump from event to event over a number of frames, return true (stopping at that moment) if the playerBall hits the goal block
+	+ bool play(World&, int) - Play up to a number of frames of a world the way its frame steps would, stepping it through the frames in which a ball can reach a block or another ball and moving the balls over the rest, return true (stopping at that frame) if the playerBall hits the goal block; stops early once the playerBall leaves the level for good, and plays nothing (holding no level) on a level load() won't take
+	+ static bool isJumpable(const World&) - return whether a world's blocks all stand still and are boxes, so the simulation can jump through its frames
+	+ void store(World&) const - Put the balls of the world the simulation was loaded from where the simulation has them, with the velocities the world's frame steps give them
+	+ double getTime() const - return the frames simulated since the simulation was loaded (or played by the last play())
+	+ long long getEventCount() const - return the number of events handled since the simulation was loaded (or the frames the last play() stepped the world through)
+	+ bool isGone(int) const - return whether a ball left the level for good
+	+ Vec2D getBallPosition(int) const - return where the center of a ball is at the simulation's time
+	+ EventSimulator() - Constructor, no level held
+	- const BlockBody& getBody(int) const - return a level block, or the goal block for the index past the last level block
+	- Vec2D positionAt(int, double) const - return where the center of a ball is at a time along its current parabola
+	- Vec2D velocityAt(int, double) const - return the velocity of a ball at a time along its current parabola
+	- void moveTo(int, double) - Move a ball along its current parabola to a time, which becomes the start of its parabola
+	- void predict(int) - Find the next event of a ball from its time on (a collision, or checking in again past the horizon) and queue it
+	- bool handle(const SimEvent&) - Handle an event that is still valid, return true if the playerBall hit the goal block
+	- void hold(const World&) - Take a world's blocks, goal block and materials by reference and the bounds of its blocks
+	- int freeFrames(const World&, int) - return how many whole frames from now on (up to a most) no ball of a world can reach a block or another ball in
+	- bool isLeaving(const World&) const - return whether a world's playerBall is past the bounds of the level moving away from it, so it never comes back
+	- double slabEntry(double, double, double, double, double) - return the first time from now on a coordinate moving with a velocity and a constant acceleration is between two bounds (infinity if it never is)
+	============================================================================
+	VARIABLES:
+	- const World *world - World whose blocks, goal block and materials the simulation reads
+	- std::vector<EventBall> balls - Every ball along its current parabola (playerBall first)
+	- std::priority_queue<SimEvent, std::vector<SimEvent>, LaterEvent> events - Events predicted for the balls, earliest first
+	- std::vector<int> candidates - Scratch list of the blocks a ball's parabola can reach before its horizon
+	- double time - Frames simulated since the simulation was loaded (or played by the last play())
+	- long long eventCount - Events handled since the simulation was loaded (or frames the last play() stepped the world through)
+	- long long eventOrder - Events queued since the simulation was loaded, which orders events due at the same time
+	- double xMin, yMin, xMax, yMax - Bounds of every block of the level, past which a ball moving away never comes back
+	============================================================================
+	STRUCTS:
+	+ EventBall - one ball's parabola (where it starts, at what time, its velocity and acceleration) and what invalidates its events
+	+ SimEvent - one predicted event of a ball: when, what kind, with what, and the stamps the balls had when it was predicted
+	+ LaterEvent - orders the queue of events earliest first (and in the order they were queued at the same time)
+*/
+
+#include <algorithm>
+#include <cmath>
+#include "eventsim.h"
+
+#define EVENT_BLOCK 0		//the ball bounces off a level block (or, for any ball but the playerBall, the goal block)
+#define EVENT_GOAL 1		//the playerBall touches the goal block
+#define EVENT_BALL 2		//the ball collides with another ball
+#define EVENT_HORIZON 3		//nothing happens to the ball before the horizon, so it checks in again there
+
+//return the first time from now on a coordinate moving with a velocity and a constant acceleration is between two bounds (infinity if it never is)
+static double slabEntry(double start, double speed, double acceleration, double low, double high)
+{
+	if (start >= low && start <= high)
+		return 0;
+
+	//the first time it reaches the nearer bound, the smallest root of a quadratic in time that isn't in the past
+	double gap = start - (start < low ? low : high);
+	double half = 0.5 * acceleration;
+	if (half == 0)
+		return speed != 0 && -gap / speed >= 0 ? -gap / speed : HUGE_VAL;
+	double discriminant = speed * speed - 4 * half * gap;
+	if (discriminant < 0)
+		return HUGE_VAL;
+	double root = sqrt(discriminant);
+	double first = (-speed - root) / (2 * half), second = (-speed + root) / (2 * half);
+	if (first > second)
+		std::swap(first, second);
+	return first >= 0 ? first : second >= 0 ? second : HUGE_VAL;
+}
+
+//Constructor, no level held
+EventSimulator::EventSimulator()
+{
+	world = nullptr;
+	time = 0;
+	eventCount = 0;
+	eventOrder = 0;
+	xMin = yMin = xMax = yMax = 0;
+}
+
+//Take the balls of a world where they are and the level's blocks, goal block and materials by reference, return false (and hold nothing) if the level has moving blocks, blocks with mass or polygon blocks
+bool EventSimulator::load(const World &source)
+{
+	balls.clear();
+	events = std::priority_queue<SimEvent, std::vector<SimEvent>, LaterEvent>();
+	time = 0;
+	eventCount = 0;
+	eventOrder = 0;
+	world = nullptr;
+
+	if (!isJumpable(source))
+		return false;
+	hold(source);
+
+	//a frame step moves a ball along its velocity and then adds a frame of gravity to it, so after n steps it has moved
+	//v*n + g*n(n-1)/2: exactly the parabola starting half a frame of gravity slower, which passes through every position the
+	//frame steps put the ball at. Starting from that velocity keeps the simulation on the world's frames between collisions.
+	//A parabola bouncing off a floor would bounce lower and sooner without end, but with the half frame the frame steps bounce
+	//(see handle()) every hop takes at least a frame, so a ball keeps hopping on a floor the way it does in the world
+	const BodyStore &bodies = source.getBodies();
+	balls.resize(bodies.size());
+	for (int i = 0; i < bodies.size(); i++)
+	{
+		EventBall &ball = balls[i];
+		ball.position = bodies.getPosition(i);
+		ball.velocity = bodies.getVelocity(i) - Vec2D(0, GRAVITY / 2);
+		ball.acceleration = Vec2D(0, GRAVITY);
+		ball.time = 0;
+		ball.radius = bodies.radius[i];
+		ball.invMass = bodies.invMass[i];
+		ball.stamp = 0;
+		ball.gone = false;
+		ball.burstStart = 0;
+		ball.burstCount = 0;
+	}
+	for (int i = 0; i < (int)balls.size(); i++)
+		predict(i);
+	return true;
+}
+
+//Jump from event to event over a number of frames, return true (stopping at that moment) if the playerBall hits the goal block
+bool EventSimulator::advance(double frames)
+{
+	double end = time + frames;
+	while (!events.empty() && events.top().time <= end)
+	{
+		SimEvent event = events.top();
+		events.pop();
+
+		//an event predicted along a parabola the ball has left since is dropped; one with another ball that has changed its
+		//parabola since only means this ball's next event has to be found again from here
+		if (balls[event.ball].stamp != event.ballStamp)
+			continue;
+		time = std::max(time, event.time);
+		if (event.kind == EVENT_BALL && balls[event.other].stamp != event.otherStamp)
+		{
+			moveTo(event.ball, event.time);
+			predict(event.ball);
+			continue;
+		}
+		eventCount++;
+		if (handle(event))
+			return true;
+	}
+	time = end;
+	return false;
+}
+
+//Play up to a number of frames of a world the way its frame steps would, stepping it through the frames in which a ball can reach a block or another ball and moving the balls over the rest, return true (stopping at that frame) if the playerBall hits the goal block; stops early once the playerBall leaves the level for good, and plays nothing (holding no level) on a level load() won't take
+bool EventSimulator::play(World &target, int frames)
+{
+	//a frame step moves a ball in a straight line, which strays up to an eighth of a frame of gravity off the parabola the events
+	//follow, so after a bounce off a corner advance() can send a ball another way than the game does. What the parabola can tell
+	//for sure is when nothing is in reach: in the frames no ball can touch a block or another ball a frame step moves every ball
+	//by its velocity and adds a frame of gravity, which is done here with the same arithmetic, and every other frame is the
+	//world's own step. The balls go exactly where the game's frames take them, at the cost of the frames near a collision
+	balls.clear();
+	events = std::priority_queue<SimEvent, std::vector<SimEvent>, LaterEvent>();
+	time = 0;
+	eventCount = 0;
+	world = nullptr;
+	if (!isJumpable(target))
+		return false;
+	hold(target);
+	const BodyStore &bodies = target.getBodies();
+	while (time < frames)
+	{
+		int free = freeFrames(target, frames - (int)time);
+		if (free == 0)
+		{
+			time++;
+			eventCount++;
+			if (target.step(1.0))
+				return true;
+			if (isLeaving(target))
+				return false;
+			continue;
+		}
+		bool leaving = false;
+		int frame = 0;
+		while (frame < free && !leaving)
+		{
+			for (int i = 0; i < bodies.size(); i++)
+			{
+				target.setBallPosition(i, bodies.x[i] + bodies.vx[i], bodies.y[i] + bodies.vy[i]);
+				target.setBallVelocity(i, bodies.vx[i], bodies.vy[i] + GRAVITY);
+			}
+			frame++;
+			leaving = isLeaving(target);
+		}
+		time += frame;
+		target.setTime(target.getTime() + frame);
+		if (leaving)
+			return false;
+	}
+	return false;
+}
+
+//return whether a world's blocks all stand still and are boxes, so the simulation can jump through its frames
+bool EventSimulator::isJumpable(const World &source)
+{
+	//a block that moves between two collisions bends no parabola, so only levels whose blocks all stand still can be jumped
+	//through, and the events only know the blocks' boxes
+	return source.getMoverCount() == 0 && source.getDynamicBlockCount() == 0 && source.getPolygonCount() == 0;
+}
+
+//Take a world's blocks, goal block and materials by reference and the bounds of its blocks
+void EventSimulator::hold(const World &source)
+{
+	//the same bounds predictTrajectory() gives up on a ball past
+	world = &source;
+	const BlockBody &goal = source.getGoalBlock();
+	xMin = goal.xMin;
+	yMin = goal.yMin;
+	xMax = goal.xMax;
+	yMax = goal.yMax;
+	if (source.getBlockTree().getNodeCount() > 0)
+	{
+		const BVH::Node &root = source.getBlockTree().getNodes()[0];
+		xMin = std::min(xMin, root.xMin);
+		yMin = std::min(yMin, root.yMin);
+		xMax = std::max(xMax, root.xMax);
+		yMax = std::max(yMax, root.yMax);
+	}
+}
+
+//Handle an event that is still valid, return true if the playerBall hit the goal block
+bool EventSimulator::handle(const SimEvent &event)
+{
+	int index = event.ball;
+	EventBall &ball = balls[index];
+	moveTo(index, event.time);
+	if (event.kind == EVENT_GOAL)
+		return true;
+
+	//a ball caught between blocks or balls can find collisions ever closer together; past the budget within a frame it's wedged
+	//where it is, still and weightless, until something knocks it out (the world's steps fall back to a cheaper approximation
+	//the same way)
+	if (event.time - ball.burstStart >= 1)
+	{
+		ball.burstStart = event.time;
+		ball.burstCount = 0;
+	}
+	if (++ball.burstCount > EVENT_BUDGET)
+	{
+		ball.velocity = Vec2D();
+		ball.acceleration = Vec2D();
+		ball.stamp++;
+		return false;
+	}
+
+	//a frame step bounces the velocity the ball has partway through the frame, which is always half a frame of gravity ahead of the
+	//parabola's (see load()), so responses are worked out on that velocity and the half frame is taken back off afterwards. A ball
+	//only just reaching an underside is already falling by then, so the parabola itself bounces instead of sticking to it
+	if (event.kind == EVENT_BLOCK)
+	{
+		const Material &material = world->getMaterial(getBody(event.other).material);
+		Vec2D lead = ball.acceleration * 0.5;
+		Vec2D bounced = bounce(ball.velocity + lead, event.normal, material) - lead;
+		ball.velocity = bounced.dot(event.normal) >= 0 ? bounced : bounce(ball.velocity, event.normal, material);
+		ball.stamp++;
+		predict(index);
+	}
+	else if (event.kind == EVENT_BALL)
+	{
+		//the same impulse World::collideBalls() exchanges; a wedged ball knocked out falls again
+		EventBall &other = balls[event.other];
+		moveTo(event.other, event.time);
+		Vec2D normal = other.position - ball.position;	//normal from the ball to the other ball
+		double length = normal.length();
+		double totalInvMass = ball.invMass + other.invMass;
+		if (length > 0 && totalInvMass > 0)
+		{
+			//on the frame steps' velocities too, unless the parabolas would still close in on each other after it
+			normal = normal / length;
+			double closingSpeed = (other.velocity - ball.velocity).dot(normal);
+			double leadClosingSpeed = (other.velocity + other.acceleration * 0.5 - ball.velocity - ball.acceleration * 0.5).dot(normal);
+			double change = -(1 + BALL_RESTITUTION) * std::min(leadClosingSpeed, 0.0);
+			if (closingSpeed + change < 0)
+				change = -(1 + BALL_RESTITUTION) * closingSpeed;
+			Vec2D impulse = normal * (change / totalInvMass);
+			ball.velocity -= impulse * ball.invMass;
+			other.velocity += impulse * other.invMass;
+		}
+		ball.acceleration = other.acceleration = Vec2D(0, GRAVITY);
+		ball.stamp++;
+		other.stamp++;
+		predict(index);
+		predict(event.other);
+	}
+	else
+	{
+		//past a side of the level moving away from it, or below it, nothing can bring the ball back
+		if ((ball.position.x < xMin - ball.radius && ball.velocity.x <= 0) || (ball.position.x > xMax + ball.radius && ball.velocity.x >= 0)
+			|| (ball.position.y > yMax + ball.radius && ball.velocity.y >= 0))
+		{
+			ball.gone = true;
+			ball.stamp++;
+			return false;
+		}
+		predict(index);
+	}
+	return false;
+}
+
+//Find the next event of a ball from its time on (a collision, or checking in again past the horizon) and queue it
+void EventSimulator::predict(int index)
+{
+	const EventBall &ball = balls[index];
+	if (ball.gone || (ball.velocity == Vec2D() && ball.acceleration == Vec2D()))
+		return;
+
+	SimEvent next;
+	next.time = EVENT_LOOKAHEAD;	//time after the ball's, until the queued event
+	next.kind = EVENT_HORIZON;
+	next.ball = index;
+	next.other = -1;
+	next.ballStamp = ball.stamp;
+	next.otherStamp = 0;
+
+	//only the blocks overlapping the box the parabola stays in until the horizon can be hit first
+	SweepHit hit;
+	Vec2D end = ball.position + ball.velocity * next.time + ball.acceleration * (0.5 * next.time * next.time);
+	double pathXMin = std::min(ball.position.x, end.x), pathXMax = std::max(ball.position.x, end.x);
+	double pathYMin = std::min(ball.position.y, end.y), pathYMax = std::max(ball.position.y, end.y);
+	if (ball.acceleration.y != 0 && -ball.velocity.y / ball.acceleration.y > 0 && -ball.velocity.y / ball.acceleration.y < next.time)
+		pathYMin = std::min(pathYMin, ball.position.y - 0.5 * ball.velocity.y * ball.velocity.y / ball.acceleration.y);
+	world->getBlockTree().query(pathXMin - ball.radius, pathYMin - ball.radius, pathXMax + ball.radius, pathYMax + ball.radius, candidates);
+	candidates.push_back(world->getBlockCount());
+	for (int block : candidates)
+	{
+		const BlockBody &body = getBody(block);
+		SweepBox box = { body.xMin, body.yMin, body.xMax, body.yMax };
+		if (sweepParabolaBox(ball.position, ball.velocity, ball.acceleration, ball.radius, box, next.time, hit) && hit.toi < next.time)
+		{
+			next.time = hit.toi;
+			next.kind = block == world->getBlockCount() && index == 0 ? EVENT_GOAL : EVENT_BLOCK;
+			next.other = block;
+			next.normal = hit.normal;
+		}
+	}
+
+	//every other ball where it is now, in the ball's frame of reference: the gap between their centers moves along a parabola of
+	//their relative velocity and acceleration, and they collide where it comes within the sum of their radii
+	for (int i = 0; i < (int)balls.size(); i++)
+	{
+		if (i == index || balls[i].gone)
+			continue;
+		double toi;
+		Vec2D offset = ball.position - positionAt(i, ball.time);
+		if (sweepParabolaCircle(offset, ball.velocity - velocityAt(i, ball.time), ball.acceleration - balls[i].acceleration,
+			ball.radius + balls[i].radius, next.time, toi) && toi < next.time)
+		{
+			next.time = toi;
+			next.kind = EVENT_BALL;
+			next.other = i;
+			next.otherStamp = balls[i].stamp;
+		}
+	}
+
+	next.time += ball.time;
+	next.order = eventOrder++;
+	events.push(next);
+}
+
+//return how many whole frames from now on (up to a most) no ball of a world can reach a block or another ball in
+int EventSimulator::freeFrames(const World &source, int most)
+{
+	//the places frame steps put a ball lie on the parabola starting half a frame of gravity slower (see load()), and within a frame
+	//the straight move is never more than an eighth of a frame of gravity off it, so a ball whose parabola keeps that much (and a
+	//margin for rounding) clear of every block moves freely in every whole frame before the parabola gets that close. Two balls
+	//fall alike, so between them the frame steps move in a straight line
+	if (source.isParabolicSteps())
+		return 0;
+	double reach = std::min((double)most, EVENT_LOOKAHEAD);
+	const BodyStore &bodies = source.getBodies();
+	Vec2D gravity(0, GRAVITY);
+	for (int i = 0; i < bodies.size(); i++)
+	{
+		Vec2D center = bodies.getPosition(i);
+		Vec2D velocity = bodies.getVelocity(i) - gravity * 0.5;
+		double radius = bodies.radius[i] + GRAVITY / 8 + EVENT_MARGIN;
+		SweepBox path = parabolaBounds(center, velocity, gravity, reach);
+		source.getBlockTree().query(path.xMin - radius, path.yMin - radius, path.xMax + radius, path.yMax + radius, candidates);
+		candidates.push_back(source.getBlockCount());
+		for (int block : candidates)
+		{
+			//the ball can't come that close to a block before it's between both pairs of the block's grown sides at once, which
+			//is cheaper to find than where it touches the rounded corners and only ever earlier
+			const BlockBody &body = getBody(block);
+			double across = slabEntry(center.x, velocity.x, 0, body.xMin - radius, body.xMax + radius);
+			double down = slabEntry(center.y, velocity.y, GRAVITY, body.yMin - radius, body.yMax + radius);
+			reach = std::min(reach, std::max(across, down));
+			if (reach < 1)
+				return 0;
+		}
+		for (int j = i + 1; j < bodies.size(); j++)
+		{
+			double toi;
+			Vec2D offset = center - bodies.getPosition(j);
+			double together = bodies.radius[i] + bodies.radius[j] + EVENT_MARGIN;
+			if (offset.length() <= together)
+				return 0;
+			if (sweepParabolaCircle(offset, bodies.getVelocity(i) - bodies.getVelocity(j), Vec2D(), together, reach, toi))
+				reach = std::min(reach, toi);
+		}
+	}
+	return (int)floor(reach);
+}
+
+//return whether a world's playerBall is past the bounds of the level moving away from it, so it never comes back
+bool EventSimulator::isLeaving(const World &source) const
+{
+	//the same test predictTrajectory() gives up on a ball with
+	Vec2D center(source.getBallX(0), source.getBallY(0));
+	Vec2D speed = source.getBallVelocity(0);
+	double radius = source.getBallRadius(0);
+	return (center.x < xMin - radius && speed.x <= 0) || (center.x > xMax + radius && speed.x >= 0) || (center.y > yMax + radius && speed.y >= 0);
+}
+
+//Put the balls of the world the simulation was loaded from where the simulation has them, with the velocities the world's frame steps give them
+void EventSimulator::store(World &target) const
+{
+	//back on the frame steps' velocities: half a frame of gravity faster than the parabola
+	for (int i = 0; i < (int)balls.size(); i++)
+	{
+		Vec2D position = positionAt(i, time);
+		Vec2D velocity = velocityAt(i, time) + balls[i].acceleration * 0.5;
+		target.setBallPosition(i, position.x, position.y);
+		target.setBallVelocity(i, velocity.x, velocity.y);
+	}
+}
+
+//return the frames simulated since the simulation was loaded
+double EventSimulator::getTime() const
+{
+	return time;
+}
+
+//return the number of events handled since the simulation was loaded
+long long EventSimulator::getEventCount() const
+{
+	return eventCount;
+}
+
+//return whether a ball left the level for good
+bool EventSimulator::isGone(int index) const
+{
+	return balls[index].gone;
+}
+
+//return where the center of a ball is at the simulation's time
+Vec2D EventSimulator::getBallPosition(int index) const
+{
+	return positionAt(index, time);
+}
+
+//return a level block, or the goal block for the index past the last level block
+const BlockBody& EventSimulator::getBody(int index) const
+{
+	return index < world->getBlockCount() ? world->getBlock(index) : world->getGoalBlock();
+}
+
+//return where the center of a ball is at a time along its current parabola
+Vec2D EventSimulator::positionAt(int index, double at) const
+{
+	const EventBall &ball = balls[index];
+	double elapsed = at - ball.time;
+	return ball.position + ball.velocity * elapsed + ball.acceleration * (0.5 * elapsed * elapsed);
+}
+
+//return the velocity of a ball at a time along its current parabola
+Vec2D EventSimulator::velocityAt(int index, double at) const
+{
+	const EventBall &ball = balls[index];
+	return ball.velocity + ball.acceleration * (at - ball.time);
+}
+
+//Move a ball along its current parabola to a time, which becomes the start of its parabola
+void EventSimulator::moveTo(int index, double at)
+{
+	EventBall &ball = balls[index];
+	ball.position = positionAt(index, at);
+	ball.velocity = velocityAt(index, at);
+	ball.time = at;
+}
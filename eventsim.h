@@ -0,0 +1,141 @@
+/* Program name: eventsim.h
+*  Author: Cory Knoll
+*  Date Last Modified: 10/17/2026
+*  Description: Event-driven simulation of a world's balls: between contacts every ball follows an exact parabola, so the simulation jumps from one predicted collision to the next instead of stepping frame by frame, for headless batch runs over static levels (no Qt dependency). The parabolas only meet the world's frames at whole frames, so advance() only approximates the game; play() uses them only to find the frames in which nothing is in reach and gives the game's own answers
+	================================================================
+	FUNCTIONS:
+	+ bool load(const World&) - Take the balls of a world where they are and the level's blocks, goal block and materials by reference, return false (and hold nothing) if the level has moving blocks, blocks with mass or polygon blocks
+	+ bool advance(double) - Jump from event to event over a number of frames, return true (stopping at that moment) if the playerBall hits the goal block
+	+ bool play(World&, int) - Play up to a number of frames of a world the way its frame steps would, stepping it through the frames in which a ball can reach a block or another ball and moving the balls over the rest, return true (stopping at that frame) if the playerBall hits the goal block; stops early once the playerBall leaves the level for good, and plays nothing (holding no level) on a level load() won't take
+	+ static bool isJumpable(const World&) - return whether a world's blocks all stand still and are boxes, so the simulation can jump through its frames
+	+ void store(World&) const - Put the balls of the world the simulation was loaded from where the simulation has them, with the velocities the world's frame steps give them
+	+ double getTime() const - return the frames simulated since the simulation was loaded (or played by the last play())
+	+ long long getEventCount() const - return the number of events handled since the simulation was loaded (or the frames the last play() stepped the world through)
+	+ bool isGone(int) const - return whether a ball left the level for good
+	+ Vec2D getBallPosition(int) const - return where the center of a ball is at the simulation's time
+	+ EventSimulator() - Constructor, no level held
+	- const BlockBody& getBody(int) const - return a level block, or the goal block for the index past the last level block
+	- Vec2D positionAt(int, double) const - return where the center of a ball is at a time along its current parabola
+	- Vec2D velocityAt(int, double) const - return the velocity of a ball at a time along its current parabola
+	- void moveTo(int, double) - Move a ball along its current parabola to a time, which becomes the start of its parabola
+	- void predict(int) - Find the next event of a ball from its time on (a collision, or checking in again past the horizon) and queue it
+	- bool handle(const SimEvent&) - Handle an event that is still valid, return true if the playerBall hit the goal block
+	- void hold(const World&) - Take a world's blocks, goal block and materials by reference and the bounds of its blocks
+	- int freeFrames(const World&, int) - return how many whole frames from now on (up to a most) no ball of a world can reach a block or another ball in
+	- bool isLeaving(const World&) const - return whether a world's playerBall is past the bounds of the level moving away from it, so it never comes back
+	============================================================================
+	VARIABLES:
+	- const World *world - World whose blocks, goal block and materials the simulation reads
+	- std::vector<EventBall> balls - Every ball along its current parabola (playerBall first)
+	- std::priority_queue<SimEvent, std::vector<SimEvent>, LaterEvent> events - Events predicted for the balls, earliest first
+	- std::vector<int> candidates - Scratch list of the blocks a ball's parabola can reach before its horizon
+	- double time - Frames simulated since the simulation was loaded (or played by the last play())
+	- long long eventCount - Events handled since the simulation was loaded (or frames the last play() stepped the world through)
+	- long long eventOrder - Events queued since the simulation was loaded, which orders events due at the same time
+	- double xMin, yMin, xMax, yMax - Bounds of every block of the level, past which a ball moving away never comes back
+	============================================================================
+	STRUCTS:
+	+ EventBall - one ball's parabola (where it starts, at what time, its velocity and acceleration) and what invalidates its events
+	+ SimEvent - one predicted event of a ball: when, what kind, with what, and the stamps the balls had when it was predicted
+	+ LaterEvent - orders the queue of events earliest first (and in the order they were queued at the same time)
+*/
+
+#ifndef EVENTSIM_H
+#define EVENTSIM_H
+
+#include <queue>
+#include <vector>
+#include "vec2d.h"
+#include "world.h"
+
+#define EVENT_LOOKAHEAD 20.0	//Frames ahead of a ball a prediction looks for its next event before it checks in again
+#define EVENT_BUDGET CONTACT_BUDGET	//Most events one ball handles within a frame before it's wedged where it is until something hits it
+#define EVENT_MARGIN 1e-3			//Distance past a ball's reach within which play() steps the world instead of moving the ball itself (well past CONTACT_TOLERANCE and rounding)
+
+struct EventBall
+{
+	Vec2D position;		//center of the ball at the start of its parabola
+	Vec2D velocity;		//velocity of the ball at the start of its parabola
+	Vec2D acceleration;	//acceleration along the parabola (gravity, or none while the ball is wedged)
+	double time;		//time the parabola starts at
+	double radius;		//radius of the ball
+	double invMass;		//inverse mass of the ball
+	int stamp;			//changes every time the ball's parabola changes, which invalidates the events predicted along the old one
+	bool gone;			//the ball left the level for good
+	double burstStart;	//time of the first event of the frame's worth of events counted for the ball
+	int burstCount;		//events handled for the ball since burstStart
+};
+
+struct SimEvent
+{
+	double time;		//time the event happens at
+	long long order;	//events queued before this one, which orders events due at the same time
+	int kind;			//what happens (EVENT_BLOCK, EVENT_GOAL, EVENT_BALL or EVENT_HORIZON)
+	int ball;			//ball the event was predicted for
+	int other;			//block or ball the ball collides with (-1 for none)
+	int ballStamp;		//stamp of the ball when the event was predicted
+	int otherStamp;		//stamp of the other ball when the event was predicted
+	Vec2D normal;		//normal of the block where the ball touches it
+};
+
+struct LaterEvent
+{
+	bool operator()(const SimEvent &first, const SimEvent &second) const
+	{
+		return first.time > second.time || (first.time == second.time && first.order > second.order);
+	}
+};
+
+class EventSimulator
+{
+public:
+	bool load(const World&);
+		//Take the balls of a world where they are and the level's blocks, goal block and materials by reference, return false (and hold nothing) if the level has moving blocks, blocks with mass or polygon blocks
+	bool advance(double);
+		//Jump from event to event over a number of frames, return true (stopping at that moment) if the playerBall hits the goal block
+	bool play(World&, int);
+		//Play up to a number of frames of a world the way its frame steps would, stepping it through the frames in which a ball can reach a block or another ball and moving the balls over the rest, return true (stopping at that frame) if the playerBall hits the goal block; stops early once the playerBall leaves the level for good, and plays nothing (holding no level) on a level load() won't take
+	static bool isJumpable(const World&);
+		//return whether a world's blocks all stand still and are boxes, so the simulation can jump through its frames
+	void store(World&) const;
+		//Put the balls of the world the simulation was loaded from where the simulation has them, with the velocities the world's frame steps give them
+	double getTime() const;
+		//return the frames simulated since the simulation was loaded (or played by the last play())
+	long long getEventCount() const;
+		//return the number of events handled since the simulation was loaded (or the frames the last play() stepped the world through)
+	bool isGone(int) const;
+		//return whether a ball left the level for good
+	Vec2D getBallPosition(int) const;
+		//return where the center of a ball is at the simulation's time
+	EventSimulator();
+		//Constructor, no level held
+private:
+	const BlockBody& getBody(int) const;
+		//return a level block, or the goal block for the index past the last level block
+	Vec2D positionAt(int, double) const;
+		//return where the center of a ball is at a time along its current parabola
+	Vec2D velocityAt(int, double) const;
+		//return the velocity of a ball at a time along its current parabola
+	void moveTo(int, double);
+		//Move a ball along its current parabola to a time, which becomes the start of its parabola
+	void predict(int);
+		//Find the next event of a ball from its time on (a collision, or checking in again past the horizon) and queue it
+	bool handle(const SimEvent&);
+		//Handle an event that is still valid, return true if the playerBall hit the goal block
+	void hold(const World&);
+		//Take a world's blocks, goal block and materials by reference and the bounds of its blocks
+	int freeFrames(const World&, int);
+		//return how many whole frames from now on (up to a most) no ball of a world can reach a block or another ball in
+	bool isLeaving(const World&) const;
+		//return whether a world's playerBall is past the bounds of the level moving away from it, so it never comes back
+	const World *world;			//World whose blocks, goal block and materials the simulation reads
+	std::vector<EventBall> balls;	//Every ball along its current parabola (playerBall first)
+	std::priority_queue<SimEvent, std::vector<SimEvent>, LaterEvent> events;	//Events predicted for the balls, earliest first
+	std::vector<int> candidates;	//Scratch list of the blocks a ball's parabola can reach before its horizon
+	double time;				//Frames simulated since the simulation was loaded (or played by the last play())
+	long long eventCount;		//Events handled since the simulation was loaded (or frames the last play() stepped the world through)
+	long long eventOrder;		//Events queued since the simulation was loaded, which orders events due at the same time
+	double xMin, yMin, xMax, yMax;	//Bounds of every block of the level, past which a ball moving away never comes back
+};
+
+#endif //EVENTSIM_H
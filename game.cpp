@@ -1,63 +1,112 @@
 /* Program name: game.cpp
 *  Author: Cory Knoll
-*  Date Last Modified: 5/7/2019
-*  Description: create a game window, all game objects and level (from level files), respond to user key presses, handle collisions and gameplay
+*  Date Last Modified: 10/17/2026
+*  Description: create a game window, all game objects and level (from level files), respond to user key presses, mirror the physics world into the scene and handle gameplay
 	================================================================
 	FUNCTIONS:
 	+ Game() - Contructor create/format game scene and items, initialize QTimer
-	+ ~Game() - Destructor
+	+ ~Game() - Destructor, save the replay of an unfinished level, destroy the level's items before the scene and stop the timer
+	+ bool soak(int) - Play and reset the level a number of times without showing the window, printing the resident memory every SOAK_REPORT_RESETS resets, return false if it kept growing
 	- void formatText(QGraphicsTextItem*, QString, int, QColor, int, int) - set position, color, font style and size for a text item
-	- void Game::formatRect(Block*, int, int, QColor, int, QColor, Qt::BrushStyle = Qt::SolidPattern) - set position, brush color and style, and pen color and thickness of a rect item
-	- void Game::formatEllipse(Ball*, int, int, QColor, int, QColor, Qt::BrushStyle = Qt::SolidPattern) - set position, brush color and style, and pen color and thickness of a ellipse item
-	- void buildLevel() - Set initial values to object values and create level from data file
-	- void resetLevel() - Return level to initial state
-	- void levelWon() - Handle level winning message and level advancement
+	- void paintBlock(QPainter&, const BlockData&, QColor, int, QColor, Qt::BrushStyle = Qt::SolidPattern) - paint a block with a brush color and style, and a pen color and thickness
+	- void paintPolygon(QPainter&, const PolygonData&, QColor, int, QColor, Qt::BrushStyle = Qt::SolidPattern) - paint a convex polygon block with a brush color and style, and a pen color and thickness
+	- void formatRect(Block*, QColor, int, QColor, Qt::BrushStyle = Qt::SolidPattern) - set brush color and style, and pen color and thickness of a rect item
+	- void formatEllipse(Ball*, int, int, QColor, int, QColor, Qt::BrushStyle = Qt::SolidPattern) - set position, brush color and style, and pen color and thickness of a ellipse item
+	- void buildLevel() - Set initial values to object values and create level from data file (preloaded in the background), then start preloading the next level
+	- void paintLevel(const LevelView&) - Rasterize the level's static blocks, polygon blocks and goalBlock once into the levelLayer, which every frame then draws as the background
+	- void clearLevel() - Destroy all of the level's items (which takes them out of the scene) in one operation
+	- void resetLevel() - Return level to initial state, putting the balls and the blocks with mass back and leaving the other blocks where they are
+	- void levelWon() - Handle level winning message, save the level's replay and level advancement
 	- void keyPressEvent(QKeyEvent *event) - Handle user key presses
-	- void getItemData(Block*, Block*, double&, double&, double&, double&) - extract data about the rectangle item
-	- bool collisionPossible(double, double, double, double, double, double, double, double) - return whether the trajectory puts it passing an object
-	- void setNormal(Block*, double, double, double) - set the parameters for the normal of the collision and track projected collision item and that a collision happened
-	- void collisionDetect(Block*, double, double, double, double, double) - detect any collisions and set normal appropriately
-	- void collisionHandler(double) - Detect and identify collisions and resolve them appropriately
-	- bool linesCross(double, double, double, double, double, double, double, double) const - Determines if two line segments cross one another
-	- bool lineCornerCollide(double, double, double, double, double, double, double, double&) const - /Determines if a line comes within a radius of a corner point
+	- void showFlightControls() - Show the controls available while the ball is in flight, with the current time scale
+	- void takeSnapshot() - Push the game's flags and the world's state onto the rewind ring as the newest frame
+	- void rewindFrame() - Pause the game and step it back one frame, as far back as the rewind ring goes
+	- void retryFromHere() - Go back to aiming from the frame the game is at, the balls staying where they are and the aim that got them there
+	- void updateLaunchGuide() - Point the pathLine and vText at the current angle and magnitude, and redraw the predicted path of the shot
+	- void startClock() - Start the timer and restart the physics clock without counting the time the game was paused
+	- void syncScene(double) - Mirror the world into the scene, blended between the states before and after the last physics step
+	- size_t residentBytes() const - return the memory the process has resident, 0 where it can't be read
+	- void paintEvent(QPaintEvent*) - Paint the scene, timing the paint as a section of the frame profiler
+	- void drawBackground(QPainter*, const QRectF&) - Draw the background color and the part of the levelLayer that's being repainted
+	- void showProfile() - Show the profiler's averages over the latest PROFILE_HUD_FRAMES frames in the overlay (PROFILING builds only)
 	============================================================================
 	VARIABLES:
 	- QGraphicsScene *scene - The scene upon which items exist (part of QT framework)
 	- Ball *playerBall - The player's ball that they launch
-	- Block *goalBlock - The Block that you're trying to hit
-	- std::vector<Block*> levelBlocks - The Blocks that make up the obstacles of the level
+	- std::vector<Ball*> levelBalls - The level's other balls, which the playerBall can knock around
+	- std::vector<Block*> levelMovers - The level's blocks that move along paths
+	- std::vector<Block*> levelDynamicBlocks - The level's blocks with mass, which fall and get pushed around (with the moving blocks, the only blocks that are items)
+	- QPixmap levelLayer - The level's blocks and goalBlock (which never move) painted once, drawn under the scene's items instead of being items themselves
 	- QGraphicsLineItem *pathLine - The line showing the current direction and magnitude of the launch
+	- QGraphicsPathItem *trajectoryPath - The predicted path of the shot being aimed, bounces included (green if it hits the goal)
+	- std::vector<Vec2D> trajectoryPoints - Centers of the playerBall along the predicted path, one per physics step
 	- VelocityText *vText - The text displaying the velocity information
 	- QGraphicsTextItem *cText - The test displaying the controls information
-	- QTimer *timer - The timer that advances the frame of the simulation/game
-	- Vec2D normal - The normal of a collision
-	- Block *collItem - Item that is to be hit by playerBall's trajectory
+	- QTimer *timer - The timer that renders the scene and advances the physics clock
+	- QElapsedTimer clock - Wall-clock time since the physics clock was started
+	- qint64 lastTick - Wall-clock time (ns) of the last timer tick
+	- double accumulator - Physics steps owed to the wall clock but not run yet (the fraction is how far the scene is between two steps)
+	- double timeScale - Speed of the simulation relative to real time (slow motion < 1 < fast forward)
+	- std::vector<double> previousX - x coordinates of the centers of the balls before the last physics step
+	- std::vector<double> previousY - y coordinates of the centers of the balls before the last physics step
+	- std::vector<BlockBody> previousBlocks - The blocks with mass before the last physics step
+	- LevelArena levelItems - Memory of the level's scene items, all destroyed together when the level is cleared and reused by the next one
+	- MappedLevel levelMap - The compiled level file of the current level, mapped for as long as the world uses its records
+	- LevelPreloader preloader - Reads and indexes the next level on a worker thread while the current one is played
+	- World world - The headless physics world simulating the level, mirrored into the scene items
+	- ReplayRecorder recorder - Records the inputs of the level being played (and keyframes of its simulation) for its replay file
+	- SnapshotRing rewind - The latest REWIND_FRAMES frames of the level, to step back through and retry from
+	- bool rewoundFlag - The game was rewound while paused, so resuming it is recorded as a restore of the simulation
 	- bool launchedFlag - Flag to determine if game has begun
-	- bool projectedCollision - A collision will occur along projected trajectory
-	- bool goalBlockCollision - projected collision is with the goalblock
-	- double subPortion - The portion of the current trajorectory until the playerBall collides with an object
 	- double magnitude - Magnitude of the launch velocity
 	- int angle - Angle of the launch velocity
 	- int currentLevel - Level currently playing.
+	- QGraphicsTextItem *profileText - Overlay of the frame profiler beside vText, toggled with [P] (PROFILING builds only)
 	==========================================================================
 	SLOT:
-	+ void detectAndMove() - Listens to timer, advances movement and collisions
+	+ void detectAndMove() - Listens to timer, runs the physics steps owed to the wall clock and renders the scene
 */
 
 #include <QGraphicsScene>
 #include <QApplication>
 #include <QGraphicsView>
 #include <QKeyEvent>
+#include <QElapsedTimer>
 #include <QTimer>
 #include <QDebug>
+#include <QPainterPath>
 #include <QPainter>
+#include <QPolygonF>
 #include <QMessageBox>
+#include <algorithm>
 #include <iostream>
-#include <fstream>
 #include "game.h"
+#include "trajectory.h"
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#include <psapi.h>
+#elif defined(__linux__)
+#include <cstdio>
+#include <unistd.h>
+#endif
 
 #define MAX_PATH_LENGTH 80
 #define MAX_VELOCITY 50.0
+#define PHYSICS_STEP_MS 29.0	//Length of one physics step (the interval the timer used to step at, written as the octal literal 0035)
+#define RENDER_INTERVAL_MS 16	//Interval of the timer that renders the scene and advances the physics clock
+#define MAX_TICK_MS 100.0		//Most wall-clock time a single tick catches up on, so a stall can't snowball into ever longer catch-ups
+#define MIN_TIME_SCALE 0.125	//Slowest slow motion
+#define MAX_TIME_SCALE 8.0		//Fastest fast forward
+#define PREVIEW_STEPS 100		//Physics steps the predicted path of a shot covers (about three seconds of play)
+#define PREVIEW_BUDGET_MS 1.0	//Most time predicting the path of a shot may take, however large the level (the path is cut short there)
+#define SOAK_FRAMES 60			//Physics steps every shot of a soak test is played for before the reset
+#define SOAK_REPORT_RESETS 1000	//Resets of a soak test between two reports of the resident memory (the first report is the baseline)
+#define SOAK_SLACK 1048576		//Bytes the resident memory may grow past the baseline by the end of a soak test
+#define REWIND_FRAMES 300		//Physics steps the game can be rewound by (about nine seconds of play)
+#define PROFILE_HUD_FRAMES 30	//Frames the profiler overlay averages over, and redraws after
 
 //set position, color, font style and size for a text item
 void Game::formatText(QGraphicsTextItem * textItem, QString fontName, int fontSize, QColor color, int xPos, int yPos)
@@ -68,10 +117,28 @@ void Game::formatText(QGraphicsTextItem * textItem, QString fontName, int fontSi
 	textItem->setZValue(100);
 }
 
-//set position, brush color and style, and pen color and thickness of a rect item
-void Game::formatRect(Block * item, int xPos, int yPos, QColor penColor, int thickness, QColor brushColor, Qt::BrushStyle pattern)
+//paint a block with a brush color and style, and a pen color and thickness
+void Game::paintBlock(QPainter &painter, const BlockData &block, QColor penColor, int thickness, QColor brushColor, Qt::BrushStyle pattern)
+{
+	painter.setPen(QPen(penColor, thickness));
+	painter.setBrush(QBrush(brushColor, pattern));
+	painter.drawRect(QRectF(block.x, block.y, block.width, block.height));
+}
+
+//paint a convex polygon block with a brush color and style, and a pen color and thickness
+void Game::paintPolygon(QPainter &painter, const PolygonData &polygon, QColor penColor, int thickness, QColor brushColor, Qt::BrushStyle pattern)
+{
+	QPolygonF corners;
+	for (int i = 0; i < polygon.pointCount; i++)
+		corners << QPointF(polygon.x[i], polygon.y[i]);
+	painter.setPen(QPen(penColor, thickness));
+	painter.setBrush(QBrush(brushColor, pattern));
+	painter.drawPolygon(corners);
+}
+
+//set brush color and style, and pen color and thickness of a rect item
+void Game::formatRect(Block * item, QColor penColor, int thickness, QColor brushColor, Qt::BrushStyle pattern)
 {
-	item->setPos(xPos, yPos);
 	item->setPen(QPen(penColor, thickness));
 	item->setBrush(QBrush(brushColor, pattern));
 }
@@ -84,113 +151,183 @@ void Game::formatEllipse(Ball * item, int xPos, int yPos, QColor penColor, int t
 	item->setBrush(QBrush(brushColor, pattern));
 }
 
-//Set initial values to object values and create level from data file
+//Set initial values to object values and create level from data file (preloaded in the background), then start preloading the next level
 void Game::buildLevel()
 {
-	//open file with level data
-	std::ifstream levelFile;
-	std::string fileName;
-	fileName = "lvl" + std::to_string(currentLevel) + ".txt";
-	levelFile.open(fileName);
-
-	//check if file successfully opened, then build level based on contained data
-	if (levelFile.is_open())
+	//take the level the preloader read (from the compiled level file if there is a valid one, otherwise the level data file) and
+	//indexed in the background; the first level wasn't requested before, so it's read now. Then build level based on contained data
+	LevelView level;
+	if (preloader.take(currentLevel, world, levelMap, level))
 	{
-		//create local variables, set initial values of of angle and and magnitude, reset launched flag
-		double x1, y1, width, height, rad, invMass;
+		//set initial values of of angle and and magnitude, reset launched flag
 		angle = 0;
 		magnitude = MAX_VELOCITY / 2;
 		launchedFlag = false;
+		accumulator = 0;
 
 		//create velocity text and control text and format them
-		vText = new VelocityText(angle, magnitude);
-		cText = new QGraphicsTextItem(QString(u8"Controls:   [\u2191][\u2193] \u00b1power   [\u2190][\u2192] \u00b1angle   [Space] launch ball"));
+		vText = levelItems.create<VelocityText>(angle, magnitude);
+		cText = levelItems.create<QGraphicsTextItem>(QString(u8"Controls:   [\u2191][\u2193] \u00b1power   [\u2190][\u2192] \u00b1angle   [Space] launch ball"));
 		formatText(cText, "times", 16, Qt::blue, 15, 560);
 
-		//read playerBall data, create playerBall and pathline, and format them
-		levelFile >> x1 >> y1 >> rad >> invMass;
-		playerBall = new Ball(0, 0, rad, invMass);
-		formatEllipse(playerBall, x1 - rad, y1 - rad, Qt::darkBlue, 3, Qt::blue, Qt::Dense3Pattern);
-		pathLine = new QGraphicsLineItem(playerBall->x()+rad, playerBall->y()+rad, playerBall->x() +rad + MAX_PATH_LENGTH / 2 + 5 + rad, playerBall->y() +rad);
+		//the level is already loaded into the physics world, create the items that mirror it in the scene
+		//create playerBall and pathline, and format them
+		double rad = level.playerBall->radius;
+		playerBall = levelItems.create<Ball>(&world, 0);
+		formatEllipse(playerBall, level.playerBall->x - rad, level.playerBall->y - rad, Qt::darkBlue, 3, Qt::blue, Qt::Dense3Pattern);
+		pathLine = levelItems.create<QGraphicsLineItem>(playerBall->x()+rad, playerBall->y()+rad, playerBall->x() +rad + MAX_PATH_LENGTH / 2 + 5 + rad, playerBall->y() +rad);
 		pathLine->setPen(QPen(Qt::white, 3));
+		trajectoryPath = levelItems.create<QGraphicsPathItem>();
 
-		//read goalBlock data and create goalBlock and format it
-		levelFile >> x1 >> y1 >> width >> height >> invMass;
-		goalBlock = new Block(0, 0, width, height);
-		formatRect(goalBlock, x1, y1, Qt::darkGreen, 3, Qt::green, Qt::Dense5Pattern);
+		//create the levelBalls and format them (ball 0 in the world is the playerBall, the level's other balls follow it)
+		for (int i = 0; i < level.ballCount; i++)
+		{
+			const BallData &data = level.balls[i];
+			levelBalls.push_back(levelItems.create<Ball>(&world, i + 1));
+			formatEllipse(levelBalls.back(), data.x - data.radius, data.y - data.radius, Qt::darkRed, 3, Qt::red, Qt::Dense3Pattern);
+		}
 
-		//read each line from the rest of the level data file and use it to create the levelBlocks and format them
-		for (int i = 0; levelFile.get() != EOF; i++)
+		//the blocks and goalBlock never move, so they aren't items: they're painted once into the level's layer. Only the blocks
+		//moving along paths and the blocks with mass are items, placed by the world
+		paintLevel(level);
+		for (int i = 0; i < world.getMoverCount(); i++)
 		{
-			levelFile >> x1 >> y1 >> width >> height >> invMass;
-			levelBlocks.push_back(new Block(0, 0, width, height));
-			if(i < 4)
-				formatRect(levelBlocks.back(), x1, y1, Qt::darkGray, 3, Qt::darkGray);
-			else
-				formatRect(levelBlocks.back(), x1, y1, Qt::darkGray, 3, Qt::gray);
+			levelMovers.push_back(levelItems.create<Block>(&world, i));
+			formatRect(levelMovers.back(), Qt::darkGray, BLOCK_OUTLINE_WIDTH, Qt::darkGray, Qt::Dense3Pattern);
+		}
+		for (int i = 0; i < (int)world.getDynamicBlocks().size(); i++)
+		{
+			levelDynamicBlocks.push_back(levelItems.create<Block>(&world, i, true));
+			formatRect(levelDynamicBlocks.back(), Qt::darkGray, BLOCK_OUTLINE_WIDTH, Qt::gray, Qt::Dense2Pattern);
 		}
-		levelFile.close();
 
 		//add newly created items to scene
 		scene->addItem(vText);
 		scene->addItem(cText);
 		scene->addItem(pathLine);
+		scene->addItem(trajectoryPath);
 		scene->addItem(playerBall);
-		scene->addItem(goalBlock);
-		for (auto &i : levelBlocks)
+		for (auto &i : levelBalls)
 			scene->addItem(i);
+		for (auto &i : levelMovers)
+			scene->addItem(i);
+		for (auto &i : levelDynamicBlocks)
+			scene->addItem(i);
+		updateLaunchGuide();
+
+		//the world is at the level's start: everything played from here on is recorded, to be saved as the level's replay, and the
+		//latest frames are kept to rewind through (the ring is only reallocated when this level's balls need bigger slots)
+		recorder.begin(currentLevel, world);
+		rewind.reset(REWIND_FRAMES, world);
+		rewoundFlag = false;
+
+		//read and index the next level while this one is played, so winning this one doesn't wait on reading the next
+		preloader.request(currentLevel + 1);
 	}
 	//filename matched none, last level cleared, game over
 	else
 	{
-		cText = new QGraphicsTextItem(QString("GAME OVER"));
+		cText = levelItems.create<QGraphicsTextItem>(QString("GAME OVER"));
 		formatText(cText, "times", 36, Qt::blue, 225, 245);
 		scene->addItem(cText);
 	}
 }
 
-//Return level to initial state
-void Game::resetLevel()
+//Rasterize the level's static blocks, polygon blocks and goalBlock once into the levelLayer, which every frame then draws as the background
+void Game::paintLevel(const LevelView &level)
 {
-	//pause gameplay
-	timer->stop();
+	//a block is painted the way its rect item was (the outline centered on its edge, the goalBlock under the blocks), so the level
+	//looks the same, but it's painted once per level rather than every frame, and a frame only copies the part of the layer that
+	//something moved over. Blocks wholly outside the scene can't be seen and are skipped, which keeps huge levels quick to build
+	QRectF area = scene->sceneRect().adjusted(-BLOCK_OUTLINE_WIDTH, -BLOCK_OUTLINE_WIDTH, BLOCK_OUTLINE_WIDTH, BLOCK_OUTLINE_WIDTH);
+	levelLayer = QPixmap((int)scene->sceneRect().width(), (int)scene->sceneRect().height());
+	levelLayer.fill(Qt::transparent);
+	QPainter painter(&levelLayer);
+	paintBlock(painter, *level.goalBlock, Qt::darkGreen, BLOCK_OUTLINE_WIDTH, Qt::green, Qt::Dense5Pattern);
+	for (int i = 0; i < level.blockCount; i++)
+	{
+		const BlockData &data = level.blocks[i];
+		if (data.invMass > 0 || !area.intersects(QRectF(data.x, data.y, data.width, data.height)))
+			continue;
+		if (i < 4)
+			paintBlock(painter, data, Qt::darkGray, BLOCK_OUTLINE_WIDTH, Qt::darkGray);
+		else
+			paintBlock(painter, data, Qt::darkGray, BLOCK_OUTLINE_WIDTH, Qt::gray);
+	}
 
-	//remove all items from the scene
-	for (auto &i : levelBlocks)
-		scene->removeItem(i);
-	scene->removeItem(playerBall);
-	scene->removeItem(goalBlock);
-	scene->removeItem(vText);
-	scene->removeItem(cText);
-	scene->removeItem(pathLine);
+	//polygon blocks (rotated boxes among them) are painted with the same outline and fill as the other obstacles
+	for (int i = 0; i < level.polygonCount; i++)
+		paintPolygon(painter, level.polygons[i], Qt::darkGray, BLOCK_OUTLINE_WIDTH, Qt::gray);
+	painter.end();
 
-	//properly delete all pointers
+	//the view keeps the background it last drew, which has the previous level's blocks in it
+	resetCachedContent();
+}
+
+//Destroy all of the level's items (which takes them out of the scene) in one operation
+void Game::clearLevel()
+{
+	//every item of the level was created in the level's arena: releasing it destroys them all (a destroyed item takes itself out of
+	//the scene) and keeps their memory for the next level, so playing level after level never grows the process
+	levelItems.release();
+	levelLayer = QPixmap();
 	playerBall = nullptr;
-	goalBlock = nullptr;
 	vText = nullptr;
 	cText = nullptr;
 	pathLine = nullptr;
-	delete playerBall;
-	delete goalBlock;
-	delete vText;
-	delete cText;
-	delete pathLine;
+	trajectoryPath = nullptr;
 
-	//Clear levelBlocks vector
-	levelBlocks.clear();
+	//Clear levelBalls, levelMovers and levelDynamicBlocks vectors
+	levelBalls.clear();
+	levelMovers.clear();
+	levelDynamicBlocks.clear();
+}
 
-	buildLevel();
+//Return level to initial state, putting the balls and the blocks with mass back and leaving the other blocks where they are
+void Game::resetLevel()
+{
+	//pause gameplay
+	timer->stop();
+
+	//the world restores its balls and blocks with mass from the state the level was loaded with and its moving blocks with the time;
+	//the static blocks, their layer and the index over them are never touched, so a reset takes the same time however large the level is
+	world.restart();
+	recorder.reset();
+	rewind.clear();
+	rewoundFlag = false;
+	accumulator = 0;
+	playerBall->syncPosition();
+	for (auto &i : levelBalls)
+		i->syncPosition();
+	for (auto &i : levelMovers)
+		i->syncPosition();
+	for (auto &i : levelDynamicBlocks)
+		i->syncPosition();
+
+	//back to aiming: set initial values of of angle and and magnitude, reset launched flag, bring back the launch guide and controls
+	angle = 0;
+	magnitude = MAX_VELOCITY / 2;
+	launchedFlag = false;
+	cText->setPlainText(QString(u8"Controls:   [\u2191][\u2193] \u00b1power   [\u2190][\u2192] \u00b1angle   [Space] launch ball"));
+	formatText(cText, "times", 16, Qt::blue, 15, 560);
+	scene->addItem(pathLine);
+	scene->addItem(trajectoryPath);
+	scene->addItem(vText);
+	updateLaunchGuide();
 }
 
-//Handle level winning message and level advancement
+//Handle level winning message, save the level's replay and level advancement
 void Game::levelWon()
 {
 	QMessageBox winnerMessageBox;
 	winnerMessageBox.setText(QString::fromStdString("Level " + std::to_string(currentLevel) + " completed!!!"));
 	winnerMessageBox.setWindowTitle("WINNER");
+	recorder.save(replayFileName(currentLevel));
 	winnerMessageBox.exec();
 	currentLevel++;
-	resetLevel();
+	timer->stop();
+	clearLevel();
+	buildLevel();
 }
 
 //Handle user key presses
@@ -200,9 +337,30 @@ void Game::keyPressEvent(QKeyEvent *event)
 	//	Left/Right: ++/-- angle by 1 degree (0-360)
 	//	Up/Down: ++/-- magnitude by 1% power (0-100)
 	//	Space: set ball velocity, remove guideline, and launch ball
+	//In PROFILING builds, whether or not the ball is launched:
+	//	P: show/hide the profiler overlay
+	//	T: write the profiler's latest frames to profile.csv and profile_trace.json (open it in chrome://tracing or Perfetto)
 	//If ball is launched:
 	//	Space: pause/unpause timer
+	//	Backspace: pause and step back one frame
+	//	Enter: go back to aiming from the current frame
 	//	R: reset level
+	//Once the game is over there is no ball left to aim or launch
+	if (!playerBall)
+		return;
+#ifdef PROFILING
+	if (event->key() == Qt::Key_P)
+	{
+		profileText->setVisible(!profileText->isVisible());
+		return;
+	}
+	if (event->key() == Qt::Key_T)
+	{
+		Profiler::instance().writeCsv("profile.csv");
+		Profiler::instance().writeTrace("profile_trace.json");
+		return;
+	}
+#endif
 	if (!launchedFlag)
 	{
 		if (event->key() == Qt::Key_Left)
@@ -216,213 +374,201 @@ void Game::keyPressEvent(QKeyEvent *event)
 		else if (event->key() == Qt::Key_Space)
 		{
 			launchedFlag = true;
-			playerBall->setVelocity(magnitude*cos(angle*3.14159 / 180), magnitude*sin(angle*3.14159 / 180));
+			Vec2D velocity = Vec2D(cos(angle * 3.14159 / 180), sin(angle * 3.14159 / 180)) * magnitude;
+			playerBall->setVelocity(velocity.x, velocity.y);
+			recorder.launch(angle, magnitude);
+			takeSnapshot();
 			scene->removeItem(pathLine);
+			scene->removeItem(trajectoryPath);
 			scene->removeItem(vText);
-			cText->setPlainText("CONTROLS   [Space] Pause/Resume   [R] Reset Level");
-			formatText(cText, "time", 16, Qt::blue, 80, 560);
-			timer->start(0035);
+			showFlightControls();
+			startClock();
 		}
 		if (magnitude > MAX_VELOCITY)
 			magnitude = MAX_VELOCITY;
 		if (magnitude < 0)
 			magnitude = 0;
 
-		//update vText and pathLine
-		pathLine->setLine(playerBall->x() + playerBall->getRadius(), playerBall->y() + playerBall->getRadius(),
-			playerBall->x() + playerBall->getRadius() + (magnitude + 10) * MAX_PATH_LENGTH / MAX_VELOCITY * cos(angle * 3.14159 / 180),
-			playerBall->y() + playerBall->getRadius() + (magnitude + 10) * MAX_PATH_LENGTH / MAX_VELOCITY * sin(angle * 3.14159 / 180));
-		vText->update();
+		//update vText, pathLine and the predicted path (unless the ball was just launched, the prediction starts from the level's start)
+		if (!launchedFlag)
+			updateLaunchGuide();
 	}
 	else
 		if (event->key() == Qt::Key_Space)
 			if (timer->isActive())
+			{
 				timer->stop();
+				recorder.pause();
+			}
 			else
-				timer->start(0035);
+			{
+				//the frames after a rewound one are played again from the snapshot, which the replay can't tell from its inputs
+				startClock();
+				recorder.resume();
+				if (rewoundFlag)
+					recorder.restore(world);
+				rewoundFlag = false;
+			}
+		else if (event->key() == Qt::Key_Backspace)
+			rewindFrame();
+		else if (event->key() == Qt::Key_Return || event->key() == Qt::Key_Enter)
+			retryFromHere();
 		else if (event->key() == Qt::Key_R)
 			resetLevel();
+		else if (event->key() == Qt::Key_Plus || event->key() == Qt::Key_Equal)
+		{
+			timeScale = std::min(2 * timeScale, MAX_TIME_SCALE);
+			showFlightControls();
+		}
+		else if (event->key() == Qt::Key_Minus)
+		{
+			timeScale = std::max(timeScale / 2, MIN_TIME_SCALE);
+			showFlightControls();
+		}
 }
 
-void Game::getItemData(Block *rectItem, Block *retItem, double &xMin, double &yMin, double &xMax, double &yMax)
+//Show the controls available while the ball is in flight, with the current time scale
+void Game::showFlightControls()
 {
-	retItem = rectItem;
-	xMin = rectItem->x();
-	yMin = rectItem->y();
-	xMax = rectItem->boundingRect().width() - 1 + rectItem->x();
-	yMax = rectItem->boundingRect().height() - 1 + rectItem->y();
+	cText->setPlainText(QString("CONTROLS   [Space] Pause   [Bksp] Rewind   [Enter] Retry Here   [R] Reset   [-][+] Speed x%1").arg(timeScale));
+	formatText(cText, "time", 16, Qt::blue, 15, 560);
 }
 
-//return whether the trajectory puts it passing an object
-bool Game::collisionPossible(double centerX, double centerY, double xTrajectory, double yTrajectory, double xMin, double yMin, double xMax, double yMax)
+//Push the game's flags and the world's state onto the rewind ring as the newest frame
+void Game::takeSnapshot()
 {
-	double leftBorder = xMin - playerBall->getRadius();
-	double rightBorder = xMax + playerBall->getRadius();
-	double topBorder = yMin - playerBall->getRadius();
-	double bottomBorder = yMax + playerBall->getRadius();
-	double endX = centerX + xTrajectory;
-	double endY = centerY + yTrajectory;
-	return !((centerX < leftBorder && endX < leftBorder) || (centerX > rightBorder && endX > rightBorder) || (centerY < topBorder && endY < topBorder) || (centerY > bottomBorder && endY > bottomBorder));
+	SnapshotHeader header = { currentLevel, recorder.getFrame(), angle, launchedFlag ? 1 : 0, magnitude };
+	rewind.push(header, world);
 }
 
-//set the parameters for the normal of the collision and track projected collision item and that a collision happened
-void Game::setNormal(Block* hitItem, double x, double y, double setSubPortion)
+//Pause the game and step it back one frame, as far back as the rewind ring goes
+void Game::rewindFrame()
 {
-	projectedCollision = true;
-	goalBlockCollision = false;
-	collItem = hitItem;
-	normal.setXY(x, y);
-	subPortion = setSubPortion;
-}
+	if (timer->isActive())
+	{
+		timer->stop();
+		recorder.pause();
+	}
 
-//detect any collisions and set normal appropriately
-void Game::collisionDetect(Block *item, double portion, double xMin, double yMin, double xMax, double yMax)
-{
-	double centerX = playerBall->x() + playerBall->getRadius();	//x value of the center point of the playerBall object
-	double centerY = playerBall->y() + playerBall->getRadius();	//y value of the center point of the playerBall object
-	double leftBorder = xMin - playerBall->getRadius();			//imaginary border wall along the left side of the block one radius away
-	double rightBorder = xMax + playerBall->getRadius();		//imaginary border wall along the right side of the block one radius away
-	double topBorder = yMin - playerBall->getRadius();			//imaginary border wall along the top of the block one radius away
-	double bottomBorder = yMax + playerBall->getRadius();		//imaginary border wall along the bottom of the block one radius away
-	double endX, endY;											//coordinates for the endpoints of projected movement
-	double xTrajectory, yTrajectory;							//x and y components of playerBall's velocity along it's current trajectory
-	double tmpSubPortion;										//temporary measurment of subportion to collision (set to subPortion if determined to be smaller)
-
-	//get trajectory of the playerBall for the remainder of the frame
-	playerBall->getVelocity().getVectorComponents(xTrajectory, yTrajectory);
-	xTrajectory *= portion;
-	yTrajectory *= portion;
-	endX = centerX + xTrajectory;
-	endY = centerY + yTrajectory;
-
-	//Only check for collision if trajectory puts the ball past the minimum and/or maximum bounds of the block (i.e. if the ball before and after moving are still on the same side of the block, it can't have collided with it)
-	if (collisionPossible(centerX, centerY, xTrajectory, yTrajectory, xMin, yMin, xMax, yMax))
-		//The following 4 if statements test to see if the ball crosses an edge of the block from the outside,
-		//that it's not in contact already, and that the distance to the collision is less than the distance to any previous collisions in this order:
-		//1. from the left, 2. from the top, 3. from the right, and 4. from the bottom (NOTE: coordinates on the y axis increase downward in QT framework)
-		if (linesCross(centerX, centerY, endX, endY, leftBorder, yMin, leftBorder, yMax)
-			&& centerX < leftBorder
-			&& (leftBorder - centerX) / xTrajectory <= subPortion)
-			setNormal(item, -1, 0, (leftBorder - centerX) / xTrajectory);
-		else if (linesCross(centerX, centerY, endX, endY, xMin, topBorder, xMax, topBorder)
-			&& centerY < topBorder
-			&& (topBorder - centerY) / yTrajectory <= subPortion)
-			setNormal(item, 0, -1, (topBorder - centerY) / yTrajectory);
-		else if (linesCross(centerX, centerY, endX, endY, rightBorder, yMin, rightBorder, yMax)
-			&& centerX > rightBorder
-			&& (rightBorder - centerX) / xTrajectory <= subPortion)
-			setNormal(item, 1, 0, (rightBorder - centerX) / xTrajectory);
-		else if (linesCross(centerX, centerY, endX, endY, xMin, bottomBorder, xMax, bottomBorder)
-			&& centerY > bottomBorder
-			&& (bottomBorder - centerY) / yTrajectory <= subPortion)
-			setNormal(item, 0, 1, (bottomBorder - centerY) / yTrajectory);
-	//The following 4 statements test to see if the ball crosses a corner of the block from the outside,
-	//that it's not in contact already, and that the distance to the collision is less than the distance to any previous collisions in this order:
-	//1. on the top-left, 2. on the top-right, 3. on the bottom-left, 4. on the bottom-right (NOTE: Again, coordinates on the y axis increase downward in QT framework)
-		else if (lineCornerCollide(centerX, centerY, endX, endY, xMin, yMin, playerBall->getRadius(), tmpSubPortion)
-			&& centerX < xMin && centerY < yMin
-			&& tmpSubPortion < subPortion)
-			setNormal(item, (centerX + tmpSubPortion * xTrajectory - xMin) / playerBall->getRadius(), (centerY + tmpSubPortion * yTrajectory - yMin) / playerBall->getRadius(), tmpSubPortion);
-		else if (lineCornerCollide(centerX, centerY, endX, endY, xMax, yMin, playerBall->getRadius(), tmpSubPortion)
-			&& centerX > xMax && centerY < yMin
-			&& tmpSubPortion < subPortion)
-			setNormal(item, (centerX + tmpSubPortion * xTrajectory - xMax) / playerBall->getRadius(), (centerY + tmpSubPortion * yTrajectory - yMin) / playerBall->getRadius(), tmpSubPortion);
-		else if (lineCornerCollide(centerX, centerY, endX, endY, xMin, yMax, playerBall->getRadius(), tmpSubPortion)
-			&& centerX < xMin && centerY > yMax
-			&& tmpSubPortion < subPortion)
-			setNormal(item, (centerX + tmpSubPortion * xTrajectory - xMin) / playerBall->getRadius(), (centerY + tmpSubPortion * yTrajectory - yMax) / playerBall->getRadius(), tmpSubPortion);
-		else if (lineCornerCollide(centerX, centerY, endX, endY, xMax, yMax, playerBall->getRadius(), tmpSubPortion)
-			&& centerX > xMax && centerY > yMax
-			&& tmpSubPortion < subPortion)
-			setNormal(item, (centerX + tmpSubPortion * xTrajectory - xMax) / playerBall->getRadius(), (centerY + tmpSubPortion * yTrajectory - yMax) / playerBall->getRadius(), tmpSubPortion);
+	//the newest snapshot is the frame on screen: dropping it makes the one before it the newest, which the next step pushed after
+	//resuming follows. The launch frame is never dropped, so the ball can't be rewound out of its flight
+	if (rewind.getCount() < 2)
+		return;
+	rewind.drop(1);
+	SnapshotHeader header;
+	if (!rewind.restore(0, header, world))
+		return;
+	rewoundFlag = true;
+	accumulator = 0;
+	const BodyStore &bodies = world.getBodies();
+	previousX = bodies.x;
+	previousY = bodies.y;
+	previousBlocks = world.getDynamicBlocks();
+	syncScene(1.0);
 }
 
-//Detect and identify collisions and resolve them appropriately
-void Game::collisionHandler(double portion)
+//Go back to aiming from the frame the game is at, the balls staying where they are and the aim that got them there
+void Game::retryFromHere()
 {
-	subPortion = 1;								//percentage of the trajectory to collision for the portion of the frame remaining (e.g. subPortion = .85 means that that collision occurs 85% of the way along remaining trajectory)
-	projectedCollision = false;					//non-corner collision detected
-	goalBlockCollision = false;
-	Block *item;
-	double xMin, xMax, yMin, yMax;				//x and y coordinates of the bounds of a rectangle
-
-	//check goal block and each level block for a collision with playerBall
-	for (int i = 0; i < levelBlocks.size()+1; i++)
+	if (timer->isActive())
 	{
-		//start with goalblock first, then each levelBlock
-		if (i == 0)
-			getItemData(goalBlock, item, xMin, yMin, xMax, yMax);
-		else
-			getItemData(levelBlocks[i-1], item, xMin, yMin, xMax, yMax);
-		//detect if playerBall collides with current item, and set collision indo
-		collisionDetect(item, portion, xMin, yMin, xMax, yMax);
-		//Collision with goalblock, set goalBlockCollision to true; If another collision is detected this frame that hits first, goalBlockCollision will be set to false by setNormal()
-		if (projectedCollision && i == 0)
-			goalBlockCollision = true;
+		timer->stop();
+		recorder.pause();
 	}
 
-	//collision with side occured, move ball along subPortion of trajectory, resolve collision, then run collision detect for remaining portion
-	if (projectedCollision)
-		if (goalBlockCollision)
-			levelWon();
-		else
-		{
-			playerBall->move(subPortion*portion);
-			playerBall->collide(normal, collItem);
-			collisionHandler(portion - subPortion * portion);
-		}
-	//no collision left to resolve, finish movement for frame
-	else
-		playerBall->move(portion);
+	//the snapshot on screen holds the aim of the shot that got the balls here, a starting point to correct it from; the next launch
+	//and the prediction branch from the world's current state rather than the level's start
+	SnapshotHeader header;
+	if (rewind.restore(0, header, world))
+	{
+		angle = header.angle;
+		magnitude = header.magnitude;
+	}
+	recorder.restore(world);
+	rewoundFlag = false;
+	accumulator = 0;
+	const BodyStore &bodies = world.getBodies();
+	previousX = bodies.x;
+	previousY = bodies.y;
+	previousBlocks = world.getDynamicBlocks();
+	syncScene(1.0);
+	launchedFlag = false;
+	cText->setPlainText(QString(u8"Controls:   [\u2191][\u2193] \u00b1power   [\u2190][\u2192] \u00b1angle   [Space] launch ball"));
+	formatText(cText, "times", 16, Qt::blue, 15, 560);
+	scene->addItem(pathLine);
+	scene->addItem(trajectoryPath);
+	scene->addItem(vText);
+	updateLaunchGuide();
+}
 
+//Point the pathLine and vText at the current angle and magnitude, and redraw the predicted path of the shot
+void Game::updateLaunchGuide()
+{
+	PROFILE_SCOPE("preview");
+	Vec2D center(playerBall->x() + playerBall->getRadius(), playerBall->y() + playerBall->getRadius());
+	Vec2D end = center + Vec2D(cos(angle * 3.14159 / 180), sin(angle * 3.14159 / 180)) * ((magnitude + 10) * MAX_PATH_LENGTH / MAX_VELOCITY);
+	pathLine->setLine(center.x, center.y, end.x, end.y);
+	vText->update();
+
+	//fast-forward the shot the launch would make (the same velocity the launch sets) through the world itself, from the state it's
+	//aimed from; the one path item is given the new path rather than building new items every keypress
+	Vec2D velocity = Vec2D(cos(angle * 3.14159 / 180), sin(angle * 3.14159 / 180)) * magnitude;
+	bool hit = predictTrajectory(world, velocity, PREVIEW_STEPS, PREVIEW_BUDGET_MS / 1e3, trajectoryPoints);
+	QPainterPath predicted(QPointF(trajectoryPoints[0].x, trajectoryPoints[0].y));
+	for (size_t i = 1; i < trajectoryPoints.size(); i++)
+		predicted.lineTo(trajectoryPoints[i].x, trajectoryPoints[i].y);
+	trajectoryPath->setPath(predicted);
+	trajectoryPath->setPen(QPen(hit ? Qt::green : Qt::white, 2, Qt::DashLine));
 }
 
-//Determines if two line segments cross one another
-bool Game::linesCross(double x1, double y1, double x2, double y2, double x3, double y3, double x4, double y4) const
+//Start the timer and restart the physics clock without counting the time the game was paused
+void Game::startClock()
 {
-	double denom = (y4 - y3)*(x2 - x1) - (x4 - x3)*(y2 - y1);
-	double numerA = (x4 - x3)*(y1 - y3) - (y4 - y3)*(x1 - x3);
-	double numerB = (x2 - x1)*(y1 - y3) - (y2 - y1)*(x1 - x3);
-	if (denom == 0)
-		return numerA == 0 && numerB == 0;
-	return (numerA / denom >= 0 && numerA / denom <= 1) && (numerB / denom >= 0 && numerB / denom <= 1);
+	const BodyStore &bodies = world.getBodies();
+	previousX = bodies.x;
+	previousY = bodies.y;
+	previousBlocks = world.getDynamicBlocks();
+	clock.start();
+	lastTick = 0;
+	timer->start(RENDER_INTERVAL_MS);
 }
 
-bool Game::lineCornerCollide(double x1, double y1, double x2, double y2, double xCorner, double yCorner, double radius, double &subPortion) const
+//Mirror the world into the scene, blended between the states before and after the last physics step
+void Game::syncScene(double fraction)
 {
-	//equation of circle: (x-xCorner)^2 + (y-yCorner)^2 = radius^2
-	//equation of line: y = ((y1-y2)/(x1-x2))*x + y1 - ((y1-y2)/(x1-x2))*x1
-	//equation for intersection: (x-xCorner)^2 + (((y1-y2)/(x1-x2))*x+y1-((y1-y2)/(x1-x2))*x1-yCorner)^2 = radius^2
-	//                 expanded: [(pow(((y1 - y2) / (x1 - x2)), 2) + 1)*x^2]  +  [(2 * (((y1 - y2) / (x1 - x2)) * (y1 - ((y1 - y2) / (x1 - x2))*x1 - yCorner) - xCorner))*x]  +  [pow(xCorner, 2) + pow((y1 - yCorner - ((y1 - y2) / (x1 - x2))*x1), 2) - pow(radius, 2)] = 0
-	//quadratic 1: (2 * (((y1 - y2) / (x1 - x2)) * (y1 - ((y1 - y2) / (x1 - x2))*x1 - yCorner) - xCorner))+sqrt((2 * (((y1 - y2) / (x1 - x2)) * (y1 - ((y1 - y2) / (x1 - x2))*x1 - yCorner) - xCorner))^2-4*(pow(((y1 - y2) / (x1 - x2)), 2) + 1)*(pow(xCorner, 2) + pow((y1 - yCorner - ((y1 - y2) / (x1 - x2))*x1), 2) - pow(radius, 2)))/(2*(pow(((y1 - y2) / (x1 - x2)), 2) + 1))
-	//quadratic 2: (2 * (((y1 - y2) / (x1 - x2)) * (y1 - ((y1 - y2) / (x1 - x2))*x1 - yCorner) - xCorner))-sqrt((2 * (((y1 - y2) / (x1 - x2)) * (y1 - ((y1 - y2) / (x1 - x2))*x1 - yCorner) - xCorner)))^2-4*(pow(((y1 - y2) / (x1 - x2)), 2) + 1)*(pow(xCorner, 2) + pow((y1 - yCorner - ((y1 - y2) / (x1 - x2))*x1), 2) - pow(radius, 2))))/(2*(pow(((y1 - y2) / (x1 - x2)), 2) + 1))
-	double A = pow(((y1 - y2) / (x1 - x2)), 2) + 1;
-	double B = 2 * (((y1 - y2) / (x1 - x2)) * (y1 - ((y1 - y2) / (x1 - x2))*x1 - yCorner) - xCorner);
-	double C = pow(xCorner, 2) + pow((y1 - yCorner - ((y1 - y2) / (x1 - x2))*x1), 2) - pow(radius, 2);
-	if (pow(B, 2) - 4 * A * C >= 0)
+	PROFILE_SCOPE("syncScene");
+	playerBall->syncPosition(previousX, previousY, fraction);
+	for (auto &i : levelBalls)
+		i->syncPosition(previousX, previousY, fraction);
+
+	//a moving block's path is a function of the time, so it's blended by going back along the path the rest of the last step
+	double time = std::max(world.getTime() - (1 - fraction), 0.0);
+	for (auto &i : levelMovers)
+		i->syncPosition(time);
+	for (auto &i : levelDynamicBlocks)
+		i->syncPosition(previousBlocks, fraction);
+}
+
+//return the memory the process has resident, 0 where it can't be read
+size_t Game::residentBytes() const
+{
+#if defined(_WIN32)
+	PROCESS_MEMORY_COUNTERS counters;
+	if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+		return counters.WorkingSetSize;
+#elif defined(__linux__)
+	//the second field of statm is the resident set in pages
+	long pages = 0, resident = 0;
+	FILE *statm = fopen("/proc/self/statm", "r");
+	if (statm)
 	{
-		double quadratic1 = (-1 * B + sqrt(pow(B, 2) - 4 * A * C)) / (2 * A);
-		double quadratic2 = (-1 * B - sqrt(pow(B, 2) - 4 * A * C)) / (2 * A);
-		if ((quadratic1 - x1) / (x2 - x1) <= 1 && (quadratic1 - x1) / (x2 - x1) > 0.001 && (quadratic2 - x1) / (x2 - x1) <= 1 && (quadratic2 - x1) / (x2 - x1) > 0.001)
-		{
-			if (abs(quadratic1 - x1) < abs(quadratic2 - x1))
-				subPortion = (quadratic1 - x1) / (x2 - x1);
-			else
-				subPortion = (quadratic2 - x1) / (x2 - x1);
-			return true;
-		}
-		else if ((quadratic1 - x1) / (x2 - x1) <= 1 && (quadratic1 - x1) / (x2 - x1) > 0.001)
-		{
-			subPortion = (quadratic1 - x1) / (x2 - x1);
-			return true;
-		}
-		else if ((quadratic2 - x1) / (x2 - x1) <= 1 && (quadratic2 - x1) / (x2 - x1) > 0.001)
-		{
-			subPortion = (quadratic2 - x1) / (x2 - x1);
-			return true;
-		}
+		if (fscanf(statm, "%ld %ld", &pages, &resident) != 2)
+			resident = 0;
+		fclose(statm);
+		return (size_t)resident * (size_t)sysconf(_SC_PAGESIZE);
 	}
-	return false;
+#endif
+	return 0;
 }
 
 //Contructor create/format game scene and items, initialize QTimer
@@ -432,10 +578,15 @@ Game::Game()
 	//connect collision detection to timer's timeout
 	timer = new QTimer();
 	QObject::connect(timer, SIGNAL(timeout()), this, SLOT(detectAndMove()));
+	playerBall = nullptr;
+	vText = nullptr;
+	cText = nullptr;
+	pathLine = nullptr;
+	trajectoryPath = nullptr;
 	currentLevel = 1;
-	buildLevel();
+	timeScale = 1;
 
-	//format widget and set scene
+	//format widget and set scene (before the level is built, which sizes the levelLayer to the scene)
 	this->setHorizontalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
 	this->setVerticalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
 	this->setFixedSize(800, 600);
@@ -443,28 +594,180 @@ Game::Game()
 	scene->setSceneRect(0, 0, this->width(), this->height());
 	scene->setBackgroundBrush(Qt::lightGray);
 
+	//the only items left in the scene are the balls, the launch guide and the text, most of them moving every frame: keeping a
+	//BSP tree of them up to date would cost more than it saves, so the scene just lists them
+	scene->setItemIndexMethod(QGraphicsScene::NoIndex);
+
+	//the background (the color and the levelLayer over it) only changes when a level is built, so the view keeps it drawn too
+	this->setCacheMode(QGraphicsView::CacheBackground);
+
+	buildLevel();
+#ifdef PROFILING
+	//the overlay outlives the levels, so it belongs to the scene rather than a level's arena
+	profileText = new QGraphicsTextItem();
+	formatText(profileText, "courier", 9, Qt::darkBlue, 560, 0);
+	scene->addItem(profileText);
+#endif
+
 
 	//Set scene as the focus of key events
 	setFocus();
 }
 
-//Destructor
+//Destructor, save the replay of an unfinished level, destroy the level's items before the scene and stop the timer
 Game::~Game()
 {
-	scene = nullptr;
-	playerBall = nullptr;
-	goalBlock = nullptr;
-	vText = nullptr;
-	cText = nullptr;
+	//a level left unfinished keeps its replay too, so a run the player gave up on can still be played back
+	if (recorder.isRecording() && recorder.getFrame() > 0)
+		recorder.save(replayFileName(currentLevel));
+
+	//a scene deletes the items still in it, which it mustn't do to items living in the level's arena
+	timer->stop();
+	delete timer;
+	clearLevel();
 	delete scene;
-	delete playerBall;
-	delete goalBlock;
-	delete vText;
-	delete cText;
 }
 
+//Play and reset the level a number of times without showing the window, printing the resident memory every SOAK_REPORT_RESETS resets, return false if it kept growing
+bool Game::soak(int resets)
+{
+	//every shot is aimed at random and played for a moment, then half of the resets restart the level in place the way [R] does and
+	//the other half clear the level and build it again the way winning does, so both paths run thousands of times
+	srand(1);
+	size_t baseline = 0;	//resident memory after the first report, once every cache and pool has warmed up
+	for (int reset = 1; reset <= resets; reset++)
+	{
+		if (playerBall)
+		{
+			angle = rand() % 360;
+			magnitude = MAX_VELOCITY * (rand() % 101) / 100;
+			QKeyEvent launch(QEvent::KeyPress, Qt::Key_Space, Qt::NoModifier);
+			keyPressEvent(&launch);
+			bool won = false;
+			for (int frame = 0; frame < SOAK_FRAMES && !won; frame++)
+			{
+				won = world.step(1.0);
+				recorder.step(world);
+				takeSnapshot();
+			}
+			syncScene(1.0);
+
+			if (won || reset % 2 == 0)
+			{
+				currentLevel += won ? 1 : 0;
+				timer->stop();
+				clearLevel();
+				buildLevel();
+			}
+			else
+			{
+				QKeyEvent restart(QEvent::KeyPress, Qt::Key_R, Qt::NoModifier);
+				keyPressEvent(&restart);
+			}
+		}
+		//past the last level: start over from the first
+		else
+		{
+			currentLevel = 1;
+			clearLevel();
+			buildLevel();
+		}
+
+		if (reset % SOAK_REPORT_RESETS == 0)
+		{
+			size_t resident = residentBytes();
+			if (reset == SOAK_REPORT_RESETS)
+				baseline = resident;
+			std::cout << "soak " << reset << " resets: level " << currentLevel << ", " << resident / 1024 << " KB resident, "
+				<< levelItems.getCapacity() / 1024 << " KB arena" << std::endl;
+		}
+	}
+	timer->stop();
+	return residentBytes() <= baseline + SOAK_SLACK;
+}
+
+//Paint the scene, timing the paint as a section of the frame profiler
+void Game::paintEvent(QPaintEvent *event)
+{
+	PROFILE_SCOPE("paint");
+	QGraphicsView::paintEvent(event);
+}
+
+//Draw the background color and the part of the levelLayer that's being repainted
+void Game::drawBackground(QPainter *painter, const QRectF &rect)
+{
+	//the layer covers the scene from its origin, so the part of the scene being repainted is the same part of the layer
+	QGraphicsView::drawBackground(painter, rect);
+	if (levelLayer.isNull())
+		return;
+	QRectF part = rect.intersected(QRectF(0, 0, levelLayer.width(), levelLayer.height()));
+	painter->drawPixmap(part, levelLayer, part);
+}
+
+#ifdef PROFILING
+//Show the profiler's averages over the latest PROFILE_HUD_FRAMES frames in the overlay
+void Game::showProfile()
+{
+	//every section's time includes the sections it calls (World::step holds findIslands, solve islands and integrate), and the
+	//sections the pool's threads run add up across threads
+	const Profiler &profiler = Profiler::instance();
+	int frames = std::min(profiler.getFrameCount(), PROFILE_HUD_FRAMES);
+	if (frames == 0)
+		return;
+	long long duration = 0, sections[PROFILE_MAX_SECTIONS] = {}, counters[PROFILE_COUNTERS] = {};
+	for (int age = 0; age < frames; age++)
+	{
+		const ProfileFrame &frame = profiler.getFrame(age);
+		duration += frame.duration;
+		for (int i = 0; i < profiler.getSectionCount(); i++)
+			sections[i] += frame.sections[i];
+		for (int i = 0; i < PROFILE_COUNTERS; i++)
+			counters[i] += frame.counters[i];
+	}
+	QString text = QString("frame %1 ms").arg(duration / 1e6 / frames, 0, 'f', 2);
+	for (int i = 0; i < profiler.getSectionCount(); i++)
+		text += QString("\n%1 %2 ms").arg(profiler.getSectionName(i)).arg(sections[i] / 1e6 / frames, 0, 'f', 3);
+	for (int i = 0; i < PROFILE_COUNTERS; i++)
+		text += QString("\n%1 %2").arg(Profiler::getCounterName(i)).arg((double)counters[i] / frames, 0, 'f', 1);
+	profileText->setPlainText(text);
+}
+#endif
+
 //Listens to timer, advances movement and collisions
 void Game::detectAndMove()
 {
-	collisionHandler(1.0);
-}
\ No newline at end of file
+#ifdef PROFILING
+	//a frame runs from one tick to the next, so it holds the paint the last tick asked for
+	Profiler::instance().endFrame();
+	if (profileText->isVisible() && Profiler::instance().getFrame(0).number % PROFILE_HUD_FRAMES == 0)
+		showProfile();
+#endif
+	PROFILE_SCOPE("detectAndMove");
+
+	//physics always steps by the same length of time however late the timer fires; the time since the last tick (capped, so a
+	//stall can't demand more steps than the next tick can run) is owed to the physics clock at the current time scale
+	qint64 now = clock.nsecsElapsed();
+	accumulator += std::min((now - lastTick) / 1e6, MAX_TICK_MS) * timeScale / PHYSICS_STEP_MS;
+	lastTick = now;
+
+	//run every whole step owed, only rendering once they're done
+	while (accumulator >= 1)
+	{
+		const BodyStore &bodies = world.getBodies();
+		previousX = bodies.x;
+		previousY = bodies.y;
+		previousBlocks = world.getDynamicBlocks();
+		accumulator -= 1;
+		bool won = world.step(1.0);
+		recorder.step(world);
+		takeSnapshot();
+		if (won)
+		{
+			levelWon();
+			return;
+		}
+	}
+
+	//the scene shows the balls the left over fraction of the way from the previous step to the current one
+	syncScene(accumulator);
+}
\ No newline at end of file
@@ -1,59 +1,93 @@
 /* Program name: game.h
 *  Author: Cory Knoll
-*  Date Last Modified: 5/7/2019
-*  Description: create a game window, all game objects and level (from level files), respond to user key presses, handle collisions and gameplay
+*  Date Last Modified: 10/17/2026
+*  Description: create a game window, all game objects and level (from level files), respond to user key presses, mirror the physics world into the scene and handle gameplay
     ================================================================
     FUNCTIONS:
 	+ Game() - Contructor create/format game scene and items, initialize QTimer
-	+ ~Game() - Destructor
+	+ ~Game() - Destructor, save the replay of an unfinished level, destroy the level's items before the scene and stop the timer
+	+ bool soak(int) - Play and reset the level a number of times without showing the window, printing the resident memory every SOAK_REPORT_RESETS resets, return false if it kept growing
 	- void formatText(QGraphicsTextItem*, QString, int, QColor, int, int) - set position, color, font style and size for a text item
-	- void Game::formatRect(Block*, int, int, QColor, int, QColor, Qt::BrushStyle = Qt::SolidPattern) - set position, brush color and style, and pen color and thickness of a rect item
-	- void Game::formatEllipse(Ball*, int, int, QColor, int, QColor, Qt::BrushStyle = Qt::SolidPattern) - set position, brush color and style, and pen color and thickness of a ellipse item
-	- void buildLevel() - Set initial values to object values and create level from data file
-	- void resetLevel() - Return level to initial state
-	- void levelWon() - Handle level winning message and level advancement
+	- void paintBlock(QPainter&, const BlockData&, QColor, int, QColor, Qt::BrushStyle = Qt::SolidPattern) - paint a block with a brush color and style, and a pen color and thickness
+	- void paintPolygon(QPainter&, const PolygonData&, QColor, int, QColor, Qt::BrushStyle = Qt::SolidPattern) - paint a convex polygon block with a brush color and style, and a pen color and thickness
+	- void formatRect(Block*, QColor, int, QColor, Qt::BrushStyle = Qt::SolidPattern) - set brush color and style, and pen color and thickness of a rect item
+	- void formatEllipse(Ball*, int, int, QColor, int, QColor, Qt::BrushStyle = Qt::SolidPattern) - set position, brush color and style, and pen color and thickness of a ellipse item
+	- void buildLevel() - Set initial values to object values and create level from data file (preloaded in the background), then start preloading the next level
+	- void paintLevel(const LevelView&) - Rasterize the level's static blocks, polygon blocks and goalBlock once into the levelLayer, which every frame then draws as the background
+	- void clearLevel() - Destroy all of the level's items (which takes them out of the scene) in one operation
+	- void resetLevel() - Return level to initial state, putting the balls and the blocks with mass back and leaving the other blocks where they are
+	- void levelWon() - Handle level winning message, save the level's replay and level advancement
 	- void keyPressEvent(QKeyEvent *event) - Handle user key presses
-	- void getItemData(Block*, Block*, double&, double&, double&, double&) - extract data about the rectangle item
-	- bool collisionPossible(double, double, double, double, double, double, double, double) - return whether the trajectory puts it passing an object
-	- void setNormal(Block*, double, double, double) - set the parameters for the normal of the collision and track projected collision item and that a collision happened
-	- void collisionDetect(Block*, double, double, double, double, double) - detect any collisions and set normal appropriately
-	- void collisionHandler(double) - Detect and identify collisions and resolve them appropriately
-	- bool linesCross(double, double, double, double, double, double, double, double) const - Determines if two line segments cross one another
-	- bool lineCornerCollide(double, double, double, double, double, double, double, double&) const - /Determines if a line comes within a radius of a corner point
+	- void showFlightControls() - Show the controls available while the ball is in flight, with the current time scale
+	- void takeSnapshot() - Push the game's flags and the world's state onto the rewind ring as the newest frame
+	- void rewindFrame() - Pause the game and step it back one frame, as far back as the rewind ring goes
+	- void retryFromHere() - Go back to aiming from the frame the game is at, the balls staying where they are and the aim that got them there
+	- void updateLaunchGuide() - Point the pathLine and vText at the current angle and magnitude, and redraw the predicted path of the shot
+	- void startClock() - Start the timer and restart the physics clock without counting the time the game was paused
+	- void syncScene(double) - Mirror the world into the scene, blended between the states before and after the last physics step
+	- size_t residentBytes() const - return the memory the process has resident, 0 where it can't be read
+	- void paintEvent(QPaintEvent*) - Paint the scene, timing the paint as a section of the frame profiler
+	- void drawBackground(QPainter*, const QRectF&) - Draw the background color and the part of the levelLayer that's being repainted
+	- void showProfile() - Show the profiler's averages over the latest PROFILE_HUD_FRAMES frames in the overlay (PROFILING builds only)
 	============================================================================
 	VARIABLES:
 	- QGraphicsScene *scene - The scene upon which items exist (part of QT framework)
 	- Ball *playerBall - The player's ball that they launch
-	- Block *goalBlock - The Block that you're trying to hit
-	- std::vector<Block*> levelBlocks - The Blocks that make up the obstacles of the level
+	- std::vector<Ball*> levelBalls - The level's other balls, which the playerBall can knock around
+	- std::vector<Block*> levelMovers - The level's blocks that move along paths
+	- std::vector<Block*> levelDynamicBlocks - The level's blocks with mass, which fall and get pushed around (with the moving blocks, the only blocks that are items)
+	- QPixmap levelLayer - The level's blocks and goalBlock (which never move) painted once, drawn under the scene's items instead of being items themselves
 	- QGraphicsLineItem *pathLine - The line showing the current direction and magnitude of the launch
+	- QGraphicsPathItem *trajectoryPath - The predicted path of the shot being aimed, bounces included (green if it hits the goal)
+	- std::vector<Vec2D> trajectoryPoints - Centers of the playerBall along the predicted path, one per physics step
 	- VelocityText *vText - The text displaying the velocity information
 	- QGraphicsTextItem *cText - The test displaying the controls information
-	- QTimer *timer - The timer that advances the frame of the simulation/game
-	- Vec2D normal - The normal of a collision
-	- Block *collItem - Item that is to be hit by playerBall's trajectory
+	- QTimer *timer - The timer that renders the scene and advances the physics clock
+	- QElapsedTimer clock - Wall-clock time since the physics clock was started
+	- qint64 lastTick - Wall-clock time (ns) of the last timer tick
+	- double accumulator - Physics steps owed to the wall clock but not run yet (the fraction is how far the scene is between two steps)
+	- double timeScale - Speed of the simulation relative to real time (slow motion < 1 < fast forward)
+	- std::vector<double> previousX - x coordinates of the centers of the balls before the last physics step
+	- std::vector<double> previousY - y coordinates of the centers of the balls before the last physics step
+	- std::vector<BlockBody> previousBlocks - The blocks with mass before the last physics step
+	- LevelArena levelItems - Memory of the level's scene items, all destroyed together when the level is cleared and reused by the next one
+	- MappedLevel levelMap - The compiled level file of the current level, mapped for as long as the world uses its records
+	- LevelPreloader preloader - Reads and indexes the next level on a worker thread while the current one is played
+	- World world - The headless physics world simulating the level, mirrored into the scene items
+	- ReplayRecorder recorder - Records the inputs of the level being played (and keyframes of its simulation) for its replay file
+	- SnapshotRing rewind - The latest REWIND_FRAMES frames of the level, to step back through and retry from
+	- bool rewoundFlag - The game was rewound while paused, so resuming it is recorded as a restore of the simulation
 	- bool launchedFlag - Flag to determine if game has begun
-	- bool projectedCollision - A collision will occur along projected trajectory
-	- bool goalBlockCollision - projected collision is with the goalblock
-	- double subPortion - The portion of the current trajorectory until the playerBall collides with an object
 	- double magnitude - Magnitude of the launch velocity
 	- int angle - Angle of the launch velocity
 	- int currentLevel - Level currently playing.
+	- QGraphicsTextItem *profileText - Overlay of the frame profiler beside vText, toggled with [P] (PROFILING builds only)
     ==========================================================================
 	SLOT:
-	+ void detectAndMove() - Listens to timer, advances movement and collisions
+	+ void detectAndMove() - Listens to timer, runs the physics steps owed to the wall clock and renders the scene
 */
 
 #ifndef GAME_H
 #define GAME_H
 
+#include <QElapsedTimer>
 #include <QGraphicsView>
+#include <QGraphicsPathItem>
 #include <QGraphicsScene>
+#include <QPainter>
+#include <QPixmap>
 #include <QString>
 #include <vector>
 #include "ball.h"
 #include "block.h"
+#include "compiledlevel.h"
+#include "levelarena.h"
+#include "levelpreloader.h"
+#include "profiler.h"
+#include "replay.h"
+#include "snapshot.h"
 #include "velocitytext.h"
+#include "world.h"
 
 class Game : public QGraphicsView
 {
@@ -62,56 +96,92 @@ public:
 	Game();
 		//Contructor create/format game scene and items, initialize QTimer
 	~Game();
-		//Destructor
+		//Destructor, save the replay of an unfinished level, destroy the level's items before the scene and stop the timer
+	bool soak(int);
+		//Play and reset the level a number of times without showing the window, printing the resident memory every SOAK_REPORT_RESETS resets, return false if it kept growing
 private:
 	void formatText(QGraphicsTextItem*, QString, int, QColor, int, int);
 		//set position, color, font style and size for a text item
-	void Game::formatRect(Block*, int, int, QColor, int, QColor, Qt::BrushStyle = Qt::SolidPattern);
-		//set position, brush color and style, and pen color and thickness of a rect item
-	void Game::formatEllipse(Ball*, int, int, QColor, int, QColor, Qt::BrushStyle = Qt::SolidPattern);
+	void paintBlock(QPainter&, const BlockData&, QColor, int, QColor, Qt::BrushStyle = Qt::SolidPattern);
+		//paint a block with a brush color and style, and a pen color and thickness
+	void paintPolygon(QPainter&, const PolygonData&, QColor, int, QColor, Qt::BrushStyle = Qt::SolidPattern);
+		//paint a convex polygon block with a brush color and style, and a pen color and thickness
+	void formatRect(Block*, QColor, int, QColor, Qt::BrushStyle = Qt::SolidPattern);
+		//set brush color and style, and pen color and thickness of a rect item
+	void formatEllipse(Ball*, int, int, QColor, int, QColor, Qt::BrushStyle = Qt::SolidPattern);
 		//set position, brush color and style, and pen color and thickness of a ellipse item
 	void buildLevel();
-		//Set initial values to object values and create level from data file
+		//Set initial values to object values and create level from data file (preloaded in the background), then start preloading the next level
+	void paintLevel(const LevelView&);
+		//Rasterize the level's static blocks, polygon blocks and goalBlock once into the levelLayer, which every frame then draws as the background
+	void clearLevel();
+		//Destroy all of the level's items (which takes them out of the scene) in one operation
 	void resetLevel();
-		//Return level to initial state
+		//Return level to initial state, putting the balls and the blocks with mass back and leaving the other blocks where they are
 	void levelWon();
-		//Handle level winning message and level advancement
+		//Handle level winning message, save the level's replay and level advancement
 	void keyPressEvent(QKeyEvent *event);
 		//Handle user key presses
-	void getItemData(Block*, Block*, double&, double&, double&, double&);
-		//extract data about the rectangle item
-	bool collisionPossible(double, double, double, double, double, double, double, double);
-		//return whether the trajectory puts it passing an object
-	void setNormal(Block*, double, double, double);
-		//set the parameters for the normal of the collision and track projected collision item and that a collision happened
-	void collisionDetect(Block*, double, double, double, double, double);
-		//detect any collisions and set normal appropriately
-	void collisionHandler(double);
-		//Detect and identify collisions and resolve them appropriately
-	bool linesCross(double, double, double, double, double, double, double, double) const;
-		//Determines if two line segments cross one another
-	bool lineCornerCollide(double, double, double, double, double, double, double, double&) const;
-		//Determines if a line comes within a radius of a corner point
+	void showFlightControls();
+		//Show the controls available while the ball is in flight, with the current time scale
+	void takeSnapshot();
+		//Push the game's flags and the world's state onto the rewind ring as the newest frame
+	void rewindFrame();
+		//Pause the game and step it back one frame, as far back as the rewind ring goes
+	void retryFromHere();
+		//Go back to aiming from the frame the game is at, the balls staying where they are and the aim that got them there
+	void updateLaunchGuide();
+		//Point the pathLine and vText at the current angle and magnitude, and redraw the predicted path of the shot
+	void startClock();
+		//Start the timer and restart the physics clock without counting the time the game was paused
+	void syncScene(double);
+		//Mirror the world into the scene, blended between the states before and after the last physics step
+	size_t residentBytes() const;
+		//return the memory the process has resident, 0 where it can't be read
+	void paintEvent(QPaintEvent*);
+		//Paint the scene, timing the paint as a section of the frame profiler
+	void drawBackground(QPainter*, const QRectF&);
+		//Draw the background color and the part of the levelLayer that's being repainted
+#ifdef PROFILING
+	void showProfile();
+		//Show the profiler's averages over the latest PROFILE_HUD_FRAMES frames in the overlay
+#endif
 	QGraphicsScene *scene;				//The scene upon which items exist (part of QT framework)
 	Ball *playerBall;					//The player's ball that they launch
-	Block *goalBlock;					//The Block that you're trying to hit
-	std::vector<Block*> levelBlocks;	//The Blocks that make up the obstacles of the level
+	std::vector<Ball*> levelBalls;		//The level's other balls, which the playerBall can knock around
+	std::vector<Block*> levelMovers;	//The level's blocks that move along paths
+	std::vector<Block*> levelDynamicBlocks;//The level's blocks with mass, which fall and get pushed around (with the moving blocks, the only blocks that are items)
+	QPixmap levelLayer;					//The level's blocks and goalBlock (which never move) painted once, drawn under the scene's items instead of being items themselves
 	QGraphicsLineItem *pathLine;		//The line showing the current direction and magnitude of the launch
+	QGraphicsPathItem *trajectoryPath;	//The predicted path of the shot being aimed, bounces included (green if it hits the goal)
+	std::vector<Vec2D> trajectoryPoints;//Centers of the playerBall along the predicted path, one per physics step
 	VelocityText *vText;				//The text displaying the velocity information
 	QGraphicsTextItem *cText;			//The test displaying the controls information
-	QTimer *timer;						//The timer that advances the frame of the simulation/game
-	Vec2D normal;						//The normal of a collision
-	Block *collItem;					//Item that is to be hit by playerBall's trajectory
+	QTimer *timer;						//The timer that renders the scene and advances the physics clock
+	QElapsedTimer clock;				//Wall-clock time since the physics clock was started
+	qint64 lastTick;					//Wall-clock time (ns) of the last timer tick
+	double accumulator;					//Physics steps owed to the wall clock but not run yet (the fraction is how far the scene is between two steps)
+	double timeScale;					//Speed of the simulation relative to real time (slow motion < 1 < fast forward)
+	std::vector<double> previousX;		//x coordinates of the centers of the balls before the last physics step
+	std::vector<double> previousY;		//y coordinates of the centers of the balls before the last physics step
+	std::vector<BlockBody> previousBlocks;//The blocks with mass before the last physics step
+	LevelArena levelItems;				//Memory of the level's scene items, all destroyed together when the level is cleared and reused by the next one
+	MappedLevel levelMap;				//The compiled level file of the current level, mapped for as long as the world uses its records
+	LevelPreloader preloader;			//Reads and indexes the next level on a worker thread while the current one is played
+	World world;						//The headless physics world simulating the level, mirrored into the scene items
+	ReplayRecorder recorder;			//Records the inputs of the level being played (and keyframes of its simulation) for its replay file
+	SnapshotRing rewind;				//The latest REWIND_FRAMES frames of the level, to step back through and retry from
+	bool rewoundFlag;					//The game was rewound while paused, so resuming it is recorded as a restore of the simulation
 	bool launchedFlag;					//Flag to determine if game has begun
-	bool projectedCollision;			//A collision will occur along projected trajectory
-	bool goalBlockCollision;			//projected collision is with the goalblock
-	double subPortion;					//The portion of the current trajorectory until the playerBall collides with an object
 	double magnitude;					//Magnitude of the launch velocity
 	int angle;							//Angle of the launch velocity
 	int currentLevel;					//Level currently playing.
+#ifdef PROFILING
+	QGraphicsTextItem *profileText;		//Overlay of the frame profiler beside vText, toggled with [P]
+#endif
 public slots:
 	void detectAndMove();
-		//Listens to timer, advances movement and collisions
+		//Listens to timer, runs the physics steps owed to the wall clock and renders the scene
 };
 
 #endif // GAME_H
@@ -0,0 +1,240 @@
+/* Program name: level.cpp
+*  Author: Cory Knoll
+*  Date Last Modified: 10/17/2026
+*  Description: Describe the balls and blocks of a level, read and write them as a level data file, and view them in place wherever they're stored (no Qt dependency)
+	================================================================
+	FUNCTIONS:
+	+ std::string levelFileName(int) - return the name of the data file for a level number
+	+ bool loadLevelFile(const std::string&, LevelData&) - Read a level data file into level data, return false if the file can't be opened or is incomplete
+	+ bool saveLevelFile(const std::string&, const LevelData&) - Write level data as a level data file, return false if the file can't be written
+	+ LevelView viewLevel(const LevelData&) - return a view of level data (without a prebuilt block hierarchy)
+	+ bool isConvex(const PolygonData&) - return true if the corners of a polygon go around it one way, turning the same way at every corner
+	============================================================================
+	VARIABLES:
+	- const char* moverKinds[MOVER_KINDS] - Names of the kinds of path in a level file
+	============================================================================
+	STRUCTS:
+	+ BallData - coordinates of the center, velocity, radius and inverse mass of a ball
+	+ BlockData - coordinates of the top-left corner, width, height, inverse mass and material of a block
+	+ MaterialData - number, restitution and friction coefficient of a block material
+	+ MoverData - starting corner, size, path and material of a block moving along a path
+	+ PolygonData - corners and material of a convex polygon block (oriented boxes included)
+	+ LevelData - the player ball, other balls, goal block, obstacle blocks, polygon blocks, moving blocks and block materials that make up a level
+	+ LevelView - where the records of a level are stored (level data or a mapped compiled level file), and its prebuilt block hierarchy if it has one
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include "level.h"
+
+static const char *moverKinds[MOVER_KINDS] = { "linear", "pingpong", "circular" };	//Names of the kinds of path in a level file
+
+//return true if the corners of a polygon go around it one way, turning the same way at every corner
+bool isConvex(const PolygonData &polygon)
+{
+	int turn = 0;	//which way the corners turn so far (0 until a corner turns)
+	for (int i = 0; i < polygon.pointCount; i++)
+	{
+		int next = (i + 1) % polygon.pointCount, after = (i + 2) % polygon.pointCount;
+		double cross = (polygon.x[next] - polygon.x[i]) * (polygon.y[after] - polygon.y[next]) - (polygon.y[next] - polygon.y[i]) * (polygon.x[after] - polygon.x[next]);
+		if (cross == 0)
+			continue;
+		if (turn != 0 && (cross > 0) != (turn > 0))
+			return false;
+		turn = cross > 0 ? 1 : -1;
+	}
+
+	//turning the same way at every corner, the corners still have to go around the polygon once rather than several times
+	double angle = 0;
+	for (int i = 0; i < polygon.pointCount; i++)
+	{
+		int next = (i + 1) % polygon.pointCount, after = (i + 2) % polygon.pointCount;
+		angle += atan2((polygon.x[next] - polygon.x[i]) * (polygon.y[after] - polygon.y[next]) - (polygon.y[next] - polygon.y[i]) * (polygon.x[after] - polygon.x[next]),
+			(polygon.x[next] - polygon.x[i]) * (polygon.x[after] - polygon.x[next]) + (polygon.y[next] - polygon.y[i]) * (polygon.y[after] - polygon.y[next]));
+	}
+	return turn != 0 && fabs(fabs(angle) - 2 * 3.14159265358979323846) < 1e-6;
+}
+
+//return the name of the data file for a level number
+std::string levelFileName(int levelNumber)
+{
+	return "lvl" + std::to_string(levelNumber) + ".txt";
+}
+
+//Read a level data file into level data, return false if the file can't be opened or is incomplete
+bool loadLevelFile(const std::string &fileName, LevelData &level)
+{
+	std::ifstream levelFile(fileName);
+	if (!levelFile.is_open())
+		return false;
+
+	level.balls.clear();
+	level.blocks.clear();
+	level.movers.clear();
+	level.polygons.clear();
+	level.materials.clear();
+	std::string line;	//one record of the level file
+	int records = 0;	//number of untagged records read so far
+	while (std::getline(levelFile, line))
+	{
+		std::istringstream fields(line);
+		std::string keyword;
+
+		//skip blank lines and comments
+		if (!(fields >> keyword) || keyword[0] == '#')
+			continue;
+
+		//tagged records describe objects the original format had no room for
+		if (keyword == "ball")
+		{
+			BallData ball = BallData();
+			if (fields >> ball.x >> ball.y >> ball.radius >> ball.invMass)
+			{
+				fields >> ball.vx >> ball.vy;
+				level.balls.push_back(ball);
+			}
+			continue;
+		}
+		if (keyword == "mover")
+		{
+			MoverData mover = MoverData();
+			std::string kind;
+			if (fields >> kind >> mover.x >> mover.y >> mover.width >> mover.height >> mover.dx >> mover.dy >> mover.period)
+			{
+				fields >> mover.phase >> mover.material;
+				mover.kind = (int)(std::find(moverKinds, moverKinds + MOVER_KINDS, kind) - moverKinds);
+				if (mover.kind < MOVER_KINDS)
+					level.movers.push_back(mover);
+			}
+			continue;
+		}
+		if (keyword == "polygon")
+		{
+			PolygonData polygon = PolygonData();
+			if (!(fields >> polygon.pointCount) || polygon.pointCount < 3 || polygon.pointCount > POLYGON_MAX_POINTS)
+				continue;
+			int read = 0;
+			while (read < polygon.pointCount && fields >> polygon.x[read] >> polygon.y[read])
+				read++;
+			if (!(fields >> polygon.material))
+				polygon.material = 0;
+			if (read == polygon.pointCount && isConvex(polygon))
+				level.polygons.push_back(polygon);
+			continue;
+		}
+		if (keyword == "box")
+		{
+			//the corners of the box turned about its center, clockwise on screen (y grows downward)
+			double x, y, width, height, angle;
+			PolygonData polygon = PolygonData();
+			if (!(fields >> x >> y >> width >> height >> angle) || width <= 0 || height <= 0)
+				continue;
+			if (!(fields >> polygon.material))
+				polygon.material = 0;
+			double radians = angle * 3.14159265358979323846 / 180, c = cos(radians), s = sin(radians);
+			const double corners[4][2] = { { -0.5, -0.5 }, { 0.5, -0.5 }, { 0.5, 0.5 }, { -0.5, 0.5 } };
+			polygon.pointCount = 4;
+			for (int i = 0; i < 4; i++)
+			{
+				double dx = corners[i][0] * width, dy = corners[i][1] * height;
+				polygon.x[i] = x + dx * c - dy * s;
+				polygon.y[i] = y + dx * s + dy * c;
+			}
+			level.polygons.push_back(polygon);
+			continue;
+		}
+		if (keyword == "material")
+		{
+			MaterialData material;
+			if (fields >> material.number >> material.restitution >> material.friction && material.number >= 0 && material.number < MAX_MATERIALS)
+				level.materials.push_back(material);
+			continue;
+		}
+
+		//untagged records are positional: playerBall (center x, center y, radius, invMass), then goalBlock, then levelBlocks (corner x, corner y, width, height, invMass, optional material)
+		//incomplete records are skipped
+		fields.clear();
+		fields.seekg(0);
+		if (records == 0)
+		{
+			BallData &ball = level.playerBall;
+			ball = BallData();
+			if (fields >> ball.x >> ball.y >> ball.radius >> ball.invMass)
+				records++;
+		}
+		else
+		{
+			BlockData block;
+			if (fields >> block.x >> block.y >> block.width >> block.height >> block.invMass)
+			{
+				if (!(fields >> block.material))
+					block.material = 0;
+				if (records == 1)
+					level.goalBlock = block;
+				else
+					level.blocks.push_back(block);
+				records++;
+			}
+		}
+	}
+	return records >= 2;
+}
+
+//Write level data as a level data file, return false if the file can't be written
+bool saveLevelFile(const std::string &fileName, const LevelData &level)
+{
+	std::ofstream levelFile(fileName);
+	if (!levelFile.is_open())
+		return false;
+
+	//enough digits that reading the file back gives the same doubles
+	levelFile.precision(std::numeric_limits<double>::max_digits10);
+	for (const MaterialData &material : level.materials)
+		levelFile << "material " << material.number << ' ' << material.restitution << ' ' << material.friction << '\n';
+	const BallData &player = level.playerBall;
+	levelFile << player.x << ' ' << player.y << ' ' << player.radius << ' ' << player.invMass << '\n';
+	const BlockData &goal = level.goalBlock;
+	levelFile << goal.x << ' ' << goal.y << ' ' << goal.width << ' ' << goal.height << ' ' << goal.invMass << ' ' << goal.material << '\n';
+	for (const BlockData &block : level.blocks)
+		levelFile << block.x << ' ' << block.y << ' ' << block.width << ' ' << block.height << ' ' << block.invMass << ' ' << block.material << '\n';
+	for (const MoverData &mover : level.movers)
+		levelFile << "mover " << moverKinds[mover.kind] << ' ' << mover.x << ' ' << mover.y << ' ' << mover.width << ' ' << mover.height << ' '
+			<< mover.dx << ' ' << mover.dy << ' ' << mover.period << ' ' << mover.phase << ' ' << mover.material << '\n';
+	for (const PolygonData &polygon : level.polygons)
+	{
+		//an oriented box is written as the polygon it was read as
+		levelFile << "polygon " << polygon.pointCount;
+		for (int i = 0; i < polygon.pointCount; i++)
+			levelFile << ' ' << polygon.x[i] << ' ' << polygon.y[i];
+		levelFile << ' ' << polygon.material << '\n';
+	}
+	for (const BallData &ball : level.balls)
+		levelFile << "ball " << ball.x << ' ' << ball.y << ' ' << ball.radius << ' ' << ball.invMass << ' ' << ball.vx << ' ' << ball.vy << '\n';
+	return levelFile.good();
+}
+
+//return a view of level data (without a prebuilt block hierarchy)
+LevelView viewLevel(const LevelData &level)
+{
+	LevelView view;
+	view.playerBall = &level.playerBall;
+	view.balls = level.balls.data();
+	view.ballCount = (int)level.balls.size();
+	view.goalBlock = &level.goalBlock;
+	view.blocks = level.blocks.data();
+	view.blockCount = (int)level.blocks.size();
+	view.movers = level.movers.data();
+	view.moverCount = (int)level.movers.size();
+	view.polygons = level.polygons.data();
+	view.polygonCount = (int)level.polygons.size();
+	view.materials = level.materials.data();
+	view.materialCount = (int)level.materials.size();
+	view.nodes = nullptr;
+	view.nodeCount = 0;
+	view.leaves = nullptr;
+	view.leafCount = 0;
+	return view;
+}
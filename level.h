@@ -0,0 +1,143 @@
+/* Program name: level.h
+*  Author: Cory Knoll
+*  Date Last Modified: 10/17/2026
+*  Description: Describe the balls and blocks of a level, read and write them as a level data file, and view them in place wherever they're stored (no Qt dependency)
+	================================================================
+	FUNCTIONS:
+	+ std::string levelFileName(int) - return the name of the data file for a level number
+	+ bool loadLevelFile(const std::string&, LevelData&) - Read a level data file into level data, return false if the file can't be opened or is incomplete
+	+ bool saveLevelFile(const std::string&, const LevelData&) - Write level data as a level data file, return false if the file can't be written
+	+ LevelView viewLevel(const LevelData&) - return a view of level data (without a prebuilt block hierarchy)
+	+ bool isConvex(const PolygonData&) - return true if the corners of a polygon go around it one way, turning the same way at every corner
+	============================================================================
+	LEVEL FILE FORMAT (one record per line, blank lines and lines starting with # are skipped):
+	  x y radius invMass				- first untagged line: the playerBall (center coordinates)
+	  x y width height invMass [material]		- second untagged line: the goalBlock (top-left coordinates), optionally with a material number
+	  x y width height invMass [material]		- every other untagged line: a levelBlock (one with an invMass above 0 has mass: it falls, stacks and is pushed)
+	  ball x y radius invMass [vx vy]			- an additional dynamic ball, optionally with a starting velocity
+	  material number restitution friction	- a block material numbered 0 to MAX_MATERIALS - 1 (material 0, the default, is used by blocks that don't name one)
+	  mover kind x y width height dx dy period [phase] [material]	- a block moving along a path, kind being one of:
+	      linear		- from (x, y) to (x + dx, y + dy) over period frames, then staying there
+	      pingpong		- from (x, y) to (x + dx, y + dy) and back every period frames
+	      circular		- with its top-left corner going around an ellipse centered on (x, y) with radii dx and dy once every period frames
+	    the phase is the part of a period the block is already along its path when the level starts (0 to 1)
+	  polygon count x1 y1 x2 y2 ... [material]	- a convex polygon block with count corners (3 to POLYGON_MAX_POINTS) in order around it
+	  box x y width height angle [material]		- an oriented box (center coordinates, angle in degrees clockwise on screen), read as a 4 corner polygon
+	    polygons that aren't convex are skipped; polygon blocks never move and have no mass
+	============================================================================
+	STRUCTS:
+	+ BallData - coordinates of the center, velocity, radius and inverse mass of a ball
+	+ BlockData - coordinates of the top-left corner, width, height, inverse mass and material of a block
+	+ MaterialData - number, restitution and friction coefficient of a block material
+	+ MoverData - starting corner, size, path and material of a block moving along a path
+	+ PolygonData - corners and material of a convex polygon block (oriented boxes included)
+	+ LevelData - the player ball, other balls, goal block, obstacle blocks, polygon blocks, moving blocks and block materials that make up a level
+	+ LevelView - where the records of a level are stored (level data or a mapped compiled level file), and its prebuilt block hierarchy if it has one
+*/
+
+#ifndef LEVEL_H
+#define LEVEL_H
+
+#include <string>
+#include <vector>
+#include "bvh.h"
+
+#define MOVER_LINEAR 0		//Kind of a moving block's path: one way from its start to its end, then still
+#define MOVER_PINGPONG 1	//Kind of a moving block's path: from its start to its end and back
+#define MOVER_CIRCULAR 2	//Kind of a moving block's path: around an ellipse
+#define MOVER_KINDS 3		//Number of kinds of path
+#define POLYGON_MAX_POINTS 8	//Most corners of a polygon block
+#define MAX_MATERIALS 1024		//Most materials a level can number (material numbers run from 0 to MAX_MATERIALS - 1)
+
+struct BallData
+{
+	double x;		//x coordinate of the center of the ball
+	double y;		//y coordinate of the center of the ball
+	double vx;		//x component of the ball's starting velocity
+	double vy;		//y component of the ball's starting velocity
+	double radius;	//radius of the ball
+	double invMass;	//inverse mass of the ball
+};
+
+struct BlockData
+{
+	double x;		//x coordinate of the top-left corner of the block
+	double y;		//y coordinate of the top-left corner of the block
+	double width;	//width of the block
+	double height;	//height of the block
+	double invMass;	//inverse mass of the block
+	int material;	//number of the block's material in the level's material table
+};
+
+struct MaterialData
+{
+	int number;			//number blocks refer to the material by
+	double restitution;	//portion of its speed into the block a ball keeps, bouncing back out
+	double friction;	//speed along the block a ball loses per unit of speed it bounces back with
+};
+
+struct MoverData
+{
+	double x;		//x coordinate of the top-left corner of the block where its path starts (the center of a circular path)
+	double y;		//y coordinate of the top-left corner of the block where its path starts (the center of a circular path)
+	double width;	//width of the block
+	double height;	//height of the block
+	double dx;		//x distance to the end of the path (the x radius of a circular path)
+	double dy;		//y distance to the end of the path (the y radius of a circular path)
+	double period;	//frames the block takes to go along its path once (0 or less: it never moves)
+	double phase;	//part of a period the block is along its path when the level starts
+	int kind;		//MOVER_LINEAR, MOVER_PINGPONG or MOVER_CIRCULAR
+	int material;	//number of the block's material in the level's material table
+};
+
+struct PolygonData
+{
+	double x[POLYGON_MAX_POINTS];	//x coordinates of the corners, in order around the polygon
+	double y[POLYGON_MAX_POINTS];	//y coordinates of the corners, in order around the polygon
+	int pointCount;					//number of corners
+	int material;					//number of the polygon's material in the level's material table
+};
+
+struct LevelData
+{
+	BallData playerBall;			//The player's ball that they launch
+	std::vector<BallData> balls;	//The other dynamic balls of the level
+	BlockData goalBlock;			//The Block that you're trying to hit
+	std::vector<BlockData> blocks;	//The Blocks that make up the obstacles of the level
+	std::vector<MoverData> movers;	//The Blocks that move along paths
+	std::vector<PolygonData> polygons;	//The convex polygon blocks (oriented boxes included)
+	std::vector<MaterialData> materials;//The materials of the blocks, in the order the level file lists them
+};
+
+struct LevelView
+{
+	const BallData *playerBall;		//The player's ball that they launch
+	const BallData *balls;			//The other dynamic balls of the level
+	int ballCount;					//Number of other balls
+	const BlockData *goalBlock;		//The Block that you're trying to hit
+	const BlockData *blocks;		//The Blocks that make up the obstacles of the level
+	int blockCount;					//Number of obstacle blocks
+	const MoverData *movers;		//The Blocks that move along paths
+	int moverCount;					//Number of moving blocks
+	const PolygonData *polygons;	//The convex polygon blocks
+	int polygonCount;				//Number of polygon blocks
+	const MaterialData *materials;	//The materials of the blocks, in the order the level lists them
+	int materialCount;				//Number of materials
+	const BVH::Node *nodes;			//Nodes of a prebuilt hierarchy over the obstacle blocks, nullptr if the level has none
+	int nodeCount;					//Number of nodes of the prebuilt hierarchy
+	const BVH::Leaf *leaves;		//Leaves of the prebuilt hierarchy
+	int leafCount;					//Number of leaves of the prebuilt hierarchy
+};
+
+std::string levelFileName(int);
+	//return the name of the data file for a level number
+bool loadLevelFile(const std::string&, LevelData&);
+	//Read a level data file into level data, return false if the file can't be opened or is incomplete
+bool saveLevelFile(const std::string&, const LevelData&);
+	//Write level data as a level data file, return false if the file can't be written
+LevelView viewLevel(const LevelData&);
+	//return a view of level data (without a prebuilt block hierarchy)
+bool isConvex(const PolygonData&);
+	//return true if the corners of a polygon go around it one way, turning the same way at every corner
+
+#endif //LEVEL_H
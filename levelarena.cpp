@@ -0,0 +1,112 @@
+/* Program name: levelarena.cpp
+*  Author: Cory Knoll
+*  Date Last Modified: 10/17/2026
+*  Description: Arena that owns every object of a level: objects are carved out of a few large chunks and destroyed together in one operation, the chunks being kept for the next level (no Qt dependency)
+	================================================================
+	FUNCTIONS:
+	+ T* create<T>(Args&&...) - Construct an object in the arena, return it (it's destroyed when the arena is released)
+	+ void* allocate(size_t, size_t) - return memory of a size and alignment that stays valid until the arena is released
+	+ void release() - Destroy every object created in the arena, newest first, and keep the chunks for the next level
+	+ size_t getUsed() const - return the number of bytes handed out since the arena was last released
+	+ size_t getCapacity() const - return the number of bytes of all the arena's chunks
+	+ int getObjectCount() const - return the number of objects waiting to be destroyed
+	+ LevelArena() - Constructor, no chunks yet
+	+ ~LevelArena() - Destructor, destroy the objects and free the chunks
+	============================================================================
+	VARIABLES:
+	- std::vector<Chunk> chunks - Blocks of memory objects are carved out of, in the order they're filled
+	- int current - Chunk being filled
+	- size_t offset - Bytes of the current chunk already handed out
+	- size_t used - Bytes handed out since the arena was last released
+	- std::vector<Destructor> destructors - Objects to destroy when the arena is released, oldest first
+	============================================================================
+	STRUCTS:
+	- Chunk - start and size of a block of memory of the arena
+	- Destructor - an object of the arena and the function that destroys it
+	============================================================================
+	CLASSES:
+	+ LevelArena - the memory of one level's objects, released in one operation
+*/
+
+#include <algorithm>
+#include <cstdint>
+#include "levelarena.h"
+
+//return memory of a size and alignment that stays valid until the arena is released
+void* LevelArena::allocate(size_t size, size_t alignment)
+{
+	//fill the chunks in order; after a release the same chunks are filled again from the first, so a level no larger than the ones
+	//before it never asks the system for memory
+	for (;;)
+	{
+		for (; current < (int)chunks.size(); current++, offset = 0)
+		{
+			const Chunk &chunk = chunks[current];
+			size_t padding = (alignment - (uintptr_t)(chunk.memory + offset) % alignment) % alignment;
+			if (offset + padding + size <= chunk.size)
+			{
+				void *memory = chunk.memory + offset + padding;
+				offset += padding + size;
+				used += size;
+				return memory;
+			}
+		}
+
+		//no chunk has room left: add one (new[] aligns it for any fundamental type, the padding covers anything stricter)
+		Chunk chunk;
+		chunk.size = std::max(size + alignment, (size_t)ARENA_CHUNK_SIZE);
+		chunk.memory = new unsigned char[chunk.size];
+		chunks.push_back(chunk);
+		current = (int)chunks.size() - 1;
+		offset = 0;
+	}
+}
+
+//Destroy every object created in the arena, newest first, and keep the chunks for the next level
+void LevelArena::release()
+{
+	//newest first, the reverse of construction, so an object is still around for anything created after it that refers to it
+	for (auto i = destructors.rbegin(); i != destructors.rend(); ++i)
+		i->destroy(i->object);
+	destructors.clear();
+	current = 0;
+	offset = 0;
+	used = 0;
+}
+
+//return the number of bytes handed out since the arena was last released
+size_t LevelArena::getUsed() const
+{
+	return used;
+}
+
+//return the number of bytes of all the arena's chunks
+size_t LevelArena::getCapacity() const
+{
+	size_t capacity = 0;
+	for (const Chunk &chunk : chunks)
+		capacity += chunk.size;
+	return capacity;
+}
+
+//return the number of objects waiting to be destroyed
+int LevelArena::getObjectCount() const
+{
+	return (int)destructors.size();
+}
+
+//Constructor, no chunks yet
+LevelArena::LevelArena()
+{
+	current = 0;
+	offset = 0;
+	used = 0;
+}
+
+//Destructor, destroy the objects and free the chunks
+LevelArena::~LevelArena()
+{
+	release();
+	for (Chunk &chunk : chunks)
+		delete[] chunk.memory;
+}
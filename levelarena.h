@@ -0,0 +1,99 @@
+/* Program name: levelarena.h
+*  Author: Cory Knoll
+*  Date Last Modified: 10/17/2026
+*  Description: Arena that owns every object of a level: objects are carved out of a few large chunks and destroyed together in one operation, the chunks being kept for the next level (no Qt dependency)
+	================================================================
+	FUNCTIONS:
+	+ T* create<T>(Args&&...) - Construct an object in the arena, return it (it's destroyed when the arena is released)
+	+ void* allocate(size_t, size_t) - return memory of a size and alignment that stays valid until the arena is released
+	+ void release() - Destroy every object created in the arena, newest first, and keep the chunks for the next level
+	+ size_t getUsed() const - return the number of bytes handed out since the arena was last released
+	+ size_t getCapacity() const - return the number of bytes of all the arena's chunks
+	+ int getObjectCount() const - return the number of objects waiting to be destroyed
+	+ LevelArena() - Constructor, no chunks yet
+	+ ~LevelArena() - Destructor, destroy the objects and free the chunks
+	============================================================================
+	VARIABLES:
+	- std::vector<Chunk> chunks - Blocks of memory objects are carved out of, in the order they're filled
+	- int current - Chunk being filled
+	- size_t offset - Bytes of the current chunk already handed out
+	- size_t used - Bytes handed out since the arena was last released
+	- std::vector<Destructor> destructors - Objects to destroy when the arena is released, oldest first
+	============================================================================
+	STRUCTS:
+	- Chunk - start and size of a block of memory of the arena
+	- Destructor - an object of the arena and the function that destroys it
+	============================================================================
+	CLASSES:
+	+ LevelArena - the memory of one level's objects, released in one operation
+*/
+
+#ifndef LEVELARENA_H
+#define LEVELARENA_H
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#define ARENA_CHUNK_SIZE 65536	//Bytes of each chunk of the arena (an object larger than that gets a chunk of its own size)
+
+class LevelArena
+{
+public:
+	template<typename T, typename... Args>
+	T* create(Args&&...);
+		//Construct an object in the arena, return it (it's destroyed when the arena is released)
+	void* allocate(size_t, size_t);
+		//return memory of a size and alignment that stays valid until the arena is released
+	void release();
+		//Destroy every object created in the arena, newest first, and keep the chunks for the next level
+	size_t getUsed() const;
+		//return the number of bytes handed out since the arena was last released
+	size_t getCapacity() const;
+		//return the number of bytes of all the arena's chunks
+	int getObjectCount() const;
+		//return the number of objects waiting to be destroyed
+	LevelArena();
+		//Constructor, no chunks yet
+	~LevelArena();
+		//Destructor, destroy the objects and free the chunks
+private:
+	struct Chunk
+	{
+		unsigned char *memory;	//start of the chunk
+		size_t size;			//size of the chunk in bytes
+	};
+	struct Destructor
+	{
+		void (*destroy)(void*);	//calls the object's destructor
+		void *object;			//the object
+	};
+	LevelArena(const LevelArena&) = delete;
+	LevelArena& operator=(const LevelArena&) = delete;
+	std::vector<Chunk> chunks;				//Blocks of memory objects are carved out of, in the order they're filled
+	int current;							//Chunk being filled
+	size_t offset;							//Bytes of the current chunk already handed out
+	size_t used;							//Bytes handed out since the arena was last released
+	std::vector<Destructor> destructors;	//Objects to destroy when the arena is released, oldest first
+};
+
+//create() is a template, so it's defined here where every caller can instantiate it
+
+//Construct an object in the arena, return it (it's destroyed when the arena is released)
+template<typename T, typename... Args>
+T* LevelArena::create(Args&&... args)
+{
+	T *object = new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+
+	//objects that need no destructor (plain records) cost nothing to release
+	if (!std::is_trivially_destructible<T>::value)
+	{
+		Destructor destructor = { [](void *created) { static_cast<T*>(created)->~T(); }, object };
+		destructors.push_back(destructor);
+	}
+	return object;
+}
+
+#endif //LEVELARENA_H
@@ -0,0 +1,69 @@
+/* Program name: levelcompiler.cpp
+*  Author: Cory Knoll
+*  Date Last Modified: 10/17/2026
+*  Description: Command line program that compiles text level files into binary level files the game maps and uses in place (build as its own executable, no window is opened)
+	================================================================
+	FUNCTIONS:
+	+ int main(int, char**) - Compile the level file named on the command line (levelcompiler input.txt output.bin), or lvl1.txt, lvl2.txt, ... until one is missing
+	- bool compileFile(const std::string&, const std::string&) - Compile one text level file and check the result maps back, print what was done, return false if it failed
+*/
+
+#include <cstdio>
+#include <string>
+#include "compiledlevel.h"
+#include "level.h"
+
+//Compile one text level file and check the result maps back, print what was done, return false if it failed
+static bool compileFile(const std::string &input, const std::string &output)
+{
+	LevelData level;
+	if (!loadLevelFile(input, level))
+	{
+		printf("%s: can't be read or is incomplete\n", input.c_str());
+		return false;
+	}
+	if (!compileLevel(level, output))
+	{
+		printf("%s: can't be written\n", output.c_str());
+		return false;
+	}
+
+	//map the file the way the game will, so a file that fails its checks is never left behind looking usable
+	MappedLevel compiled;
+	if (!compiled.open(output))
+	{
+		remove(output.c_str());
+		printf("%s: didn't map back after compiling\n", output.c_str());
+		return false;
+	}
+	const CompiledLevelHeader &header = compiled.getHeader();
+	printf("%s -> %s: %d balls, %d blocks, %d polygon blocks, %d moving blocks, %d materials, %d hierarchy nodes, %llu bytes\n", input.c_str(), output.c_str(),
+		header.ballCount, header.blockCount, header.polygonCount, header.moverCount, header.materialCount, header.nodeCount, sizeof(header) + header.payloadSize);
+	return true;
+}
+
+//Compile the level file named on the command line (levelcompiler input.txt output.bin), or lvl1.txt, lvl2.txt, ... until one is missing
+int main(int argc, char *argv[])
+{
+	if (argc == 3)
+		return compileFile(argv[1], argv[2]) ? 0 : 1;
+	if (argc != 1)
+	{
+		printf("usage: %s [input.txt output.bin]\n", argv[0]);
+		return 1;
+	}
+
+	//with no arguments, compile the game's levels in place, in the order the game plays them
+	int compiled = 0;
+	for (int levelNumber = 1; ; levelNumber++)
+	{
+		LevelData level;
+		if (!loadLevelFile(levelFileName(levelNumber), level))
+			break;
+		if (!compileFile(levelFileName(levelNumber), compiledLevelFileName(levelNumber)))
+			return 1;
+		compiled++;
+	}
+	printf("%d levels compiled\n", compiled);
+	return compiled > 0 ? 0 : 1;
+}
@@ -0,0 +1,83 @@
+/* Program name: levelpreloader.cpp
+*  Author: Cory Knoll
+*  Date Last Modified: 10/17/2026
+*  Description: Read and index a level on a worker thread while another level is played, and hand it over to the game's world when it's needed (no Qt dependency)
+	================================================================
+	FUNCTIONS:
+	+ void request(int) - Start reading and indexing a level on the worker thread, unless it's already the level being preloaded
+	+ bool take(int, World&, MappedLevel&, LevelView&) - Wait for a level (reading it now if it wasn't requested) and hand it over: swap it into a world and the file its records are mapped from, set a view of its records (valid until the next request), return false if the level has no data file
+	+ LevelPreloader() - Constructor, nothing preloaded
+	+ ~LevelPreloader() - Destructor, wait for the worker thread
+	- void load() - Read the requested level from its compiled file (or its text file if it has no valid compiled one) and load it into the preloaded world (worker thread)
+	============================================================================
+	VARIABLES:
+	- std::thread worker - Thread reading the requested level
+	- int levelNumber - Number of the level being preloaded, 0 if none
+	- bool loaded - The level's data file was found and read (only read once the worker is joined)
+	- MappedLevel levelMap - The level's compiled file, if it has a valid one
+	- LevelData levelData - The level's records read from its text file, if it has no valid compiled one
+	- World world - The world the level is loaded into, which the game's world swaps levels with
+	============================================================================
+	CLASSES:
+	+ LevelPreloader - a level read and indexed off the GUI thread, ready to swap into the game's world
+*/
+
+#include "levelpreloader.h"
+
+//Start reading and indexing a level on the worker thread, unless it's already the level being preloaded
+void LevelPreloader::request(int number)
+{
+	if (number == levelNumber)
+		return;
+	if (worker.joinable())
+		worker.join();
+	levelNumber = number;
+	loaded = false;
+	worker = std::thread(&LevelPreloader::load, this);
+}
+
+//Wait for a level (reading it now if it wasn't requested) and hand it over: swap it into a world and the file its records are mapped from, set a view of its records (valid until the next request), return false if the level has no data file
+bool LevelPreloader::take(int number, World &target, MappedLevel &targetMap, LevelView &view)
+{
+	request(number);
+	if (worker.joinable())
+		worker.join();
+
+	//the level changes hands in constant time however large it is; the level the target had comes back here and is freed off the
+	//GUI thread when the next level is requested
+	target.swapLevel(world);
+	targetMap.swap(levelMap);
+	view = targetMap.isOpen() ? targetMap.getView() : viewLevel(levelData);
+	levelNumber = 0;
+	return loaded;
+}
+
+//Read the requested level from its compiled file (or its text file if it has no valid compiled one) and load it into the preloaded world (worker thread)
+void LevelPreloader::load()
+{
+	//the world may use the records of the mapped file it was loaded from, so it's emptied before that file is unmapped
+	world.clear();
+	levelData = LevelData();
+	loaded = levelMap.open(compiledLevelFileName(levelNumber));
+	if (loaded)
+		world.loadLevel(levelMap.getView());
+	else if (loadLevelFile(levelFileName(levelNumber), levelData))
+	{
+		world.loadLevel(levelData);
+		loaded = true;
+	}
+}
+
+//Constructor, nothing preloaded
+LevelPreloader::LevelPreloader()
+{
+	levelNumber = 0;
+	loaded = false;
+}
+
+//Destructor, wait for the worker thread
+LevelPreloader::~LevelPreloader()
+{
+	if (worker.joinable())
+		worker.join();
+}
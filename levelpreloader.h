@@ -0,0 +1,55 @@
+/* Program name: levelpreloader.h
+*  Author: Cory Knoll
+*  Date Last Modified: 10/17/2026
+*  Description: Read and index a level on a worker thread while another level is played, and hand it over to the game's world when it's needed (no Qt dependency)
+	================================================================
+	FUNCTIONS:
+	+ void request(int) - Start reading and indexing a level on the worker thread, unless it's already the level being preloaded
+	+ bool take(int, World&, MappedLevel&, LevelView&) - Wait for a level (reading it now if it wasn't requested) and hand it over: swap it into a world and the file its records are mapped from, set a view of its records (valid until the next request), return false if the level has no data file
+	+ LevelPreloader() - Constructor, nothing preloaded
+	+ ~LevelPreloader() - Destructor, wait for the worker thread
+	- void load() - Read the requested level from its compiled file (or its text file if it has no valid compiled one) and load it into the preloaded world (worker thread)
+	============================================================================
+	VARIABLES:
+	- std::thread worker - Thread reading the requested level
+	- int levelNumber - Number of the level being preloaded, 0 if none
+	- bool loaded - The level's data file was found and read (only read once the worker is joined)
+	- MappedLevel levelMap - The level's compiled file, if it has a valid one
+	- LevelData levelData - The level's records read from its text file, if it has no valid compiled one
+	- World world - The world the level is loaded into, which the game's world swaps levels with
+	============================================================================
+	CLASSES:
+	+ LevelPreloader - a level read and indexed off the GUI thread, ready to swap into the game's world
+*/
+
+#ifndef LEVELPRELOADER_H
+#define LEVELPRELOADER_H
+
+#include <thread>
+#include "compiledlevel.h"
+#include "level.h"
+#include "world.h"
+
+class LevelPreloader
+{
+public:
+	void request(int);
+		//Start reading and indexing a level on the worker thread, unless it's already the level being preloaded
+	bool take(int, World&, MappedLevel&, LevelView&);
+		//Wait for a level (reading it now if it wasn't requested) and hand it over: swap it into a world and the file its records are mapped from, set a view of its records (valid until the next request), return false if the level has no data file
+	LevelPreloader();
+		//Constructor, nothing preloaded
+	~LevelPreloader();
+		//Destructor, wait for the worker thread
+private:
+	void load();
+		//Read the requested level from its compiled file (or its text file if it has no valid compiled one) and load it into the preloaded world (worker thread)
+	std::thread worker;		//Thread reading the requested level
+	int levelNumber;		//Number of the level being preloaded, 0 if none
+	bool loaded;			//The level's data file was found and read (only read once the worker is joined)
+	MappedLevel levelMap;	//The level's compiled file, if it has a valid one
+	LevelData levelData;	//The level's records read from its text file, if it has no valid compiled one
+	World world;			//The world the level is loaded into, which the game's world swaps levels with
+};
+
+#endif //LEVELPRELOADER_H
@@ -1,28 +1,27 @@
 /* Program name: main.cpp
 *  Author: Cory Knoll
-*  Date Last Modified: 5/7/2019
-*  Description: Create a game object that will build and run physics simulations
+*  Date Last Modified: 10/17/2026
+*  Description: Create a game object that will build and run physics simulations (or soak test it with --soak resets)
 */
 
 #include "FinalProject.h"
 #include <QtWidgets/QApplication>
 #include "game.h"
 
-Game *game; //Needed at some point, but can't remember if I used... Deletion TBD
-
 int main(int argc, char *argv[])
 {
 	//Create QT application
 	QApplication a(argc, argv);
 	//FinalProject w;
 
-	//Create game and make it visible
-	game = new Game();
-	game->show();
+	//Create game, which lives until the application's event loop ends
+	Game game;
 
-	//Properly delete game on exit
-	game = nullptr;
-	delete game;
+	//a soak test plays and resets levels without showing the window, and fails if memory kept growing
+	if (argc == 3 && QString(argv[1]) == "--soak")
+		return game.soak(QString(argv[2]).toInt()) ? 0 : 1;
 
+	//make it visible
+	game.show();
 	return a.exec();
 }
@@ -0,0 +1,141 @@
+/* Program name: narrowphase.h
+*  Author: Cory Knoll
+*  Date Last Modified: 10/17/2026
+*  Description: Table of the narrowphase routines for every pair of shape kinds the world collides (a moving ball against a block's box, a convex polygon or another ball), picked by template specialization so the collision loops call each routine directly instead of through a virtual call (header only, no Qt dependency)
+	================================================================
+	FUNCTIONS:
+	+ bool sweep(const SweepMotion&, const SweepBox&, double, SweepHit&) - Find when a moving ball first touches a box (ShapePair<SHAPE_CIRCLE, SHAPE_BOX>), return false if it doesn't
+	+ bool sweep(const SweepMotion&, const SweepPolygon&, double, SweepHit&) - Find when a moving ball first touches a convex polygon (ShapePair<SHAPE_CIRCLE, SHAPE_POLYGON>), return false if it doesn't
+	+ bool sweep(const SweepMotion&, const SweepCircle&, double, SweepHit&) - Find when a moving ball first touches a circle (ShapePair<SHAPE_CIRCLE, SHAPE_CIRCLE>), return false if it doesn't
+	+ bool sweepShape<Shape>(const SweepMotion&, const ShapeType<Shape>::Type&, double, SweepHit&) - Find when a moving ball first touches a shape of a kind through the table (no later than a maximum time), return false if it doesn't
+	============================================================================
+	STRUCTS:
+	+ SweepMotion - start, velocity, acceleration and radius of a moving ball
+	+ SweepCircle - center and radius of a circle
+	+ ShapeType - the description of a shape of one kind
+	+ ShapePair - the narrowphase routine of a moving shape of one kind against a shape of another
+	============================================================================
+	FORMAT:
+	Every motion is along a straight trajectory when its acceleration is 0 (times are then portions of the trajectory) and along
+	an exact parabola otherwise (times are in frames), the same as the functions of sweep.h
+*/
+
+#ifndef NARROWPHASE_H
+#define NARROWPHASE_H
+
+#include <cmath>
+#include "sweep.h"
+
+#define SHAPE_CIRCLE 0	//Kind of a ball
+#define SHAPE_BOX 1		//Kind of an axis-aligned block (its outline rounds the corners)
+#define SHAPE_POLYGON 2	//Kind of a convex polygon block (including rotated boxes)
+
+struct SweepMotion
+{
+	Vec2D center;		//where the ball starts
+	Vec2D velocity;		//trajectory (or velocity along a parabola) of the ball
+	Vec2D acceleration;	//constant acceleration of the ball, 0 along a straight trajectory
+	double radius;		//radius of the ball
+};
+
+struct SweepCircle
+{
+	Vec2D center;	//center of the circle
+	double radius;	//radius of the circle
+};
+
+//the description each kind of shape is swept against
+template<int Shape>
+struct ShapeType;
+
+template<>
+struct ShapeType<SHAPE_CIRCLE>
+{
+	typedef SweepCircle Type;
+};
+
+template<>
+struct ShapeType<SHAPE_BOX>
+{
+	typedef SweepBox Type;
+};
+
+template<>
+struct ShapeType<SHAPE_POLYGON>
+{
+	typedef SweepPolygon Type;
+};
+
+//only the pairs below have a routine, so sweeping a pair that doesn't fails to compile instead of failing at run time
+template<int Moving, int Other>
+struct ShapePair;
+
+template<>
+struct ShapePair<SHAPE_CIRCLE, SHAPE_BOX>
+{
+	//Find when a moving ball first touches a box, return false if it doesn't
+	static bool sweep(const SweepMotion &motion, const SweepBox &box, double maxTime, SweepHit &hit)
+	{
+		if (motion.acceleration.x == 0 && motion.acceleration.y == 0)
+			return sweepCircleBox(motion.center, motion.velocity, motion.radius, box, maxTime, hit);
+		return sweepParabolaBox(motion.center, motion.velocity, motion.acceleration, motion.radius, box, maxTime, hit);
+	}
+};
+
+template<>
+struct ShapePair<SHAPE_CIRCLE, SHAPE_POLYGON>
+{
+	//Find when a moving ball first touches a convex polygon, return false if it doesn't
+	static bool sweep(const SweepMotion &motion, const SweepPolygon &polygon, double maxTime, SweepHit &hit)
+	{
+		return sweepPolygon(motion.center, motion.velocity, motion.acceleration, motion.radius, polygon, maxTime, hit);
+	}
+};
+
+template<>
+struct ShapePair<SHAPE_CIRCLE, SHAPE_CIRCLE>
+{
+	//Find when a moving ball first touches a circle, return false if it doesn't
+	static bool sweep(const SweepMotion &motion, const SweepCircle &circle, double maxTime, SweepHit &hit)
+	{
+		Vec2D offset = motion.center - circle.center;
+		double touching = motion.radius + circle.radius;
+
+		//a ball already touching the circle touches it right away if it's moving towards it
+		double C = offset.lengthSquared() - touching * touching;
+		double B = 2 * offset.dot(motion.velocity);
+		if (C <= 0)
+		{
+			if (B >= 0)
+				return false;
+			hit.toi = 0;
+		}
+		else if (motion.acceleration.x == 0 && motion.acceleration.y == 0)
+		{
+			//|offset + velocity * t| = touching is a quadratic in t whose earlier root is where the ball first touches, and a ball
+			//moving away never does
+			if (B >= 0)
+				return false;
+			double A = motion.velocity.lengthSquared();
+			double discriminant = B * B - 4 * A * C;
+			if (discriminant < 0)
+				return false;
+			hit.toi = (-B - sqrt(discriminant)) / (2 * A);
+			if (hit.toi > maxTime)
+				return false;
+		}
+		else if (!sweepParabolaCircle(offset, motion.velocity, motion.acceleration, touching, maxTime, hit.toi))
+			return false;
+		hit.normal = (offset + motion.velocity * hit.toi + motion.acceleration * (0.5 * hit.toi * hit.toi)) / touching;
+		return true;
+	}
+};
+
+//Find when a moving ball first touches a shape of a kind through the table (no later than a maximum time), return false if it doesn't
+template<int Shape>
+inline bool sweepShape(const SweepMotion &motion, const typename ShapeType<Shape>::Type &shape, double maxTime, SweepHit &hit)
+{
+	return ShapePair<SHAPE_CIRCLE, Shape>::sweep(motion, shape, maxTime, hit);
+}
+
+#endif //NARROWPHASE_H
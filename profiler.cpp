@@ -0,0 +1,233 @@
+/* Program name: profiler.cpp
+*  Author: Cory Knoll
+*  Date Last Modified: 10/17/2026
+*  Description: Frame profiler: scoped timers and counters for the hot path of the physics and the game, kept per frame for an on-screen overlay and exported as CSV or a Chrome trace; only built into the program when PROFILING is defined (no Qt dependency)
+	================================================================
+	FUNCTIONS:
+	+ static Profiler& instance() - return the one profiler of the program
+	+ static long long now() - return the nanoseconds on the steady clock, which every time the profiler keeps is read from
+	+ int section(const char*) - return the number of a named section, adding it the first time it's named (-1 once PROFILE_MAX_SECTIONS are named)
+	+ void add(int, long long, long long) - Add a timed run of a section (its start and duration in nanoseconds) to the calling thread's log
+	+ void count(int, long long) - Add an amount to one of the calling thread's counters
+	+ void endFrame() - Close the frame: total every thread's sections and counters into the history and start the next frame (only call it while no other thread is in a section)
+	+ int getSectionCount() const - return the number of named sections
+	+ const char* getSectionName(int) const - return the name of a section
+	+ static const char* getCounterName(int) - return the name of a counter
+	+ int getFrameCount() const - return the number of frames in the history
+	+ const ProfileFrame& getFrame(int) const - return a frame of the history a number of frames older than the last one closed
+	+ bool writeCsv(const std::string&) const - Write the history to a CSV file, one line a frame, oldest first, return false if it can't be written
+	+ bool writeTrace(const std::string&) const - Write every thread's latest timed sections and the counters of every frame of the history to a Chrome trace file, return false if it can't be written
+	- ThreadLog& local() - return the calling thread's log, creating it the first time the thread logs anything
+	- Profiler() - Constructor, no sections and an empty history
+	============================================================================
+	VARIABLES:
+	- long long origin - When the profiler was created, which the exported times count from
+	- const char* names[PROFILE_MAX_SECTIONS] - Name of every section, in the order they were named
+	- int sectionCount - Number of named sections
+	- std::vector<std::unique_ptr<ThreadLog>> logs - Log of every thread that has logged anything
+	- std::vector<ProfileFrame> history - The latest PROFILE_HISTORY frames, oldest overwritten first
+	- int newest - Index in history of the last frame closed
+	- int frameCount - Number of frames in the history
+	- long long frameStart - When the frame being logged started
+	- long long frameNumber - Number of frames closed since the profiler was created
+	- std::mutex mutex - Guards the section names and the list of logs while a section or a thread is added
+	============================================================================
+	STRUCTS:
+	+ ProfileFrame - the time spent in every section and every counter's total during one frame
+	+ TraceEvent - one timed run of a section, for the trace export
+	- ThreadLog - the sections, counters and latest timed runs one thread logged during the frame
+	============================================================================
+	CLASSES:
+	+ Profiler - the per-frame times and counters of the program, logged by every thread without locking
+*/
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include "profiler.h"
+
+//return the one profiler of the program
+Profiler& Profiler::instance()
+{
+	static Profiler profiler;
+	return profiler;
+}
+
+//return the number of a named section, adding it the first time it's named (-1 once PROFILE_MAX_SECTIONS are named)
+int Profiler::section(const char *name)
+{
+	//every PROFILE_SCOPE asks once and keeps the number, so the lock is only taken the first time each scope runs
+	std::lock_guard<std::mutex> lock(mutex);
+	for (int i = 0; i < sectionCount; i++)
+		if (strcmp(names[i], name) == 0)
+			return i;
+	if (sectionCount == PROFILE_MAX_SECTIONS)
+		return -1;
+	names[sectionCount] = name;
+	return sectionCount++;
+}
+
+//Add a timed run of a section (its start and duration in nanoseconds) to the calling thread's log
+void Profiler::add(int section, long long start, long long duration)
+{
+	if (section < 0)
+		return;
+	ThreadLog &log = local();
+	log.sections[section] += duration;
+	TraceEvent event = { section, start, duration };
+	log.events[log.nextEvent] = event;
+	log.nextEvent = (log.nextEvent + 1) % PROFILE_TRACE_EVENTS;
+}
+
+//Add an amount to one of the calling thread's counters
+void Profiler::count(int counter, long long amount)
+{
+	local().counters[counter] += amount;
+}
+
+//Close the frame: total every thread's sections and counters into the history and start the next frame (only call it while no other thread is in a section)
+void Profiler::endFrame()
+{
+	//each thread only ever writes its own log, so nothing is locked on the hot path; the logs are read here, between frames, when
+	//the pool's threads are waiting for the next step
+	long long end = now();
+	newest = (newest + 1) % PROFILE_HISTORY;
+	frameCount = std::min(frameCount + 1, PROFILE_HISTORY);
+	ProfileFrame &frame = history[newest];
+	memset(&frame, 0, sizeof(frame));
+	frame.number = frameNumber++;
+	frame.start = frameStart;
+	frame.duration = end - frameStart;
+	std::lock_guard<std::mutex> lock(mutex);
+	for (std::unique_ptr<ThreadLog> &log : logs)
+	{
+		for (int i = 0; i < PROFILE_MAX_SECTIONS; i++)
+			frame.sections[i] += log->sections[i];
+		for (int i = 0; i < PROFILE_COUNTERS; i++)
+			frame.counters[i] += log->counters[i];
+		memset(log->sections, 0, sizeof(log->sections));
+		memset(log->counters, 0, sizeof(log->counters));
+	}
+	frameStart = end;
+}
+
+//return the number of named sections
+int Profiler::getSectionCount() const
+{
+	return sectionCount;
+}
+
+//return the name of a section
+const char* Profiler::getSectionName(int section) const
+{
+	return names[section];
+}
+
+//return the name of a counter
+const char* Profiler::getCounterName(int counter)
+{
+	static const char *counterNames[PROFILE_COUNTERS] = { "steps", "sub-steps", "blocks tested", "early-outs", "narrowphase hits" };
+	return counterNames[counter];
+}
+
+//return the number of frames in the history
+int Profiler::getFrameCount() const
+{
+	return frameCount;
+}
+
+//return a frame of the history a number of frames older than the last one closed
+const ProfileFrame& Profiler::getFrame(int age) const
+{
+	return history[(newest - age + PROFILE_HISTORY) % PROFILE_HISTORY];
+}
+
+//Write the history to a CSV file, one line a frame, oldest first, return false if it can't be written
+bool Profiler::writeCsv(const std::string &fileName) const
+{
+	FILE *file = fopen(fileName.c_str(), "w");
+	if (!file)
+		return false;
+	fprintf(file, "frame,start_ms,frame_ms");
+	for (int i = 0; i < sectionCount; i++)
+		fprintf(file, ",%s_ms", names[i]);
+	for (int i = 0; i < PROFILE_COUNTERS; i++)
+		fprintf(file, ",%s", getCounterName(i));
+	fprintf(file, "\n");
+	for (int age = frameCount - 1; age >= 0; age--)
+	{
+		const ProfileFrame &frame = getFrame(age);
+		fprintf(file, "%lld,%.3f,%.3f", frame.number, (frame.start - origin) / 1e6, frame.duration / 1e6);
+		for (int i = 0; i < sectionCount; i++)
+			fprintf(file, ",%.4f", frame.sections[i] / 1e6);
+		for (int i = 0; i < PROFILE_COUNTERS; i++)
+			fprintf(file, ",%lld", frame.counters[i]);
+		fprintf(file, "\n");
+	}
+	return fclose(file) == 0;
+}
+
+//Write every thread's latest timed sections and the counters of every frame of the history to a Chrome trace file, return false if it can't be written
+bool Profiler::writeTrace(const std::string &fileName) const
+{
+	//the Trace Event Format chrome://tracing and Perfetto open: a complete ("X") event for every timed run, on the row of the
+	//thread that ran it, and a counter ("C") event for every frame; times are in microseconds
+	FILE *file = fopen(fileName.c_str(), "w");
+	if (!file)
+		return false;
+	fprintf(file, "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n");
+	const char *separator = "";
+	for (const std::unique_ptr<ThreadLog> &log : logs)
+		for (size_t i = 0; i < PROFILE_TRACE_EVENTS; i++)
+		{
+			const TraceEvent &event = log->events[(log->nextEvent + i) % PROFILE_TRACE_EVENTS];
+			if (event.section < 0)
+				continue;
+			fprintf(file, "%s{\"name\": \"%s\", \"ph\": \"X\", \"pid\": 1, \"tid\": %d, \"ts\": %.3f, \"dur\": %.3f}", separator, names[event.section],
+				log->thread, (event.start - origin) / 1e3, event.duration / 1e3);
+			separator = ",\n";
+		}
+	for (int age = frameCount - 1; age >= 0; age--)
+	{
+		const ProfileFrame &frame = getFrame(age);
+		fprintf(file, "%s{\"name\": \"counters\", \"ph\": \"C\", \"pid\": 1, \"ts\": %.3f, \"args\": {", separator, (frame.start - origin) / 1e3);
+		for (int i = 0; i < PROFILE_COUNTERS; i++)
+			fprintf(file, "%s\"%s\": %lld", i > 0 ? ", " : "", getCounterName(i), frame.counters[i]);
+		fprintf(file, "}}");
+		separator = ",\n";
+	}
+	fprintf(file, "\n]}\n");
+	return fclose(file) == 0;
+}
+
+//return the calling thread's log, creating it the first time the thread logs anything
+Profiler::ThreadLog& Profiler::local()
+{
+	thread_local ThreadLog *log = nullptr;
+	if (!log)
+	{
+		std::unique_ptr<ThreadLog> created(new ThreadLog());
+		memset(created->sections, 0, sizeof(created->sections));
+		memset(created->counters, 0, sizeof(created->counters));
+		TraceEvent empty = { -1, 0, 0 };
+		created->events.assign(PROFILE_TRACE_EVENTS, empty);
+		created->nextEvent = 0;
+		std::lock_guard<std::mutex> lock(mutex);
+		created->thread = (int)logs.size();
+		log = created.get();
+		logs.push_back(std::move(created));
+	}
+	return *log;
+}
+
+//Constructor, no sections and an empty history
+Profiler::Profiler()
+{
+	origin = now();
+	sectionCount = 0;
+	history.resize(PROFILE_HISTORY);
+	newest = PROFILE_HISTORY - 1;
+	frameCount = 0;
+	frameStart = origin;
+	frameNumber = 0;
+}
@@ -0,0 +1,163 @@
+/* Program name: profiler.h
+*  Author: Cory Knoll
+*  Date Last Modified: 10/17/2026
+*  Description: Frame profiler: scoped timers and counters for the hot path of the physics and the game, kept per frame for an on-screen overlay and exported as CSV or a Chrome trace; only built into the program when PROFILING is defined (no Qt dependency)
+	================================================================
+	FUNCTIONS:
+	+ static Profiler& instance() - return the one profiler of the program
+	+ static long long now() - return the nanoseconds on the steady clock, which every time the profiler keeps is read from
+	+ int section(const char*) - return the number of a named section, adding it the first time it's named (-1 once PROFILE_MAX_SECTIONS are named)
+	+ void add(int, long long, long long) - Add a timed run of a section (its start and duration in nanoseconds) to the calling thread's log
+	+ void count(int, long long) - Add an amount to one of the calling thread's counters
+	+ void endFrame() - Close the frame: total every thread's sections and counters into the history and start the next frame (only call it while no other thread is in a section)
+	+ int getSectionCount() const - return the number of named sections
+	+ const char* getSectionName(int) const - return the name of a section
+	+ static const char* getCounterName(int) - return the name of a counter
+	+ int getFrameCount() const - return the number of frames in the history
+	+ const ProfileFrame& getFrame(int) const - return a frame of the history a number of frames older than the last one closed
+	+ bool writeCsv(const std::string&) const - Write the history to a CSV file, one line a frame, oldest first, return false if it can't be written
+	+ bool writeTrace(const std::string&) const - Write every thread's latest timed sections and the counters of every frame of the history to a Chrome trace file, return false if it can't be written
+	- ThreadLog& local() - return the calling thread's log, creating it the first time the thread logs anything
+	- Profiler() - Constructor, no sections and an empty history
+	+ ProfileScope(int) - Constructor, start timing a section
+	+ ~ProfileScope() - Destructor, add the time since the constructor to the section
+	============================================================================
+	VARIABLES:
+	- long long origin - When the profiler was created, which the exported times count from
+	- const char* names[PROFILE_MAX_SECTIONS] - Name of every section, in the order they were named
+	- int sectionCount - Number of named sections
+	- std::vector<std::unique_ptr<ThreadLog>> logs - Log of every thread that has logged anything
+	- std::vector<ProfileFrame> history - The latest PROFILE_HISTORY frames, oldest overwritten first
+	- int newest - Index in history of the last frame closed
+	- int frameCount - Number of frames in the history
+	- long long frameStart - When the frame being logged started
+	- long long frameNumber - Number of frames closed since the profiler was created
+	- std::mutex mutex - Guards the section names and the list of logs while a section or a thread is added
+	- int section - Section a scope times
+	- long long start - When the scope started
+	============================================================================
+	STRUCTS:
+	+ ProfileFrame - the time spent in every section and every counter's total during one frame
+	+ TraceEvent - one timed run of a section, for the trace export
+	- ThreadLog - the sections, counters and latest timed runs one thread logged during the frame
+	============================================================================
+	CLASSES:
+	+ Profiler - the per-frame times and counters of the program, logged by every thread without locking
+	+ ProfileScope - times a section from its construction to its destruction
+*/
+
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#define PROFILE_MAX_SECTIONS 32		//Most named sections the profiler times
+#define PROFILE_HISTORY 600			//Frames the profiler keeps for the overlay and the exports (about ten seconds of play)
+#define PROFILE_TRACE_EVENTS 65536	//Most timed runs of sections a thread keeps for the trace export, the oldest overwritten first
+#define PROFILE_STEPS 0				//Counter of the physics steps run
+#define PROFILE_SUBSTEPS 1			//Counter of the collisions resolved, each one a sub-step of a ball's frame
+#define PROFILE_BLOCKS_TESTED 2		//Counter of the blocks the narrowphase was asked about
+#define PROFILE_EARLY_OUTS 3		//Counter of the blocks collisionPossible() ruled out before the narrowphase
+#define PROFILE_NARROW_HITS 4		//Counter of the collisions the narrowphase found
+#define PROFILE_COUNTERS 5			//Number of counters
+
+//PROFILE_SCOPE times the rest of the enclosing block as a named section and PROFILE_COUNT adds to a counter; without PROFILING
+//both are nothing at all, so the hot path they sit in compiles exactly as if they weren't there
+#define PROFILE_JOIN(a, b) a##b					//Paste two tokens together
+#define PROFILE_NAME(a, b) PROFILE_JOIN(a, b)		//Paste two tokens together once both are expanded (to give every scope its own name)
+#ifdef PROFILING
+#define PROFILE_SCOPE(name) static const int PROFILE_NAME(profileSection, __LINE__) = Profiler::instance().section(name); \
+	ProfileScope PROFILE_NAME(profileScope, __LINE__)(PROFILE_NAME(profileSection, __LINE__))
+#define PROFILE_COUNT(counter, amount) Profiler::instance().count(counter, amount)
+#else
+#define PROFILE_SCOPE(name)
+#define PROFILE_COUNT(counter, amount)
+#endif
+
+struct ProfileFrame
+{
+	long long number;								//frames closed before this one since the profiler was created
+	long long start;								//when the frame started (nanoseconds on the steady clock)
+	long long duration;								//how long the frame lasted (nanoseconds)
+	long long sections[PROFILE_MAX_SECTIONS];		//time spent in every section, all threads added together (nanoseconds)
+	long long counters[PROFILE_COUNTERS];			//total of every counter, all threads added together
+};
+
+struct TraceEvent
+{
+	int section;		//section timed
+	long long start;	//when the run started (nanoseconds on the steady clock)
+	long long duration;	//how long the run lasted (nanoseconds)
+};
+
+class Profiler
+{
+public:
+	static Profiler& instance();
+		//return the one profiler of the program
+	static long long now() { return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count(); }
+		//return the nanoseconds on the steady clock, which every time the profiler keeps is read from
+	int section(const char*);
+		//return the number of a named section, adding it the first time it's named (-1 once PROFILE_MAX_SECTIONS are named)
+	void add(int, long long, long long);
+		//Add a timed run of a section (its start and duration in nanoseconds) to the calling thread's log
+	void count(int, long long);
+		//Add an amount to one of the calling thread's counters
+	void endFrame();
+		//Close the frame: total every thread's sections and counters into the history and start the next frame (only call it while no other thread is in a section)
+	int getSectionCount() const;
+		//return the number of named sections
+	const char* getSectionName(int) const;
+		//return the name of a section
+	static const char* getCounterName(int);
+		//return the name of a counter
+	int getFrameCount() const;
+		//return the number of frames in the history
+	const ProfileFrame& getFrame(int) const;
+		//return a frame of the history a number of frames older than the last one closed
+	bool writeCsv(const std::string&) const;
+		//Write the history to a CSV file, one line a frame, oldest first, return false if it can't be written
+	bool writeTrace(const std::string&) const;
+		//Write every thread's latest timed sections and the counters of every frame of the history to a Chrome trace file, return false if it can't be written
+private:
+	struct ThreadLog
+	{
+		int thread;									//number of the thread in the trace, in the order threads first logged
+		long long sections[PROFILE_MAX_SECTIONS];	//time spent in every section this frame (nanoseconds)
+		long long counters[PROFILE_COUNTERS];		//total of every counter this frame
+		std::vector<TraceEvent> events;				//latest PROFILE_TRACE_EVENTS timed runs, oldest overwritten first
+		size_t nextEvent;							//index in events the next run is written to
+	};
+	ThreadLog& local();
+		//return the calling thread's log, creating it the first time the thread logs anything
+	Profiler();
+		//Constructor, no sections and an empty history
+	long long origin;									//When the profiler was created, which the exported times count from
+	const char *names[PROFILE_MAX_SECTIONS];			//Name of every section, in the order they were named
+	int sectionCount;									//Number of named sections
+	std::vector<std::unique_ptr<ThreadLog>> logs;		//Log of every thread that has logged anything
+	std::vector<ProfileFrame> history;					//The latest PROFILE_HISTORY frames, oldest overwritten first
+	int newest;											//Index in history of the last frame closed
+	int frameCount;										//Number of frames in the history
+	long long frameStart;								//When the frame being logged started
+	long long frameNumber;								//Number of frames closed since the profiler was created
+	std::mutex mutex;									//Guards the section names and the list of logs while a section or a thread is added
+};
+
+class ProfileScope
+{
+public:
+	ProfileScope(int sectionNumber) { section = sectionNumber; start = Profiler::now(); }
+		//Constructor, start timing a section
+	~ProfileScope() { Profiler::instance().add(section, start, Profiler::now() - start); }
+		//Destructor, add the time since the constructor to the section
+private:
+	int section;		//Section a scope times
+	long long start;	//When the scope started
+};
+
+#endif //PROFILER_H
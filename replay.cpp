@@ -0,0 +1,597 @@
+/* Program name: replay.cpp
+*  Author: Cory Knoll
+*  Date Last Modified: 10/17/2026
+*  Description: Record the inputs of a level's play (with periodic keyframes of the simulation) into a compact binary replay, and play a replay back headlessly: seek to any frame from the nearest keyframe or re-simulate the whole run (no Qt dependency)
+	================================================================
+	FUNCTIONS:
+	+ std::string replayFileName(int) - return the name of the replay file for a level number
+	+ unsigned long long replaySignature(const World&) - return a checksum of the balls and blocks of a world, to tell the level a replay was recorded on
+	+ void begin(int, const World&, int = REPLAY_KEYFRAME_INTERVAL) - Start a new recording of a level whose world is at its start, with a keyframe every number of frames (0 for none)
+	+ void launch(int, double) - Record the launch of the playerBall with an angle and magnitude
+	+ void pause() - Record that the game was paused
+	+ void resume() - Record that the game was resumed
+	+ void reset() - Record that the level was reset
+	+ void restore(const World&) - Record that the game was rewound, with the state the simulation of a world was put back in
+	+ void step(const World&) - Count a frame the world was stepped, recording a keyframe of its simulation if one is due
+	+ void finish() - End the recording, after which nothing more is recorded until the next begin
+	+ bool save(const std::string&) - End the recording and write it to a replay file, return false if the file can't be written
+	+ const std::vector<unsigned char>& getData() const - return the bytes recorded so far
+	+ int getFrame() const - return the number of frames recorded
+	+ bool isRecording() const - return true if a recording was begun and not finished
+	+ ReplayRecorder() - Constructor, nothing recorded
+	- void writeVarint(unsigned long long) - Append an unsigned number in as few bytes as it needs, seven bits a byte
+	- void writeRecord(int) - Append the kind of a record and the frames since the record before it
+	- void writeKeyframe(int, const World&) - Append a keyframe (or a restore) of the simulation of a world, every word as the difference from the last one
+	+ bool open(const std::string&) - Read a replay file, return false if it can't be read or isn't a valid replay
+	+ bool decode(const std::vector<unsigned char>&) - Read a replay from its bytes, return false (and hold nothing) if it isn't a valid replay
+	+ int getLevelNumber() const - return the number of the level the replay was recorded on
+	+ int getBallCount() const - return the number of balls of the level the replay was recorded on
+	+ int getFrameCount() const - return the number of frames the replay lasts
+	+ int getKeyframeCount() const - return the number of keyframes (and restores) of the replay
+	+ const std::vector<ReplayRecord>& getRecords() const - return the inputs, keyframes and end of the replay, in the order they were recorded
+	+ bool matches(const World&) const - return true if a world at its level's start is the level the replay was recorded on
+	+ bool seek(World&, int) const - Put a world in the state it was in a number of frames into the replay, starting from the nearest keyframe (or restore) before it, return false if the world isn't the replay's level
+	+ bool simulate(World&, int&, int&) const - Re-simulate the whole replay from the level's start, set the frame the goal was hit (-1 if never) and the first keyframe the world disagreed with (-1 if none), return false if the world isn't the replay's level
+	+ ReplayPlayer() - Constructor, no replay
+	- void runTo(World&, const std::vector<unsigned long long>&, int&, int&, int, int&, int&) const - Apply the records from the next one on (to a world whose level starts in some state), stepping the world (and counting its frames) up to each one's frame, until a frame is reached with its records applied; set the frame the goal was hit and the first keyframe the world disagreed with, unless they're set already
+	- void restore(World&, const ReplayRecord&, const std::vector<unsigned long long>&) const - Put the simulation of a world whose level starts in some state in the state of a keyframe (or a restore)
+	- bool agrees(const World&, const ReplayRecord&, const std::vector<unsigned long long>&) const - return true if the simulation of a world whose level starts in some state is exactly in the state of a keyframe
+	- unsigned long long bitsOf(double) - return the bits of a double
+	- void stateBits(const World&, std::vector<unsigned long long>&) - Set the words of the state of the simulation of a world
+	- double doubleOf(unsigned long long) - return the double with some bits
+	- unsigned long long mixSignature(unsigned long long, double) - return a signature with one more value folded in
+	- void writeFixed(std::vector<unsigned char>&, unsigned long long) - Append a number as eight bytes, little endian
+	- bool readVarint(const std::vector<unsigned char>&, size_t&, size_t, unsigned long long&) - Read a varint from bytes up to an end, moving past it, return false if it runs past the end or is too long
+	- bool readFixed(const std::vector<unsigned char>&, size_t&, size_t, unsigned long long&) - Read a number of eight bytes, little endian, moving past it, return false if it runs past the end
+	============================================================================
+	VARIABLES:
+	- std::vector<unsigned char> data - Bytes of the recording
+	- int frame - Frames recorded since the recording began
+	- int lastFrame - Frame of the last record written
+	- int keyframeInterval - Frames between two keyframes, 0 for none
+	- bool recording - A recording was begun and not finished
+	- std::vector<unsigned long long> reference - Bits of every value of the last keyframe (the level's start before the first), which the next keyframe is written as the difference from
+	- int levelNumber - Number of the level the replay was recorded on
+	- int ballCount - Number of balls of the level the replay was recorded on
+	- int stateWords - Eight byte words of the state of the simulation of the level the replay was recorded on
+	- unsigned long long signature - replaySignature() of the level's world at its start
+	- int frameCount - Number of frames the replay lasts
+	- std::vector<ReplayRecord> records - Inputs, keyframes and end of the replay, in the order they were recorded
+	- std::vector<int> keyframes - Index in records of every keyframe and restore, in frame order
+	- std::vector<unsigned long long> states - Words of the state of the simulation of every keyframe, as the difference from the words at the level's start
+	============================================================================
+	STRUCTS:
+	+ ReplayRecord - one input, keyframe or the end of a replay, with the frame it happened on
+	============================================================================
+	CLASSES:
+	+ ReplayRecorder - the replay of a level being recorded while it's played
+	+ ReplayPlayer - a replay read back, which puts a world in the state of any of its frames
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include "compiledlevel.h"
+#include "replay.h"
+
+//return the bits of a double
+static unsigned long long bitsOf(double value)
+{
+	unsigned long long bits;
+	memcpy(&bits, &value, sizeof(bits));
+	return bits;
+}
+
+//Set the words of the state of the simulation of a world
+static void stateBits(const World &world, std::vector<unsigned long long> &bits)
+{
+	//a keyframe is the same state a snapshot is: the balls, the time (which is where the moving blocks are), and the blocks with mass
+	//with the impulses the solver kept for them, which a step starts from just as it does from the balls. Every part of it is made
+	//of eight byte values, so it's taken as words and each is diffed like a double
+	bits.assign(world.getStateSize() / sizeof(unsigned long long), 0);
+	world.saveState(bits.data());
+}
+
+//return the double with some bits
+static double doubleOf(unsigned long long bits)
+{
+	double value;
+	memcpy(&value, &bits, sizeof(value));
+	return value;
+}
+
+//return a signature with one more value folded in
+static unsigned long long mixSignature(unsigned long long hash, double value)
+{
+	//the same FNV-1a step levelChecksum() folds each eight bytes in with
+	return (hash ^ bitsOf(value)) * 1099511628211ull;
+}
+
+//Append a number as eight bytes, little endian
+static void writeFixed(std::vector<unsigned char> &bytes, unsigned long long value)
+{
+	for (int i = 0; i < 8; i++)
+		bytes.push_back((unsigned char)(value >> (8 * i)));
+}
+
+//Read a varint from bytes up to an end, moving past it, return false if it runs past the end or is too long
+static bool readVarint(const std::vector<unsigned char> &bytes, size_t &at, size_t end, unsigned long long &value)
+{
+	value = 0;
+	for (int shift = 0; shift < 64 && at < end; shift += 7)
+	{
+		unsigned char byte = bytes[at++];
+		value |= (unsigned long long)(byte & 0x7f) << shift;
+		if (!(byte & 0x80))
+			return true;
+	}
+	return false;
+}
+
+//Read a number of eight bytes, little endian, moving past it, return false if it runs past the end
+static bool readFixed(const std::vector<unsigned char> &bytes, size_t &at, size_t end, unsigned long long &value)
+{
+	if (end - at < 8)
+		return false;
+	value = 0;
+	for (int i = 0; i < 8; i++)
+		value |= (unsigned long long)bytes[at++] << (8 * i);
+	return true;
+}
+
+//return the name of the replay file for a level number
+std::string replayFileName(int levelNumber)
+{
+	return "lvl" + std::to_string(levelNumber) + ".rpl";
+}
+
+//return a checksum of the balls and blocks of a world, to tell the level a replay was recorded on
+unsigned long long replaySignature(const World &world)
+{
+	//a replay is only inputs: played on a level with a block moved, it would play out differently without saying so
+	unsigned long long hash = 14695981039346656037ull;
+	const BodyStore &bodies = world.getBodies();
+	hash = mixSignature(hash, bodies.size());
+	for (int i = 0; i < bodies.size(); i++)
+	{
+		hash = mixSignature(hash, bodies.x[i]);
+		hash = mixSignature(hash, bodies.y[i]);
+		hash = mixSignature(hash, bodies.vx[i]);
+		hash = mixSignature(hash, bodies.vy[i]);
+		hash = mixSignature(hash, bodies.radius[i]);
+		hash = mixSignature(hash, bodies.invMass[i]);
+	}
+	for (int i = -1; i < world.getBlockCount(); i++)
+	{
+		const BlockBody &block = i < 0 ? world.getGoalBlock() : world.getBlock(i);
+		const Material &material = world.getMaterial(block.material);
+		hash = mixSignature(hash, block.xMin);
+		hash = mixSignature(hash, block.yMin);
+		hash = mixSignature(hash, block.xMax);
+		hash = mixSignature(hash, block.yMax);
+		hash = mixSignature(hash, material.restitution);
+		hash = mixSignature(hash, material.friction);
+	}
+	for (const BlockBody &block : world.getDynamicBlocks())
+	{
+		const Material &material = world.getMaterial(block.material);
+		const double values[] = { block.xMin, block.yMin, block.xMax, block.yMax, block.vx, block.vy, block.invMass, material.restitution, material.friction };
+		for (double value : values)
+			hash = mixSignature(hash, value);
+	}
+	for (int i = 0; i < world.getMoverCount(); i++)
+	{
+		const MoverData &path = world.getMoverPath(i);
+		const Material &material = world.getMaterial(world.getMover(i, 0).material);
+		const double values[] = { path.x, path.y, path.width, path.height, path.dx, path.dy, path.period, path.phase, (double)path.kind,
+			material.restitution, material.friction };
+		for (double value : values)
+			hash = mixSignature(hash, value);
+	}
+	for (int i = 0; i < world.getPolygonCount(); i++)
+	{
+		const SweepPolygon &polygon = world.getPolygon(i);
+		const Material &material = world.getMaterial(world.getPolygonBounds(i).material);
+		hash = mixSignature(hash, polygon.count);
+		for (int j = 0; j < polygon.count; j++)
+		{
+			hash = mixSignature(hash, polygon.points[j].x);
+			hash = mixSignature(hash, polygon.points[j].y);
+		}
+		hash = mixSignature(hash, material.restitution);
+		hash = mixSignature(hash, material.friction);
+	}
+	return hash;
+}
+
+//Start a new recording of a level whose world is at its start, with a keyframe every number of frames (0 for none)
+void ReplayRecorder::begin(int levelNumber, const World &world, int interval)
+{
+	data.assign(REPLAY_MAGIC, REPLAY_MAGIC + 8);
+	frame = 0;
+	lastFrame = 0;
+	keyframeInterval = std::max(interval, 0);
+	recording = true;
+	writeVarint(REPLAY_VERSION);
+	writeVarint(levelNumber);
+	writeVarint(world.getBallCount());
+	writeVarint(world.getStateSize() / sizeof(unsigned long long));
+	writeVarint(keyframeInterval);
+	writeFixed(data, replaySignature(world));
+
+	//the first keyframe is written as the difference from the level's start, which the player has from the level itself
+	stateBits(world, reference);
+}
+
+//Record the launch of the playerBall with an angle and magnitude
+void ReplayRecorder::launch(int angle, double magnitude)
+{
+	if (!recording)
+		return;
+	writeRecord(REPLAY_LAUNCH);
+	writeVarint(angle);
+	writeFixed(data, bitsOf(magnitude));
+}
+
+//Record that the game was paused
+void ReplayRecorder::pause()
+{
+	if (recording)
+		writeRecord(REPLAY_PAUSE);
+}
+
+//Record that the game was resumed
+void ReplayRecorder::resume()
+{
+	if (recording)
+		writeRecord(REPLAY_RESUME);
+}
+
+//Record that the level was reset
+void ReplayRecorder::reset()
+{
+	if (recording)
+		writeRecord(REPLAY_RESET);
+}
+
+//Record that the game was rewound, with the state the simulation of a world was put back in
+void ReplayRecorder::restore(const World &world)
+{
+	//a rewind breaks the chain of frames that follow from the inputs, so the state it lands on is kept whole, the way a keyframe is
+	if (recording)
+		writeKeyframe(REPLAY_RESTORE, world);
+}
+
+//Count a frame the world was stepped, recording a keyframe of its simulation if one is due
+void ReplayRecorder::step(const World &world)
+{
+	if (!recording)
+		return;
+	frame++;
+	if (keyframeInterval > 0 && frame % keyframeInterval == 0)
+		writeKeyframe(REPLAY_KEYFRAME, world);
+}
+
+//End the recording, after which nothing more is recorded until the next begin
+void ReplayRecorder::finish()
+{
+	if (!recording)
+		return;
+	writeRecord(REPLAY_END);
+	writeFixed(data, levelChecksum(data.data(), data.size()));
+	recording = false;
+}
+
+//End the recording and write it to a replay file, return false if the file can't be written
+bool ReplayRecorder::save(const std::string &fileName)
+{
+	finish();
+	if (data.empty())
+		return false;
+	std::ofstream replayFile(fileName, std::ios::binary);
+	if (!replayFile.is_open())
+		return false;
+	replayFile.write((const char*)data.data(), data.size());
+	return replayFile.good();
+}
+
+//return the bytes recorded so far
+const std::vector<unsigned char>& ReplayRecorder::getData() const
+{
+	return data;
+}
+
+//return the number of frames recorded
+int ReplayRecorder::getFrame() const
+{
+	return frame;
+}
+
+//return true if a recording was begun and not finished
+bool ReplayRecorder::isRecording() const
+{
+	return recording;
+}
+
+//Constructor, nothing recorded
+ReplayRecorder::ReplayRecorder()
+{
+	frame = 0;
+	lastFrame = 0;
+	keyframeInterval = REPLAY_KEYFRAME_INTERVAL;
+	recording = false;
+}
+
+//Append an unsigned number in as few bytes as it needs, seven bits a byte
+void ReplayRecorder::writeVarint(unsigned long long value)
+{
+	while (value >= 0x80)
+	{
+		data.push_back((unsigned char)(value | 0x80));
+		value >>= 7;
+	}
+	data.push_back((unsigned char)value);
+}
+
+//Append the kind of a record and the frames since the record before it
+void ReplayRecorder::writeRecord(int kind)
+{
+	data.push_back((unsigned char)kind);
+	writeVarint(frame - lastFrame);
+	lastFrame = frame;
+}
+
+//Append a keyframe (or a restore) of the simulation of a world, every word as the difference from the last one
+void ReplayRecorder::writeKeyframe(int kind, const World &world)
+{
+	//the difference is taken between the bits of the doubles, so the keyframe restores them exactly and the replay plays on from it
+	//just as the game did: a ball at rest costs a byte a value, and a ball that moved a little only changes the low bits of the
+	//mantissa. Zigzag maps differences of either sign to small unsigned numbers
+	writeRecord(kind);
+	std::vector<unsigned long long> bits;
+	stateBits(world, bits);
+	for (size_t i = 0; i < bits.size(); i++)
+	{
+		long long difference = (long long)(bits[i] - reference[i]);
+		writeVarint(((unsigned long long)difference << 1) ^ (unsigned long long)(difference >> 63));
+	}
+	reference.swap(bits);
+}
+
+//Read a replay file, return false if it can't be read or isn't a valid replay
+bool ReplayPlayer::open(const std::string &fileName)
+{
+	std::ifstream replayFile(fileName, std::ios::binary);
+	if (!replayFile.is_open())
+	{
+		decode(std::vector<unsigned char>());
+		return false;
+	}
+	std::vector<unsigned char> bytes((std::istreambuf_iterator<char>(replayFile)), std::istreambuf_iterator<char>());
+	return decode(bytes);
+}
+
+//Read a replay from its bytes, return false (and hold nothing) if it isn't a valid replay
+bool ReplayPlayer::decode(const std::vector<unsigned char> &bytes)
+{
+	levelNumber = 0;
+	ballCount = 0;
+	stateWords = 0;
+	signature = 0;
+	frameCount = 0;
+	records.clear();
+	keyframes.clear();
+	states.clear();
+
+	//the checksum covers everything before it, so nothing after this reads a byte that wasn't written by a recorder
+	unsigned long long value, checksum;
+	size_t at = 0, end = bytes.size() < 16 ? 0 : bytes.size() - 8, checksumAt = end;
+	if (end == 0 || memcmp(bytes.data(), REPLAY_MAGIC, 8) != 0 || !readFixed(bytes, checksumAt, bytes.size(), checksum)
+		|| checksum != levelChecksum(bytes.data(), end))
+		return false;
+	at = 8;
+	//the keyframe interval only tells a reader how far apart the keyframes are meant to be; the records say where they are
+	unsigned long long version, number, balls, words, interval;
+	if (!readVarint(bytes, at, end, version) || version != REPLAY_VERSION || !readVarint(bytes, at, end, number)
+		|| !readVarint(bytes, at, end, balls) || balls == 0 || balls > (end - at) || !readVarint(bytes, at, end, words)
+		|| words == 0 || words > (end - at) || !readVarint(bytes, at, end, interval) || !readFixed(bytes, at, end, signature))
+	{
+		signature = 0;
+		return false;
+	}
+
+	//the first keyframe is the difference from the level's start, which only the level has, so each keyframe is kept as the sum of
+	//the differences up to it: the difference from the level's start, which the world is at whenever one is applied
+	std::vector<unsigned long long> reference(words, 0);
+	std::vector<ReplayRecord> read;
+	std::vector<unsigned long long> values;
+	int frame = 0;
+	bool ended = false;
+	while (!ended && at < end)
+	{
+		ReplayRecord record = { bytes[at++], 0, 0, 0, -1 };
+		if (!readVarint(bytes, at, end, value) || value > (unsigned long long)(0x7fffffff - frame))
+			break;
+		frame += (int)value;
+		record.frame = frame;
+		if (record.kind == REPLAY_LAUNCH)
+		{
+			unsigned long long angle, magnitude;
+			if (!readVarint(bytes, at, end, angle) || angle >= 360 || !readFixed(bytes, at, end, magnitude))
+				break;
+			record.angle = (int)angle;
+			record.magnitude = doubleOf(magnitude);
+		}
+		else if (record.kind == REPLAY_KEYFRAME || record.kind == REPLAY_RESTORE)
+		{
+			record.state = (int)values.size();
+			size_t j = 0;
+			for (; j < reference.size() && readVarint(bytes, at, end, value); j++)
+			{
+				reference[j] += (value >> 1) ^ (0 - (value & 1));
+				values.push_back(reference[j]);
+			}
+			if (j < reference.size())
+				break;
+		}
+		else if (record.kind == REPLAY_END)
+			ended = true;
+		else if (record.kind != REPLAY_PAUSE && record.kind != REPLAY_RESUME && record.kind != REPLAY_RESET)
+			break;
+		read.push_back(record);
+	}
+	if (!ended || at != end)
+	{
+		signature = 0;
+		return false;
+	}
+
+	levelNumber = (int)number;
+	ballCount = (int)balls;
+	stateWords = (int)words;
+	frameCount = frame;
+	records.swap(read);
+	states.swap(values);
+	for (int i = 0; i < (int)records.size(); i++)
+		if (records[i].kind == REPLAY_KEYFRAME || records[i].kind == REPLAY_RESTORE)
+			keyframes.push_back(i);
+	return true;
+}
+
+//return the number of the level the replay was recorded on
+int ReplayPlayer::getLevelNumber() const
+{
+	return levelNumber;
+}
+
+//return the number of balls of the level the replay was recorded on
+int ReplayPlayer::getBallCount() const
+{
+	return ballCount;
+}
+
+//return the number of frames the replay lasts
+int ReplayPlayer::getFrameCount() const
+{
+	return frameCount;
+}
+
+//return the number of keyframes (and restores) of the replay
+int ReplayPlayer::getKeyframeCount() const
+{
+	return (int)keyframes.size();
+}
+
+//return the inputs, keyframes and end of the replay, in the order they were recorded
+const std::vector<ReplayRecord>& ReplayPlayer::getRecords() const
+{
+	return records;
+}
+
+//return true if a world at its level's start is the level the replay was recorded on
+bool ReplayPlayer::matches(const World &world) const
+{
+	return !records.empty() && world.getBallCount() == ballCount && world.getStateSize() == stateWords * sizeof(unsigned long long)
+		&& replaySignature(world) == signature;
+}
+
+//Put a world in the state it was in a number of frames into the replay, starting from the nearest keyframe (or restore) before it, return false if the world isn't the replay's level
+bool ReplayPlayer::seek(World &world, int target) const
+{
+	world.restart();
+	if (!matches(world))
+		return false;
+	std::vector<unsigned long long> start;
+	stateBits(world, start);
+
+	//the last keyframe at or before the frame holds every ball exactly as it was, so only the frames after it are simulated: a seek
+	//costs at most a keyframe interval of steps wherever it lands
+	int next = 0, frame = 0, goalFrame = -1, desyncFrame = -1;
+	auto keyframe = std::upper_bound(keyframes.begin(), keyframes.end(), target,
+		[this](int frame, int index) { return frame < records[index].frame; });
+	if (keyframe != keyframes.begin())
+	{
+		next = *(keyframe - 1);
+		frame = records[next].frame;
+		restore(world, records[next], start);
+		next++;
+	}
+	runTo(world, start, next, frame, std::min(target, frameCount), goalFrame, desyncFrame);
+	return true;
+}
+
+//Re-simulate the whole replay from the level's start, set the frame the goal was hit (-1 if never) and the first keyframe the world disagreed with (-1 if none), return false if the world isn't the replay's level
+bool ReplayPlayer::simulate(World &world, int &goalFrame, int &desyncFrame) const
+{
+	goalFrame = -1;
+	desyncFrame = -1;
+	world.restart();
+	if (!matches(world))
+		return false;
+	std::vector<unsigned long long> start;
+	stateBits(world, start);
+	int next = 0, frame = 0;
+	runTo(world, start, next, frame, frameCount, goalFrame, desyncFrame);
+	return true;
+}
+
+//Constructor, no replay
+ReplayPlayer::ReplayPlayer()
+{
+	levelNumber = 0;
+	ballCount = 0;
+	stateWords = 0;
+	signature = 0;
+	frameCount = 0;
+}
+
+//Apply the records from the next one on, stepping the world (and counting its frames) up to each one's frame, until a frame is reached with its records applied; set the frame the goal was hit and the first keyframe the world disagreed with, unless they're set already
+void ReplayPlayer::runTo(World &world, const std::vector<unsigned long long> &start, int &next, int &frame, int target, int &goalFrame, int &desyncFrame) const
+{
+	for (;;)
+	{
+		int until = next < (int)records.size() ? std::min(records[next].frame, target) : target;
+		for (; frame < until; frame++)
+			if (world.step(1.0) && goalFrame < 0)
+				goalFrame = frame + 1;
+		if (next >= (int)records.size() || records[next].frame > target)
+			return;
+
+		//pausing and resuming only stop the clock, never the physics, so they're kept for whoever reads the replay but change nothing
+		const ReplayRecord &record = records[next++];
+		if (record.kind == REPLAY_LAUNCH)
+		{
+			//the same velocity the game's launch sets for this angle and magnitude
+			Vec2D velocity = Vec2D(cos(record.angle * 3.14159 / 180), sin(record.angle * 3.14159 / 180)) * record.magnitude;
+			world.setBallVelocity(0, velocity.x, velocity.y);
+		}
+		else if (record.kind == REPLAY_RESET)
+			world.restart();
+		else if (record.kind == REPLAY_RESTORE)
+			restore(world, record, start);
+		else if (record.kind == REPLAY_KEYFRAME && desyncFrame < 0 && !agrees(world, record, start))
+			desyncFrame = record.frame;
+	}
+}
+
+//Put the simulation of a world in the state of a keyframe (or a restore)
+void ReplayPlayer::restore(World &world, const ReplayRecord &keyframe, const std::vector<unsigned long long> &start) const
+{
+	std::vector<unsigned long long> bits(start.size());
+	for (size_t i = 0; i < bits.size(); i++)
+		bits[i] = start[i] + states[keyframe.state + i];
+	world.loadState(bits.data());
+}
+
+//return true if the simulation of a world is exactly in the state of a keyframe
+bool ReplayPlayer::agrees(const World &world, const ReplayRecord &keyframe, const std::vector<unsigned long long> &start) const
+{
+	std::vector<unsigned long long> bits;
+	stateBits(world, bits);
+	for (size_t i = 0; i < bits.size(); i++)
+		if (bits[i] != start[i] + states[keyframe.state + i])
+			return false;
+	return true;
+}
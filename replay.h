@@ -0,0 +1,198 @@
+/* Program name: replay.h
+*  Author: Cory Knoll
+*  Date Last Modified: 10/17/2026
+*  Description: Record the inputs of a level's play (with periodic keyframes of the simulation) into a compact binary replay, and play a replay back headlessly: seek to any frame from the nearest keyframe or re-simulate the whole run (no Qt dependency)
+	================================================================
+	FUNCTIONS:
+	+ std::string replayFileName(int) - return the name of the replay file for a level number
+	+ unsigned long long replaySignature(const World&) - return a checksum of the balls and blocks of a world, to tell the level a replay was recorded on
+	+ void begin(int, const World&, int = REPLAY_KEYFRAME_INTERVAL) - Start a new recording of a level whose world is at its start, with a keyframe every number of frames (0 for none)
+	+ void launch(int, double) - Record the launch of the playerBall with an angle and magnitude
+	+ void pause() - Record that the game was paused
+	+ void resume() - Record that the game was resumed
+	+ void reset() - Record that the level was reset
+	+ void restore(const World&) - Record that the game was rewound, with the state the simulation of a world was put back in
+	+ void step(const World&) - Count a frame the world was stepped, recording a keyframe of its simulation if one is due
+	+ void finish() - End the recording, after which nothing more is recorded until the next begin
+	+ bool save(const std::string&) - End the recording and write it to a replay file, return false if the file can't be written
+	+ const std::vector<unsigned char>& getData() const - return the bytes recorded so far
+	+ int getFrame() const - return the number of frames recorded
+	+ bool isRecording() const - return true if a recording was begun and not finished
+	+ ReplayRecorder() - Constructor, nothing recorded
+	- void writeVarint(unsigned long long) - Append an unsigned number in as few bytes as it needs, seven bits a byte
+	- void writeRecord(int) - Append the kind of a record and the frames since the record before it
+	- void writeKeyframe(int, const World&) - Append a keyframe (or a restore) of the simulation of a world, every word as the difference from the last one
+	+ bool open(const std::string&) - Read a replay file, return false if it can't be read or isn't a valid replay
+	+ bool decode(const std::vector<unsigned char>&) - Read a replay from its bytes, return false (and hold nothing) if it isn't a valid replay
+	+ int getLevelNumber() const - return the number of the level the replay was recorded on
+	+ int getBallCount() const - return the number of balls of the level the replay was recorded on
+	+ int getFrameCount() const - return the number of frames the replay lasts
+	+ int getKeyframeCount() const - return the number of keyframes (and restores) of the replay
+	+ const std::vector<ReplayRecord>& getRecords() const - return the inputs, keyframes and end of the replay, in the order they were recorded
+	+ bool matches(const World&) const - return true if a world at its level's start is the level the replay was recorded on
+	+ bool seek(World&, int) const - Put a world in the state it was in a number of frames into the replay, starting from the nearest keyframe (or restore) before it, return false if the world isn't the replay's level
+	+ bool simulate(World&, int&, int&) const - Re-simulate the whole replay from the level's start, set the frame the goal was hit (-1 if never) and the first keyframe the world disagreed with (-1 if none), return false if the world isn't the replay's level
+	+ ReplayPlayer() - Constructor, no replay
+	- void runTo(World&, const std::vector<unsigned long long>&, int&, int&, int, int&, int&) const - Apply the records from the next one on (to a world whose level starts in some state), stepping the world (and counting its frames) up to each one's frame, until a frame is reached with its records applied; set the frame the goal was hit and the first keyframe the world disagreed with, unless they're set already
+	- void restore(World&, const ReplayRecord&, const std::vector<unsigned long long>&) const - Put the simulation of a world whose level starts in some state in the state of a keyframe (or a restore)
+	- bool agrees(const World&, const ReplayRecord&, const std::vector<unsigned long long>&) const - return true if the simulation of a world whose level starts in some state is exactly in the state of a keyframe
+	============================================================================
+	VARIABLES:
+	- std::vector<unsigned char> data - Bytes of the recording
+	- int frame - Frames recorded since the recording began
+	- int lastFrame - Frame of the last record written
+	- int keyframeInterval - Frames between two keyframes, 0 for none
+	- bool recording - A recording was begun and not finished
+	- std::vector<unsigned long long> reference - Bits of every value of the last keyframe (the level's start before the first), which the next keyframe is written as the difference from
+	- int levelNumber - Number of the level the replay was recorded on
+	- int ballCount - Number of balls of the level the replay was recorded on
+	- int stateWords - Eight byte words of the state of the simulation of the level the replay was recorded on
+	- unsigned long long signature - replaySignature() of the level's world at its start
+	- int frameCount - Number of frames the replay lasts
+	- std::vector<ReplayRecord> records - Inputs, keyframes and end of the replay, in the order they were recorded
+	- std::vector<int> keyframes - Index in records of every keyframe and restore, in frame order
+	- std::vector<unsigned long long> states - Words of the state of the simulation of every keyframe, as the difference from the words at the level's start
+	============================================================================
+	REPLAY FILE FORMAT (varint: seven bits a byte, low bits first, high bit set on every byte but the last):
+	  magic, 8 bytes			- REPLAY_MAGIC
+	  version, varint			- REPLAY_VERSION
+	  level number, varint		- level the replay was recorded on
+	  ball count, varint		- balls of that level
+	  state words, varint		- eight byte words of World::saveState() on that level
+	  keyframe interval, varint	- frames between two keyframes, 0 for none
+	  signature, 8 bytes		- replaySignature() of the level at its start (little endian)
+	  records					- kind (1 byte), frames since the record before it (varint), then:
+									REPLAY_LAUNCH: angle (varint) and magnitude (8 bytes, little endian)
+									REPLAY_KEYFRAME and REPLAY_RESTORE: every word of World::saveState() (the balls, the blocks with mass, the solver's
+									impulses and the time), each the zigzag varint of the difference between it and the same word in the keyframe
+									before (the level's start before the first)
+	  REPLAY_END record			- the last record, its frame being the length of the replay
+	  checksum, 8 bytes			- levelChecksum() of every byte before it (little endian)
+	============================================================================
+	STRUCTS:
+	+ ReplayRecord - one input, keyframe or the end of a replay, with the frame it happened on
+	============================================================================
+	CLASSES:
+	+ ReplayRecorder - the replay of a level being recorded while it's played
+	+ ReplayPlayer - a replay read back, which puts a world in the state of any of its frames
+*/
+
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include <string>
+#include <vector>
+#include "world.h"
+
+#define REPLAY_MAGIC "BLRPLAY"			//First eight bytes of a replay file (including the terminating zero)
+#define REPLAY_VERSION 4				//Version of the replay format, raised whenever a record changes
+#define REPLAY_KEYFRAME_INTERVAL 60		//Default frames between two keyframes of a recording (about two seconds of play)
+#define REPLAY_LAUNCH 1					//Record of the launch of the playerBall
+#define REPLAY_PAUSE 2					//Record of the game being paused
+#define REPLAY_RESUME 3					//Record of the game being resumed
+#define REPLAY_RESET 4					//Record of the level being reset
+#define REPLAY_KEYFRAME 5				//Record of the state of the simulation
+#define REPLAY_END 6					//Record of the end of the replay
+#define REPLAY_RESTORE 7				//Record of the game being rewound, with the state the simulation was put back in
+
+struct ReplayRecord
+{
+	int kind;			//REPLAY_LAUNCH, REPLAY_PAUSE, REPLAY_RESUME, REPLAY_RESET, REPLAY_KEYFRAME, REPLAY_RESTORE or REPLAY_END
+	int frame;			//frames played before the record
+	int angle;			//angle of a launch
+	double magnitude;	//magnitude of a launch
+	int state;			//index in the player's states of the first value of a keyframe or restore
+};
+
+std::string replayFileName(int);
+	//return the name of the replay file for a level number
+unsigned long long replaySignature(const World&);
+	//return a checksum of the balls and blocks of a world, to tell the level a replay was recorded on
+
+class ReplayRecorder
+{
+public:
+	void begin(int, const World&, int = REPLAY_KEYFRAME_INTERVAL);
+		//Start a new recording of a level whose world is at its start, with a keyframe every number of frames (0 for none)
+	void launch(int, double);
+		//Record the launch of the playerBall with an angle and magnitude
+	void pause();
+		//Record that the game was paused
+	void resume();
+		//Record that the game was resumed
+	void reset();
+		//Record that the level was reset
+	void restore(const World&);
+		//Record that the game was rewound, with the state the simulation of a world was put back in
+	void step(const World&);
+		//Count a frame the world was stepped, recording a keyframe of its simulation if one is due
+	void finish();
+		//End the recording, after which nothing more is recorded until the next begin
+	bool save(const std::string&);
+		//End the recording and write it to a replay file, return false if the file can't be written
+	const std::vector<unsigned char>& getData() const;
+		//return the bytes recorded so far
+	int getFrame() const;
+		//return the number of frames recorded
+	bool isRecording() const;
+		//return true if a recording was begun and not finished
+	ReplayRecorder();
+		//Constructor, nothing recorded
+private:
+	void writeVarint(unsigned long long);
+		//Append an unsigned number in as few bytes as it needs, seven bits a byte
+	void writeRecord(int);
+		//Append the kind of a record and the frames since the record before it
+	void writeKeyframe(int, const World&);
+		//Append a keyframe (or a restore) of the simulation of a world, every word as the difference from the last one
+	std::vector<unsigned char> data;				//Bytes of the recording
+	int frame;										//Frames recorded since the recording began
+	int lastFrame;									//Frame of the last record written
+	int keyframeInterval;							//Frames between two keyframes, 0 for none
+	bool recording;									//A recording was begun and not finished
+	std::vector<unsigned long long> reference;		//Bits of every value of the last keyframe (the level's start before the first), which the next keyframe is written as the difference from
+};
+
+class ReplayPlayer
+{
+public:
+	bool open(const std::string&);
+		//Read a replay file, return false if it can't be read or isn't a valid replay
+	bool decode(const std::vector<unsigned char>&);
+		//Read a replay from its bytes, return false (and hold nothing) if it isn't a valid replay
+	int getLevelNumber() const;
+		//return the number of the level the replay was recorded on
+	int getBallCount() const;
+		//return the number of balls of the level the replay was recorded on
+	int getFrameCount() const;
+		//return the number of frames the replay lasts
+	int getKeyframeCount() const;
+		//return the number of keyframes (and restores) of the replay
+	const std::vector<ReplayRecord>& getRecords() const;
+		//return the inputs, keyframes and end of the replay, in the order they were recorded
+	bool matches(const World&) const;
+		//return true if a world at its level's start is the level the replay was recorded on
+	bool seek(World&, int) const;
+		//Put a world in the state it was in a number of frames into the replay, starting from the nearest keyframe (or restore) before it, return false if the world isn't the replay's level
+	bool simulate(World&, int&, int&) const;
+		//Re-simulate the whole replay from the level's start, set the frame the goal was hit (-1 if never) and the first keyframe the world disagreed with (-1 if none), return false if the world isn't the replay's level
+	ReplayPlayer();
+		//Constructor, no replay
+private:
+	void runTo(World&, const std::vector<unsigned long long>&, int&, int&, int, int&, int&) const;
+		//Apply the records from the next one on (to a world whose level starts in some state), stepping the world (and counting its frames) up to each one's frame, until a frame is reached with its records applied; set the frame the goal was hit and the first keyframe the world disagreed with, unless they're set already
+	void restore(World&, const ReplayRecord&, const std::vector<unsigned long long>&) const;
+		//Put the simulation of a world whose level starts in some state in the state of a keyframe (or a restore)
+	bool agrees(const World&, const ReplayRecord&, const std::vector<unsigned long long>&) const;
+		//return true if the simulation of a world whose level starts in some state is exactly in the state of a keyframe
+	int levelNumber;							//Number of the level the replay was recorded on
+	int ballCount;								//Number of balls of the level the replay was recorded on
+	int stateWords;								//Eight byte words of the state of the simulation of the level the replay was recorded on
+	unsigned long long signature;				//replaySignature() of the level's world at its start
+	int frameCount;								//Number of frames the replay lasts
+	std::vector<ReplayRecord> records;			//Inputs, keyframes and end of the replay, in the order they were recorded
+	std::vector<int> keyframes;					//Index in records of every keyframe and restore, in frame order
+	std::vector<unsigned long long> states;		//Words of the state of the simulation of every keyframe, as the difference from the words at the level's start
+};
+
+#endif //REPLAY_H
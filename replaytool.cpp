@@ -0,0 +1,132 @@
+/* Program name: replaytool.cpp
+*  Author: Cory Knoll
+*  Date Last Modified: 10/17/2026
+*  Description: Command line program that plays a replay file back headlessly: lists its inputs, re-simulates the whole run faster than real time and checks it against its keyframes, and shows the balls at any frame (build as its own executable, no window is opened)
+	================================================================
+	FUNCTIONS:
+	+ int main(int, char**) - Play back the replay file named on the command line (replaytool lvlN.rpl [frame ...]) on the level it was recorded on, return 1 if it can't be or disagrees with its keyframes
+	- double secondsSince(Clock::time_point) - return the seconds elapsed since a point in time
+	- bool openLevel(int, World&, MappedLevel&) - Load a level into a world from its compiled file, or its text file if it has no valid compiled one, return false if it has neither
+	- const char* recordName(int) - return the name of a kind of replay record
+*/
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include "compiledlevel.h"
+#include "level.h"
+#include "replay.h"
+#include "world.h"
+
+#define PHYSICS_STEP_MS 29.0	//Length of one physics step in the game, to tell how much faster than real time a replay plays back
+
+typedef std::chrono::steady_clock Clock;
+
+//return the seconds elapsed since a point in time
+static double secondsSince(Clock::time_point start)
+{
+	return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+//Load a level into a world from its compiled file, or its text file if it has no valid compiled one, return false if it has neither
+static bool openLevel(int levelNumber, World &world, MappedLevel &map)
+{
+	//the world may use the records of the mapped file, so the map stays open for as long as the world plays the level
+	if (map.open(compiledLevelFileName(levelNumber)))
+	{
+		world.loadLevel(map.getView());
+		return true;
+	}
+	LevelData level;
+	if (!loadLevelFile(levelFileName(levelNumber), level))
+		return false;
+	world.loadLevel(level);
+	return true;
+}
+
+//return the name of a kind of replay record
+static const char* recordName(int kind)
+{
+	switch (kind)
+	{
+	case REPLAY_LAUNCH:
+		return "launch";
+	case REPLAY_PAUSE:
+		return "pause";
+	case REPLAY_RESUME:
+		return "resume";
+	case REPLAY_RESET:
+		return "reset";
+	case REPLAY_KEYFRAME:
+		return "keyframe";
+	case REPLAY_RESTORE:
+		return "rewind";
+	default:
+		return "end";
+	}
+}
+
+//Play back the replay file named on the command line (replaytool lvlN.rpl [frame ...]) on the level it was recorded on, return 1 if it can't be or disagrees with its keyframes
+int main(int argc, char *argv[])
+{
+	if (argc < 2)
+	{
+		printf("usage: %s replay.rpl [frame ...]\n", argv[0]);
+		return 1;
+	}
+	ReplayPlayer replay;
+	if (!replay.open(argv[1]))
+	{
+		printf("%s: can't be read or isn't a valid replay\n", argv[1]);
+		return 1;
+	}
+	World world;
+	MappedLevel map;
+	world.setThreadCount(1);
+	if (!openLevel(replay.getLevelNumber(), world, map) || !replay.matches(world))
+	{
+		printf("%s: level %d can't be read or isn't the level the replay was recorded on\n", argv[1], replay.getLevelNumber());
+		return 1;
+	}
+
+	//the inputs, with the frame each was given on (keyframes are only counted)
+	printf("%s: level %d, %d balls, %d frames, %d keyframes\n", argv[1], replay.getLevelNumber(), replay.getBallCount(),
+		replay.getFrameCount(), replay.getKeyframeCount());
+	for (const ReplayRecord &record : replay.getRecords())
+		if (record.kind == REPLAY_LAUNCH)
+			printf("\tframe %6d: launch, angle %d, magnitude %g\n", record.frame, record.angle, record.magnitude);
+		else if (record.kind != REPLAY_KEYFRAME)
+			printf("\tframe %6d: %s\n", record.frame, recordName(record.kind));
+
+	//re-simulate the whole run from the level's start; the keyframes say whether this build plays it the way the recording did
+	int goalFrame, desyncFrame;
+	Clock::time_point start = Clock::now();
+	replay.simulate(world, goalFrame, desyncFrame);
+	double seconds = secondsSince(start);
+	printf("re-simulated in %.3f ms (%.0fx real time): ", seconds * 1e3, replay.getFrameCount() * PHYSICS_STEP_MS / 1e3 / seconds);
+	if (goalFrame >= 0)
+		printf("goal hit on frame %d, ", goalFrame);
+	else
+		printf("goal never hit, ");
+	if (desyncFrame >= 0)
+		printf("DISAGREES with the keyframe of frame %d\n", desyncFrame);
+	else
+		printf("agrees with every keyframe\n");
+
+	//the balls at every frame asked for, each reached from the nearest keyframe before it
+	for (int i = 2; i < argc; i++)
+	{
+		int frame = atoi(argv[i]);
+		start = Clock::now();
+		replay.seek(world, frame);
+		seconds = secondsSince(start);
+		printf("frame %d (seeked in %.3f ms):\n", frame, seconds * 1e3);
+		for (int ball = 0; ball < world.getBallCount(); ball++)
+		{
+			Vec2D velocity = world.getBallVelocity(ball);
+			printf("\tball %d: position (%.17g, %.17g), velocity (%.17g, %.17g)\n", ball, world.getBallX(ball), world.getBallY(ball),
+				velocity.x, velocity.y);
+		}
+	}
+	return desyncFrame >= 0 ? 1 : 0;
+}
@@ -0,0 +1,72 @@
+/* Program name: response.cpp
+*  Author: Cory Knoll
+*  Date Last Modified: 10/17/2026
+*  Description: Collision response of balls bouncing off blocks: block materials and a trig-free reflection kernel with friction, one contact at a time or in batches (no Qt dependency)
+	================================================================
+	FUNCTIONS:
+	+ Vec2D bounce(Vec2D, Vec2D, const Material&) - return the velocity of a ball after it bounces off a surface with a unit normal and a material
+	+ void bounceBatch(BodyStore&, const ContactBatch&) - Bounce every ball of a batch of contacts off its surface, in the order the contacts were added
+	+ void add(int, Vec2D, const Material&) - Add the contact of a ball with a surface with a unit normal and a material to the batch
+	+ void clear() - Remove all contacts from the batch
+	+ int size() const - return the number of contacts in the batch
+	============================================================================
+	VARIABLES:
+	+ std::vector<int> ball - index of the ball of every contact
+	+ std::vector<double> nx - x components of the unit normals of the contacts
+	+ std::vector<double> ny - y components of the unit normals of the contacts
+	+ std::vector<double> restitution - restitution of the material of every contact
+	+ std::vector<double> friction - friction coefficient of the material of every contact
+	============================================================================
+	STRUCTS:
+	+ Material - how much of its speed into a surface and along it a ball keeps after bouncing off it
+*/
+
+#include "response.h"
+
+//Add the contact of a ball with a surface with a unit normal and a material to the batch
+void ContactBatch::add(int index, Vec2D normal, const Material &material)
+{
+	ball.push_back(index);
+	nx.push_back(normal.x);
+	ny.push_back(normal.y);
+	restitution.push_back(material.restitution);
+	friction.push_back(material.friction);
+}
+
+//Remove all contacts from the batch
+void ContactBatch::clear()
+{
+	ball.clear();
+	nx.clear();
+	ny.clear();
+	restitution.clear();
+	friction.clear();
+}
+
+//return the number of contacts in the batch
+int ContactBatch::size() const
+{
+	return (int)ball.size();
+}
+
+//Bounce every ball of a batch of contacts off its surface, in the order the contacts were added
+void bounceBatch(BodyStore &bodies, const ContactBatch &contacts)
+{
+	//a ball can appear in more than one contact (a corner, or a pile resting on a floor), so each bounce starts from the velocity the
+	//ball was left with by the one before it; with no trig in the kernel, every contact costs the same few multiplies and a square root
+	const int *ball = contacts.ball.data();
+	const double *nx = contacts.nx.data();
+	const double *ny = contacts.ny.data();
+	const double *restitution = contacts.restitution.data();
+	const double *friction = contacts.friction.data();
+	double *vx = bodies.vx.data();
+	double *vy = bodies.vy.data();
+	int count = contacts.size();
+	for (int i = 0; i < count; i++)
+	{
+		Material material = { restitution[i], friction[i] };
+		Vec2D velocity = bounce(Vec2D(vx[ball[i]], vy[ball[i]]), Vec2D(nx[i], ny[i]), material);
+		vx[ball[i]] = velocity.x;
+		vy[ball[i]] = velocity.y;
+	}
+}
@@ -0,0 +1,80 @@
+/* Program name: response.h
+*  Author: Cory Knoll
+*  Date Last Modified: 10/17/2026
+*  Description: Collision response of balls bouncing off blocks: block materials and a trig-free reflection kernel with friction, one contact at a time or in batches (no Qt dependency)
+	================================================================
+	FUNCTIONS:
+	+ Vec2D bounce(Vec2D, Vec2D, const Material&) - return the velocity of a ball after it bounces off a surface with a unit normal and a material
+	+ void bounceBatch(BodyStore&, const ContactBatch&) - Bounce every ball of a batch of contacts off its surface, in the order the contacts were added
+	+ void add(int, Vec2D, const Material&) - Add the contact of a ball with a surface with a unit normal and a material to the batch
+	+ void clear() - Remove all contacts from the batch
+	+ int size() const - return the number of contacts in the batch
+	============================================================================
+	VARIABLES:
+	+ std::vector<int> ball - index of the ball of every contact
+	+ std::vector<double> nx - x components of the unit normals of the contacts
+	+ std::vector<double> ny - y components of the unit normals of the contacts
+	+ std::vector<double> restitution - restitution of the material of every contact
+	+ std::vector<double> friction - friction coefficient of the material of every contact
+	============================================================================
+	STRUCTS:
+	+ Material - how much of its speed into a surface and along it a ball keeps after bouncing off it
+*/
+
+#ifndef RESPONSE_H
+#define RESPONSE_H
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include "bodystore.h"
+#include "vec2d.h"
+
+#define DEFAULT_RESTITUTION 0.85	//Portion of its speed into a block a ball keeps after bouncing off a block of the default material
+#define DEFAULT_FRICTION 0			//Friction coefficient of the default material (blocks are frictionless unless the level says otherwise)
+
+struct Material
+{
+	double restitution;	//portion of its speed into the surface a ball keeps, bouncing back out (0 = no bounce, 1 = no loss)
+	double friction;	//Coulomb friction coefficient: the speed along the surface a ball loses per unit of speed it bounces back with (0 = none)
+};
+
+class ContactBatch
+{
+public:
+	void add(int, Vec2D, const Material&);
+		//Add the contact of a ball with a surface with a unit normal and a material to the batch
+	void clear();
+		//Remove all contacts from the batch
+	int size() const;
+		//return the number of contacts in the batch
+	//Each component lives in its own contiguous array, the same way the bodies are stored
+	std::vector<int> ball;				//index of the ball of every contact
+	std::vector<double> nx;				//x components of the unit normals of the contacts
+	std::vector<double> ny;				//y components of the unit normals of the contacts
+	std::vector<double> restitution;	//restitution of the material of every contact
+	std::vector<double> friction;		//friction coefficient of the material of every contact
+};
+
+Vec2D bounce(Vec2D, Vec2D, const Material&);
+	//return the velocity of a ball after it bounces off a surface with a unit normal and a material
+void bounceBatch(BodyStore&, const ContactBatch&);
+	//Bounce every ball of a batch of contacts off its surface, in the order the contacts were added
+
+//bounce() runs once for every collision the world resolves, so it's defined here where every caller can inline it
+
+//return the velocity of a ball after it bounces off a surface with a unit normal and a material
+inline Vec2D bounce(Vec2D velocity, Vec2D normal, const Material &material)
+{
+	//v' = v - (1+e)(v.n)n reverses and scales the part of the velocity into the surface; a ball already moving away keeps its velocity
+	double intoNormal = std::min(velocity.dot(normal), 0.0);
+	Vec2D tangent = velocity - normal * intoNormal;
+
+	//friction takes speed along the surface in proportion to the bounce's impulse, but can only stop the sliding, never reverse it
+	double impulse = -(1 + material.restitution) * intoNormal;
+	double slide = tangent.length();
+	double slowdown = slide > 0 ? std::min(material.friction * impulse, slide) / slide : 0;
+	return velocity + normal * impulse - tangent * slowdown;
+}
+
+#endif //RESPONSE_H
@@ -0,0 +1,300 @@
+/* Program name: shotsolver.cpp
+*  Author: Cory Knoll
+*  Date Last Modified: 10/17/2026
+*  Description: Command line program that plays every shot a player can aim at a level headlessly on every core, and reports which ones reach the goal as a CSV file and an image (build as its own executable, no window is opened)
+	================================================================
+	FUNCTIONS:
+	+ int main(int, char**) - Solve the level files named on the command line, or lvl1, lvl2, ... until one is missing, with the grid and limits given by the options
+	- double secondsSince(Clock::time_point) - return the seconds elapsed since a point in time
+	- std::string baseName(const std::string&) - return a file name without its extension
+	- bool openLevel(const std::string&, MappedLevel&, LevelData&, LevelView&) - Read a level from a compiled (.bin) or text level file, set a view of its records, return false if it can't be read
+	- void solveLevel(const LevelView&, ThreadPool&, const SolverOptions&, std::vector<Shot>&) - Play every shot of the grid on a level, one angle per task, each worker playing its shots in a world of its own (frame by frame or in longer steps along the balls' parabolas, or jumping between the frames near a collision if the options ask for it and the level's blocks all stand still)
+	- bool writeCsv(const std::string&, const SolverOptions&, const std::vector<Shot>&) - Write a row per shot (angle, power step, magnitude, hit, frames), return false if the file can't be written
+	- bool writeImage(const std::string&, const SolverOptions&, const std::vector<Shot>&) - Write the solution map as a binary PPM image (angle across, power up, goal hits shaded by frames), return false if the file can't be written
+	- bool solveFile(const std::string&, ThreadPool&, const SolverOptions&) - Solve one level file, write its solution map next to it and print a summary, return false if it can't be read or has no solution
+	============================================================================
+	STRUCTS:
+	- SolverOptions - the grid of shots to play and how long each one is played
+	- Shot - the outcome of one shot
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "compiledlevel.h"
+#include "eventsim.h"
+#include "level.h"
+#include "threadpool.h"
+#include "trajectory.h"
+#include "world.h"
+
+#define MAX_VELOCITY 50.0			//Largest launch speed the player can aim (the game's MAX_VELOCITY)
+#define SOLVER_ANGLES 360			//Default number of angles around the circle (the game's 1 degree steps)
+#define SOLVER_POWERS 100			//Default number of power steps up to MAX_VELOCITY (the game's 1% steps)
+#define SOLVER_MAX_FRAMES 2000		//Default most frames a shot is played for before it counts as a miss
+
+typedef std::chrono::steady_clock Clock;
+
+struct SolverOptions
+{
+	int angles;		//number of angles around the circle, angle i being i * 360 / angles degrees
+	int powers;		//number of power steps, power p (1 to powers) launching at p * MAX_VELOCITY / powers
+	int maxFrames;	//most frames a shot is played for before it counts as a miss
+	int threads;	//number of threads that share the shots, 0 for one per core
+	bool events;	//jump over the frames in which nothing is in a shot's reach instead of stepping every one where the level allows it
+	int stepFrames;	//frames every step of a shot played step by step covers, more than 1 moving the balls along their parabolas
+};
+
+struct Shot
+{
+	bool hit;		//the shot reached the goal
+	int frames;		//frames played until the shot reached the goal, left the level for good or ran out of frames (steps of many frames count all of theirs)
+};
+
+//return the seconds elapsed since a point in time
+static double secondsSince(Clock::time_point start)
+{
+	return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+//return a file name without its extension
+static std::string baseName(const std::string &fileName)
+{
+	size_t dot = fileName.find_last_of('.');
+	size_t slash = fileName.find_last_of("/\\");
+	if (dot == std::string::npos || (slash != std::string::npos && dot < slash))
+		return fileName;
+	return fileName.substr(0, dot);
+}
+
+//Read a level from a compiled (.bin) or text level file, set a view of its records, return false if it can't be read
+static bool openLevel(const std::string &fileName, MappedLevel &map, LevelData &data, LevelView &view)
+{
+	if (fileName.size() > 4 && fileName.compare(fileName.size() - 4, 4, ".bin") == 0)
+	{
+		if (!map.open(fileName))
+			return false;
+		view = map.getView();
+		return true;
+	}
+	if (!loadLevelFile(fileName, data))
+		return false;
+	view = viewLevel(data);
+	return true;
+}
+
+//Play every shot of the grid on a level, one angle per task, each worker playing its shots in a world of its own (frame by frame or in longer steps along the balls' parabolas, or jumping between the frames near a collision if the options ask for it and the level's blocks all stand still)
+static void solveLevel(const LevelView &view, ThreadPool &pool, const SolverOptions &options, std::vector<Shot> &shots)
+{
+	//a world per worker, loaded once: the blocks and the hierarchy over them never change between shots, each shot only puts the
+	//balls back, so a shot costs its frames and nothing else. Each world steps on its worker's thread alone, the parallelism is
+	//across shots, which never wait on each other
+	std::vector<World> worlds(pool.getThreadCount());
+	std::vector<std::vector<Vec2D>> paths(worlds.size());
+	std::vector<EventSimulator> simulators(worlds.size());
+	std::vector<std::vector<unsigned char>> states(worlds.size());
+	for (World &world : worlds)
+	{
+		world.setThreadCount(1);
+		world.loadLevel(view);
+	}
+	for (std::vector<unsigned char> &state : states)
+		state.resize(worlds[0].getStateSize());
+
+	shots.assign((size_t)options.angles * options.powers, Shot());
+	pool.run(options.angles, [&](int angleIndex, int worker)
+	{
+		World &world = worlds[worker];
+		double angle = angleIndex * 360.0 / options.angles;
+		for (int power = 1; power <= options.powers; power++)
+		{
+			//the same velocity the game's launch sets for this angle and magnitude
+			double magnitude = power * MAX_VELOCITY / options.powers;
+			Vec2D velocity = Vec2D(cos(angle * 3.14159 / 180), sin(angle * 3.14159 / 180)) * magnitude;
+			Shot &shot = shots[(size_t)angleIndex * options.powers + power - 1];
+
+			//with events a shot only pays the world's frame steps near a collision and jumps over the frames in between the way the
+			//frame steps would move the ball, so it gets the same answer as frame by frame (the events' own jumps don't, see
+			//EventSimulator::play()); a snapshot puts the world back the way every shot starts from
+			if (options.events && EventSimulator::isJumpable(world))
+			{
+				world.saveState(states[worker].data());
+				world.setBallVelocity(0, velocity.x, velocity.y);
+				shot.hit = simulators[worker].play(world, options.maxFrames);
+				shot.frames = (int)simulators[worker].getTime();
+				world.loadState(states[worker].data());
+				continue;
+			}
+			shot.hit = predictTrajectory(world, velocity, (options.maxFrames + options.stepFrames - 1) / options.stepFrames, HUGE_VAL, paths[worker], options.stepFrames);
+			shot.frames = ((int)paths[worker].size() - 1) * options.stepFrames;
+		}
+	});
+}
+
+//Write a row per shot (angle, power step, magnitude, hit, frames), return false if the file can't be written
+static bool writeCsv(const std::string &fileName, const SolverOptions &options, const std::vector<Shot> &shots)
+{
+	FILE *file = fopen(fileName.c_str(), "w");
+	if (!file)
+		return false;
+	fprintf(file, "angle,power,magnitude,hit,frames\n");
+	for (int angleIndex = 0; angleIndex < options.angles; angleIndex++)
+		for (int power = 1; power <= options.powers; power++)
+		{
+			const Shot &shot = shots[(size_t)angleIndex * options.powers + power - 1];
+			fprintf(file, "%g,%d,%g,%d,%d\n", angleIndex * 360.0 / options.angles, power, power * MAX_VELOCITY / options.powers,
+				shot.hit ? 1 : 0, shot.frames);
+		}
+	return fclose(file) == 0;
+}
+
+//Write the solution map as a binary PPM image (angle across, power up, goal hits shaded by frames), return false if the file can't be written
+static bool writeImage(const std::string &fileName, const SolverOptions &options, const std::vector<Shot> &shots)
+{
+	FILE *file = fopen(fileName.c_str(), "wb");
+	if (!file)
+		return false;
+
+	//the quickest hit is bright green and the slowest dark green, so the easy shots stand out from the ones that only just make it
+	int fewest = options.maxFrames, most = 0;
+	for (const Shot &shot : shots)
+		if (shot.hit)
+		{
+			fewest = std::min(fewest, shot.frames);
+			most = std::max(most, shot.frames);
+		}
+	fprintf(file, "P6\n%d %d\n255\n", options.angles, options.powers);
+	std::vector<unsigned char> row((size_t)options.angles * 3);
+	for (int power = options.powers; power >= 1; power--)
+	{
+		for (int angleIndex = 0; angleIndex < options.angles; angleIndex++)
+		{
+			const Shot &shot = shots[(size_t)angleIndex * options.powers + power - 1];
+			unsigned char *pixel = &row[(size_t)angleIndex * 3];
+			if (shot.hit)
+			{
+				double slowness = most > fewest ? (double)(shot.frames - fewest) / (most - fewest) : 0;
+				pixel[0] = 0;
+				pixel[1] = (unsigned char)(255 - 160 * slowness);
+				pixel[2] = 0;
+			}
+			else
+				pixel[0] = pixel[1] = pixel[2] = 32;
+		}
+		fwrite(row.data(), 1, row.size(), file);
+	}
+	return fclose(file) == 0;
+}
+
+//Solve one level file, write its solution map next to it and print a summary, return false if it can't be read or has no solution
+static bool solveFile(const std::string &fileName, ThreadPool &pool, const SolverOptions &options)
+{
+	MappedLevel map;
+	LevelData data;
+	LevelView view;
+	if (!openLevel(fileName, map, data, view))
+	{
+		printf("%s: can't be read or is incomplete\n", fileName.c_str());
+		return false;
+	}
+
+	Clock::time_point start = Clock::now();
+	std::vector<Shot> shots;
+	solveLevel(view, pool, options, shots);
+	double seconds = secondsSince(start);
+
+	int hits = 0, best = -1;
+	long long frames = 0;
+	for (int i = 0; i < (int)shots.size(); i++)
+	{
+		frames += shots[i].frames;
+		if (shots[i].hit)
+		{
+			hits++;
+			if (best < 0 || shots[i].frames < shots[best].frames)
+				best = i;
+		}
+	}
+	printf("%s: %d of %d shots hit the goal, %lld frames played in %.2f s (%.0f shots/s, %d threads)\n", fileName.c_str(), hits,
+		(int)shots.size(), frames, seconds, shots.size() / seconds, pool.getThreadCount());
+	if (best >= 0)
+		printf("\tquickest: angle %g, power %d (magnitude %g), %d frames\n", (best / options.powers) * 360.0 / options.angles,
+			best % options.powers + 1, (best % options.powers + 1) * MAX_VELOCITY / options.powers, shots[best].frames);
+
+	std::string csvName = baseName(fileName) + "_shots.csv", imageName = baseName(fileName) + "_shots.ppm";
+	if (!writeCsv(csvName, options, shots) || !writeImage(imageName, options, shots))
+	{
+		printf("%s: the solution map can't be written\n", fileName.c_str());
+		return false;
+	}
+	printf("\tsolution map: %s, %s\n", csvName.c_str(), imageName.c_str());
+	return hits > 0;
+}
+
+//Solve the level files named on the command line, or lvl1, lvl2, ... until one is missing, with the grid and limits given by the options
+int main(int argc, char *argv[])
+{
+	SolverOptions options = { SOLVER_ANGLES, SOLVER_POWERS, SOLVER_MAX_FRAMES, 0, false, 1 };
+	std::vector<std::string> files;
+	bool valid = true;
+	for (int i = 1; i < argc && valid; i++)
+	{
+		if (argv[i][0] != '-')
+		{
+			files.push_back(argv[i]);
+			continue;
+		}
+		if (strcmp(argv[i], "-events") == 0)
+		{
+			options.events = true;
+			continue;
+		}
+		int *option = nullptr;
+		if (strcmp(argv[i], "-angles") == 0)
+			option = &options.angles;
+		else if (strcmp(argv[i], "-powers") == 0)
+			option = &options.powers;
+		else if (strcmp(argv[i], "-frames") == 0)
+			option = &options.maxFrames;
+		else if (strcmp(argv[i], "-threads") == 0)
+			option = &options.threads;
+		else if (strcmp(argv[i], "-step") == 0)
+			option = &options.stepFrames;
+		valid = option && i + 1 < argc;
+		if (valid)
+		{
+			*option = atoi(argv[++i]);
+			valid = *option >= (option == &options.threads ? 0 : 1);
+		}
+	}
+	if (!valid)
+	{
+		printf("usage: %s [-angles N] [-powers N] [-frames N] [-threads N] [-step N] [-events] [level.txt|level.bin ...]\n", argv[0]);
+		return 1;
+	}
+
+	//with no files named, solve the game's levels, from their compiled files where they have valid ones, the way the game reads them
+	if (files.empty())
+		for (int levelNumber = 1; ; levelNumber++)
+		{
+			MappedLevel map;
+			LevelData level;
+			if (map.open(compiledLevelFileName(levelNumber)))
+				files.push_back(compiledLevelFileName(levelNumber));
+			else if (loadLevelFile(levelFileName(levelNumber), level))
+				files.push_back(levelFileName(levelNumber));
+			else
+				break;
+		}
+
+	ThreadPool pool(options.threads);
+	bool solved = !files.empty();
+	for (const std::string &fileName : files)
+		solved = solveFile(fileName, pool, options) && solved;
+	return solved ? 0 : 1;
+}
@@ -0,0 +1,133 @@
+/* Program name: snapshot.cpp
+*  Author: Cory Knoll
+*  Date Last Modified: 10/17/2026
+*  Description: Fixed-size ring buffer of flat snapshots of the game's state (its flags and the world's balls), one per frame, to rewind the game frame by frame or branch what-if simulations from any of them (no Qt dependency)
+	================================================================
+	FUNCTIONS:
+	+ void reset(int, const World&) - Empty the ring and size it for a number of snapshots of a world's level (the memory is only allocated when the level's size changes)
+	+ void clear() - Drop every snapshot
+	+ void push(const SnapshotHeader&, const World&) - Snapshot the game's flags and a world's state as the newest snapshot, overwriting the oldest if the ring is full
+	+ bool restore(int, SnapshotHeader&, World&) const - Put a world and the game's flags in the state of a snapshot a number of frames older than the newest, return false if there's none that old or it's of another level
+	+ void drop(int) - Drop a number of the newest snapshots, so the next one pushed follows the one left newest
+	+ const void* getState(int) const - return the world state of a snapshot a number of frames older than the newest (nullptr if none), which any world of the same level can load
+	+ int getCount() const - return the number of snapshots held
+	+ int getCapacity() const - return the most snapshots the ring holds
+	+ SnapshotRing() - Constructor, no room for snapshots
+	- unsigned char* slot(int) - return the start of a snapshot a number of frames older than the newest
+	- const unsigned char* slot(int) const - return the start of a snapshot a number of frames older than the newest
+	============================================================================
+	VARIABLES:
+	- std::vector<unsigned char> memory - Memory of every snapshot, one slot after the other, allocated once
+	- size_t slotSize - Bytes of a slot: the header, then the world state, rounded up to keep the next slot aligned
+	- int capacity - Most snapshots the ring holds
+	- int newest - Slot of the newest snapshot
+	- int count - Number of snapshots held
+	============================================================================
+	STRUCTS:
+	+ SnapshotHeader - the game's flags a snapshot holds besides the world's state
+	============================================================================
+	CLASSES:
+	+ SnapshotRing - the latest frames of a level as flat snapshots, oldest overwritten first
+*/
+
+#include <algorithm>
+#include <cstring>
+#include <type_traits>
+#include "snapshot.h"
+
+static_assert(std::is_trivially_copyable<SnapshotHeader>::value, "snapshot header must stay a flat record");
+static_assert(std::is_trivially_copyable<WorldState>::value, "world state header must stay a flat record");
+
+//Empty the ring and size it for a number of snapshots of a world's level (the memory is only allocated when the level's size changes)
+void SnapshotRing::reset(int snapshots, const World &world)
+{
+	//every slot is the same size, so the ring is one block of memory that's never reallocated while the level is played: pushing a
+	//snapshot every frame costs a copy and nothing else
+	size_t size = sizeof(SnapshotHeader) + world.getStateSize();
+	slotSize = (size + SNAPSHOT_ALIGNMENT - 1) / SNAPSHOT_ALIGNMENT * SNAPSHOT_ALIGNMENT;
+	capacity = std::max(snapshots, 1);
+	memory.resize(slotSize * capacity);
+	clear();
+}
+
+//Drop every snapshot
+void SnapshotRing::clear()
+{
+	newest = capacity - 1;
+	count = 0;
+}
+
+//Snapshot the game's flags and a world's state as the newest snapshot, overwriting the oldest if the ring is full
+void SnapshotRing::push(const SnapshotHeader &header, const World &world)
+{
+	//a ring sized for another level would cut the world's state short
+	if (sizeof(SnapshotHeader) + world.getStateSize() > slotSize)
+		return;
+	newest = (newest + 1) % capacity;
+	count = std::min(count + 1, capacity);
+	unsigned char *snapshot = slot(0);
+	memcpy(snapshot, &header, sizeof(header));
+	world.saveState(snapshot + sizeof(header));
+}
+
+//Put a world and the game's flags in the state of a snapshot a number of frames older than the newest, return false if there's none that old or it's of another level
+bool SnapshotRing::restore(int age, SnapshotHeader &header, World &world) const
+{
+	const unsigned char *snapshot = slot(age);
+	if (!snapshot || !world.loadState(snapshot + sizeof(SnapshotHeader)))
+		return false;
+	memcpy(&header, snapshot, sizeof(header));
+	return true;
+}
+
+//Drop a number of the newest snapshots, so the next one pushed follows the one left newest
+void SnapshotRing::drop(int snapshots)
+{
+	snapshots = std::max(0, std::min(snapshots, count));
+	newest = (newest - snapshots + capacity) % capacity;
+	count -= snapshots;
+}
+
+//return the world state of a snapshot a number of frames older than the newest (nullptr if none), which any world of the same level can load
+const void* SnapshotRing::getState(int age) const
+{
+	const unsigned char *snapshot = slot(age);
+	return snapshot ? snapshot + sizeof(SnapshotHeader) : nullptr;
+}
+
+//return the number of snapshots held
+int SnapshotRing::getCount() const
+{
+	return count;
+}
+
+//return the most snapshots the ring holds
+int SnapshotRing::getCapacity() const
+{
+	return capacity;
+}
+
+//Constructor, no room for snapshots
+SnapshotRing::SnapshotRing()
+{
+	slotSize = 0;
+	capacity = 1;
+	newest = 0;
+	count = 0;
+}
+
+//return the start of a snapshot a number of frames older than the newest
+unsigned char* SnapshotRing::slot(int age)
+{
+	if (age < 0 || age >= count)
+		return nullptr;
+	return memory.data() + ((newest - age + capacity) % capacity) * slotSize;
+}
+
+//return the start of a snapshot a number of frames older than the newest
+const unsigned char* SnapshotRing::slot(int age) const
+{
+	if (age < 0 || age >= count)
+		return nullptr;
+	return memory.data() + ((newest - age + capacity) % capacity) * slotSize;
+}
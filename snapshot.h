@@ -0,0 +1,89 @@
+/* Program name: snapshot.h
+*  Author: Cory Knoll
+*  Date Last Modified: 10/17/2026
+*  Description: Fixed-size ring buffer of flat snapshots of the game's state (its flags and the world's balls), one per frame, to rewind the game frame by frame or branch what-if simulations from any of them (no Qt dependency)
+	================================================================
+	FUNCTIONS:
+	+ void reset(int, const World&) - Empty the ring and size it for a number of snapshots of a world's level (the memory is only allocated when the level's size changes)
+	+ void clear() - Drop every snapshot
+	+ void push(const SnapshotHeader&, const World&) - Snapshot the game's flags and a world's state as the newest snapshot, overwriting the oldest if the ring is full
+	+ bool restore(int, SnapshotHeader&, World&) const - Put a world and the game's flags in the state of a snapshot a number of frames older than the newest, return false if there's none that old or it's of another level
+	+ void drop(int) - Drop a number of the newest snapshots, so the next one pushed follows the one left newest
+	+ const void* getState(int) const - return the world state of a snapshot a number of frames older than the newest (nullptr if none), which any world of the same level can load
+	+ int getCount() const - return the number of snapshots held
+	+ int getCapacity() const - return the most snapshots the ring holds
+	+ SnapshotRing() - Constructor, no room for snapshots
+	- unsigned char* slot(int) - return the start of a snapshot a number of frames older than the newest
+	- const unsigned char* slot(int) const - return the start of a snapshot a number of frames older than the newest
+	============================================================================
+	VARIABLES:
+	- std::vector<unsigned char> memory - Memory of every snapshot, one slot after the other, allocated once
+	- size_t slotSize - Bytes of a slot: the header, then the world state, rounded up to keep the next slot aligned
+	- int capacity - Most snapshots the ring holds
+	- int newest - Slot of the newest snapshot
+	- int count - Number of snapshots held
+	============================================================================
+	SNAPSHOT LAYOUT (every slot the same size, nothing in it points anywhere, so a slot is copied with memcpy):
+	  SnapshotHeader			- the game's level number, frame, aim and launchedFlag
+	  WorldState				- the world's ball count and goal flag
+	  double[ballCount] x 4		- x, y, vx and vy of every ball
+	============================================================================
+	STRUCTS:
+	+ SnapshotHeader - the game's flags a snapshot holds besides the world's state
+	============================================================================
+	CLASSES:
+	+ SnapshotRing - the latest frames of a level as flat snapshots, oldest overwritten first
+*/
+
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <cstddef>
+#include <vector>
+#include "world.h"
+
+#define SNAPSHOT_ALIGNMENT 8	//Alignment of every slot of the ring
+
+struct SnapshotHeader
+{
+	int levelNumber;	//level the snapshot was taken in
+	int frame;			//frames played since the level started when the snapshot was taken
+	int angle;			//angle of the launch velocity
+	int launchedFlag;	//the playerBall had been launched
+	double magnitude;	//magnitude of the launch velocity
+};
+
+class SnapshotRing
+{
+public:
+	void reset(int, const World&);
+		//Empty the ring and size it for a number of snapshots of a world's level (the memory is only allocated when the level's size changes)
+	void clear();
+		//Drop every snapshot
+	void push(const SnapshotHeader&, const World&);
+		//Snapshot the game's flags and a world's state as the newest snapshot, overwriting the oldest if the ring is full
+	bool restore(int, SnapshotHeader&, World&) const;
+		//Put a world and the game's flags in the state of a snapshot a number of frames older than the newest, return false if there's none that old or it's of another level
+	void drop(int);
+		//Drop a number of the newest snapshots, so the next one pushed follows the one left newest
+	const void* getState(int) const;
+		//return the world state of a snapshot a number of frames older than the newest (nullptr if none), which any world of the same level can load
+	int getCount() const;
+		//return the number of snapshots held
+	int getCapacity() const;
+		//return the most snapshots the ring holds
+	SnapshotRing();
+		//Constructor, no room for snapshots
+private:
+	unsigned char* slot(int);
+		//return the start of a snapshot a number of frames older than the newest
+	const unsigned char* slot(int) const;
+		//return the start of a snapshot a number of frames older than the newest
+	std::vector<unsigned char> memory;	//Memory of every snapshot, one slot after the other, allocated once
+	size_t slotSize;					//Bytes of a slot: the header, then the world state, rounded up to keep the next slot aligned
+	int capacity;						//Most snapshots the ring holds
+	int newest;							//Slot of the newest snapshot
+	int count;							//Number of snapshots held
+};
+
+#endif //SNAPSHOT_H
@@ -0,0 +1,470 @@
+/* Program name: sweep.cpp
+*  Author: Cory Knoll
+*  Date Last Modified: 10/17/2026
+*  Description: Swept-circle narrowphase: the time of impact and normal of a moving ball against a block's rounded box, one box at a time or against a batch of boxes, and against convex polygons, along a straight trajectory or an exact parabola (no Qt dependency)
+	================================================================
+	FUNCTIONS:
+	+ bool sweepCircleBox(Vec2D, Vec2D, double, const SweepBox&, double, SweepHit&) - Find when a ball moving along a trajectory first touches a box (no later than a maximum portion of the trajectory), return false if it doesn't
+	+ int sweepCircleBoxes(Vec2D, Vec2D, double, const SweepBoxes&, const int*, int, double, SweepHit&) - Find the box of a list the ball touches first (SSE/AVX with a scalar fallback), return its position in the list or -1 if it touches none
+	+ bool sweepParabolaCircle(Vec2D, Vec2D, Vec2D, double, double, double&) - Find when a point moving from an offset from a circle's center with a velocity and a constant acceleration first comes within the circle's radius (no later than a maximum time), return false if it doesn't
+	+ bool sweepParabolaBox(Vec2D, Vec2D, Vec2D, double, const SweepBox&, double, SweepHit&) - Find when a ball moving from a center with a velocity and a constant acceleration first touches a box (no later than a maximum time), return false if it doesn't
+	+ SweepBox parabolaBounds(Vec2D, Vec2D, Vec2D, double) - return the box a point moving from a center with a velocity and a constant acceleration stays in up to a time
+	+ bool sweepPolygon(Vec2D, Vec2D, Vec2D, double, const SweepPolygon&, double, SweepHit&) - Find when a ball moving from a center with a velocity and a constant acceleration (none for a straight trajectory) first touches a convex polygon (no later than a maximum time), return false if it doesn't
+	+ void add(const SweepBox&) - Add a box to the batch
+	+ void clear() - Remove all boxes from the batch
+	+ int size() const - return the number of boxes in the batch
+	============================================================================
+	VARIABLES:
+	+ std::vector<double> xMin - left bounds of the boxes
+	+ std::vector<double> yMin - top bounds of the boxes
+	+ std::vector<double> xMax - right bounds of the boxes
+	+ std::vector<double> yMax - bottom bounds of the boxes
+	============================================================================
+	STRUCTS:
+	+ SweepBox - bounds of a box
+	+ SweepHit - portion of the trajectory until a ball touches a box, and the normal of the box where it does
+	+ SweepPolygon - corners, edge normals, bounds and outline of a convex polygon
+	============================================================================
+	STATIC HELPERS:
+	- double evaluatePolynomial(const double*, int, double) - return the value of a polynomial (coefficients from the constant up) at a time
+	- int polynomialRoots(const double*, int, double, double, double*) - Find every time between two times where a polynomial of degree 4 or less crosses 0, ascending, return how many there are
+	- bool enterSlab(double, double, double, double, double, double&) - Find when a coordinate moving with a velocity and a constant acceleration first reaches a side moving in the direction the side faces into, no later than a maximum time, return false if it doesn't
+*/
+
+#include <algorithm>
+#include <cmath>
+#include "sweep.h"
+
+//pick the widest vector instruction set the compiler was allowed to target
+#if defined(__AVX__)
+#include <immintrin.h>
+#define SWEEP_AVX
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define SWEEP_SSE2
+#endif
+
+//Add a box to the batch
+void SweepBoxes::add(const SweepBox &box)
+{
+	xMin.push_back(box.xMin);
+	yMin.push_back(box.yMin);
+	xMax.push_back(box.xMax);
+	yMax.push_back(box.yMax);
+}
+
+//Remove all boxes from the batch
+void SweepBoxes::clear()
+{
+	xMin.clear();
+	yMin.clear();
+	xMax.clear();
+	yMax.clear();
+}
+
+//return the number of boxes in the batch
+int SweepBoxes::size() const
+{
+	return (int)xMin.size();
+}
+
+//Find when a ball moving along a trajectory first touches a box (no later than a maximum portion of the trajectory), return false if it doesn't
+bool sweepCircleBox(Vec2D center, Vec2D trajectory, double radius, const SweepBox &box, double maxToi, SweepHit &hit)
+{
+	//most boxes handed to the test are nowhere near the ball's path: if the path stays on one side of the box grown by the radius,
+	//nothing else is needed
+	Vec2D end = center + trajectory * maxToi;
+	if ((center.x < box.xMin - radius && end.x < box.xMin - radius) || (center.x > box.xMax + radius && end.x > box.xMax + radius)
+		|| (center.y < box.yMin - radius && end.y < box.yMin - radius) || (center.y > box.yMax + radius && end.y > box.yMax + radius))
+		return false;
+
+	//the center of a ball touching the box lies on the box's outline pushed out by the radius: four straight sides joined by
+	//quarter circles around the corners. The grown box contains that rounded box, so first find where the center enters the
+	//grown box (slab by slab, vertical and horizontal motion included) and which side it enters by
+	double enter = -HUGE_VAL;	//portion of the trajectory where the center enters the grown box
+	double leave = HUGE_VAL;	//portion of the trajectory where the center leaves the grown box
+	Vec2D enterNormal;			//normal of the side of the grown box the center enters by
+	if (trajectory.x == 0)
+	{
+		if (center.x < box.xMin - radius || center.x > box.xMax + radius)
+			return false;
+	}
+	else
+	{
+		enter = ((trajectory.x > 0 ? box.xMin - radius : box.xMax + radius) - center.x) / trajectory.x;
+		leave = ((trajectory.x > 0 ? box.xMax + radius : box.xMin - radius) - center.x) / trajectory.x;
+		enterNormal = Vec2D(trajectory.x > 0 ? -1 : 1, 0);
+	}
+	if (trajectory.y == 0)
+	{
+		if (center.y < box.yMin - radius || center.y > box.yMax + radius)
+			return false;
+	}
+	else
+	{
+		double enterY = ((trajectory.y > 0 ? box.yMin - radius : box.yMax + radius) - center.y) / trajectory.y;
+		double leaveY = ((trajectory.y > 0 ? box.yMax + radius : box.yMin - radius) - center.y) / trajectory.y;
+		if (enterY > enter)
+		{
+			enter = enterY;
+			enterNormal = Vec2D(0, trajectory.y > 0 ? -1 : 1);
+		}
+		if (leaveY < leave)
+			leave = leaveY;
+	}
+	if (enter > leave || leave < 0 || enter > maxToi)
+		return false;
+
+	//entering the grown box beside one of the box's sides is touching that side; entering it beyond a corner (or starting there) the
+	//ball only touches the box if the center reaches the quarter circle around that corner: solve |offset + t*trajectory| = radius
+	Vec2D entry = center + trajectory * (enter > 0 ? enter : 0);
+	bool beyondX = entry.x < box.xMin || entry.x > box.xMax;
+	bool beyondY = entry.y < box.yMin || entry.y > box.yMax;
+	if (beyondX && beyondY)
+	{
+		Vec2D offset = center - Vec2D(entry.x < box.xMin ? box.xMin : box.xMax, entry.y < box.yMin ? box.yMin : box.yMax);
+		double A = trajectory.lengthSquared();
+		double B = offset.dot(trajectory);
+		double C = offset.lengthSquared() - radius * radius;
+		if (C <= 0 || B >= 0 || B * B - A * C < 0)
+			return false;
+		double toi = (-B - sqrt(B * B - A * C)) / A;
+		if (toi > maxToi)
+			return false;
+		hit.toi = toi;
+		hit.normal = (offset + trajectory * toi) / radius;
+		return true;
+	}
+
+	//a ball that starts already overlapping a side (touching, or pushed in by another ball) is left to the contact test
+	if (enter < 0)
+		return false;
+	hit.toi = enter;
+	hit.normal = enterNormal;
+	return true;
+}
+
+//Find the box of a list the ball touches first (SSE/AVX with a scalar fallback), return its position in the list or -1 if it touches none
+int sweepCircleBoxes(Vec2D center, Vec2D trajectory, double radius, const SweepBoxes &boxes, const int *indices, int count, double maxToi, SweepHit &hit)
+{
+	//boxes are tested in list order and a box touched at the same time as an earlier one replaces it, the same as testing them one by one
+	int first = -1;
+	int i = 0;
+
+	//several boxes at a time, run the slab test against the grown boxes with the same operations as sweepCircleBox(), and only
+	//run the exact test on the boxes that pass it (a ball moving straight along an axis goes through the scalar path instead)
+#if defined(SWEEP_AVX) || defined(SWEEP_SSE2)
+	if (trajectory.x != 0 && trajectory.y != 0)
+	{
+		const double *nearX = trajectory.x > 0 ? boxes.xMin.data() : boxes.xMax.data();
+		const double *farX = trajectory.x > 0 ? boxes.xMax.data() : boxes.xMin.data();
+		const double *nearY = trajectory.y > 0 ? boxes.yMin.data() : boxes.yMax.data();
+		const double *farY = trajectory.y > 0 ? boxes.yMax.data() : boxes.yMin.data();
+		double growX = trajectory.x > 0 ? -radius : radius;
+		double growY = trajectory.y > 0 ? -radius : radius;
+#if defined(SWEEP_AVX)
+		const int width = 4;
+		const __m256d startX = _mm256_set1_pd(center.x), startY = _mm256_set1_pd(center.y);
+		const __m256d moveX = _mm256_set1_pd(trajectory.x), moveY = _mm256_set1_pd(trajectory.y);
+		const __m256d nearGrowX = _mm256_set1_pd(growX), nearGrowY = _mm256_set1_pd(growY);
+		const __m256d zero = _mm256_setzero_pd();
+#else
+		const int width = 2;
+		const __m128d startX = _mm_set1_pd(center.x), startY = _mm_set1_pd(center.y);
+		const __m128d moveX = _mm_set1_pd(trajectory.x), moveY = _mm_set1_pd(trajectory.y);
+		const __m128d nearGrowX = _mm_set1_pd(growX), nearGrowY = _mm_set1_pd(growY);
+		const __m128d zero = _mm_setzero_pd();
+#endif
+		for (; i + width <= count; i += width)
+		{
+			const int *box = indices + i;
+#if defined(SWEEP_AVX)
+			__m256d enterX = _mm256_div_pd(_mm256_sub_pd(_mm256_add_pd(_mm256_set_pd(nearX[box[3]], nearX[box[2]], nearX[box[1]], nearX[box[0]]), nearGrowX), startX), moveX);
+			__m256d leaveX = _mm256_div_pd(_mm256_sub_pd(_mm256_sub_pd(_mm256_set_pd(farX[box[3]], farX[box[2]], farX[box[1]], farX[box[0]]), nearGrowX), startX), moveX);
+			__m256d enterY = _mm256_div_pd(_mm256_sub_pd(_mm256_add_pd(_mm256_set_pd(nearY[box[3]], nearY[box[2]], nearY[box[1]], nearY[box[0]]), nearGrowY), startY), moveY);
+			__m256d leaveY = _mm256_div_pd(_mm256_sub_pd(_mm256_sub_pd(_mm256_set_pd(farY[box[3]], farY[box[2]], farY[box[1]], farY[box[0]]), nearGrowY), startY), moveY);
+			__m256d enter = _mm256_max_pd(enterX, enterY);
+			__m256d leave = _mm256_min_pd(leaveX, leaveY);
+			__m256d pass = _mm256_and_pd(_mm256_and_pd(_mm256_cmp_pd(enter, leave, _CMP_LE_OQ), _mm256_cmp_pd(leave, zero, _CMP_GE_OQ)),
+				_mm256_cmp_pd(enter, _mm256_set1_pd(maxToi), _CMP_LE_OQ));
+			int lanes = _mm256_movemask_pd(pass);
+#else
+			__m128d enterX = _mm_div_pd(_mm_sub_pd(_mm_add_pd(_mm_set_pd(nearX[box[1]], nearX[box[0]]), nearGrowX), startX), moveX);
+			__m128d leaveX = _mm_div_pd(_mm_sub_pd(_mm_sub_pd(_mm_set_pd(farX[box[1]], farX[box[0]]), nearGrowX), startX), moveX);
+			__m128d enterY = _mm_div_pd(_mm_sub_pd(_mm_add_pd(_mm_set_pd(nearY[box[1]], nearY[box[0]]), nearGrowY), startY), moveY);
+			__m128d leaveY = _mm_div_pd(_mm_sub_pd(_mm_sub_pd(_mm_set_pd(farY[box[1]], farY[box[0]]), nearGrowY), startY), moveY);
+			__m128d enter = _mm_max_pd(enterX, enterY);
+			__m128d leave = _mm_min_pd(leaveX, leaveY);
+			__m128d pass = _mm_and_pd(_mm_and_pd(_mm_cmple_pd(enter, leave), _mm_cmpge_pd(leave, zero)), _mm_cmple_pd(enter, _mm_set1_pd(maxToi)));
+			int lanes = _mm_movemask_pd(pass);
+#endif
+			for (int lane = 0; lane < width; lane++)
+				if (lanes & (1 << lane))
+				{
+					SweepBox candidate = { boxes.xMin[box[lane]], boxes.yMin[box[lane]], boxes.xMax[box[lane]], boxes.yMax[box[lane]] };
+					if (sweepCircleBox(center, trajectory, radius, candidate, maxToi, hit))
+					{
+						maxToi = hit.toi;
+						first = i + lane;
+					}
+				}
+		}
+	}
+#endif
+
+	//scalar fallback for the remaining boxes (or all of them without SSE2)
+	for (; i < count; i++)
+	{
+		SweepBox candidate = { boxes.xMin[indices[i]], boxes.yMin[indices[i]], boxes.xMax[indices[i]], boxes.yMax[indices[i]] };
+		if (sweepCircleBox(center, trajectory, radius, candidate, maxToi, hit))
+		{
+			maxToi = hit.toi;
+			first = i;
+		}
+	}
+	return first;
+}
+
+//return the value of a polynomial (coefficients from the constant up) at a time
+static double evaluatePolynomial(const double *coefficients, int degree, double time)
+{
+	double value = coefficients[degree];
+	for (int i = degree - 1; i >= 0; i--)
+		value = value * time + coefficients[i];
+	return value;
+}
+
+//Find every time between two times where a polynomial of degree 4 or less crosses 0, ascending, return how many there are
+static int polynomialRoots(const double *coefficients, int degree, double from, double to, double *roots)
+{
+	while (degree > 0 && coefficients[degree] == 0)
+		degree--;
+	int count = 0;
+	if (degree == 0)
+		return 0;
+	if (degree == 1)
+	{
+		double root = -coefficients[0] / coefficients[1];
+		if (root >= from && root <= to)
+			roots[count++] = root;
+		return count;
+	}
+	if (degree == 2)
+	{
+		//the form that doesn't subtract two nearly equal numbers, and a touching (double) root isn't a crossing
+		double a = coefficients[2], b = coefficients[1], c = coefficients[0];
+		double discriminant = b * b - 4 * a * c;
+		if (discriminant <= 0)
+			return 0;
+		double q = -0.5 * (b + (b >= 0 ? sqrt(discriminant) : -sqrt(discriminant)));
+		double first = q / a, second = q != 0 ? c / q : -first;
+		if (first > second)
+			std::swap(first, second);
+		if (first >= from && first <= to)
+			roots[count++] = first;
+		if (second >= from && second <= to)
+			roots[count++] = second;
+		return count;
+	}
+
+	//higher degrees: between two roots of the derivative the polynomial only goes one way, so every piece of the range split at
+	//them crosses 0 at most once, and halving a piece whose ends have different signs narrows that crossing down
+	double derivative[4] = { 0, 0, 0, 0 };
+	for (int i = 1; i <= degree; i++)
+		derivative[i - 1] = coefficients[i] * i;
+	double ends[5];
+	int pieces = polynomialRoots(derivative, degree - 1, from, to, ends);
+	ends[pieces] = to;
+	double start = from;
+	double startValue = evaluatePolynomial(coefficients, degree, from);
+	for (int i = 0; i <= pieces; i++)
+	{
+		double end = ends[i];
+		double endValue = evaluatePolynomial(coefficients, degree, end);
+		if ((startValue < 0) != (endValue < 0))
+		{
+			double low = start, high = end;
+			for (int step = 0; step < PARABOLA_ROOT_STEPS && high - low > 1e-12 * (1 + high); step++)
+			{
+				double middle = 0.5 * (low + high);
+				if ((evaluatePolynomial(coefficients, degree, middle) < 0) == (startValue < 0))
+					low = middle;
+				else
+					high = middle;
+			}
+			roots[count++] = 0.5 * (low + high);
+		}
+		start = end;
+		startValue = endValue;
+	}
+	return count;
+}
+
+//Find when a coordinate moving with a velocity and a constant acceleration first reaches a side moving in the direction the side faces into, no later than a maximum time, return false if it doesn't
+static bool enterSlab(double gap, double speed, double acceleration, double maxTime, double &time)
+{
+	//gap is how far the coordinate is outside the side, speed and acceleration point out of it: the gap (a quadratic in time)
+	//has to reach 0 while shrinking. Starting on the side, or a hair past it, moving (or only just starting to move) in counts as
+	//touching it right away
+	if (gap <= 0 && gap > -PARABOLA_TOLERANCE && (speed < 0 || (speed == 0 && acceleration < 0)))
+	{
+		time = 0;
+		return true;
+	}
+	double coefficients[3] = { gap, speed, 0.5 * acceleration };
+	double roots[2];
+	int count = polynomialRoots(coefficients, 2, 0, maxTime, roots);
+	for (int i = 0; i < count; i++)
+		if (speed + acceleration * roots[i] < 0)
+		{
+			time = roots[i];
+			return true;
+		}
+	return false;
+}
+
+//Find when a point moving from an offset from a circle's center with a velocity and a constant acceleration first comes within the circle's radius (no later than a maximum time), return false if it doesn't
+bool sweepParabolaCircle(Vec2D offset, Vec2D velocity, Vec2D acceleration, double radius, double maxTime, double &time)
+{
+	//|offset + velocity*t + acceleration*t^2/2|^2 - radius^2 is a quartic in t; the point comes within the circle where it
+	//crosses 0 going down. Starting on the circle, or a hair inside it, moving (or only just starting to move) in counts as
+	//touching it right away
+	Vec2D half = acceleration * 0.5;
+	double coefficients[5] = { offset.lengthSquared() - radius * radius, 2 * offset.dot(velocity), velocity.lengthSquared() + 2 * offset.dot(half),
+		2 * velocity.dot(half), half.lengthSquared() };
+	if (coefficients[0] <= 0 && coefficients[0] > -2 * radius * PARABOLA_TOLERANCE && (coefficients[1] < 0 || (coefficients[1] == 0 && coefficients[2] < 0)))
+	{
+		time = 0;
+		return true;
+	}
+	double roots[4];
+	int count = polynomialRoots(coefficients, 4, 0, maxTime, roots);
+	for (int i = 0; i < count; i++)
+	{
+		double slope = coefficients[1] + roots[i] * (2 * coefficients[2] + roots[i] * (3 * coefficients[3] + roots[i] * 4 * coefficients[4]));
+		if (slope < 0)
+		{
+			time = roots[i];
+			return true;
+		}
+	}
+	return false;
+}
+
+//Find when a ball moving from a center with a velocity and a constant acceleration first touches a box (no later than a maximum time), return false if it doesn't
+bool sweepParabolaBox(Vec2D center, Vec2D velocity, Vec2D acceleration, double radius, const SweepBox &box, double maxTime, SweepHit &hit)
+{
+	SweepBox path = parabolaBounds(center, velocity, acceleration, maxTime);
+	double pathXMin = path.xMin, pathYMin = path.yMin, pathXMax = path.xMax, pathYMax = path.yMax;
+	if (pathXMax < box.xMin - radius || pathXMin > box.xMax + radius || pathYMax < box.yMin - radius || pathYMin > box.yMax + radius)
+		return false;
+
+	//unlike a straight line, a parabola can enter and leave the grown box more than once, so every side of the rounded box is
+	//swept on its own: each straight side is a slab the center enters beside the box, each corner a quarter circle it enters
+	//beyond both of the box's sides, and the earliest of them is the hit
+	bool found = false;
+	double time;
+	const double sides[4][3] = {	//outward normal of every side of the grown box, and how far along it the side is
+		{ -1, 0, radius - box.xMin }, { 1, 0, box.xMax + radius }, { 0, -1, radius - box.yMin }, { 0, 1, box.yMax + radius } };
+	for (int i = 0; i < 4; i++)
+	{
+		Vec2D normal(sides[i][0], sides[i][1]);
+		double gap = normal.dot(center) - sides[i][2];
+		if (!enterSlab(gap, velocity.dot(normal), acceleration.dot(normal), found ? hit.toi : maxTime, time) || (found && time >= hit.toi))
+			continue;
+		Vec2D entry = center + velocity * time + acceleration * (0.5 * time * time);
+		if (normal.x != 0 ? (entry.y < box.yMin || entry.y > box.yMax) : (entry.x < box.xMin || entry.x > box.xMax))
+			continue;
+		hit.toi = time;
+		hit.normal = normal;
+		found = true;
+	}
+	for (int i = 0; i < 4; i++)
+	{
+		Vec2D corner(i & 1 ? box.xMax : box.xMin, i & 2 ? box.yMax : box.yMin);
+		if ((i & 1 ? pathXMax <= box.xMax : pathXMin >= box.xMin) || (i & 2 ? pathYMax <= box.yMax : pathYMin >= box.yMin)
+			|| pathXMax < corner.x - radius || pathXMin > corner.x + radius || pathYMax < corner.y - radius || pathYMin > corner.y + radius)
+			continue;
+		Vec2D offset = center - corner;
+		if (!sweepParabolaCircle(offset, velocity, acceleration, radius, found ? hit.toi : maxTime, time) || (found && time >= hit.toi))
+			continue;
+		Vec2D touch = offset + velocity * time + acceleration * (0.5 * time * time);
+		if ((i & 1 ? touch.x < 0 : touch.x > 0) || (i & 2 ? touch.y < 0 : touch.y > 0))
+			continue;
+		hit.toi = time;
+		hit.normal = touch / radius;
+		found = true;
+	}
+	return found;
+}
+
+//return the box a point moving from a center with a velocity and a constant acceleration stays in up to a time
+SweepBox parabolaBounds(Vec2D center, Vec2D velocity, Vec2D acceleration, double maxTime)
+{
+	//its ends and, if it turns around on an axis in between, where it does
+	Vec2D end = center + velocity * maxTime + acceleration * (0.5 * maxTime * maxTime);
+	SweepBox path = { std::min(center.x, end.x), std::min(center.y, end.y), std::max(center.x, end.x), std::max(center.y, end.y) };
+	if (acceleration.x != 0 && -velocity.x / acceleration.x > 0 && -velocity.x / acceleration.x < maxTime)
+	{
+		double turn = center.x - 0.5 * velocity.x * velocity.x / acceleration.x;
+		path.xMin = std::min(path.xMin, turn);
+		path.xMax = std::max(path.xMax, turn);
+	}
+	if (acceleration.y != 0 && -velocity.y / acceleration.y > 0 && -velocity.y / acceleration.y < maxTime)
+	{
+		double turn = center.y - 0.5 * velocity.y * velocity.y / acceleration.y;
+		path.yMin = std::min(path.yMin, turn);
+		path.yMax = std::max(path.yMax, turn);
+	}
+	return path;
+}
+
+//Find when a ball moving from a center with a velocity and a constant acceleration (none for a straight trajectory) first touches a convex polygon (no later than a maximum time), return false if it doesn't
+bool sweepPolygon(Vec2D center, Vec2D velocity, Vec2D acceleration, double radius, const SweepPolygon &polygon, double maxTime, SweepHit &hit)
+{
+	//touching the polygon's outline is touching the polygon itself with a ball that much bigger
+	radius += polygon.reach;
+	SweepBox path = parabolaBounds(center, velocity, acceleration, maxTime);
+	if (path.xMax < polygon.bounds.xMin - radius || path.xMin > polygon.bounds.xMax + radius || path.yMax < polygon.bounds.yMin - radius
+		|| path.yMin > polygon.bounds.yMax + radius)
+		return false;
+
+	//the center of a ball touching the polygon lies on its edges pushed out by the radius, joined by arcs around the corners, the
+	//same as a box's rounded outline but with any edge normals: every edge is a slab the center enters beside the edge, every corner
+	//a circle it enters between the normals of the edges that meet there, and the earliest of them is the hit. The acceleration
+	//only raises the degree of each test, so a straight trajectory (and toi as a portion of it) goes through the same tests
+	bool found = false;
+	double time;
+	for (int i = 0; i < polygon.count; i++)
+	{
+		Vec2D normal = polygon.normals[i];
+		Vec2D start = polygon.points[i];
+		Vec2D edge = polygon.points[i + 1 < polygon.count ? i + 1 : 0] - start;
+		if (!enterSlab(normal.dot(center - start) - radius, normal.dot(velocity), normal.dot(acceleration), found ? hit.toi : maxTime, time) || (found && time >= hit.toi))
+			continue;
+		double along = (center + velocity * time + acceleration * (0.5 * time * time) - start).dot(edge);
+		if (along < 0 || along > edge.lengthSquared())
+			continue;
+		hit.toi = time;
+		hit.normal = normal;
+		found = true;
+	}
+	for (int i = 0; i < polygon.count; i++)
+	{
+		Vec2D corner = polygon.points[i];
+		if (path.xMax < corner.x - radius || path.xMin > corner.x + radius || path.yMax < corner.y - radius || path.yMin > corner.y + radius)
+			continue;
+		Vec2D offset = center - corner;
+		if (!sweepParabolaCircle(offset, velocity, acceleration, radius, found ? hit.toi : maxTime, time) || (found && time >= hit.toi))
+			continue;
+		Vec2D touch = offset + velocity * time + acceleration * (0.5 * time * time);
+		Vec2D before = corner - polygon.points[i > 0 ? i - 1 : polygon.count - 1];
+		Vec2D after = polygon.points[i + 1 < polygon.count ? i + 1 : 0] - corner;
+		if (touch.dot(before) < 0 || touch.dot(after) > 0)
+			continue;
+		hit.toi = time;
+		hit.normal = touch / radius;
+		found = true;
+	}
+	return found;
+}
@@ -0,0 +1,90 @@
+/* Program name: sweep.h
+*  Author: Cory Knoll
+*  Date Last Modified: 10/17/2026
+*  Description: Swept-circle narrowphase: the time of impact and normal of a moving ball against a block's rounded box, one box at a time or against a batch of boxes, and against convex polygons, along a straight trajectory or an exact parabola (no Qt dependency)
+	================================================================
+	FUNCTIONS:
+	+ bool sweepCircleBox(Vec2D, Vec2D, double, const SweepBox&, double, SweepHit&) - Find when a ball moving along a trajectory first touches a box (no later than a maximum portion of the trajectory), return false if it doesn't
+	+ int sweepCircleBoxes(Vec2D, Vec2D, double, const SweepBoxes&, const int*, int, double, SweepHit&) - Find the box of a list the ball touches first (SSE/AVX with a scalar fallback), return its position in the list or -1 if it touches none
+	+ bool sweepParabolaCircle(Vec2D, Vec2D, Vec2D, double, double, double&) - Find when a point moving from an offset from a circle's center with a velocity and a constant acceleration first comes within the circle's radius (no later than a maximum time), return false if it doesn't
+	+ bool sweepParabolaBox(Vec2D, Vec2D, Vec2D, double, const SweepBox&, double, SweepHit&) - Find when a ball moving from a center with a velocity and a constant acceleration first touches a box (no later than a maximum time), return false if it doesn't
+	+ SweepBox parabolaBounds(Vec2D, Vec2D, Vec2D, double) - return the box a point moving from a center with a velocity and a constant acceleration stays in up to a time
+	+ bool sweepPolygon(Vec2D, Vec2D, Vec2D, double, const SweepPolygon&, double, SweepHit&) - Find when a ball moving from a center with a velocity and a constant acceleration (none for a straight trajectory) first touches a convex polygon (no later than a maximum time), return false if it doesn't
+	+ void add(const SweepBox&) - Add a box to the batch
+	+ void clear() - Remove all boxes from the batch
+	+ int size() const - return the number of boxes in the batch
+	============================================================================
+	VARIABLES:
+	+ std::vector<double> xMin - left bounds of the boxes
+	+ std::vector<double> yMin - top bounds of the boxes
+	+ std::vector<double> xMax - right bounds of the boxes
+	+ std::vector<double> yMax - bottom bounds of the boxes
+	============================================================================
+	STRUCTS:
+	+ SweepBox - bounds of a box
+	+ SweepHit - portion of the trajectory until a ball touches a box, and the normal of the box where it does
+	+ SweepPolygon - corners, edge normals, bounds and outline of a convex polygon
+*/
+
+#ifndef SWEEP_H
+#define SWEEP_H
+
+#include <vector>
+#include "vec2d.h"
+
+#define PARABOLA_TOLERANCE 1e-6	//How far a ball can start past a side or into a corner of a box and still be touching it along a parabola
+#define PARABOLA_ROOT_STEPS 64		//Most halvings that narrow down the time a parabola crosses a corner's circle
+
+struct SweepBox
+{
+	double xMin;	//left bound of the box
+	double yMin;	//top bound of the box
+	double xMax;	//right bound of the box
+	double yMax;	//bottom bound of the box
+};
+
+struct SweepHit
+{
+	double toi;		//portion of the trajectory (or time along a parabola) until the ball touches the box
+	Vec2D normal;	//unit normal of the box where the ball touches it
+};
+
+struct SweepPolygon
+{
+	const Vec2D *points;	//corners in order around the polygon
+	const Vec2D *normals;	//outward unit normal of the edge from every corner to the next
+	int count;				//number of corners
+	SweepBox bounds;		//bounds of the corners
+	double reach;			//how far the polygon's outline reaches past its edges, rounding its corners
+};
+
+class SweepBoxes
+{
+public:
+	void add(const SweepBox&);
+		//Add a box to the batch
+	void clear();
+		//Remove all boxes from the batch
+	int size() const;
+		//return the number of boxes in the batch
+	//Each bound lives in its own contiguous array so the batch test can load several boxes per instruction
+	std::vector<double> xMin;	//left bounds of the boxes
+	std::vector<double> yMin;	//top bounds of the boxes
+	std::vector<double> xMax;	//right bounds of the boxes
+	std::vector<double> yMax;	//bottom bounds of the boxes
+};
+
+bool sweepCircleBox(Vec2D, Vec2D, double, const SweepBox&, double, SweepHit&);
+	//Find when a ball moving along a trajectory first touches a box (no later than a maximum portion of the trajectory), return false if it doesn't
+int sweepCircleBoxes(Vec2D, Vec2D, double, const SweepBoxes&, const int*, int, double, SweepHit&);
+	//Find the box of a list the ball touches first (SSE/AVX with a scalar fallback), return its position in the list or -1 if it touches none
+bool sweepParabolaCircle(Vec2D, Vec2D, Vec2D, double, double, double&);
+	//Find when a point moving from an offset from a circle's center with a velocity and a constant acceleration first comes within the circle's radius (no later than a maximum time), return false if it doesn't
+bool sweepParabolaBox(Vec2D, Vec2D, Vec2D, double, const SweepBox&, double, SweepHit&);
+	//Find when a ball moving from a center with a velocity and a constant acceleration first touches a box (no later than a maximum time), return false if it doesn't
+SweepBox parabolaBounds(Vec2D, Vec2D, Vec2D, double);
+	//return the box a point moving from a center with a velocity and a constant acceleration stays in up to a time
+bool sweepPolygon(Vec2D, Vec2D, Vec2D, double, const SweepPolygon&, double, SweepHit&);
+	//Find when a ball moving from a center with a velocity and a constant acceleration (none for a straight trajectory) first touches a convex polygon (no later than a maximum time), return false if it doesn't
+
+#endif //SWEEP_H
@@ -0,0 +1,180 @@
+/* Program name: threadpool.cpp
+*  Author: Cory Knoll
+*  Date Last Modified: 10/17/2026
+*  Description: Work-stealing pool of worker threads that runs a batch of independent tasks and waits for all of them to finish (no Qt dependency)
+	================================================================
+	FUNCTIONS:
+	+ void run(int, const std::function<void(int, int)>&) - Run a number of tasks, each given its task index and the index of the worker running it, and wait for them to finish
+	+ void setThreadCount(int) - Set the number of threads (including the calling thread) that share the tasks, 0 for one per core
+	+ int getThreadCount() const - return the number of threads that share the tasks
+	+ ThreadPool(int = 0) - Constructor, set the number of threads (the helper threads are only started by the first batch that needs them)
+	+ ~ThreadPool() - Destructor, stop and join the helper threads
+	- void startThreads() - Start the helper threads
+	- void stopThreads() - Stop and join the helper threads
+	- void workerLoop(int, int) - Wait for batches newer than the one given and work on them until the pool is stopped (helper threads)
+	- void workOn(int) - Run tasks from a worker's own queue, then steal from the others until every queue is empty
+	- bool takeTask(int, int&) - Take a task from the back of a worker's own queue or the front of another worker's queue
+	============================================================================
+	VARIABLES:
+	- int threadCount - Number of threads that share the tasks, the calling thread being worker 0
+	- std::vector<std::thread> threads - The helper threads (workers 1 and up)
+	- std::vector<std::unique_ptr<TaskQueue>> queues - Queue of task indices of every worker
+	- const std::function<void(int, int)> *job - The task function of the batch being run
+	- std::mutex lock - Guards the batch state shared with the helper threads
+	- std::condition_variable wake - Signals the helper threads that a batch started or the pool is stopping
+	- std::condition_variable done - Signals the calling thread that a helper thread finished its part of the batch
+	- int batch - Number of the batch being run, so a helper thread can tell a new batch from the one it finished
+	- int busy - Number of helper threads still working on the current batch
+	- bool stopping - The helper threads should exit
+	============================================================================
+	STRUCTS:
+	- TaskQueue - task indices waiting to be run by one worker, and the lock guarding them
+*/
+
+#include <algorithm>
+#include "threadpool.h"
+
+//Run a number of tasks, each given its task index and the index of the worker running it, and wait for them to finish
+void ThreadPool::run(int taskCount, const std::function<void(int, int)> &task)
+{
+	//a single task (or a single thread) isn't worth waking anyone for
+	if (threadCount <= 1 || taskCount <= 1)
+	{
+		for (int i = 0; i < taskCount; i++)
+			task(i, 0);
+		return;
+	}
+	if (threads.empty())
+		startThreads();
+
+	//hand every worker a contiguous share of the tasks, then let idle workers steal whatever is left over
+	for (int i = 0; i < taskCount; i++)
+		queues[(long long)i * threadCount / taskCount]->tasks.push_back(i);
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		job = &task;
+		busy = threadCount - 1;
+		batch++;
+	}
+	wake.notify_all();
+
+	//the calling thread works as worker 0, then waits until no helper thread is still running a task
+	workOn(0);
+	std::unique_lock<std::mutex> guard(lock);
+	done.wait(guard, [this] { return busy == 0; });
+	job = nullptr;
+}
+
+//Set the number of threads (including the calling thread) that share the tasks, 0 for one per core
+void ThreadPool::setThreadCount(int count)
+{
+	if (count <= 0)
+		count = std::max(1, (int)std::thread::hardware_concurrency());
+	if (count == threadCount)
+		return;
+	stopThreads();
+	threadCount = count;
+	queues.clear();
+	for (int i = 0; i < threadCount; i++)
+		queues.push_back(std::unique_ptr<TaskQueue>(new TaskQueue));
+}
+
+//return the number of threads that share the tasks
+int ThreadPool::getThreadCount() const
+{
+	return threadCount;
+}
+
+//Start the helper threads
+void ThreadPool::startThreads()
+{
+	//the threads are started before the batch that needs them is published, so they'll see it as new
+	stopping = false;
+	for (int i = 1; i < threadCount; i++)
+		threads.push_back(std::thread(&ThreadPool::workerLoop, this, i, batch));
+}
+
+//Stop and join the helper threads
+void ThreadPool::stopThreads()
+{
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		stopping = true;
+	}
+	wake.notify_all();
+	for (std::thread &thread : threads)
+		thread.join();
+	threads.clear();
+}
+
+//Wait for batches newer than the one given and work on them until the pool is stopped (helper threads)
+void ThreadPool::workerLoop(int worker, int finished)
+{
+	while (true)
+	{
+		{
+			std::unique_lock<std::mutex> guard(lock);
+			wake.wait(guard, [this, finished] { return stopping || batch != finished; });
+			if (stopping)
+				return;
+			finished = batch;
+		}
+		workOn(worker);
+
+		//the calling thread only returns once every helper is done, so no helper can still be running the old task function in the next batch
+		std::lock_guard<std::mutex> guard(lock);
+		if (--busy == 0)
+			done.notify_one();
+	}
+}
+
+//Run tasks from a worker's own queue, then steal from the others until every queue is empty
+void ThreadPool::workOn(int worker)
+{
+	//every task is queued before the batch starts and tasks never queue more, so once all queues are empty this worker is done
+	int task;
+	while (takeTask(worker, task))
+		(*job)(task, worker);
+}
+
+//Take a task from the back of a worker's own queue or the front of another worker's queue
+bool ThreadPool::takeTask(int worker, int &task)
+{
+	//the owner and the thieves work from opposite ends so they rarely want the same task
+	for (int i = 0; i < threadCount; i++)
+	{
+		TaskQueue &queue = *queues[(worker + i) % threadCount];
+		std::lock_guard<std::mutex> guard(queue.lock);
+		if (queue.tasks.empty())
+			continue;
+		if (i == 0)
+		{
+			task = queue.tasks.back();
+			queue.tasks.pop_back();
+		}
+		else
+		{
+			task = queue.tasks.front();
+			queue.tasks.pop_front();
+		}
+		return true;
+	}
+	return false;
+}
+
+//Constructor, set the number of threads (the helper threads are only started by the first batch that needs them)
+ThreadPool::ThreadPool(int count)
+{
+	threadCount = 0;
+	job = nullptr;
+	batch = 0;
+	busy = 0;
+	stopping = false;
+	setThreadCount(count);
+}
+
+//Destructor, stop and join the helper threads
+ThreadPool::~ThreadPool()
+{
+	stopThreads();
+}
@@ -0,0 +1,86 @@
+/* Program name: threadpool.h
+*  Author: Cory Knoll
+*  Date Last Modified: 10/17/2026
+*  Description: Work-stealing pool of worker threads that runs a batch of independent tasks and waits for all of them to finish (no Qt dependency)
+	================================================================
+	FUNCTIONS:
+	+ void run(int, const std::function<void(int, int)>&) - Run a number of tasks, each given its task index and the index of the worker running it, and wait for them to finish
+	+ void setThreadCount(int) - Set the number of threads (including the calling thread) that share the tasks, 0 for one per core
+	+ int getThreadCount() const - return the number of threads that share the tasks
+	+ ThreadPool(int = 0) - Constructor, set the number of threads (the helper threads are only started by the first batch that needs them)
+	+ ~ThreadPool() - Destructor, stop and join the helper threads
+	- void startThreads() - Start the helper threads
+	- void stopThreads() - Stop and join the helper threads
+	- void workerLoop(int, int) - Wait for batches newer than the one given and work on them until the pool is stopped (helper threads)
+	- void workOn(int) - Run tasks from a worker's own queue, then steal from the others until every queue is empty
+	- bool takeTask(int, int&) - Take a task from the back of a worker's own queue or the front of another worker's queue
+	============================================================================
+	VARIABLES:
+	- int threadCount - Number of threads that share the tasks, the calling thread being worker 0
+	- std::vector<std::thread> threads - The helper threads (workers 1 and up)
+	- std::vector<std::unique_ptr<TaskQueue>> queues - Queue of task indices of every worker
+	- const std::function<void(int, int)> *job - The task function of the batch being run
+	- std::mutex lock - Guards the batch state shared with the helper threads
+	- std::condition_variable wake - Signals the helper threads that a batch started or the pool is stopping
+	- std::condition_variable done - Signals the calling thread that a helper thread finished its part of the batch
+	- int batch - Number of the batch being run, so a helper thread can tell a new batch from the one it finished
+	- int busy - Number of helper threads still working on the current batch
+	- bool stopping - The helper threads should exit
+	============================================================================
+	STRUCTS:
+	- TaskQueue - task indices waiting to be run by one worker, and the lock guarding them
+*/
+
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class ThreadPool
+{
+public:
+	void run(int, const std::function<void(int, int)>&);
+		//Run a number of tasks, each given its task index and the index of the worker running it, and wait for them to finish
+	void setThreadCount(int);
+		//Set the number of threads (including the calling thread) that share the tasks, 0 for one per core
+	int getThreadCount() const;
+		//return the number of threads that share the tasks
+	ThreadPool(int = 0);
+		//Constructor, set the number of threads (the helper threads are only started by the first batch that needs them)
+	~ThreadPool();
+		//Destructor, stop and join the helper threads
+private:
+	struct TaskQueue
+	{
+		std::mutex lock;		//guards the tasks
+		std::deque<int> tasks;	//indices of the tasks waiting to be run
+	};
+	void startThreads();
+		//Start the helper threads
+	void stopThreads();
+		//Stop and join the helper threads
+	void workerLoop(int, int);
+		//Wait for batches newer than the one given and work on them until the pool is stopped (helper threads)
+	void workOn(int);
+		//Run tasks from a worker's own queue, then steal from the others until every queue is empty
+	bool takeTask(int, int&);
+		//Take a task from the back of a worker's own queue or the front of another worker's queue
+	int threadCount;								//Number of threads that share the tasks, the calling thread being worker 0
+	std::vector<std::thread> threads;				//The helper threads (workers 1 and up)
+	std::vector<std::unique_ptr<TaskQueue>> queues;	//Queue of task indices of every worker
+	const std::function<void(int, int)> *job;		//The task function of the batch being run
+	std::mutex lock;								//Guards the batch state shared with the helper threads
+	std::condition_variable wake;					//Signals the helper threads that a batch started or the pool is stopping
+	std::condition_variable done;					//Signals the calling thread that a helper thread finished its part of the batch
+	int batch;										//Number of the batch being run, so a helper thread can tell a new batch from the one it finished
+	int busy;										//Number of helper threads still working on the current batch
+	bool stopping;									//The helper threads should exit
+};
+
+#endif //THREADPOOL_H
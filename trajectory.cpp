@@ -0,0 +1,91 @@
+/* Program name: trajectory.cpp
+*  Author: Cory Knoll
+*  Date Last Modified: 10/17/2026
+*  Description: Predict the path of a shot by fast-forwarding the physics world headlessly from its current state, within a time budget (no Qt dependency)
+	================================================================
+	FUNCTIONS:
+	+ bool predictTrajectory(World&, Vec2D, int, double, std::vector<Vec2D>&, int = 1) - Predict the path of a world's playerBall launched with a velocity from the world's current state, one point per step of a number of frames (steps longer than a frame follow the balls' parabolas), for up to a number of steps or a time budget (seconds), stopping early once it hits the goal or leaves the level for good; put the world back the way it was, return true if the path hits the goal
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include "trajectory.h"
+
+//Predict the path of a world's playerBall launched with a velocity from the world's current state, one point per step of a number of frames (steps longer than a frame follow the balls' parabolas), for up to a number of steps or a time budget (seconds), stopping early once it hits the goal or leaves the level for good; put the world back the way it was, return true if the path hits the goal
+bool predictTrajectory(World &world, Vec2D velocity, int maxSteps, double budget, std::vector<Vec2D> &path, int stepFrames)
+{
+	typedef std::chrono::steady_clock Clock;
+	Clock::time_point start = Clock::now();
+
+	//the prediction runs the real pipeline on the world the shot will be played in, so the blocks and the hierarchy over them are
+	//already there and nothing is copied; only the balls and the blocks with mass move, and a snapshot of them puts them back afterwards. The shot is a branch
+	//off whatever state the world is in: the level's start, or a moment the player rewound to
+	std::vector<unsigned char> state(world.getStateSize());
+	world.saveState(state.data());
+	world.setBallVelocity(0, velocity.x, velocity.y);
+	path.clear();
+	path.push_back(Vec2D(world.getBallX(0), world.getBallY(0)));
+
+	//every block (the roots of the hierarchies cover the level blocks and the polygon blocks, and each moving block is bounded by
+	//the whole of its path) lies inside these bounds, and every step widens them to wherever the blocks with mass have got to;
+	//nothing outside them can push the ball back, and gravity only pulls it down, so a ball past a side moving away, or below the
+	//bottom, never comes back
+	const BlockBody &goal = world.getGoalBlock();
+	double xMin = goal.xMin, yMin = goal.yMin, xMax = goal.xMax, yMax = goal.yMax;
+	const BVH *trees[2] = { &world.getBlockTree(), &world.getPolygonTree() };
+	for (const BVH *tree : trees)
+		if (tree->getNodeCount() > 0)
+		{
+			const BVH::Node &root = tree->getNodes()[0];
+			xMin = std::min(xMin, root.xMin);
+			yMin = std::min(yMin, root.yMin);
+			xMax = std::max(xMax, root.xMax);
+			yMax = std::max(yMax, root.yMax);
+		}
+	for (int i = 0; i < world.getMoverCount(); i++)
+	{
+		//a linear or ping-pong path keeps the block's corner between its start and its end, a circular one within the ellipse's radii
+		const MoverData &mover = world.getMoverPath(i);
+		bool circular = mover.kind == MOVER_CIRCULAR;
+		double left = circular ? mover.x - fabs(mover.dx) : std::min(mover.x, mover.x + mover.dx);
+		double top = circular ? mover.y - fabs(mover.dy) : std::min(mover.y, mover.y + mover.dy);
+		double right = circular ? mover.x + fabs(mover.dx) : std::max(mover.x, mover.x + mover.dx);
+		double bottom = circular ? mover.y + fabs(mover.dy) : std::max(mover.y, mover.y + mover.dy);
+		xMin = std::min(xMin, left);
+		yMin = std::min(yMin, top);
+		xMax = std::max(xMax, right + mover.width + BLOCK_OUTLINE_WIDTH - 1);
+		yMax = std::max(yMax, bottom + mover.height + BLOCK_OUTLINE_WIDTH - 1);
+	}
+	double radius = world.getBallRadius(0);
+
+	//a step of many frames along straight lines would cut the corners of every fall, along the parabolas it stays on the curve
+	//the frame steps' places lie on, so longer steps switch the world to parabolas until the prediction is done. It's still an
+	//approximation: the parabola misses the straight moves the frame steps make in between, so a bounce can come out differently
+	//(see World::setParabolicSteps())
+	bool parabolic = world.isParabolicSteps();
+	if (stepFrames > 1)
+		world.setParabolicSteps(true);
+	bool hit = false;
+	for (int step = 0; step < maxSteps && !hit; step++)
+	{
+		hit = world.step(stepFrames);
+		Vec2D center(world.getBallX(0), world.getBallY(0));
+		Vec2D speed = world.getBallVelocity(0);
+		path.push_back(center);
+		for (const BlockBody &block : world.getDynamicBlocks())
+		{
+			xMin = std::min(xMin, block.xMin);
+			yMin = std::min(yMin, block.yMin);
+			xMax = std::max(xMax, block.xMax);
+			yMax = std::max(yMax, block.yMax);
+		}
+		if ((center.x < xMin - radius && speed.x <= 0) || (center.x > xMax + radius && speed.x >= 0) || (center.y > yMax + radius && speed.y >= 0))
+			break;
+		if (std::chrono::duration<double>(Clock::now() - start).count() > budget)
+			break;
+	}
+	world.setParabolicSteps(parabolic);
+	world.loadState(state.data());
+	return hit;
+}
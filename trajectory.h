@@ -0,0 +1,20 @@
+/* Program name: trajectory.h
+*  Author: Cory Knoll
+*  Date Last Modified: 10/17/2026
+*  Description: Predict the path of a shot by fast-forwarding the physics world headlessly from its current state, within a time budget (no Qt dependency)
+	================================================================
+	FUNCTIONS:
+	+ bool predictTrajectory(World&, Vec2D, int, double, std::vector<Vec2D>&, int = 1) - Predict the path of a world's playerBall launched with a velocity from the world's current state, one point per step of a number of frames (steps longer than a frame follow the balls' parabolas), for up to a number of steps or a time budget (seconds), stopping early once it hits the goal or leaves the level for good; put the world back the way it was, return true if the path hits the goal
+*/
+
+#ifndef TRAJECTORY_H
+#define TRAJECTORY_H
+
+#include <vector>
+#include "vec2d.h"
+#include "world.h"
+
+bool predictTrajectory(World&, Vec2D, int, double, std::vector<Vec2D>&, int = 1);
+	//Predict the path of a world's playerBall launched with a velocity from the world's current state, one point per step of a number of frames (steps longer than a frame follow the balls' parabolas), for up to a number of steps or a time budget (seconds), stopping early once it hits the goal or leaves the level for good; put the world back the way it was, return true if the path hits the goal
+
+#endif //TRAJECTORY_H
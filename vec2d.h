@@ -1,42 +1,242 @@
 /* Program name: vec2d.h
 *  Author: Cory Knoll
-*  Date Last Modified: 5/7/2019
-*  Description: store a vector in x and y coordinates
+*  Date Last Modified: 10/17/2026
+*  Description: Header-only 2D vector value type templated on its scalar type (float or double), with the arithmetic the physics needs
 	================================================================
 	FUNCTIONS:
-	+ void setX(double) - set value of x
-	+ void setY(double) - set value of y
-	+ void setXY(double, double) - set value of x and y
-	+ void getVectorComponents(double&, double&) - return values of x and y
-	+ Vec2D() - Constructor, initial vector [0,0]
-	+ ~Vec2D() - Destructor
+	+ constexpr Vec2() - Constructor, initial vector [0,0]
+	+ constexpr Vec2(T, T) - Constructor, vector [x,y]
+	+ constexpr Vec2 operator+(const Vec2&) const - return the sum of two vectors
+	+ constexpr Vec2 operator-(const Vec2&) const - return the difference of two vectors
+	+ constexpr Vec2 operator-() const - return the vector pointing the opposite way
+	+ constexpr Vec2 operator*(T) const - return the vector scaled by a scalar
+	+ constexpr Vec2 operator/(T) const - return the vector divided by a scalar
+	+ constexpr Vec2& operator+=(const Vec2&) - add a vector to this one
+	+ constexpr Vec2& operator-=(const Vec2&) - subtract a vector from this one
+	+ constexpr Vec2& operator*=(T) - scale this vector by a scalar
+	+ constexpr bool operator==(const Vec2&) const - return whether two vectors are equal
+	+ constexpr bool operator!=(const Vec2&) const - return whether two vectors differ
+	+ constexpr T dot(const Vec2&) const - return the dot product of two vectors
+	+ constexpr T cross(const Vec2&) const - return the z component of the cross product of two vectors
+	+ constexpr T lengthSquared() const - return the squared length of the vector
+	+ T length() const - return the length of the vector
+	+ Vec2 normalized() const - return the vector scaled to length 1 ([0,0] stays [0,0])
+	+ constexpr Vec2 perpendicular() const - return the vector turned a quarter turn (counterclockwise with y up, clockwise on screen)
+	+ constexpr Vec2 reflect(const Vec2&) const - return the vector mirrored off a surface with a unit normal
+	+ constexpr Vec2 operator*(T, const Vec2&) - return a vector scaled by a scalar (scalar first)
 	============================================================================
 	VARIABLES:
-	- double x - x component of the vector
-	- double y - y component of the vector
+	+ T x - x component of the vector
+	+ T y - y component of the vector
+	============================================================================
+	TYPES:
+	+ Vec2f - vector of floats
+	+ Vec2D - vector of doubles (the type the physics uses)
 */
 
 #ifndef VEC2D_H
 #define VEC2D_H
 
-class Vec2D
-{
-public:
-	void setX(double);
-		//set value of x
-	void setY(double);
-		//set value of y
-	void setXY(double, double);
-		//set value of x and y
-	void getVectorComponents(double&, double&);
-		//return values of x and y
-	Vec2D();
+#include <cmath>
+#include <type_traits>
+
+//a plain pair of scalars with no virtual functions or user-defined copy/destruction, so arrays of it are tightly packed and
+//every operation inlines down to a couple of scalar (or, in a loop, vector) instructions
+template <typename T>
+struct Vec2
+{
+	T x;	//x component of the vector
+	T y;	//y component of the vector
+
+	constexpr Vec2();
 		//Constructor, initial vector [0,0]
-	~Vec2D();
-	//Destructor
-private:
-	double x;	//x component of the vector
-	double y;	//y component of the vector
+	constexpr Vec2(T, T);
+		//Constructor, vector [x,y]
+	constexpr Vec2 operator+(const Vec2&) const;
+		//return the sum of two vectors
+	constexpr Vec2 operator-(const Vec2&) const;
+		//return the difference of two vectors
+	constexpr Vec2 operator-() const;
+		//return the vector pointing the opposite way
+	constexpr Vec2 operator*(T) const;
+		//return the vector scaled by a scalar
+	constexpr Vec2 operator/(T) const;
+		//return the vector divided by a scalar
+	constexpr Vec2& operator+=(const Vec2&);
+		//add a vector to this one
+	constexpr Vec2& operator-=(const Vec2&);
+		//subtract a vector from this one
+	constexpr Vec2& operator*=(T);
+		//scale this vector by a scalar
+	constexpr bool operator==(const Vec2&) const;
+		//return whether two vectors are equal
+	constexpr bool operator!=(const Vec2&) const;
+		//return whether two vectors differ
+	constexpr T dot(const Vec2&) const;
+		//return the dot product of two vectors
+	constexpr T cross(const Vec2&) const;
+		//return the z component of the cross product of two vectors
+	constexpr T lengthSquared() const;
+		//return the squared length of the vector
+	T length() const;
+		//return the length of the vector
+	Vec2 normalized() const;
+		//return the vector scaled to length 1 ([0,0] stays [0,0])
+	constexpr Vec2 perpendicular() const;
+		//return the vector turned a quarter turn (counterclockwise with y up, clockwise on screen)
+	constexpr Vec2 reflect(const Vec2&) const;
+		//return the vector mirrored off a surface with a unit normal
 };
 
-#endif //VEC2D_H
\ No newline at end of file
+typedef Vec2<float> Vec2f;
+typedef Vec2<double> Vec2D;
+
+static_assert(std::is_trivially_copyable<Vec2D>::value && std::is_standard_layout<Vec2D>::value, "Vec2 must stay a plain value type");
+static_assert(sizeof(Vec2D) == 2 * sizeof(double) && sizeof(Vec2f) == 2 * sizeof(float), "Vec2 must pack its components with no padding");
+
+//Constructor, initial vector [0,0]
+template <typename T>
+constexpr Vec2<T>::Vec2() : x(0), y(0)
+{
+}
+
+//Constructor, vector [x,y]
+template <typename T>
+constexpr Vec2<T>::Vec2(T newX, T newY) : x(newX), y(newY)
+{
+}
+
+//return the sum of two vectors
+template <typename T>
+constexpr Vec2<T> Vec2<T>::operator+(const Vec2 &other) const
+{
+	return Vec2(x + other.x, y + other.y);
+}
+
+//return the difference of two vectors
+template <typename T>
+constexpr Vec2<T> Vec2<T>::operator-(const Vec2 &other) const
+{
+	return Vec2(x - other.x, y - other.y);
+}
+
+//return the vector pointing the opposite way
+template <typename T>
+constexpr Vec2<T> Vec2<T>::operator-() const
+{
+	return Vec2(-x, -y);
+}
+
+//return the vector scaled by a scalar
+template <typename T>
+constexpr Vec2<T> Vec2<T>::operator*(T scale) const
+{
+	return Vec2(x * scale, y * scale);
+}
+
+//return the vector divided by a scalar
+template <typename T>
+constexpr Vec2<T> Vec2<T>::operator/(T scale) const
+{
+	return Vec2(x / scale, y / scale);
+}
+
+//add a vector to this one
+template <typename T>
+constexpr Vec2<T>& Vec2<T>::operator+=(const Vec2 &other)
+{
+	x += other.x;
+	y += other.y;
+	return *this;
+}
+
+//subtract a vector from this one
+template <typename T>
+constexpr Vec2<T>& Vec2<T>::operator-=(const Vec2 &other)
+{
+	x -= other.x;
+	y -= other.y;
+	return *this;
+}
+
+//scale this vector by a scalar
+template <typename T>
+constexpr Vec2<T>& Vec2<T>::operator*=(T scale)
+{
+	x *= scale;
+	y *= scale;
+	return *this;
+}
+
+//return whether two vectors are equal
+template <typename T>
+constexpr bool Vec2<T>::operator==(const Vec2 &other) const
+{
+	return x == other.x && y == other.y;
+}
+
+//return whether two vectors differ
+template <typename T>
+constexpr bool Vec2<T>::operator!=(const Vec2 &other) const
+{
+	return !(*this == other);
+}
+
+//return the dot product of two vectors
+template <typename T>
+constexpr T Vec2<T>::dot(const Vec2 &other) const
+{
+	return x * other.x + y * other.y;
+}
+
+//return the z component of the cross product of two vectors
+template <typename T>
+constexpr T Vec2<T>::cross(const Vec2 &other) const
+{
+	return x * other.y - y * other.x;
+}
+
+//return the squared length of the vector
+template <typename T>
+constexpr T Vec2<T>::lengthSquared() const
+{
+	return dot(*this);
+}
+
+//return the length of the vector
+template <typename T>
+T Vec2<T>::length() const
+{
+	return std::sqrt(lengthSquared());
+}
+
+//return the vector scaled to length 1 ([0,0] stays [0,0])
+template <typename T>
+Vec2<T> Vec2<T>::normalized() const
+{
+	T vectorLength = length();
+	return vectorLength > 0 ? *this / vectorLength : Vec2();
+}
+
+//return the vector turned a quarter turn (counterclockwise with y up, clockwise on screen)
+template <typename T>
+constexpr Vec2<T> Vec2<T>::perpendicular() const
+{
+	return Vec2(-y, x);
+}
+
+//return the vector mirrored off a surface with a unit normal
+template <typename T>
+constexpr Vec2<T> Vec2<T>::reflect(const Vec2 &normal) const
+{
+	return *this - normal * (2 * dot(normal));
+}
+
+//return a vector scaled by a scalar (scalar first)
+template <typename T>
+constexpr Vec2<T> operator*(T scale, const Vec2<T> &vector)
+{
+	return vector * scale;
+}
+
+#endif //VEC2D_H
@@ -1,12 +1,12 @@
 /* Program name: velocityText.cpp
 *  Author: Cory Knoll
-*  Date Last Modified: 5/7/2019
+*  Date Last Modified: 10/17/2026
 *  Description: a text object that continually updates to display the megnitude and angle the launcher before ball is launched
 	================================================================
 	FUNCTIONS:
 	+ void update(void) - update the vText display with current info
 	+ VelocityText(int&, double&, QGraphicsItem* = nullptr) - Constructor create a QTGraphicsText item, connect angle and magnitude pointers to their memory locations and display initial message
-	+ ~VelocityText(void) - Destructor
+	+ ~VelocityText(void) - Destructor (the angle and magnitude belong to the game object)
 	============================================================================
 	VARIABLES:
 	- int *angle - Points to the angle member of game object
@@ -40,11 +40,7 @@ VelocityText::VelocityText(int &angleAddr, double &magnitudeAddr, QGraphicsItem
 	setZValue(100);
 }
 
-//Destructor
+//Destructor (the angle and magnitude belong to the game object)
 VelocityText::~VelocityText()
 {
-	angle = nullptr;
-	magnitude = nullptr;
-	delete angle;
-	delete magnitude;
 }
@@ -0,0 +1,1993 @@
+/* Program name: world.cpp
+*  Author: Cory Knoll
+*  Date Last Modified: 10/17/2026
+*  Description: Headless physics world that owns the bodies of a level, moves its moving blocks along their paths, solves the contacts of its blocks with mass and runs the collision pipeline (no Qt dependency)
+	================================================================
+	FUNCTIONS:
+	+ void loadLevel(const LevelView&) - Replace all bodies in the world with the ones described by a level view, using its prebuilt block hierarchy in place if it has a valid one
+	+ void loadLevel(const LevelData&) - Replace all bodies in the world with the ones described by the level data
+	+ void clear() - Remove all bodies from the world
+	+ void restart() - Put every ball and block with mass back the way the level was loaded and the time back to 0, leaving the other blocks and the hierarchy over them as they are
+	+ void swapLevel(World&) - Exchange the level (balls, blocks and hierarchy) with another world in constant time, each world keeping its threads and settings
+	+ size_t getStateSize() const - return the bytes a snapshot of the state of the simulation takes
+	+ void saveState(void*) const - Copy the state of the simulation (the position and velocity of every ball and block with mass, the impulses the solver kept, the time and the goal flag) into a flat buffer of getStateSize() bytes
+	+ bool loadState(const void*) - Put the simulation back in a state saved from this world or another world of the same level, return false (and change nothing) if it has a different number of balls or blocks with mass
+	+ int addBall(double, double, double, double) - Add a ball at rest to the world, return its index
+	+ bool step(double) - Advance every ball and block with mass by a portion of a frame, detect/handle collisions, return true if the playerBall hit the goal block
+	+ void moveBall(int, double) - Move a ball along its velocity vector, calculate new velocity due to gravity
+	+ void collideBall(int, Vec2D, int = 0, Vec2D = Vec2D()) - Bounce a ball off a surface with the normal of a collision, one of the level's materials and the velocity the surface moves at
+	+ void collideBalls(int, int) - Exchange a mass-weighted impulse between two touching balls
+	+ void setBallVelocity(int, double, double) - Set the velocity of a ball
+	+ void setBallPosition(int, double, double) - Set the coordinates of the center of a ball
+	+ void setBallInvMass(int, double) - Set the inverse mass (>=0) of a ball
+	+ Vec2D getBallVelocity(int) const - return velocity vector of a ball
+	+ double getBallX(int) const - return x coordinate of the center of a ball
+	+ double getBallY(int) const - return y coordinate of the center of a ball
+	+ double getBallRadius(int) const - return the radius of a ball
+	+ int getBallCount() const - return the number of balls
+	+ const BodyStore& getBodies() const - return the body storage of the balls
+	+ const BlockBody& getGoalBlock() const - return the goal block
+	+ const BlockBody& getBlock(int) const - return a level block that doesn't move
+	+ int getBlockCount() const - return the number of level blocks that don't move
+	+ const std::vector<BlockBody>& getDynamicBlocks() const - return the blocks with mass where they are, with their velocities
+	+ int getDynamicBlockCount() const - return the number of blocks with mass
+	+ BlockBody getMover(int, double) const - return a moving block where its path has it at a time, moving at the speed that takes it along its path over the next frame
+	+ const MoverData& getMoverPath(int) const - return the path of a moving block
+	+ int getMoverCount() const - return the number of moving blocks
+	+ const BVH& getMoverTree() const - return the bounding volume hierarchy over the moving blocks
+	+ double getTime() const - return the frames simulated since the level started, which says where the moving blocks are
+	+ void setTime(double) - Set the frames simulated since the level started and put the moving blocks where their paths have them then, refitting the hierarchy over them
+	+ bool blockReachable(int, int, double) const - return whether a ball's trajectory over a portion of a frame gets past the borders of a level block (the test before the narrowphase)
+	+ bool detectBlock(int, int, double, Vec2D&, double&) const - Detect whether a ball collides with a level block within a portion of a frame, set the normal and the subportion to the collision (the narrowphase on its own)
+	+ const Material& getMaterial(int) const - return one of the level's block materials
+	+ int getMaterialCount() const - return the number of block materials (material 0 being the default)
+	+ const BVH& getBlockTree() const - return the bounding volume hierarchy over the level blocks
+	+ const SweepPolygon& getPolygon(int) const - return the corners, edge normals, bounds and outline of a convex polygon block
+	+ const BlockBody& getPolygonBounds(int) const - return the bounds (its outline included) and material of a convex polygon block
+	+ int getPolygonCount() const - return the number of convex polygon blocks
+	+ const BVH& getPolygonTree() const - return the bounding volume hierarchy over the convex polygon blocks
+	+ int getIslandCount() const - return the number of islands the balls were split into during the last step
+	+ void setThreadCount(int) - Set the number of threads that solve the islands, 0 for one per core
+	+ int getThreadCount() const - return the number of threads that solve the islands
+	+ void setContactBudget(int) - Set the most collisions resolved for one ball or island in a step before the rest of its step falls back to a cheaper approximation
+	+ int getContactBudget() const - return the most collisions resolved for one ball or island in a step
+	+ void setMinAdvance(double) - Set the least portion of a frame every resolved collision uses up
+	+ double getMinAdvance() const - return the least portion of a frame every resolved collision uses up
+	+ void setParabolicSteps(bool) - Set whether the balls move along exact parabolas within a step (and are swept along them), so a step of many frames lands where that many frame steps would and cuts no corners
+	+ bool isParabolicSteps() const - return whether the balls move along exact parabolas within a step
+	+ const ContactStats& getContactStats() const - return the collision counters since the world was created or the counters were reset
+	+ void resetContactStats() - Set every collision counter back to 0
+	+ void setSolverIterations(int) - Set the number of times the solver resolves every contact of the blocks with mass in a step
+	+ int getSolverIterations() const - return the number of times the solver resolves every contact of the blocks with mass in a step
+	+ int getSolverContactCount() const - return the number of contacts of the blocks with mass the solver resolved in the last step
+	+ void setBlockSleeping(bool) - Set whether blocks with mass that have come to rest sleep (are left out of the step) until something can disturb them
+	+ bool isBlockSleeping() const - return whether blocks with mass that have come to rest sleep until something can disturb them
+	+ World() - Constructor, empty world
+	+ ~World() - Destructor
+	- void addBlock(BlockBody&, const BlockData&) - Convert block data to the collision bounds of a block body
+	- void addPolygon(const PolygonData&) - Add a convex polygon block, working out its edge normals and bounds once
+	- void moveMovers(double) - Put every moving block where it is at the start of a portion of a frame, moving at the speed that takes it where it is at the end, and refit the hierarchy over the ones that left their bounds
+	- void solveBlocks(double) - Pull the blocks with mass down and solve their contacts with each other and the other blocks over a portion of a frame, leaving every one at its start with the velocity the solver gave it
+	- void addBlockContact(int, int, int, const BlockBody&, double) - Add a contact between a block with mass and another block (of a kind, with its index) to the solver if they can touch during a portion of a frame
+	- void addBallContact(int, int, double) - Add a contact between a block with mass and a ball to the solver if the block can close in on the ball during a portion of a frame
+	- void sweepDynamics(double) - Give every block with mass the box it sweeps over a portion of a frame in the hierarchy over them
+	- void moveDynamics(double) - Move every block with mass along its velocity by a portion of a frame
+	- bool wakeDynamics(double) - Mark the blocks with mass that sleep through a portion of a frame (their island has rested long enough and nothing can move it), return true if any is awake
+	- bool collisionPossible(const BallBody&, double, double, const BlockBody&) const - return whether the trajectory puts it passing an object
+	- void setNormal(Collision&, const BlockBody&, Vec2D, double) const - set the parameters for the normal of the collision with a block and track that a collision happened
+	- bool contactDetect(const BallBody&, const BlockBody&, Collision&) const - detect a ball already touching a block and moving into it, and set normal appropriately
+	- bool collisionDetect(const BallBody&, const BlockBody&, double, Collision&) const - detect a collision with a block earlier than any found so far and set normal appropriately, return true if one was found
+	- bool sweepDetect<Shape>(const BallBody&, const ShapeType<Shape>::Type&, const BlockBody&, double, Collision&) const - detect a collision with a block of a kind of shape earlier than any found so far through the shape pair table and set normal appropriately, return true if one was found
+	- SweepBox sweptBounds(const BallBody&, double) const - return the box the center of a ball sweeps over a portion of a frame, along its velocity or its parabola
+	- double ballReach(int, double) const - return how far from where it starts a ball (its radius included) can get over a portion of a frame
+	- void findIslands(double) - Find the pairs of balls that can reach each other this frame and split the balls into islands that can't affect each other
+	- int findRoot(int) - return the lowest numbered ball of the island a ball has been joined to so far
+	- int findDynamicRoot(int) - return the lowest numbered block with mass of the island a block has been joined to so far this step
+	- bool ballCollisionDetect(const BallPair&, double, double&) const - Detect whether two balls collide within a portion of a frame and set the subportion to the collision
+	- void islandHandler(const Island&, double, WorkerState&) - Detect and resolve every collision of the balls of an island during a portion of the frame
+	- void groupHandler(const Island&, double, WorkerState&) - Resolve the collisions among the balls of an island earliest first until the portion of the frame is used up or the contact budget runs out
+	- void findCollision(int, double, Collision&, WorkerState&) const - Detect the earliest collision of a ball with the goal block or a level block its trajectory can reach
+	- void findMoverCollision(const BallBody&, int, double, Collision&, WorkerState&) const - Detect a collision of a ball with a moving block or a block with mass earlier than any found so far, each block swept in its own frame of reference
+	- void resolveCollision(int, double, const Collision&, WorkerState&) - Move a ball along a portion of the frame to its collision and resolve it
+	- void respond(int, const Collision&, WorkerState&) - Bounce a ball off the block it collided with, pushing the block if it has mass
+	- void pushBlock(int, const Collision&, WorkerState&) - Bounce a ball off a block with mass in the block's frame of reference, sharing the change of their velocities by their masses
+	- void collisionHandler(int, double, Collision&, int, WorkerState&) - Resolve a ball's collisions one after the other, starting from one already found, until the portion of the frame is used up or a number of collisions (the contact budget it has left) runs out
+	- double advanceBall(int, double, WorkerState&) - Move a ball along its velocity for a portion of a frame, stopping short of the first block in its way, return the portion it moved
+	- void slideBall(int, double, const Collision&, WorkerState&) - Move a ball that ran out of contact budget along the surface of its last collision for the rest of a portion of the frame, leaving its speed into the surface to the next step
+	- void countContacts(int, WorkerState&) const - Add the collisions resolved for one ball or island to a thread's counters
+	- Vec2D moverOffset(const MoverData&, double) - return how far a moving block is along its path from where it starts at a time
+	- BlockBody placeMover(const MoverData&, int, double, double) - return a moving block of a material where its path has it at a time, moving at the speed that takes it along its path over a portion of a frame
+	- int boxSeparation(const BlockBody&, const BlockBody&, Vec2D&, double&) - Find the side two blocks are nearest to touching on, set the normal from the second to the first and the gap between them along it (below 0 when they overlap), return the side (0-3)
+	- int polygonSeparation(const BlockBody&, const SweepPolygon&, Vec2D&, double&) - Find the side a block and a convex polygon block are nearest to touching on, set the normal from the polygon to the block and the gap between them along it (below 0 when they overlap), return the side (0-3 the block's, then the polygon's edges)
+	============================================================================
+	VARIABLES:
+	- BodyStore bodies - The balls of the level (playerBall first)
+	- BodyStore startBodies - The balls the way the level was loaded, for restarting it
+	- std::vector<double> freePortion - Portion of the frame each ball moves in the batch kernel because nothing is in its way
+	- SweepAndPrune broadphase - Sorted axis list of the boxes the balls can reach this frame, kept from frame to frame
+	- std::vector<BallPair> pairs - Pairs of balls that can reach each other this frame
+	- std::vector<int> parent - Ball each ball was joined to while the islands are found
+	- std::vector<int> islandIndex - Island each ball belongs to this frame
+	- std::vector<Island> islands - Islands of balls that can reach each other this frame, ordered by their lowest numbered ball
+	- std::vector<int> islandBalls - Balls of every island, island by island (ascending within an island)
+	- std::vector<BallPair> islandPairs - Pairs of every island, island by island (ascending within an island)
+	- std::vector<int> batches - First island of every task handed to the thread pool, followed by the number of islands
+	- ThreadPool pool - Work-stealing pool of threads that solves the islands
+	- std::vector<WorkerState> workers - Scratch space and results of every thread of the pool
+	- int contactBudget - Most collisions resolved for one ball or island in a step
+	- double minAdvance - Least portion of a frame every resolved collision uses up
+	- bool parabolic - Balls move along exact parabolas within a step instead of along their velocities
+	- ContactStats stats - Collision counters since the world was created or the counters were reset
+	- BlockBody goalBlock - The Block that you're trying to hit
+	- std::vector<BlockBody> blocks - The Blocks that make up the obstacles of the level
+	- std::vector<Material> materials - Materials of the blocks, material 0 being the default
+	- SweepBoxes blockBoxes - Bounds of the level blocks in the layout the batch sweep test reads
+	- BVH blockTree - Static bounding volume hierarchy over the level blocks, built when the level is loaded (or attached to the level's prebuilt one)
+	- std::vector<BlockBody> polygons - Bounds (their outline included) and material of the convex polygon blocks
+	- std::vector<SweepPolygon> polygonShapes - Corners, edge normals, bounds and outline of every convex polygon block, pointing into polygonPoints and polygonNormals
+	- std::vector<Vec2D> polygonPoints - Corners of every convex polygon block, polygon by polygon
+	- std::vector<Vec2D> polygonNormals - Outward unit normal of every edge of every convex polygon block, polygon by polygon
+	- BVH polygonTree - Static bounding volume hierarchy over the convex polygon blocks, built when the level is loaded
+	- std::vector<MoverData> moverPaths - The paths of the moving blocks
+	- std::vector<BlockBody> movers - The moving blocks where they are at the start of the step being taken, with the speed they move at during it
+	- std::vector<SweepBox> moverBounds - Bounds of every moving block in the moverTree, which hold it over a step and some margin
+	- BVH moverTree - Bounding volume hierarchy over the moving blocks, refit over the ones that left their bounds every step
+	- std::vector<BlockBody> dynamics - The blocks with mass where they are at the start of the step being taken, with their velocities
+	- std::vector<BlockBody> startDynamics - The blocks with mass the way the level was loaded, for restarting it
+	- BVH dynamicTree - Bounding volume hierarchy over the boxes the blocks with mass sweep during the step being taken
+	- std::vector<int> dynamicBall - First ball that can reach every block with mass this step (-1 for none)
+	- std::vector<int> dynamicIsland - Island of the balls that can reach every block with mass this step (-1 for none)
+	- std::vector<int> solverCandidates - Scratch list of the blocks a block with mass can reach this step
+	- std::vector<int> dynamicParent - Block with mass each awake one was joined to by their contacts while the islands of the step are found
+	- std::vector<unsigned char> dynamicAsleep - Every block with mass sleeps through the step being taken
+	- std::vector<int> wakeQueue - Scratch list of the awake blocks with mass whose reach is yet to be searched for sleeping ones
+	- std::vector<double> dynamicRest - Frames the island of every block with mass has been at rest for; from BLOCK_SLEEP_FRAMES on the island sleeps
+	- ContactSolver solver - Sequential impulse solver for the contacts of the blocks with mass, with the impulses it keeps from step to step
+	- double time - Frames simulated since the level started
+	- double stepPortion - Portion of a frame the step being taken covers, which the time a ball has got to during it is counted back from
+	- bool goalReached - The playerBall hit the goal block during the last step
+	- bool blockSleeping - Blocks with mass that have come to rest sleep until something can disturb them
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include "profiler.h"
+#include "world.h"
+
+#define CONTACT_DYNAMIC 0	//Kind of the other block of a contact of a block with mass: another block with mass
+#define CONTACT_LEVEL 1		//a level block that doesn't move
+#define CONTACT_MOVER 2		//a moving block
+#define CONTACT_GOAL 3		//the goal block
+#define CONTACT_BALL 4		//a ball
+#define CONTACT_POLYGON 5	//a convex polygon block
+
+//return how far a moving block is along its path from where it starts at a time
+static Vec2D moverOffset(const MoverData &path, double time)
+{
+	//a path is a function of the time alone, so wherever the world is put back to (a restart, a snapshot, a keyframe) the blocks
+	//are where they were without anything about them being saved
+	if (path.period <= 0)
+		return Vec2D();
+	double cycles = time / path.period + path.phase;
+	if (path.kind == MOVER_LINEAR)
+		return Vec2D(path.dx, path.dy) * std::min(std::max(cycles, 0.0), 1.0);
+	if (path.kind == MOVER_PINGPONG)
+	{
+		double along = cycles - floor(cycles);
+		return Vec2D(path.dx, path.dy) * (along < 0.5 ? 2 * along : 2 - 2 * along);
+	}
+	double angle = 2 * 3.14159265358979323846 * cycles;
+	return Vec2D(path.dx * cos(angle), path.dy * sin(angle));
+}
+
+//return a moving block of a material where its path has it at a time, moving at the speed that takes it along its path over a portion of a frame
+static BlockBody placeMover(const MoverData &path, int material, double time, double portion)
+{
+	//over one step the block moves in a straight line (the chord of a circular path), which is what lets a ball be swept against it
+	Vec2D start = moverOffset(path, time);
+	Vec2D velocity = portion > 0 ? (moverOffset(path, time + portion) - start) / portion : Vec2D();
+	BlockBody mover;
+	mover.xMin = path.x + start.x;
+	mover.yMin = path.y + start.y;
+	mover.xMax = path.x + path.width + BLOCK_OUTLINE_WIDTH - 1 + start.x;
+	mover.yMax = path.y + path.height + BLOCK_OUTLINE_WIDTH - 1 + start.y;
+	mover.invMass = 0;
+	mover.vx = velocity.x;
+	mover.vy = velocity.y;
+	mover.material = material;
+	return mover;
+}
+
+//Find the side two blocks are nearest to touching on, set the normal from the second to the first and the gap between them along it (below 0 when they overlap), return the side (0-3)
+static int boxSeparation(const BlockBody &first, const BlockBody &second, Vec2D &normal, double &gap)
+{
+	//of the four ways the first block can be off the second, the one with the largest gap is where they're apart (or, when they
+	//overlap, where they overlap least and so where they get pushed apart): 0 and 1 the first to the right and left, 2 and 3 below and above
+	double right = first.xMin - second.xMax;
+	double left = second.xMin - first.xMax;
+	double below = first.yMin - second.yMax;
+	double above = second.yMin - first.yMax;
+	if (std::max(right, left) >= std::max(below, above))
+	{
+		normal = right >= left ? Vec2D(1, 0) : Vec2D(-1, 0);
+		gap = std::max(right, left);
+		return right >= left ? 0 : 1;
+	}
+	normal = below >= above ? Vec2D(0, 1) : Vec2D(0, -1);
+	gap = std::max(below, above);
+	return below >= above ? 2 : 3;
+}
+
+//Find the side a block and a convex polygon block are nearest to touching on, set the normal from the polygon to the block and the gap between them along it (below 0 when they overlap), return the side (0-3 the block's, then the polygon's edges)
+static int polygonSeparation(const BlockBody &block, const SweepPolygon &polygon, Vec2D &normal, double &gap)
+{
+	//two convex shapes are apart along one of their sides if they're apart at all: the block's sides are the polygon's bounds
+	//against the block, and along an edge's normal the polygon reaches no further than the edge while the block reaches its
+	//nearest corner. The side with the largest gap is where they're apart, or overlap least, and the outline narrows every gap
+	BlockBody bounds = block;
+	bounds.xMin = polygon.bounds.xMin - polygon.reach;
+	bounds.yMin = polygon.bounds.yMin - polygon.reach;
+	bounds.xMax = polygon.bounds.xMax + polygon.reach;
+	bounds.yMax = polygon.bounds.yMax + polygon.reach;
+	int side = boxSeparation(block, bounds, normal, gap);
+	Vec2D center((block.xMin + block.xMax) / 2, (block.yMin + block.yMax) / 2);
+	Vec2D half((block.xMax - block.xMin) / 2, (block.yMax - block.yMin) / 2);
+	for (int i = 0; i < polygon.count; i++)
+	{
+		const Vec2D &edgeNormal = polygon.normals[i];
+		double edgeGap = (center - polygon.points[i]).dot(edgeNormal) - half.x * fabs(edgeNormal.x) - half.y * fabs(edgeNormal.y) - polygon.reach;
+		if (edgeGap > gap)
+		{
+			normal = edgeNormal;
+			gap = edgeGap;
+			side = 4 + i;
+		}
+	}
+	return side;
+}
+
+//Replace all bodies in the world with the ones described by a level view, using its prebuilt block hierarchy in place if it has a valid one
+void World::loadLevel(const LevelView &level)
+{
+	clear();
+
+	//the playerBall is always ball 0, followed by the level's other balls
+	const BallData &ballData = *level.playerBall;
+	addBall(ballData.x, ballData.y, ballData.radius, ballData.invMass);
+	for (int i = 0; i < level.ballCount; i++)
+	{
+		const BallData &data = level.balls[i];
+		setBallVelocity(addBall(data.x, data.y, data.radius, data.invMass), data.vx, data.vy);
+	}
+
+	//materials the level doesn't describe (including the default, material 0, unless the level overrides it) bounce like the original blocks;
+	//level data built in code hasn't been through the loaders' checks, so a record no block can refer to is skipped
+	Material defaultMaterial = { DEFAULT_RESTITUTION, DEFAULT_FRICTION };
+	for (int i = 0; i < level.materialCount; i++)
+	{
+		const MaterialData &data = level.materials[i];
+		if (data.number < 0 || data.number >= MAX_MATERIALS)
+			continue;
+		if (data.number >= (int)materials.size())
+			materials.resize(data.number + 1, defaultMaterial);
+		materials[data.number].restitution = std::max(data.restitution, 0.0);
+		materials[data.number].friction = std::max(data.friction, 0.0);
+	}
+
+	//blocks with mass move, so they're kept apart from the level's other blocks, which keep their order among themselves
+	addBlock(goalBlock, *level.goalBlock);
+	blocks.reserve(level.blockCount);
+	for (int i = 0; i < level.blockCount; i++)
+	{
+		BlockBody block;
+		addBlock(block, level.blocks[i]);
+		if (block.invMass > 0)
+		{
+			dynamics.push_back(block);
+			continue;
+		}
+		blocks.push_back(block);
+		SweepBox box = { block.xMin, block.yMin, block.xMax, block.yMax };
+		blockBoxes.add(box);
+	}
+
+	//the other blocks never move, so the index over them only has to be built once per level, or not at all when the level file carries one
+	if (!level.nodes || !blockTree.attach(level.nodes, level.nodeCount, level.leaves, level.leafCount, (int)blocks.size()))
+		blockTree.build(blocks);
+
+	//convex polygons never move either and get a hierarchy of their own, so a level without any keeps its block hierarchy (and the
+	//batch test over the blocks) exactly as it was; every corner is stored before any polygon points at them. Level data built in
+	//code hasn't been through the loaders' checks, so a polygon with more corners than its record holds (or too few) is skipped
+	auto usable = [](const PolygonData &polygon) { return polygon.pointCount >= 3 && polygon.pointCount <= POLYGON_MAX_POINTS; };
+	int pointCount = 0;
+	for (int i = 0; i < level.polygonCount; i++)
+		if (usable(level.polygons[i]))
+			pointCount += level.polygons[i].pointCount;
+	polygonPoints.reserve(pointCount);
+	polygonNormals.reserve(pointCount);
+	for (int i = 0; i < level.polygonCount; i++)
+		if (usable(level.polygons[i]))
+			addPolygon(level.polygons[i]);
+	polygonTree.build(polygons);
+
+	//moving blocks get a hierarchy of their own, so the one over the static blocks (which may be a mapped file) never changes: it's
+	//built once over where they start, and every step only refits the nodes above the ones that got out of their bounds
+	moverPaths.assign(level.movers, level.movers + level.moverCount);
+	movers.resize(level.moverCount);
+	moverBounds.resize(level.moverCount);
+	std::vector<BlockBody> startBounds(level.moverCount);
+	for (int i = 0; i < level.moverCount; i++)
+	{
+		int material = moverPaths[i].material >= 0 && moverPaths[i].material < (int)materials.size() ? moverPaths[i].material : 0;
+		movers[i] = placeMover(moverPaths[i], material, 0, 0);
+		SweepBox bounds = { movers[i].xMin - MOVER_MARGIN, movers[i].yMin - MOVER_MARGIN, movers[i].xMax + MOVER_MARGIN, movers[i].yMax + MOVER_MARGIN };
+		moverBounds[i] = bounds;
+		startBounds[i] = movers[i];
+		startBounds[i].xMin = bounds.xMin;
+		startBounds[i].yMin = bounds.yMin;
+		startBounds[i].xMax = bounds.xMax;
+		startBounds[i].yMax = bounds.yMax;
+	}
+	moverTree.build(startBounds);
+
+	//the blocks with mass get one more, built over where they start; every step gives each of them the box it sweeps and refits it
+	startDynamics = dynamics;
+	dynamicTree.build(dynamics);
+	dynamicBall.assign(dynamics.size(), -1);
+	dynamicIsland.assign(dynamics.size(), -1);
+	dynamicParent.assign(dynamics.size(), 0);
+	dynamicAsleep.assign(dynamics.size(), 0);
+	dynamicRest.assign(dynamics.size(), 0);
+	solver.reset((int)dynamics.size());
+	startBodies = bodies;
+}
+
+//Replace all bodies in the world with the ones described by the level data
+void World::loadLevel(const LevelData &level)
+{
+	loadLevel(viewLevel(level));
+}
+
+//Remove all bodies from the world
+void World::clear()
+{
+	bodies.clear();
+	startBodies.clear();
+	broadphase.reset(0);
+	parent.clear();
+	islandIndex.clear();
+	islands.clear();
+	blocks.clear();
+	blockBoxes.clear();
+	blockTree.clear();
+	polygons.clear();
+	polygonShapes.clear();
+	polygonPoints.clear();
+	polygonNormals.clear();
+	polygonTree.clear();
+	moverPaths.clear();
+	movers.clear();
+	moverBounds.clear();
+	moverTree.clear();
+	dynamics.clear();
+	startDynamics.clear();
+	dynamicTree.clear();
+	dynamicBall.clear();
+	dynamicIsland.clear();
+	dynamicParent.clear();
+	dynamicAsleep.clear();
+	dynamicRest.clear();
+	solver.reset(0);
+	time = 0;
+	stepPortion = 0;
+	Material defaultMaterial = { DEFAULT_RESTITUTION, DEFAULT_FRICTION };
+	materials.assign(1, defaultMaterial);
+	goalBlock = BlockBody();
+	goalReached = false;
+}
+
+//Put every ball and block with mass back the way the level was loaded and the time back to 0, leaving the other blocks and the hierarchy over them as they are
+void World::restart()
+{
+	//the balls jump back to their start, so the broadphase's order from the last frame is no use; the moving blocks go back to
+	//their start with the time, and the blocks with mass start again at rest with nothing to warm-start their contacts
+	bodies = startBodies;
+	dynamics = startDynamics;
+	solver.reset((int)dynamics.size());
+	broadphase.reset((int)bodies.size());
+	islands.clear();
+	time = 0;
+	std::fill(dynamicRest.begin(), dynamicRest.end(), 0.0);
+	goalReached = false;
+}
+
+//return the bytes a snapshot of the state of the simulation takes
+size_t World::getStateSize() const
+{
+	return sizeof(WorldState) + 4 * bodies.size() * sizeof(double) + 7 * dynamics.size() * sizeof(double) + solver.getCacheCapacity() * sizeof(CachedContact);
+}
+
+//Copy the state of the simulation (the position and velocity of every ball and block with mass, the impulses the solver kept, the time and the goal flag) into a flat buffer of getStateSize() bytes
+void World::saveState(void *buffer) const
+{
+	//only what a step changes is saved: the static blocks never move, the moving ones are where the time puts them, and the radii
+	//and masses stay what the level gave them, so a snapshot is four copies of contiguous arrays and costs about what reading the
+	//balls once does
+	const std::vector<CachedContact> &cache = solver.getCache();
+	WorldState header = { (int)bodies.size(), goalReached ? 1 : 0, time, (int)dynamics.size(), (int)cache.size() };
+	size_t count = bodies.size() * sizeof(double);
+	unsigned char *bytes = (unsigned char*)buffer;
+	memcpy(bytes, &header, sizeof(header));
+	bytes += sizeof(header);
+	if (count > 0)
+	{
+		memcpy(bytes, bodies.x.data(), count);
+		memcpy(bytes + count, bodies.y.data(), count);
+		memcpy(bytes + 2 * count, bodies.vx.data(), count);
+		memcpy(bytes + 3 * count, bodies.vy.data(), count);
+		bytes += 4 * count;
+	}
+
+	//a block with mass is its bounds, velocity and the time its island has rested, and the solver's cache goes with them (the next
+	//step starts from it, so a state without it would step differently); the cache is padded to its capacity so every state of a
+	//level is the same size
+	for (size_t i = 0; i < dynamics.size(); i++)
+	{
+		const BlockBody &block = dynamics[i];
+		double values[7] = { block.xMin, block.yMin, block.xMax, block.yMax, block.vx, block.vy, dynamicRest[i] };
+		memcpy(bytes, values, sizeof(values));
+		bytes += sizeof(values);
+	}
+	size_t cached = cache.size() * sizeof(CachedContact);
+	if (cached > 0)
+		memcpy(bytes, cache.data(), cached);
+	memset(bytes + cached, 0, solver.getCacheCapacity() * sizeof(CachedContact) - cached);
+}
+
+//Put the simulation back in a state saved from this world or another world of the same level, return false (and change nothing) if it has a different number of balls or blocks with mass
+bool World::loadState(const void *buffer)
+{
+	WorldState header;
+	const unsigned char *bytes = (const unsigned char*)buffer;
+	memcpy(&header, bytes, sizeof(header));
+	if (header.ballCount != bodies.size() || header.blockCount != (int)dynamics.size() || header.contactCount < 0 || header.contactCount > solver.getCacheCapacity())
+		return false;
+	bytes += sizeof(header);
+	size_t count = bodies.size() * sizeof(double);
+	if (count > 0)
+	{
+		memcpy(bodies.x.data(), bytes, count);
+		memcpy(bodies.y.data(), bytes + count, count);
+		memcpy(bodies.vx.data(), bytes + 2 * count, count);
+		memcpy(bodies.vy.data(), bytes + 3 * count, count);
+		bytes += 4 * count;
+	}
+	for (size_t i = 0; i < dynamics.size(); i++)
+	{
+		BlockBody &block = dynamics[i];
+		double values[7];
+		memcpy(values, bytes, sizeof(values));
+		bytes += sizeof(values);
+		block.xMin = values[0];
+		block.yMin = values[1];
+		block.xMax = values[2];
+		block.yMax = values[3];
+		block.vx = values[4];
+		block.vy = values[5];
+		dynamicRest[i] = values[6];
+	}
+
+	//the buffer needn't be aligned for the cache, so it's copied out before the solver takes it
+	std::vector<CachedContact> cache(header.contactCount);
+	if (header.contactCount > 0)
+		memcpy(cache.data(), bytes, cache.size() * sizeof(CachedContact));
+	solver.setCache(cache.data(), header.contactCount);
+
+	//the balls may have jumped anywhere, so the broadphase's order from the last frame is no use, just as after a restart
+	broadphase.reset(bodies.size());
+	islands.clear();
+	goalReached = header.goalReached != 0;
+	time = header.time;
+
+	//a step of sleeping blocks doesn't give them new boxes, so the boxes go back with the blocks (held still, they're the same
+	//over any portion)
+	if (!dynamics.empty())
+		sweepDynamics(0);
+	return true;
+}
+
+//Exchange the level (balls, blocks and hierarchy) with another world in constant time, each world keeping its threads and settings
+void World::swapLevel(World &other)
+{
+	//every container swaps its storage rather than its elements, so a level of any size changes worlds in the same time (a
+	//hierarchy attached to a mapped level file goes with it, so the file has to be handed over along with the world)
+	std::swap(bodies, other.bodies);
+	std::swap(startBodies, other.startBodies);
+	std::swap(freePortion, other.freePortion);
+	std::swap(broadphase, other.broadphase);
+	std::swap(pairs, other.pairs);
+	std::swap(parent, other.parent);
+	std::swap(islandIndex, other.islandIndex);
+	std::swap(islands, other.islands);
+	std::swap(islandBalls, other.islandBalls);
+	std::swap(islandPairs, other.islandPairs);
+	std::swap(goalBlock, other.goalBlock);
+	std::swap(blocks, other.blocks);
+	std::swap(materials, other.materials);
+	std::swap(blockBoxes, other.blockBoxes);
+	std::swap(blockTree, other.blockTree);
+	std::swap(polygons, other.polygons);
+	std::swap(polygonShapes, other.polygonShapes);
+	std::swap(polygonPoints, other.polygonPoints);
+	std::swap(polygonNormals, other.polygonNormals);
+	std::swap(polygonTree, other.polygonTree);
+	std::swap(moverPaths, other.moverPaths);
+	std::swap(movers, other.movers);
+	std::swap(moverBounds, other.moverBounds);
+	std::swap(moverTree, other.moverTree);
+	std::swap(dynamics, other.dynamics);
+	std::swap(startDynamics, other.startDynamics);
+	std::swap(dynamicTree, other.dynamicTree);
+	std::swap(dynamicBall, other.dynamicBall);
+	std::swap(dynamicIsland, other.dynamicIsland);
+	std::swap(dynamicParent, other.dynamicParent);
+	std::swap(dynamicAsleep, other.dynamicAsleep);
+	std::swap(dynamicRest, other.dynamicRest);
+	solver.swapCache(other.solver);
+	std::swap(time, other.time);
+	std::swap(goalReached, other.goalReached);
+}
+
+//Add a ball at rest to the world, return its index
+int World::addBall(double xCenter, double yCenter, double radius, double invMass)
+{
+	return bodies.add(xCenter, yCenter, radius, invMass);
+}
+
+//Convert block data to the collision bounds of a block body
+void World::addBlock(BlockBody &block, const BlockData &data)
+{
+	//the bounds cover the block's outline the same way the scene item's boundingRect() does
+	block.xMin = data.x;
+	block.yMin = data.y;
+	block.xMax = data.x + data.width + BLOCK_OUTLINE_WIDTH - 1;
+	block.yMax = data.y + data.height + BLOCK_OUTLINE_WIDTH - 1;
+	block.invMass = data.invMass >= 0 ? data.invMass : 0;
+	block.vx = 0;
+	block.vy = 0;
+	block.material = data.material >= 0 && data.material < (int)materials.size() ? data.material : 0;
+}
+
+//Add a convex polygon block, working out its edge normals and bounds once
+void World::addPolygon(const PolygonData &data)
+{
+	//the level may list the corners either way around; the sign of the polygon's area says which side of every edge is outside
+	int first = (int)polygonPoints.size();
+	double area = 0;
+	for (int i = 0; i < data.pointCount; i++)
+	{
+		int next = i + 1 < data.pointCount ? i + 1 : 0;
+		area += data.x[i] * data.y[next] - data.x[next] * data.y[i];
+		polygonPoints.push_back(Vec2D(data.x[i], data.y[i]));
+	}
+	SweepBox bounds = { data.x[0], data.y[0], data.x[0], data.y[0] };
+	for (int i = 0; i < data.pointCount; i++)
+	{
+		Vec2D edge = polygonPoints[first + (i + 1 < data.pointCount ? i + 1 : 0)] - polygonPoints[first + i];
+		Vec2D normal = Vec2D(edge.y, -edge.x) / edge.length();
+		polygonNormals.push_back(area > 0 ? normal : -normal);
+		bounds.xMin = std::min(bounds.xMin, data.x[i]);
+		bounds.yMin = std::min(bounds.yMin, data.y[i]);
+		bounds.xMax = std::max(bounds.xMax, data.x[i]);
+		bounds.yMax = std::max(bounds.yMax, data.y[i]);
+	}
+	SweepPolygon shape = { polygonPoints.data() + first, polygonNormals.data() + first, data.pointCount, bounds, POLYGON_OUTLINE_REACH };
+	polygonShapes.push_back(shape);
+
+	//the bounds the hierarchy holds cover the outline, the same way a block's do
+	BlockBody block;
+	block.xMin = bounds.xMin - POLYGON_OUTLINE_REACH;
+	block.yMin = bounds.yMin - POLYGON_OUTLINE_REACH;
+	block.xMax = bounds.xMax + POLYGON_OUTLINE_REACH;
+	block.yMax = bounds.yMax + POLYGON_OUTLINE_REACH;
+	block.invMass = 0;
+	block.vx = 0;
+	block.vy = 0;
+	block.material = data.material >= 0 && data.material < (int)materials.size() ? data.material : 0;
+	polygons.push_back(block);
+}
+
+//Advance every ball and block with mass by a portion of a frame, detect/handle collisions, return true if the playerBall hit the goal block
+bool World::step(double portion)
+{
+	PROFILE_SCOPE("World::step");
+	PROFILE_COUNT(PROFILE_STEPS, 1);
+	//the moving blocks are put where they are during this step first, then the blocks with mass get the velocities that keep them
+	//out of every block, so every ball is swept against both as they move
+	moveMovers(portion);
+	solveBlocks(portion);
+
+	//balls that can reach each other are moved together so their collisions resolve in the order they happen; islands that can't
+	//reach each other never touch the same ball, so the pool can solve them in any order on any thread and get the same result
+	findIslands(portion);
+	freePortion.assign(bodies.size(), 0);
+	for (WorkerState &worker : workers)
+	{
+		worker.goalReached = false;
+		worker.stats = ContactStats();
+	}
+	{
+		PROFILE_SCOPE("solve islands");
+		pool.run((int)batches.size() - 1, [this, portion](int task, int worker)
+		{
+			for (int i = batches[task]; i < batches[task + 1]; i++)
+				islandHandler(islands[i], portion, workers[worker]);
+		});
+	}
+
+	//merge the results of the threads, then move every ball nothing was in the way of with the batch kernel
+	goalReached = false;
+	stats.steps++;
+	for (const WorkerState &worker : workers)
+	{
+		goalReached = goalReached || worker.goalReached;
+		stats.contacts += worker.stats.contacts;
+		stats.minAdvances += worker.stats.minAdvances;
+		stats.budgetHits += worker.stats.budgetHits;
+		stats.budgetSlides += worker.stats.budgetSlides;
+		stats.maxContacts = std::max(stats.maxContacts, worker.stats.maxContacts);
+	}
+	moveDynamics(portion);
+	time += portion;
+	PROFILE_SCOPE("integrate");
+	if (parabolic)
+		bodies.integrateParabola(freePortion.data());
+	else
+		bodies.integrate(freePortion.data());
+	return goalReached;
+}
+
+//Put every moving block where it is at the start of a portion of a frame, moving at the speed that takes it where it is at the end, and refit the hierarchy over the ones that left their bounds
+void World::moveMovers(double portion)
+{
+	stepPortion = portion;
+	if (movers.empty())
+		return;
+	PROFILE_SCOPE("moveMovers");
+
+	//a block's bounds in the hierarchy reach MOVER_MARGIN past it, so they hold the box it sweeps over a step for several steps of a
+	//slow block, and a block that stands still (at the end of a linear path, say) never touches the hierarchy at all
+	bool moved = false;
+	for (size_t i = 0; i < movers.size(); i++)
+	{
+		BlockBody &mover = movers[i];
+		mover = placeMover(moverPaths[i], mover.material, time, portion);
+		double xMin = std::min(mover.xMin, mover.xMin + mover.vx * portion);
+		double yMin = std::min(mover.yMin, mover.yMin + mover.vy * portion);
+		double xMax = std::max(mover.xMax, mover.xMax + mover.vx * portion);
+		double yMax = std::max(mover.yMax, mover.yMax + mover.vy * portion);
+		SweepBox &bounds = moverBounds[i];
+		if (xMin >= bounds.xMin && yMin >= bounds.yMin && xMax <= bounds.xMax && yMax <= bounds.yMax)
+			continue;
+		SweepBox grown = { xMin - MOVER_MARGIN, yMin - MOVER_MARGIN, xMax + MOVER_MARGIN, yMax + MOVER_MARGIN };
+		bounds = grown;
+		moverTree.moveBlock((int)i, grown.xMin, grown.yMin, grown.xMax, grown.yMax);
+		moved = true;
+	}
+	if (moved)
+		moverTree.refit();
+}
+
+//Pull the blocks with mass down and solve their contacts with each other and the other blocks over a portion of a frame, leaving every one at its start with the velocity the solver gave it
+void World::solveBlocks(double portion)
+{
+	if (dynamics.empty())
+		return;
+
+	//an island of blocks with mass that has stayed at rest long enough sleeps: only a ball or a moving block coming within reach,
+	//a ball pushing one of its blocks or an awake block reaching one can move it again, so until then a resting pile costs the step
+	//nothing however much goes on elsewhere. Held still, its contacts keep the impulses they had for when it wakes
+	if (!wakeDynamics(portion))
+	{
+		solver.skip();
+		return;
+	}
+	PROFILE_SCOPE("solveBlocks");
+
+	//gravity goes into the velocities before the contacts are solved, so a block resting on another has its weight taken by the
+	//contact in the same step and never sinks into it
+	for (size_t i = 0; i < dynamics.size(); i++)
+	{
+		dynamicParent[i] = (int)i;
+		if (!dynamicAsleep[i])
+			dynamics[i].vy += GRAVITY * portion;
+	}
+	sweepDynamics(portion);
+
+	//every block a block with mass can touch during the step gets a contact with it: the goal block, the level's blocks and its
+	//polygons don't give way, moving blocks push without being pushed, and each pair of blocks with mass is added once, by its
+	//lower numbered block
+	for (int i = 0; i < (int)dynamics.size(); i++)
+	{
+		if (dynamicAsleep[i])
+			continue;
+		const BlockBody &block = dynamics[i];
+		double reach = Vec2D(block.vx, block.vy).length() * portion + BLOCK_CONTACT_DISTANCE;
+		double xMin = block.xMin - reach, yMin = block.yMin - reach, xMax = block.xMax + reach, yMax = block.yMax + reach;
+		addBlockContact(i, CONTACT_GOAL, 0, goalBlock, portion);
+		blockTree.query(xMin, yMin, xMax, yMax, solverCandidates);
+		for (int other : solverCandidates)
+			addBlockContact(i, CONTACT_LEVEL, other, blocks[other], portion);
+		if (!polygons.empty())
+		{
+			polygonTree.query(xMin, yMin, xMax, yMax, solverCandidates);
+			for (int other : solverCandidates)
+				addBlockContact(i, CONTACT_POLYGON, other, polygons[other], portion);
+		}
+		if (!movers.empty())
+		{
+			moverTree.query(xMin, yMin, xMax, yMax, solverCandidates);
+			for (int other : solverCandidates)
+				addBlockContact(i, CONTACT_MOVER, other, movers[other], portion);
+		}
+		dynamicTree.query(xMin, yMin, xMax, yMax, solverCandidates);
+		for (int other : solverCandidates)
+			if (other > i)
+				addBlockContact(i, CONTACT_DYNAMIC, other, dynamics[other], portion);
+	}
+
+	//a block pushed or pulled into a ball the ball can't get out of the way of (one resting on the floor, say) would go through
+	//it, so every ball a block can reach holds the block back too
+	for (int i = 0; i < bodies.size(); i++)
+	{
+		double reach = bodies.getVelocity(i).length() * portion + bodies.radius[i];
+		dynamicTree.query(bodies.x[i] - reach, bodies.y[i] - reach, bodies.x[i] + reach, bodies.y[i] + reach, solverCandidates);
+		for (int block : solverCandidates)
+			addBallContact(block, i, portion);
+	}
+	solver.solve(dynamics, portion, dynamicAsleep);
+
+	//the blocks the solver gave contacts with each other make up an island, which has rested as long as its least rested block if
+	//every one of its blocks is at rest. The root of an island (its lowest numbered block) comes first, so going up it gathers the
+	//island's rest time (-1 for an island on the move) and going back down hands it to every block before the root's is changed
+	int count = (int)dynamics.size();
+	for (int i = 0; i < count; i++)
+	{
+		if (dynamicAsleep[i])
+			continue;
+		int root = findDynamicRoot(i);
+		bool resting = Vec2D(dynamics[i].vx, dynamics[i].vy).length() < BLOCK_SLEEP_SPEED;
+		if (root == i)
+			dynamicRest[i] = resting ? dynamicRest[i] : -1;
+		else if (dynamicRest[root] >= 0)
+			dynamicRest[root] = resting ? std::min(dynamicRest[root], dynamicRest[i]) : -1;
+	}
+
+	//a pile at rest is held exactly still, so the rest of the step doesn't creep it along and a block that starts moving again
+	//shows it had been pushed
+	for (int i = count - 1; i >= 0; i--)
+	{
+		if (dynamicAsleep[i])
+			continue;
+		double rest = dynamicRest[findDynamicRoot(i)];
+		dynamicRest[i] = rest < 0 ? 0 : rest + portion;
+		if (dynamicRest[i] >= BLOCK_SLEEP_FRAMES)
+		{
+			dynamics[i].vx = 0;
+			dynamics[i].vy = 0;
+		}
+	}
+
+	//the balls meet the blocks along the velocities the solver gave them
+	sweepDynamics(portion);
+}
+
+//Add a contact between a block with mass and another block (of a kind, with its index) to the solver if they can touch during a portion of a frame
+void World::addBlockContact(int index, int kind, int other, const BlockBody &block, double portion)
+{
+	const BlockBody &body = dynamics[index];
+	Vec2D normal;
+	double gap;
+	int side = kind == CONTACT_POLYGON ? polygonSeparation(body, polygonShapes[other], normal, gap) : boxSeparation(body, block, normal, gap);
+	if (gap > (Vec2D(body.vx, body.vy).length() + Vec2D(block.vx, block.vy).length()) * portion + BLOCK_CONTACT_DISTANCE)
+		return;
+
+	//the key names the contact by its blocks and the side they touch on, so it's the same every step the contact lasts and the
+	//impulse it needed the step before can be found again (a polygon's edges past the fourth share the key's sides, which only
+	//matters to a contact that moves from one of them to another between steps)
+	const Material &first = materials[body.material];
+	const Material &second = materials[block.material];
+	SolverContact contact;
+	contact.first = index;
+	contact.second = kind == CONTACT_DYNAMIC ? other : -1;
+	contact.key = ((unsigned long long)index << 32) | ((unsigned long long)kind << 29) | ((unsigned long long)(other & 0x07ffffff) << 2) | (unsigned long long)(side & 3);
+	contact.normal = normal;
+	contact.gap = gap;
+	contact.restitution = std::min(first.restitution, second.restitution);
+	contact.friction = std::max(first.friction, second.friction);
+	contact.velocity = kind == CONTACT_DYNAMIC ? Vec2D() : Vec2D(block.vx, block.vy);
+	contact.mass = 0;
+	contact.target = 0;
+	contact.normalImpulse = 0;
+	contact.tangentImpulse = 0;
+	solver.add(contact);
+
+	//blocks with mass in contact sleep and wake together, so they're joined into one island, the lower numbered block the root
+	if (kind == CONTACT_DYNAMIC)
+	{
+		int first = findDynamicRoot(index);
+		int second = findDynamicRoot(other);
+		if (first != second)
+			dynamicParent[std::max(first, second)] = std::min(first, second);
+	}
+}
+
+//Add a contact between a block with mass and a ball to the solver if the block can close in on the ball during a portion of a frame
+void World::addBallContact(int index, int ball, double portion)
+{
+	//the normal goes from the nearest point of the block to the center of the ball, or out of the nearest side of the block when the
+	//center is inside it; the sides are numbered the way boxSeparation() numbers them
+	const BlockBody &block = dynamics[index];
+	Vec2D center = bodies.getPosition(ball);
+	Vec2D nearest(std::min(std::max(center.x, block.xMin), block.xMax), std::min(std::max(center.y, block.yMin), block.yMax));
+	Vec2D normal;
+	double gap;
+	int side;
+	if (center.x != nearest.x || center.y != nearest.y)
+	{
+		Vec2D offset = nearest - center;
+		gap = offset.length();
+		normal = offset / gap;
+		gap -= bodies.radius[ball];
+		side = fabs(offset.x) >= fabs(offset.y) ? (offset.x > 0 ? 0 : 1) : (offset.y > 0 ? 2 : 3);
+	}
+	else
+	{
+		double sides[4] = { center.x - block.xMin, block.xMax - center.x, center.y - block.yMin, block.yMax - center.y };
+		side = (int)(std::min_element(sides, sides + 4) - sides);
+		Vec2D normals[4] = { Vec2D(1, 0), Vec2D(-1, 0), Vec2D(0, 1), Vec2D(0, -1) };
+		normal = normals[side];
+		gap = -sides[side] - bodies.radius[ball];
+	}
+	Vec2D velocity = bodies.getVelocity(ball);
+	if (gap > (Vec2D(block.vx, block.vy).length() + velocity.length()) * portion + BLOCK_CONTACT_DISTANCE)
+		return;
+
+	//the ball doesn't give way and stands still: it stands for whatever holds it where it is (a ball moving off would let a block
+	//follow it into the floor it's about to bounce off, squeezing it). A ball closing in on a block is left to its own collision,
+	//which pushes the block with the ball's mass, and one moving away opens a gap the block closes the step after
+	SolverContact contact;
+	contact.first = index;
+	contact.second = -1;
+	contact.key = ((unsigned long long)index << 32) | ((unsigned long long)CONTACT_BALL << 29) | ((unsigned long long)(ball & 0x07ffffff) << 2) | (unsigned long long)side;
+	contact.normal = normal;
+	contact.gap = gap;
+	contact.restitution = 0;
+	contact.friction = 0;
+	contact.velocity = Vec2D();
+	contact.mass = 0;
+	contact.target = 0;
+	contact.normalImpulse = 0;
+	contact.tangentImpulse = 0;
+	solver.add(contact);
+}
+
+//Give every block with mass the box it sweeps over a portion of a frame in the hierarchy over them
+void World::sweepDynamics(double portion)
+{
+	//every block with mass moves, if only by falling, so all of them get new boxes before the nodes above are refit; the boxes only
+	//depend on the blocks, so a step taken from a snapshot finds the same contacts as the step it was saved before
+	for (size_t i = 0; i < dynamics.size(); i++)
+	{
+		const BlockBody &block = dynamics[i];
+		double xMin = std::min(block.xMin, block.xMin + block.vx * portion) - BLOCK_CONTACT_DISTANCE;
+		double yMin = std::min(block.yMin, block.yMin + block.vy * portion) - BLOCK_CONTACT_DISTANCE;
+		double xMax = std::max(block.xMax, block.xMax + block.vx * portion) + BLOCK_CONTACT_DISTANCE;
+		double yMax = std::max(block.yMax, block.yMax + block.vy * portion) + BLOCK_CONTACT_DISTANCE;
+		dynamicTree.moveBlock((int)i, xMin, yMin, xMax, yMax);
+	}
+	dynamicTree.refit();
+}
+
+//Move every block with mass along its velocity by a portion of a frame
+void World::moveDynamics(double portion)
+{
+	for (BlockBody &block : dynamics)
+	{
+		block.xMin += block.vx * portion;
+		block.yMin += block.vy * portion;
+		block.xMax += block.vx * portion;
+		block.yMax += block.vy * portion;
+	}
+}
+
+//Mark the blocks with mass that sleep through a portion of a frame (their island has rested long enough and nothing can move it), return true if any is awake
+bool World::wakeDynamics(double portion)
+{
+	//a block held still that has any speed at all was pushed by a ball, so it's awake whatever its island's rest time says
+	int count = (int)dynamics.size();
+	int sleeping = 0;
+	wakeQueue.clear();
+	for (int i = 0; i < count; i++)
+	{
+		const BlockBody &block = dynamics[i];
+		dynamicAsleep[i] = blockSleeping && dynamicRest[i] >= BLOCK_SLEEP_FRAMES && block.vx == 0 && block.vy == 0;
+		if (dynamicAsleep[i])
+			sleeping++;
+		else
+			wakeQueue.push_back(i);
+	}
+	auto wake = [&](int block)
+	{
+		if (!dynamicAsleep[block])
+			return;
+		dynamicAsleep[block] = 0;
+		wakeQueue.push_back(block);
+		sleeping--;
+	};
+
+	//a ball wakes a block the same way it would be given a contact with it, and a moving block wakes one it could be given a contact
+	//with once awake (the whole pile is tried first, so a level whose moving blocks are nowhere near its piles pays for one query)
+	if (sleeping > 0)
+		for (int i = 0; i < bodies.size(); i++)
+		{
+			double reach = bodies.getVelocity(i).length() * portion + bodies.radius[i];
+			dynamicTree.query(bodies.x[i] - reach, bodies.y[i] - reach, bodies.x[i] + reach, bodies.y[i] + reach, solverCandidates);
+			for (int block : solverCandidates)
+				wake(block);
+		}
+	if (sleeping > 0 && !movers.empty())
+	{
+		const BVH::Node &root = dynamicTree.getNodes()[0];
+		moverTree.query(root.xMin, root.yMin, root.xMax, root.yMax, solverCandidates);
+		bool near = !solverCandidates.empty();
+		double reach = GRAVITY * portion * portion + BLOCK_CONTACT_DISTANCE;
+		for (int i = 0; i < count && near; i++)
+		{
+			const BlockBody &block = dynamics[i];
+			if (!dynamicAsleep[i])
+				continue;
+			moverTree.query(block.xMin - reach, block.yMin - reach, block.xMax + reach, block.yMax + reach, solverCandidates);
+			if (!solverCandidates.empty())
+				wake(i);
+		}
+	}
+
+	//an awake block wakes every sleeping one it can reach, with the gravity it's about to be given counted in, and those wake the
+	//ones they reach in turn; a sleeping block never has a contact with an awake one, so an island wakes whole and the solver never
+	//pushes a block that's meant to be held still
+	for (size_t next = 0; next < wakeQueue.size() && sleeping > 0; next++)
+	{
+		const BlockBody &block = dynamics[wakeQueue[next]];
+		double reach = (Vec2D(block.vx, block.vy).length() + GRAVITY * portion) * portion + BLOCK_CONTACT_DISTANCE;
+		dynamicTree.query(block.xMin - reach, block.yMin - reach, block.xMax + reach, block.yMax + reach, solverCandidates);
+		for (int other : solverCandidates)
+			wake(other);
+	}
+	return !wakeQueue.empty();
+}
+
+//Move a ball along its velocity vector, calculate new velocity due to gravity
+void World::moveBall(int index, double portion)
+{
+	if (parabolic)
+		bodies.integrateParabola(index, portion);
+	else
+		bodies.integrate(index, portion);
+}
+
+//Bounce a ball off a surface with the normal of a collision, one of the level's materials and the velocity the surface moves at
+void World::collideBall(int index, Vec2D normal, int material, Vec2D velocity)
+{
+	//off a moving block the ball bounces in the block's frame of reference: its speed relative to the block is what bounces, and
+	//the block's speed is added back. Off a block that stands still the velocity is exactly what bounce() gives
+	Vec2D bounced = velocity.x == 0 && velocity.y == 0 ? bounce(bodies.getVelocity(index), normal, materials[material])
+		: bounce(bodies.getVelocity(index) - velocity, normal, materials[material]) + velocity;
+
+	//along a parabola the ball moves half a frame of gravity slower than its velocity (see BodyStore::integrateParabola()); bouncing
+	//the velocity gives the hops frame steps give, but a ball rising into a block slower than that would be sent on into it, so it
+	//bounces the way it moves instead
+	Vec2D lead(0, 0.5 * GRAVITY);
+	if (parabolic && (bounced - velocity - lead).dot(normal) < 0)
+		bounced = bounce(bodies.getVelocity(index) - velocity - lead, normal, materials[material]) + lead + velocity;
+	bodies.setVelocity(index, bounced);
+}
+
+//Bounce a ball off the block it collided with, pushing the block if it has mass
+void World::respond(int index, const Collision &hit, WorkerState &worker)
+{
+	if (hit.dynamic >= 0)
+		pushBlock(index, hit, worker);
+	else
+		collideBall(index, hit.normal, hit.material, hit.velocity);
+}
+
+//Bounce a ball off a block with mass in the block's frame of reference, sharing the change of their velocities by their masses
+void World::pushBlock(int index, const Collision &hit, WorkerState &worker)
+{
+	//the change bounce() gives their relative velocity is shared the way an impulse between them shares it: the lighter of the two
+	//takes more of it, and together they keep the momentum they had
+	BlockBody &block = dynamics[hit.dynamic];
+	Vec2D blockVelocity(block.vx, block.vy);
+	Vec2D relative = bodies.getVelocity(index) - blockVelocity;
+	Vec2D change = bounce(relative, hit.normal, materials[hit.material]) - relative;
+	double share = bodies.invMass[index] / (bodies.invMass[index] + block.invMass);
+
+	//a ball only slowly closing in on a block is resting on it, under it or leaning on it, which the solver already took into account
+	//moving the block at the start of the step; the ball bounces off it as it would off a level block so it can't kick it into the
+	//blocks around it behind the solver's back
+	if (relative.dot(hit.normal) > -SOLVER_BOUNCE_SPEED)
+		share = 1;
+	bodies.setVelocity(index, bodies.getVelocity(index) + change * share);
+	Vec2D pushed = blockVelocity - change * (1 - share);
+
+	//the block's bounds are where it started the step, so they're moved back by what its new velocity adds over the part of the
+	//step gone by; it carries on from where it was hit instead of jumping
+	Vec2D shift = (blockVelocity - pushed) * hit.elapsed;
+	block.xMin += shift.x;
+	block.yMin += shift.y;
+	block.xMax += shift.x;
+	block.yMax += shift.y;
+	block.vx = pushed.x;
+	block.vy = pushed.y;
+
+	//its box in the hierarchy was swept along the velocity it had, so from now on the island's balls look for it by itself
+	if (std::find(worker.pushed.begin(), worker.pushed.end(), hit.dynamic) == worker.pushed.end())
+		worker.pushed.push_back(hit.dynamic);
+}
+
+//Exchange a mass-weighted impulse between two touching balls
+void World::collideBalls(int first, int second)
+{
+	Vec2D normal = bodies.getPosition(second) - bodies.getPosition(first);	//normal from the first ball to the second
+	double length = normal.length();
+	double totalInvMass = bodies.invMass[first] + bodies.invMass[second];
+	if (length == 0 || totalInvMass == 0)
+		return;
+	normal = normal / length;
+
+	//only balls closing in on each other bounce; the lighter ball (larger inverse mass) takes more of the impulse
+	double closingSpeed = (bodies.getVelocity(second) - bodies.getVelocity(first)).dot(normal);
+	if (closingSpeed >= 0)
+		return;
+	Vec2D impulse = normal * (-(1 + BALL_RESTITUTION) * closingSpeed / totalInvMass);
+	bodies.setVelocity(first, bodies.getVelocity(first) - impulse * bodies.invMass[first]);
+	bodies.setVelocity(second, bodies.getVelocity(second) + impulse * bodies.invMass[second]);
+}
+
+//Set the velocity of a ball
+void World::setBallVelocity(int index, double xVect, double yVect)
+{
+	bodies.vx[index] = xVect;
+	bodies.vy[index] = yVect;
+}
+
+//Set the coordinates of the center of a ball
+void World::setBallPosition(int index, double xPos, double yPos)
+{
+	bodies.x[index] = xPos;
+	bodies.y[index] = yPos;
+}
+
+//Set the inverse mass (>=0) of a ball
+void World::setBallInvMass(int index, double newInvMass)
+{
+	if (newInvMass >= 0)
+		bodies.invMass[index] = newInvMass;
+}
+
+//return velocity vector of a ball
+Vec2D World::getBallVelocity(int index) const
+{
+	return bodies.getVelocity(index);
+}
+
+//return x coordinate of the center of a ball
+double World::getBallX(int index) const
+{
+	return bodies.x[index];
+}
+
+//return y coordinate of the center of a ball
+double World::getBallY(int index) const
+{
+	return bodies.y[index];
+}
+
+//return the radius of a ball
+double World::getBallRadius(int index) const
+{
+	return bodies.radius[index];
+}
+
+//return the number of balls
+int World::getBallCount() const
+{
+	return bodies.size();
+}
+
+//return the body storage of the balls
+const BodyStore& World::getBodies() const
+{
+	return bodies;
+}
+
+//return the goal block
+const BlockBody& World::getGoalBlock() const
+{
+	return goalBlock;
+}
+
+//return a level block
+const BlockBody& World::getBlock(int index) const
+{
+	return blocks[index];
+}
+
+//return the number of level blocks
+int World::getBlockCount() const
+{
+	return (int)blocks.size();
+}
+
+//return a moving block where its path has it at a time, moving at the speed that takes it along its path over the next frame
+BlockBody World::getMover(int index, double atTime) const
+{
+	return placeMover(moverPaths[index], movers[index].material, atTime, 1);
+}
+
+//return the path of a moving block
+const MoverData& World::getMoverPath(int index) const
+{
+	return moverPaths[index];
+}
+
+//return the number of moving blocks
+int World::getMoverCount() const
+{
+	return (int)movers.size();
+}
+
+//return the bounding volume hierarchy over the moving blocks
+const BVH& World::getMoverTree() const
+{
+	return moverTree;
+}
+
+//return the blocks with mass where they are, with their velocities
+const std::vector<BlockBody>& World::getDynamicBlocks() const
+{
+	return dynamics;
+}
+
+//return the number of blocks with mass
+int World::getDynamicBlockCount() const
+{
+	return (int)dynamics.size();
+}
+
+//Set the number of times the solver resolves every contact of the blocks with mass in a step
+void World::setSolverIterations(int count)
+{
+	solver.setIterations(count);
+}
+
+//return the number of times the solver resolves every contact of the blocks with mass in a step
+int World::getSolverIterations() const
+{
+	return solver.getIterations();
+}
+
+//return the number of contacts of the blocks with mass the solver resolved in the last step
+int World::getSolverContactCount() const
+{
+	return solver.getContactCount();
+}
+
+//Set whether blocks with mass that have come to rest sleep (are left out of the step) until something can disturb them
+void World::setBlockSleeping(bool sleeping)
+{
+	blockSleeping = sleeping;
+}
+
+//return whether blocks with mass that have come to rest sleep until something can disturb them
+bool World::isBlockSleeping() const
+{
+	return blockSleeping;
+}
+
+//return the frames simulated since the level started, which says where the moving blocks are
+double World::getTime() const
+{
+	return time;
+}
+
+//Set the frames simulated since the level started and put the moving blocks where their paths have them then, refitting the hierarchy over them
+void World::setTime(double newTime)
+{
+	//the blocks keep the speed of the step last taken, which the next step sets again anyway
+	time = newTime;
+	moveMovers(stepPortion);
+}
+
+//return whether a ball's trajectory over a portion of a frame gets past the borders of a level block (the test before the narrowphase)
+bool World::blockReachable(int index, int block, double portion) const
+{
+	BallBody ball = bodies.get(index);
+	return collisionPossible(ball, ball.vx * portion, ball.vy * portion, blocks[block]);
+}
+
+//Detect whether a ball collides with a level block within a portion of a frame, set the normal and the subportion to the collision (the narrowphase on its own)
+bool World::detectBlock(int index, int block, double portion, Vec2D &normal, double &subPortion) const
+{
+	//the same query a step makes of every candidate block, without the hierarchy or the rest of the step around it
+	Collision hit;
+	hit.subPortion = 1;
+	hit.projected = false;
+	hit.goal = false;
+	collisionDetect(bodies.get(index), blocks[block], portion, hit);
+	normal = hit.normal;
+	subPortion = hit.subPortion;
+	return hit.projected;
+}
+
+//return one of the level's block materials
+const Material& World::getMaterial(int index) const
+{
+	return materials[index];
+}
+
+//return the number of block materials (material 0 being the default)
+int World::getMaterialCount() const
+{
+	return (int)materials.size();
+}
+
+//return the bounding volume hierarchy over the level blocks
+const BVH& World::getBlockTree() const
+{
+	return blockTree;
+}
+
+//return the corners, edge normals, bounds and outline of a convex polygon block
+const SweepPolygon& World::getPolygon(int index) const
+{
+	return polygonShapes[index];
+}
+
+//return the bounds (its outline included) and material of a convex polygon block
+const BlockBody& World::getPolygonBounds(int index) const
+{
+	return polygons[index];
+}
+
+//return the number of convex polygon blocks
+int World::getPolygonCount() const
+{
+	return (int)polygons.size();
+}
+
+//return the bounding volume hierarchy over the convex polygon blocks
+const BVH& World::getPolygonTree() const
+{
+	return polygonTree;
+}
+
+//return the number of islands the balls were split into during the last step
+int World::getIslandCount() const
+{
+	return (int)islands.size();
+}
+
+//Set the number of threads that solve the islands, 0 for one per core
+void World::setThreadCount(int count)
+{
+	pool.setThreadCount(count);
+	workers.resize(pool.getThreadCount());
+}
+
+//return the number of threads that solve the islands
+int World::getThreadCount() const
+{
+	return pool.getThreadCount();
+}
+
+//Set the most collisions resolved for one ball or island in a step before the rest of its step falls back to a cheaper approximation
+void World::setContactBudget(int budget)
+{
+	if (budget >= 0)
+		contactBudget = budget;
+}
+
+//return the most collisions resolved for one ball or island in a step
+int World::getContactBudget() const
+{
+	return contactBudget;
+}
+
+//Set whether the balls move along exact parabolas within a step (and are swept along them), so a step of many frames lands where that many frame steps would and cuts no corners
+void World::setParabolicSteps(bool enabled)
+{
+	parabolic = enabled;
+}
+
+//return whether the balls move along exact parabolas within a step
+bool World::isParabolicSteps() const
+{
+	return parabolic;
+}
+
+//Set the least portion of a frame every resolved collision uses up
+void World::setMinAdvance(double advance)
+{
+	if (advance >= 0)
+		minAdvance = advance;
+}
+
+//return the least portion of a frame every resolved collision uses up
+double World::getMinAdvance() const
+{
+	return minAdvance;
+}
+
+//return the collision counters since the world was created or the counters were reset
+const ContactStats& World::getContactStats() const
+{
+	return stats;
+}
+
+//Set every collision counter back to 0
+void World::resetContactStats()
+{
+	stats = ContactStats();
+}
+
+//return whether the trajectory puts it passing an object
+bool World::collisionPossible(const BallBody &ball, double xTrajectory, double yTrajectory, const BlockBody &block) const
+{
+	double leftBorder = block.xMin - ball.radius;
+	double rightBorder = block.xMax + ball.radius;
+	double topBorder = block.yMin - ball.radius;
+	double bottomBorder = block.yMax + ball.radius;
+	double endX = ball.x + xTrajectory;
+	double endY = ball.y + yTrajectory;
+	return !((ball.x < leftBorder && endX < leftBorder) || (ball.x > rightBorder && endX > rightBorder) || (ball.y < topBorder && endY < topBorder) || (ball.y > bottomBorder && endY > bottomBorder));
+}
+
+//set the parameters for the normal of the collision with a block and track that a collision happened
+void World::setNormal(Collision &hit, const BlockBody &block, Vec2D normal, double setSubPortion) const
+{
+	PROFILE_COUNT(PROFILE_NARROW_HITS, 1);
+	hit.projected = true;
+	hit.goal = false;
+	hit.normal = normal;
+	hit.material = block.material;
+	hit.velocity = Vec2D(block.vx, block.vy);
+	hit.dynamic = -1;
+	hit.subPortion = setSubPortion;
+}
+
+//detect a ball already touching a block and moving into it, and set normal appropriately
+bool World::contactDetect(const BallBody &ball, const BlockBody &block, Collision &hit) const
+{
+	//a ball left exactly on a block's border by an earlier collision can be pushed into it by another ball; the crossing tests below need it
+	//to start outside the border, so without this check it would pass straight through (a ball only sliding along the border, give or take rounding, isn't moving into it)
+	Vec2D corner(ball.x < block.xMin ? block.xMin : block.xMax, ball.y < block.yMin ? block.yMin : block.yMax);	//nearest corner
+	Vec2D fromCorner = Vec2D(ball.x, ball.y) - corner;												//offset of the center of the ball from the corner
+	bool alongX = ball.x >= block.xMin && ball.x <= block.xMax;		//ball is beside the top or bottom edge
+	bool alongY = ball.y >= block.yMin && ball.y <= block.yMax;		//ball is beside the left or right edge
+	if (alongX && fabs(ball.y - (block.yMin - ball.radius)) <= CONTACT_TOLERANCE && ball.vy > CONTACT_TOLERANCE)
+		setNormal(hit, block, Vec2D(0, -1), 0);
+	else if (alongX && fabs(ball.y - (block.yMax + ball.radius)) <= CONTACT_TOLERANCE && ball.vy < -CONTACT_TOLERANCE)
+		setNormal(hit, block, Vec2D(0, 1), 0);
+	else if (alongY && fabs(ball.x - (block.xMin - ball.radius)) <= CONTACT_TOLERANCE && ball.vx > CONTACT_TOLERANCE)
+		setNormal(hit, block, Vec2D(-1, 0), 0);
+	else if (alongY && fabs(ball.x - (block.xMax + ball.radius)) <= CONTACT_TOLERANCE && ball.vx < -CONTACT_TOLERANCE)
+		setNormal(hit, block, Vec2D(1, 0), 0);
+	else if (!alongX && !alongY
+		&& fabs(fromCorner.length() - ball.radius) <= CONTACT_TOLERANCE
+		&& -Vec2D(ball.vx, ball.vy).dot(fromCorner) / ball.radius > CONTACT_TOLERANCE)
+		setNormal(hit, block, fromCorner / ball.radius, 0);
+	else
+		return false;
+	return true;
+}
+
+//detect a collision with a block earlier than any found so far and set normal appropriately, return true if one was found
+bool World::collisionDetect(const BallBody &ball, const BlockBody &block, double portion, Collision &hit) const
+{
+	Vec2D trajectory(ball.vx * portion, ball.vy * portion);	//the ball's movement along it's current trajectory
+
+	//Only check for collision if trajectory puts the ball past the minimum and/or maximum bounds of the block (i.e. if the ball before and after moving are still on the same side of the block, it can't have collided with it)
+	if (!parabolic && !collisionPossible(ball, trajectory.x, trajectory.y, block))
+	{
+		PROFILE_COUNT(PROFILE_EARLY_OUTS, 1);
+		return false;
+	}
+
+	//nothing can happen earlier than a collision with a block the ball is already touching (along a parabola, starting on the block
+	//and moving into it counts as a collision right away in the sweep itself)
+	if (!parabolic && contactDetect(ball, block, hit))
+		return true;
+
+	//one closed-form test finds where the ball first touches the block's sides or rounded corners, whichever way it's moving
+	SweepBox box = { block.xMin, block.yMin, block.xMax, block.yMax };
+	return sweepDetect<SHAPE_BOX>(ball, box, block, portion, hit);
+}
+
+//detect a collision with a block of a kind of shape earlier than any found so far through the shape pair table and set normal appropriately, return true if one was found
+template<int Shape>
+bool World::sweepDetect(const BallBody &ball, const typename ShapeType<Shape>::Type &shape, const BlockBody &block, double portion, Collision &hit) const
+{
+	//the kind of shape picks the routine when this is compiled, so every candidate costs a direct call. Along a trajectory the time
+	//of impact is a portion of it; along a parabola it's in frames, and the ball moves half a frame of gravity slower than its
+	//velocity (see BodyStore::integrateParabola())
+	SweepHit sweep;
+	if (!parabolic)
+	{
+		SweepMotion motion = { Vec2D(ball.x, ball.y), Vec2D(ball.vx * portion, ball.vy * portion), Vec2D(), ball.radius };
+		if (!sweepShape<Shape>(motion, shape, hit.subPortion, sweep))
+			return false;
+		setNormal(hit, block, sweep.normal, sweep.toi);
+		return true;
+	}
+	SweepMotion motion = { Vec2D(ball.x, ball.y), Vec2D(ball.vx, ball.vy - 0.5 * GRAVITY), Vec2D(0, GRAVITY), ball.radius };
+	if (!sweepShape<Shape>(motion, shape, hit.subPortion * portion, sweep))
+		return false;
+	setNormal(hit, block, sweep.normal, sweep.toi / portion);
+	return true;
+}
+
+//return the box the center of a ball sweeps over a portion of a frame, along its velocity or its parabola
+SweepBox World::sweptBounds(const BallBody &ball, double portion) const
+{
+	if (parabolic)
+		return parabolaBounds(Vec2D(ball.x, ball.y), Vec2D(ball.vx, ball.vy - 0.5 * GRAVITY), Vec2D(0, GRAVITY), portion);
+	double endX = ball.x + ball.vx * portion;
+	double endY = ball.y + ball.vy * portion;
+	SweepBox bounds = { std::min(ball.x, endX), std::min(ball.y, endY), std::max(ball.x, endX), std::max(ball.y, endY) };
+	return bounds;
+}
+
+//return how far from where it starts a ball (its radius included) can get over a portion of a frame
+double World::ballReach(int index, double portion) const
+{
+	//a ball can't get farther from where it starts than its speed (bounces only slow it) plus what gravity adds this frame; along a
+	//parabola it starts up to half a frame of gravity faster than its velocity, and gravity only adds half as much over the portion
+	double speed = bodies.getVelocity(index).length();
+	if (parabolic)
+		return (speed + 0.5 * GRAVITY * (1 + portion)) * portion + bodies.radius[index];
+	return (speed + GRAVITY * portion) * portion + bodies.radius[index];
+}
+
+//Find the pairs of balls that can reach each other this frame and split the balls into islands that can't affect each other
+void World::findIslands(double portion)
+{
+	PROFILE_SCOPE("findIslands");
+	int count = bodies.size();
+	if ((int)parent.size() != count)
+	{
+		broadphase.reset(count);
+		parent.resize(count);
+		islandIndex.resize(count);
+	}
+
+	for (int i = 0; i < count; i++)
+	{
+		double reach = ballReach(i, portion);
+		broadphase.setBox(i, bodies.x[i] - reach, bodies.y[i] - reach, bodies.x[i] + reach, bodies.y[i] + reach, bodies.invMass[i] > 0);
+	}
+	broadphase.findPairs(pairs);
+
+	//join the two balls of every pair into one island, always keeping the lower numbered ball as the root
+	for (int i = 0; i < count; i++)
+		parent[i] = i;
+	for (const BallPair &pair : pairs)
+	{
+		int first = findRoot(pair.first);
+		int second = findRoot(pair.second);
+		if (first != second)
+			parent[std::max(first, second)] = std::min(first, second);
+	}
+
+	//balls that can reach the same block with mass can push it into each other, so they're joined into one island too; that leaves
+	//every block with mass to the one thread solving the island of the balls that can reach it
+	if (!dynamics.empty())
+	{
+		std::fill(dynamicBall.begin(), dynamicBall.end(), -1);
+		for (int i = 0; i < count; i++)
+		{
+			double reach = ballReach(i, portion);
+			dynamicTree.query(bodies.x[i] - reach, bodies.y[i] - reach, bodies.x[i] + reach, bodies.y[i] + reach, solverCandidates);
+			for (int block : solverCandidates)
+			{
+				if (dynamicBall[block] < 0)
+				{
+					dynamicBall[block] = i;
+					continue;
+				}
+				int first = findRoot(i);
+				int second = findRoot(dynamicBall[block]);
+				if (first != second)
+					parent[std::max(first, second)] = std::min(first, second);
+			}
+		}
+	}
+
+	//number the islands in order of their lowest numbered ball (a root comes before the rest of its island), so the islands
+	//and everything built from them only depend on the balls and never on how the work is later split between threads
+	islands.clear();
+	for (int i = 0; i < count; i++)
+	{
+		int root = findRoot(i);
+		if (root == i)
+		{
+			Island island = { 0, 0, 0, 0 };
+			islandIndex[i] = (int)islands.size();
+			islands.push_back(island);
+		}
+		else
+			islandIndex[i] = islandIndex[root];
+		islands[islandIndex[i]].ballCount++;
+	}
+	for (const BallPair &pair : pairs)
+		islands[islandIndex[pair.first]].pairCount++;
+	for (size_t i = 0; i < dynamics.size(); i++)
+		dynamicIsland[i] = dynamicBall[i] >= 0 ? islandIndex[dynamicBall[i]] : -1;
+
+	//lay out the balls and pairs island by island, keeping their ascending order within each island
+	int firstBall = 0, firstPair = 0;
+	for (Island &island : islands)
+	{
+		island.firstBall = firstBall;
+		island.firstPair = firstPair;
+		firstBall += island.ballCount;
+		firstPair += island.pairCount;
+		island.ballCount = island.pairCount = 0;
+	}
+	islandBalls.resize(count);
+	islandPairs.resize(pairs.size());
+	for (int i = 0; i < count; i++)
+	{
+		Island &island = islands[islandIndex[i]];
+		islandBalls[island.firstBall + island.ballCount++] = i;
+	}
+	for (const BallPair &pair : pairs)
+	{
+		Island &island = islands[islandIndex[pair.first]];
+		islandPairs[island.firstPair + island.pairCount++] = pair;
+	}
+
+	//batch small islands together so each task handed to the pool is worth the trip to another thread
+	batches.assign(1, 0);
+	int batchBalls = 0;
+	for (size_t i = 0; i < islands.size(); i++)
+	{
+		batchBalls += islands[i].ballCount;
+		if (batchBalls >= ISLAND_BATCH_BALLS || i + 1 == islands.size())
+		{
+			batches.push_back((int)i + 1);
+			batchBalls = 0;
+		}
+	}
+}
+
+//return the lowest numbered ball of the island a ball has been joined to so far
+int World::findRoot(int ball)
+{
+	//point every other ball on the way at its grandparent so later searches take fewer steps
+	while (parent[ball] != ball)
+	{
+		parent[ball] = parent[parent[ball]];
+		ball = parent[ball];
+	}
+	return ball;
+}
+
+//return the lowest numbered block with mass of the island a block has been joined to so far this step
+int World::findDynamicRoot(int block)
+{
+	while (dynamicParent[block] != block)
+	{
+		dynamicParent[block] = dynamicParent[dynamicParent[block]];
+		block = dynamicParent[block];
+	}
+	return block;
+}
+
+//Detect whether two balls collide within a portion of a frame and set the subportion to the collision
+bool World::ballCollisionDetect(const BallPair &pair, double portion, double &subPortion) const
+{
+	//gravity pulls both balls the same way, so relative to each other they move in a straight line
+	Vec2D distance = bodies.getPosition(pair.second) - bodies.getPosition(pair.first);
+	Vec2D trajectory = (bodies.getVelocity(pair.second) - bodies.getVelocity(pair.first)) * portion;
+	double touching = bodies.radius[pair.first] + bodies.radius[pair.second];
+
+	//balls that aren't closing in on each other can't collide
+	double B = 2 * distance.dot(trajectory);
+	if (B >= 0)
+		return false;
+
+	//balls already touching collide right away unless they're only resting against each other (a pile would otherwise trade ever smaller
+	//impulses forever without time moving on), otherwise the circle-circle routine of the shape pair table finds the first touch
+	double C = distance.lengthSquared() - touching * touching;
+	if (C <= 0)
+	{
+		if (-B / (2 * portion * distance.length()) <= CONTACT_TOLERANCE)
+			return false;
+		subPortion = 0;
+		return true;
+	}
+	SweepMotion motion = { distance, trajectory, Vec2D(), 0 };
+	SweepCircle circle = { Vec2D(), touching };
+	SweepHit sweep;
+	if (!sweepShape<SHAPE_CIRCLE>(motion, circle, 1, sweep))
+		return false;
+	subPortion = sweep.toi;
+	return true;
+}
+
+//Detect and resolve every collision of the balls of an island during a portion of the frame
+void World::islandHandler(const Island &island, double portion, WorkerState &worker)
+{
+	//a ball alone in its island only has blocks to hit, and if nothing is in its way the batch kernel moves it
+	worker.pushing = true;
+	worker.pushed.clear();
+	if (island.ballCount == 1)
+	{
+		int ball = islandBalls[island.firstBall];
+		Collision hit;
+		findCollision(ball, portion, hit, worker);
+		if (hit.projected)
+			collisionHandler(ball, portion, hit, contactBudget, worker);
+		else
+			freePortion[ball] = portion;
+	}
+	else
+		groupHandler(island, portion, worker);
+}
+
+//Resolve the collisions among the balls of an island earliest first until the portion of the frame is used up or the contact budget runs out
+void World::groupHandler(const Island &island, double portion, WorkerState &worker)
+{
+	PROFILE_SCOPE("groupHandler");
+	const int *balls = islandBalls.data() + island.firstBall;
+	const BallPair *islandPair = islandPairs.data() + island.firstPair;
+	int contacts = 0;	//collisions resolved in the island this step
+
+	while (true)
+	{
+		//earliest collision of any ball in the group with a block
+		Collision hit;
+		int hitBall = -1;
+		worker.hitPortions.resize(island.ballCount);
+		for (int i = 0; i < island.ballCount; i++)
+		{
+			Collision ballHit;
+			findCollision(balls[i], portion, ballHit, worker);
+			worker.hitPortions[i] = ballHit.projected ? ballHit.subPortion : 2;
+			if (ballHit.projected && (hitBall < 0 || ballHit.subPortion < hit.subPortion))
+			{
+				hit = ballHit;
+				hitBall = balls[i];
+			}
+		}
+
+		//earliest collision between two balls, if it happens before that (block collisions win ties)
+		int hitPair = -1;
+		double subPortion = hitBall >= 0 ? hit.subPortion : 1;
+		for (int i = 0; i < island.pairCount; i++)
+		{
+			double pairSubPortion;
+			if (ballCollisionDetect(islandPair[i], portion, pairSubPortion) && (pairSubPortion < subPortion || (hitBall < 0 && hitPair < 0)))
+			{
+				subPortion = pairSubPortion;
+				hitPair = i;
+			}
+		}
+
+		//no collision left to resolve, finish movement for frame
+		if (hitBall < 0 && hitPair < 0)
+		{
+			for (int i = 0; i < island.ballCount; i++)
+				moveBall(balls[i], portion);
+			break;
+		}
+		if (hitPair < 0 && hit.goal)
+		{
+			worker.goalReached = true;
+			break;
+		}
+
+		//out of budget (typically a settling pile): finish the frame with every ball on its own, only colliding with blocks; balls
+		//left overlapping a little are pushed apart as soon as the next step finds them touching. The island's budget is spent, so
+		//every ball only moves to its next collision and slides from there. One ball finishing the frame before the next starts
+		//would push a block with mass at a time the others haven't got to, so the blocks don't give way
+		if (contacts >= contactBudget)
+		{
+			worker.stats.budgetHits++;
+			worker.pushing = false;
+			for (int i = 0; i < island.ballCount && !worker.goalReached; i++)
+			{
+				Collision ballHit;
+				findCollision(balls[i], portion, ballHit, worker);
+				collisionHandler(balls[i], portion, ballHit, 0, worker);
+			}
+			break;
+		}
+
+		//move every ball in the group along subPortion of its trajectory and resolve the collision
+		for (int i = 0; i < island.ballCount; i++)
+			moveBall(balls[i], subPortion * portion);
+		if (hitPair >= 0)
+			collideBalls(islandPair[hitPair].first, islandPair[hitPair].second);
+		else
+			respond(hitBall, hit, worker);
+		contacts++;
+
+		//every collision uses up at least the minimum advance, so collisions no time apart can't keep the loop from finishing the frame;
+		//the balls move on along their new velocities for the rest of it, so the frame loses no time. Only a ball that just bounced
+		//or is about to hit a block is swept again (stopping short of the block, which the next pass resolves); the others already
+		//know how far they are from their next block
+		double advance = subPortion * portion;
+		if (advance < minAdvance)
+		{
+			double extra = std::min(minAdvance, portion) - advance;
+			for (int i = 0; i < island.ballCount; i++)
+			{
+				int ball = balls[i];
+				bool bounced = hitPair >= 0 ? ball == islandPair[hitPair].first || ball == islandPair[hitPair].second : ball == hitBall;
+				if (bounced || (worker.hitPortions[i] - subPortion) * portion <= extra)
+					advanceBall(ball, extra, worker);
+				else
+					moveBall(ball, extra);
+			}
+			advance += extra;
+			worker.stats.minAdvances++;
+		}
+		portion -= advance;
+		if (portion <= 0)
+			break;
+	}
+	countContacts(contacts, worker);
+}
+
+//Detect the earliest collision of a ball with the goal block or a level block its trajectory can reach
+void World::findCollision(int index, double portion, Collision &hit, WorkerState &worker) const
+{
+	PROFILE_SCOPE("findCollision");
+	hit.subPortion = 1;			//percentage of the trajectory to collision for the portion of the frame remaining (e.g. subPortion = .85 means that that collision occurs 85% of the way along remaining trajectory)
+	hit.projected = false;		//collision detected
+	hit.goal = false;
+	hit.dynamic = -1;
+	BallBody ball = bodies.get(index);
+
+	//start with goalblock first, then check each level block for a collision with the ball
+	//Collision with goalblock sets hit.goal to true; If another collision is detected this frame that hits first, hit.goal will be set to false by collisionDetect()
+	//(only the playerBall wins the level, every other ball bounces off the goal block like any other block)
+	collisionDetect(ball, goalBlock, portion, hit);
+	if (hit.projected && index == 0)
+		hit.goal = true;
+
+	//only the blocks overlapping the box swept by the ball this frame can pass collisionPossible(), so skip the rest
+	SweepBox path = sweptBounds(ball, portion);
+	blockTree.query(path.xMin - ball.radius, path.yMin - ball.radius, path.xMax + ball.radius, path.yMax + ball.radius, worker.candidates);
+	PROFILE_COUNT(PROFILE_BLOCKS_TESTED, worker.candidates.size() + 1);
+	if (parabolic || (int)worker.candidates.size() < SWEEP_BATCH_BLOCKS)
+	{
+		for (int block : worker.candidates)
+			collisionDetect(ball, blocks[block], portion, hit);
+	}
+	else
+	{
+		//with many candidates, look for a block the ball is already pushing into first (nothing can happen earlier), then sweep the
+		//ball against the rest all at once
+		Vec2D trajectory(ball.vx * portion, ball.vy * portion);
+		bool touching = false;
+		for (int block : worker.candidates)
+			if (collisionPossible(ball, trajectory.x, trajectory.y, blocks[block]) && contactDetect(ball, blocks[block], hit))
+				touching = true;
+		if (!touching)
+		{
+			SweepHit sweep;
+			int first = sweepCircleBoxes(Vec2D(ball.x, ball.y), trajectory, ball.radius, blockBoxes, worker.candidates.data(), (int)worker.candidates.size(), hit.subPortion, sweep);
+			if (first >= 0)
+				setNormal(hit, blocks[worker.candidates[first]], sweep.normal, sweep.toi);
+		}
+	}
+
+	//convex polygons have a hierarchy of their own, so a level without any pays one test for them
+	if (!polygons.empty())
+	{
+		polygonTree.query(path.xMin - ball.radius, path.yMin - ball.radius, path.xMax + ball.radius, path.yMax + ball.radius, worker.candidates);
+		PROFILE_COUNT(PROFILE_BLOCKS_TESTED, worker.candidates.size());
+		for (int polygon : worker.candidates)
+			sweepDetect<SHAPE_POLYGON>(ball, polygonShapes[polygon], polygons[polygon], portion, hit);
+	}
+	if (!movers.empty() || !dynamics.empty())
+		findMoverCollision(ball, index, portion, hit, worker);
+	hit.elapsed = stepPortion - portion + hit.subPortion * portion;
+}
+
+//Detect a collision of a ball with a moving block or a block with mass earlier than any found so far, each block swept in its own frame of reference
+void World::findMoverCollision(const BallBody &ball, int index, double portion, Collision &hit, WorkerState &worker) const
+{
+	//nothing can happen earlier than a collision with a block the ball is already touching
+	if (hit.projected && hit.subPortion == 0)
+		return;
+
+	//a block's bounds in the hierarchy hold it over the whole step, so the box the ball sweeps over what's left of the step finds
+	//every block it can meet. Each of them is taken where it is by the time the ball has got this far into the step, and the ball is
+	//swept relative to it: in the block's frame of reference the block stands still, so however fast it moves it can't step over the ball
+	SweepBox path = sweptBounds(ball, portion);
+	double xMin = path.xMin - ball.radius, yMin = path.yMin - ball.radius;
+	double xMax = path.xMax + ball.radius, yMax = path.yMax + ball.radius;
+	double elapsed = stepPortion - portion;
+	auto sweepMoving = [&](BlockBody block)
+	{
+		block.xMin += block.vx * elapsed;
+		block.yMin += block.vy * elapsed;
+		block.xMax += block.vx * elapsed;
+		block.yMax += block.vy * elapsed;
+		BallBody relative = ball;
+		relative.vx -= block.vx;
+		relative.vy -= block.vy;
+
+		//while a ball pinned against another surface uses up its least advances the block carries on without it, so a ball a
+		//little inside the block and still closing in on it is taken as touching it rather than let through
+		Vec2D nearest(std::max(block.xMin, std::min(ball.x, block.xMax)), std::max(block.yMin, std::min(ball.y, block.yMax)));
+		Vec2D offset = Vec2D(ball.x, ball.y) - nearest;
+		double distance = offset.length();
+		if (distance > 0 && distance < ball.radius - CONTACT_TOLERANCE && Vec2D(relative.vx, relative.vy).dot(offset) < -CONTACT_TOLERANCE * distance)
+		{
+			setNormal(hit, block, offset / distance, 0);
+			return true;
+		}
+		return collisionDetect(relative, block, portion, hit);
+	};
+	if (!movers.empty())
+	{
+		moverTree.query(xMin, yMin, xMax, yMax, worker.candidates);
+		PROFILE_COUNT(PROFILE_BLOCKS_TESTED, worker.candidates.size());
+		for (int mover : worker.candidates)
+			sweepMoving(movers[mover]);
+	}
+
+	//blocks with mass are swept the same way, but only by the balls of the island each was given to this step, so the one thread
+	//that may push a block is the only one that reads it; a block already pushed may be anywhere its new velocity took it, so
+	//it's swept whether the hierarchy finds it or not
+	if (!dynamics.empty())
+	{
+		dynamicTree.query(xMin, yMin, xMax, yMax, worker.candidates);
+		PROFILE_COUNT(PROFILE_BLOCKS_TESTED, worker.candidates.size() + worker.pushed.size());
+		for (int block : worker.candidates)
+			if (dynamicIsland[block] == islandIndex[index] && std::find(worker.pushed.begin(), worker.pushed.end(), block) == worker.pushed.end() && sweepMoving(dynamics[block]))
+				hit.dynamic = block;
+		for (int block : worker.pushed)
+			if (sweepMoving(dynamics[block]))
+				hit.dynamic = block;
+	}
+}
+
+//Move a ball along a portion of the frame to its collision and resolve it
+void World::resolveCollision(int index, double portion, const Collision &hit, WorkerState &worker)
+{
+	moveBall(index, portion);
+	respond(index, hit, worker);
+}
+
+//Resolve a ball's collisions one after the other, starting from one already found, until the portion of the frame is used up or a number of collisions (the contact budget it has left) runs out
+void World::collisionHandler(int index, double portion, Collision &hit, int budget, WorkerState &worker)
+{
+	PROFILE_SCOPE("collisionHandler");
+	int contacts = 0;	//collisions resolved for the ball this step
+
+	while (true)
+	{
+		//no collision left to resolve, finish movement for frame
+		if (!hit.projected)
+		{
+			moveBall(index, portion);
+			break;
+		}
+		if (hit.goal)
+		{
+			worker.goalReached = true;
+			break;
+		}
+
+		//out of budget: stop the ball at its next collision and leave that collision to the next step, spending the rest of the frame
+		//on a slide along the surface it stopped against (a ball handed no budget was counted with its island)
+		if (contacts >= budget)
+		{
+			if (budget > 0)
+				worker.stats.budgetHits++;
+			double advance = hit.subPortion * portion;
+			moveBall(index, advance);
+			slideBall(index, portion - advance, hit, worker);
+			break;
+		}
+
+		//move ball along subPortion of trajectory and resolve the collision; every collision uses up at least the minimum advance,
+		//so a ball rattling in a corner or sliding along a floor can't keep finding new collisions no time apart. The ball moves on
+		//along its new velocity for the rest of it, and only the time it actually moved is used up (a ball that can't move at all
+		//runs out of budget instead)
+		double advance = hit.subPortion * portion;
+		if (!worker.pushing)
+			hit.dynamic = -1;
+		resolveCollision(index, advance, hit, worker);
+		contacts++;
+		if (advance < minAdvance)
+		{
+			advance += advanceBall(index, std::min(minAdvance, portion) - advance, worker);
+			worker.stats.minAdvances++;
+		}
+		portion -= advance;
+		if (portion <= 0)
+			break;
+		findCollision(index, portion, hit, worker);
+	}
+	countContacts(contacts, worker);
+}
+
+//Move a ball along its velocity for a portion of a frame, stopping short of the first block in its way, return the portion it moved
+double World::advanceBall(int index, double portion, WorkerState &worker)
+{
+	//the block isn't collided with, so the goal block only stops the ball like any other
+	Collision next;
+	findCollision(index, portion, next, worker);
+	double moved = next.projected ? next.subPortion * portion : portion;
+	moveBall(index, moved);
+	return moved;
+}
+
+//Move a ball that ran out of contact budget along the surface of its last collision for the rest of a portion of the frame, leaving its speed into the surface to the next step
+void World::slideBall(int index, double portion, const Collision &contact, WorkerState &worker)
+{
+	//only the part of the ball's velocity (relative to the surface) along the surface moves it, so the slide can't take it into the
+	//surface; one sweep stops it short of anything else in its way without resolving it. Its speed into the surface is given back
+	//afterwards, so the next step still finds the collision it was stopped at. Taking that speed off leaves a rounding error's worth
+	//of it either way, and the sweep would stop a ball still closing in by that much right where it is while a moving block carries
+	//on through it, so the ball slides a hair away from the surface instead
+	if (portion <= 0)
+		return;
+	Vec2D velocity = bodies.getVelocity(index);
+	double into = std::min((velocity - contact.velocity).dot(contact.normal), 0.0);
+	if (into < 0)
+		into -= CONTACT_TOLERANCE;
+	setBallVelocity(index, velocity.x - contact.normal.x * into, velocity.y - contact.normal.y * into);
+	Collision next;
+	findCollision(index, portion, next, worker);
+	if (next.projected && next.goal)
+		worker.goalReached = true;
+	moveBall(index, next.projected ? next.subPortion * portion : portion);
+	Vec2D slid = bodies.getVelocity(index);
+	setBallVelocity(index, slid.x + contact.normal.x * into, slid.y + contact.normal.y * into);
+	worker.stats.budgetSlides++;
+}
+
+//Add the collisions resolved for one ball or island to a thread's counters
+void World::countContacts(int contacts, WorkerState &worker) const
+{
+	PROFILE_COUNT(PROFILE_SUBSTEPS, contacts);
+	worker.stats.contacts += contacts;
+	worker.stats.maxContacts = std::max(worker.stats.maxContacts, contacts);
+}
+
+//Constructor, empty world
+World::World()
+{
+	workers.resize(pool.getThreadCount());
+	contactBudget = CONTACT_BUDGET;
+	minAdvance = MIN_ADVANCE;
+	parabolic = false;
+	blockSleeping = true;
+	resetContactStats();
+	clear();
+}
+
+//Destructor
+World::~World()
+{
+}
@@ -0,0 +1,477 @@
+/* Program name: world.h
+*  Author: Cory Knoll
+*  Date Last Modified: 10/17/2026
+*  Description: Headless physics world that owns the bodies of a level, moves its moving blocks along their paths, solves the contacts of its blocks with mass and runs the collision pipeline (no Qt dependency)
+	================================================================
+	FUNCTIONS:
+	+ void loadLevel(const LevelView&) - Replace all bodies in the world with the ones described by a level view, using its prebuilt block hierarchy in place if it has a valid one
+	+ void loadLevel(const LevelData&) - Replace all bodies in the world with the ones described by the level data
+	+ void clear() - Remove all bodies from the world
+	+ void restart() - Put every ball and block with mass back the way the level was loaded and the time back to 0, leaving the other blocks and the hierarchy over them as they are
+	+ void swapLevel(World&) - Exchange the level (balls, blocks and hierarchy) with another world in constant time, each world keeping its threads and settings
+	+ size_t getStateSize() const - return the bytes a snapshot of the state of the simulation takes
+	+ void saveState(void*) const - Copy the state of the simulation (the position and velocity of every ball and block with mass, the impulses the solver kept, the time and the goal flag) into a flat buffer of getStateSize() bytes
+	+ bool loadState(const void*) - Put the simulation back in a state saved from this world or another world of the same level, return false (and change nothing) if it has a different number of balls or blocks with mass
+	+ int addBall(double, double, double, double) - Add a ball at rest to the world, return its index
+	+ bool step(double) - Advance every ball and block with mass by a portion of a frame, detect/handle collisions, return true if the playerBall hit the goal block
+	+ void moveBall(int, double) - Move a ball along its velocity vector, calculate new velocity due to gravity
+	+ void collideBall(int, Vec2D, int = 0, Vec2D = Vec2D()) - Bounce a ball off a surface with the normal of a collision, one of the level's materials and the velocity the surface moves at
+	+ void collideBalls(int, int) - Exchange a mass-weighted impulse between two touching balls
+	+ void setBallVelocity(int, double, double) - Set the velocity of a ball
+	+ void setBallPosition(int, double, double) - Set the coordinates of the center of a ball
+	+ void setBallInvMass(int, double) - Set the inverse mass (>=0) of a ball
+	+ Vec2D getBallVelocity(int) const - return velocity vector of a ball
+	+ double getBallX(int) const - return x coordinate of the center of a ball
+	+ double getBallY(int) const - return y coordinate of the center of a ball
+	+ double getBallRadius(int) const - return the radius of a ball
+	+ int getBallCount() const - return the number of balls
+	+ const BodyStore& getBodies() const - return the body storage of the balls
+	+ const BlockBody& getGoalBlock() const - return the goal block
+	+ const BlockBody& getBlock(int) const - return a level block that doesn't move
+	+ int getBlockCount() const - return the number of level blocks that don't move
+	+ const std::vector<BlockBody>& getDynamicBlocks() const - return the blocks with mass where they are, with their velocities
+	+ int getDynamicBlockCount() const - return the number of blocks with mass
+	+ BlockBody getMover(int, double) const - return a moving block where its path has it at a time, moving at the speed that takes it along its path over the next frame
+	+ const MoverData& getMoverPath(int) const - return the path of a moving block
+	+ int getMoverCount() const - return the number of moving blocks
+	+ const BVH& getMoverTree() const - return the bounding volume hierarchy over the moving blocks
+	+ double getTime() const - return the frames simulated since the level started, which says where the moving blocks are
+	+ void setTime(double) - Set the frames simulated since the level started and put the moving blocks where their paths have them then, refitting the hierarchy over them
+	+ bool blockReachable(int, int, double) const - return whether a ball's trajectory over a portion of a frame gets past the borders of a level block (the test before the narrowphase)
+	+ bool detectBlock(int, int, double, Vec2D&, double&) const - Detect whether a ball collides with a level block within a portion of a frame, set the normal and the subportion to the collision (the narrowphase on its own)
+	+ const Material& getMaterial(int) const - return one of the level's block materials
+	+ int getMaterialCount() const - return the number of block materials (material 0 being the default)
+	+ const BVH& getBlockTree() const - return the bounding volume hierarchy over the level blocks
+	+ const SweepPolygon& getPolygon(int) const - return the corners, edge normals, bounds and outline of a convex polygon block
+	+ const BlockBody& getPolygonBounds(int) const - return the bounds (its outline included) and material of a convex polygon block
+	+ int getPolygonCount() const - return the number of convex polygon blocks
+	+ const BVH& getPolygonTree() const - return the bounding volume hierarchy over the convex polygon blocks
+	+ int getIslandCount() const - return the number of islands the balls were split into during the last step
+	+ void setThreadCount(int) - Set the number of threads that solve the islands, 0 for one per core
+	+ int getThreadCount() const - return the number of threads that solve the islands
+	+ void setContactBudget(int) - Set the most collisions resolved for one ball or island in a step before the rest of its step falls back to a cheaper approximation
+	+ int getContactBudget() const - return the most collisions resolved for one ball or island in a step
+	+ void setMinAdvance(double) - Set the least portion of a frame every resolved collision uses up
+	+ double getMinAdvance() const - return the least portion of a frame every resolved collision uses up
+	+ void setParabolicSteps(bool) - Set whether the balls move along exact parabolas within a step (and are swept along them), so a step of many frames cuts no corners of a fall; the parabolas pass through the places frame steps put a ball at whole frames but not the straight moves in between, so bounces (and which shots reach the goal) can come out differently from the game's frame steps even at a frame per step
+	+ bool isParabolicSteps() const - return whether the balls move along exact parabolas within a step
+	+ const ContactStats& getContactStats() const - return the collision counters since the world was created or the counters were reset
+	+ void resetContactStats() - Set every collision counter back to 0
+	+ void setSolverIterations(int) - Set the number of times the solver resolves every contact of the blocks with mass in a step
+	+ int getSolverIterations() const - return the number of times the solver resolves every contact of the blocks with mass in a step
+	+ int getSolverContactCount() const - return the number of contacts of the blocks with mass the solver resolved in the last step
+	+ void setBlockSleeping(bool) - Set whether blocks with mass that have come to rest sleep (are left out of the step) until something can disturb them
+	+ bool isBlockSleeping() const - return whether blocks with mass that have come to rest sleep until something can disturb them
+	+ World() - Constructor, empty world
+	+ ~World() - Destructor
+	- void addBlock(BlockBody&, const BlockData&) - Convert block data to the collision bounds of a block body
+	- void addPolygon(const PolygonData&) - Add a convex polygon block, working out its edge normals and bounds once
+	- void moveMovers(double) - Put every moving block where it is at the start of a portion of a frame, moving at the speed that takes it where it is at the end, and refit the hierarchy over the ones that left their bounds
+	- void solveBlocks(double) - Pull the blocks with mass down and solve their contacts with each other and the other blocks over a portion of a frame, leaving every one at its start with the velocity the solver gave it
+	- void addBlockContact(int, int, int, const BlockBody&, double) - Add a contact between a block with mass and another block (of a kind, with its index) to the solver if they can touch during a portion of a frame
+	- void addBallContact(int, int, double) - Add a contact between a block with mass and a ball to the solver if the block can close in on the ball during a portion of a frame
+	- void sweepDynamics(double) - Give every block with mass the box it sweeps over a portion of a frame in the hierarchy over them
+	- void moveDynamics(double) - Move every block with mass along its velocity by a portion of a frame
+	- bool wakeDynamics(double) - Mark the blocks with mass that sleep through a portion of a frame (their island has rested long enough and nothing can move it), return true if any is awake
+	- bool collisionPossible(const BallBody&, double, double, const BlockBody&) const - return whether the trajectory puts it passing an object
+	- void setNormal(Collision&, const BlockBody&, Vec2D, double) const - set the parameters for the normal of the collision with a block and track that a collision happened
+	- bool contactDetect(const BallBody&, const BlockBody&, Collision&) const - detect a ball already touching a block and moving into it, and set normal appropriately
+	- bool collisionDetect(const BallBody&, const BlockBody&, double, Collision&) const - detect a collision with a block earlier than any found so far and set normal appropriately, return true if one was found
+	- bool sweepDetect<Shape>(const BallBody&, const ShapeType<Shape>::Type&, const BlockBody&, double, Collision&) const - detect a collision with a block of a kind of shape earlier than any found so far through the shape pair table and set normal appropriately, return true if one was found
+	- SweepBox sweptBounds(const BallBody&, double) const - return the box the center of a ball sweeps over a portion of a frame, along its velocity or its parabola
+	- double ballReach(int, double) const - return how far from where it starts a ball (its radius included) can get over a portion of a frame
+	- void findIslands(double) - Find the pairs of balls that can reach each other this frame and split the balls into islands that can't affect each other
+	- int findRoot(int) - return the lowest numbered ball of the island a ball has been joined to so far
+	- int findDynamicRoot(int) - return the lowest numbered block with mass of the island a block has been joined to so far this step
+	- bool ballCollisionDetect(const BallPair&, double, double&) const - Detect whether two balls collide within a portion of a frame and set the subportion to the collision
+	- void islandHandler(const Island&, double, WorkerState&) - Detect and resolve every collision of the balls of an island during a portion of the frame
+	- void groupHandler(const Island&, double, WorkerState&) - Resolve the collisions among the balls of an island earliest first until the portion of the frame is used up or the contact budget runs out
+	- void findCollision(int, double, Collision&, WorkerState&) const - Detect the earliest collision of a ball with the goal block or a level block its trajectory can reach
+	- void findMoverCollision(const BallBody&, int, double, Collision&, WorkerState&) const - Detect a collision of a ball with a moving block or a block with mass earlier than any found so far, each block swept in its own frame of reference
+	- void resolveCollision(int, double, const Collision&, WorkerState&) - Move a ball along a portion of the frame to its collision and resolve it
+	- void respond(int, const Collision&, WorkerState&) - Bounce a ball off the block it collided with, pushing the block if it has mass
+	- void pushBlock(int, const Collision&, WorkerState&) - Bounce a ball off a block with mass in the block's frame of reference, sharing the change of their velocities by their masses
+	- void collisionHandler(int, double, Collision&, int, WorkerState&) - Resolve a ball's collisions one after the other, starting from one already found, until the portion of the frame is used up or a number of collisions (the contact budget it has left) runs out
+	- double advanceBall(int, double, WorkerState&) - Move a ball along its velocity for a portion of a frame, stopping short of the first block in its way, return the portion it moved
+	- void slideBall(int, double, const Collision&, WorkerState&) - Move a ball that ran out of contact budget along the surface of its last collision for the rest of a portion of the frame, leaving its speed into the surface to the next step
+	- void countContacts(int, WorkerState&) const - Add the collisions resolved for one ball or island to a thread's counters
+	============================================================================
+	VARIABLES:
+	- BodyStore bodies - The balls of the level (playerBall first)
+	- BodyStore startBodies - The balls the way the level was loaded, for restarting it
+	- std::vector<double> freePortion - Portion of the frame each ball moves in the batch kernel because nothing is in its way
+	- SweepAndPrune broadphase - Sorted axis list of the boxes the balls can reach this frame, kept from frame to frame
+	- std::vector<BallPair> pairs - Pairs of balls that can reach each other this frame
+	- std::vector<int> parent - Ball each ball was joined to while the islands are found
+	- std::vector<int> islandIndex - Island each ball belongs to this frame
+	- std::vector<Island> islands - Islands of balls that can reach each other this frame, ordered by their lowest numbered ball
+	- std::vector<int> islandBalls - Balls of every island, island by island (ascending within an island)
+	- std::vector<BallPair> islandPairs - Pairs of every island, island by island (ascending within an island)
+	- std::vector<int> batches - First island of every task handed to the thread pool, followed by the number of islands
+	- ThreadPool pool - Work-stealing pool of threads that solves the islands
+	- std::vector<WorkerState> workers - Scratch space and results of every thread of the pool
+	- int contactBudget - Most collisions resolved for one ball or island in a step
+	- double minAdvance - Least portion of a frame every resolved collision uses up
+	- bool parabolic - Balls move along exact parabolas within a step instead of along their velocities
+	- ContactStats stats - Collision counters since the world was created or the counters were reset
+	- BlockBody goalBlock - The Block that you're trying to hit
+	- std::vector<BlockBody> blocks - The Blocks that make up the obstacles of the level
+	- std::vector<Material> materials - Materials of the blocks, material 0 being the default
+	- SweepBoxes blockBoxes - Bounds of the level blocks in the layout the batch sweep test reads
+	- BVH blockTree - Static bounding volume hierarchy over the level blocks, built when the level is loaded (or attached to the level's prebuilt one)
+	- std::vector<BlockBody> polygons - Bounds (their outline included) and material of the convex polygon blocks
+	- std::vector<SweepPolygon> polygonShapes - Corners, edge normals, bounds and outline of every convex polygon block, pointing into polygonPoints and polygonNormals
+	- std::vector<Vec2D> polygonPoints - Corners of every convex polygon block, polygon by polygon
+	- std::vector<Vec2D> polygonNormals - Outward unit normal of every edge of every convex polygon block, polygon by polygon
+	- BVH polygonTree - Static bounding volume hierarchy over the convex polygon blocks, built when the level is loaded
+	- std::vector<MoverData> moverPaths - The paths of the moving blocks
+	- std::vector<BlockBody> movers - The moving blocks where they are at the start of the step being taken, with the speed they move at during it
+	- std::vector<SweepBox> moverBounds - Bounds of every moving block in the moverTree, which hold it over a step and some margin
+	- BVH moverTree - Bounding volume hierarchy over the moving blocks, refit over the ones that left their bounds every step
+	- std::vector<BlockBody> dynamics - The blocks with mass where they are at the start of the step being taken, with their velocities
+	- std::vector<BlockBody> startDynamics - The blocks with mass the way the level was loaded, for restarting it
+	- BVH dynamicTree - Bounding volume hierarchy over the boxes the blocks with mass sweep during the step being taken
+	- std::vector<int> dynamicBall - First ball that can reach every block with mass this step (-1 for none)
+	- std::vector<int> dynamicIsland - Island of the balls that can reach every block with mass this step (-1 for none)
+	- std::vector<int> solverCandidates - Scratch list of the blocks a block with mass can reach this step
+	- std::vector<int> dynamicParent - Block with mass each awake one was joined to by their contacts while the islands of the step are found
+	- std::vector<unsigned char> dynamicAsleep - Every block with mass sleeps through the step being taken
+	- std::vector<int> wakeQueue - Scratch list of the awake blocks with mass whose reach is yet to be searched for sleeping ones
+	- std::vector<double> dynamicRest - Frames the island of every block with mass has been at rest for; from BLOCK_SLEEP_FRAMES on the island sleeps
+	- ContactSolver solver - Sequential impulse solver for the contacts of the blocks with mass, with the impulses it keeps from step to step
+	- double time - Frames simulated since the level started
+	- double stepPortion - Portion of a frame the step being taken covers, which the time a ball has got to during it is counted back from
+	- bool goalReached - The playerBall hit the goal block during the last step
+	- bool blockSleeping - Blocks with mass that have come to rest sleep until something can disturb them
+	============================================================================
+	STRUCTS:
+	+ BlockBody - collision bounds, inverse mass, velocity and material of a block
+	+ ContactStats - counters of the collisions the world resolved and how often it had to cut the work short
+	+ WorldState - what a snapshot of the state of the simulation starts with, followed by x, y, vx and vy of every ball, each as one array, the bounds, velocity and rest time of every block with mass, and the solver's cache
+	- Collision - earliest collision found along a ball's trajectory
+	- Island - range of the balls and pairs of an island in islandBalls and islandPairs
+	- WorkerState - scratch space and results of one thread solving islands
+*/
+
+#ifndef WORLD_H
+#define WORLD_H
+
+#include <vector>
+#include "bodystore.h"
+#include "broadphase.h"
+#include "bvh.h"
+#include "contactsolver.h"
+#include "level.h"
+#include "narrowphase.h"
+#include "response.h"
+#include "sweep.h"
+#include "threadpool.h"
+#include "vec2d.h"
+
+#define BLOCK_OUTLINE_WIDTH 3	//Pen width of a block's outline, which the block's collision bounds include
+#define BALL_RESTITUTION 0.85	//Portion of their closing speed two balls keep after bouncing off each other
+#define CONTACT_TOLERANCE 1e-6	//Distance from a block within which a ball counts as touching it (and the speed into it that counts as moving into it)
+#define ISLAND_BATCH_BALLS 64	//Fewest balls handed to a thread of the pool at once (small islands are batched together)
+#define CONTACT_BUDGET 64		//Default most collisions resolved for one ball or island in a step
+#define MIN_ADVANCE 1e-4		//Default least portion of a frame every resolved collision uses up
+#define SWEEP_BATCH_BLOCKS 8	//Fewest candidate blocks a ball is swept against all at once with the batch test instead of one by one
+#define MOVER_MARGIN 8			//Distance a moving block's bounds in the hierarchy reach past it, so a slow block only needs them moved every few steps
+#define BLOCK_CONTACT_DISTANCE 1.0	//Gap between a block with mass and another block within which the solver is given their contact, whatever their speeds
+#define BLOCK_SLEEP_SPEED 0.05	//Speed below which a block with mass counts as at rest after its contacts are solved
+#define BLOCK_SLEEP_FRAMES 30	//Frames an island of blocks with mass (the blocks touching each other) has to stay at rest before it sleeps
+#define POLYGON_OUTLINE_REACH (BLOCK_OUTLINE_WIDTH / 2.0)	//Distance a polygon block's outline reaches past its edges, which its collision outline includes
+
+struct BlockBody
+{
+	double xMin;	//left bound of the block
+	double yMin;	//top bound of the block
+	double xMax;	//right bound of the block
+	double yMax;	//bottom bound of the block
+	double invMass;	//inverse mass of the block
+	double vx;		//x component of the block's velocity (0 unless it moves along a path or has mass)
+	double vy;		//y component of the block's velocity
+	int material;	//index of the block's material in the world's material table
+};
+
+struct ContactStats
+{
+	long long steps;		//steps taken
+	long long contacts;		//collisions resolved
+	long long minAdvances;	//collisions that came sooner after the one before than the minimum advance, so the minimum advance was used up instead
+	long long budgetHits;	//balls or islands that ran out of contact budget and finished their step with the fallback
+	long long budgetSlides;	//balls that slid along the surface of their last collision for the rest of their step after the budget ran out
+	int maxContacts;		//most collisions resolved for one ball or island in a single step
+};
+
+struct WorldState
+{
+	int ballCount;		//balls of the level the state was saved from
+	int goalReached;	//the playerBall had hit the goal block during the step before the state was saved
+	double time;		//frames simulated since the level started, which puts the moving blocks where they were
+	int blockCount;		//blocks with mass of the level
+	int contactCount;	//contacts whose impulses the solver kept, of the getCacheCapacity() saved
+};
+
+class World
+{
+public:
+	void loadLevel(const LevelView&);
+		//Replace all bodies in the world with the ones described by a level view, using its prebuilt block hierarchy in place if it has a valid one
+	void loadLevel(const LevelData&);
+		//Replace all bodies in the world with the ones described by the level data
+	void clear();
+		//Remove all bodies from the world
+	void restart();
+		//Put every ball and block with mass back the way the level was loaded and the time back to 0, leaving the other blocks and the hierarchy over them as they are
+	void swapLevel(World&);
+		//Exchange the level (balls, blocks and hierarchy) with another world in constant time, each world keeping its threads and settings
+	size_t getStateSize() const;
+		//return the bytes a snapshot of the state of the simulation takes
+	void saveState(void*) const;
+		//Copy the state of the simulation (the position and velocity of every ball and block with mass, the impulses the solver kept, the time and the goal flag) into a flat buffer of getStateSize() bytes
+	bool loadState(const void*);
+		//Put the simulation back in a state saved from this world or another world of the same level, return false (and change nothing) if it has a different number of balls or blocks with mass
+	int addBall(double, double, double, double);
+		//Add a ball at rest to the world, return its index
+	bool step(double);
+		//Advance every ball and block with mass by a portion of a frame, detect/handle collisions, return true if the playerBall hit the goal block
+	void moveBall(int, double);
+		//Move a ball along its velocity vector, calculate new velocity due to gravity
+	void collideBall(int, Vec2D, int = 0, Vec2D = Vec2D());
+		//Bounce a ball off a surface with the normal of a collision, one of the level's materials and the velocity the surface moves at
+	void collideBalls(int, int);
+		//Exchange a mass-weighted impulse between two touching balls
+	void setBallVelocity(int, double, double);
+		//Set the velocity of a ball
+	void setBallPosition(int, double, double);
+		//Set the coordinates of the center of a ball
+	void setBallInvMass(int, double);
+		//Set the inverse mass (>=0) of a ball
+	Vec2D getBallVelocity(int) const;
+		//return velocity vector of a ball
+	double getBallX(int) const;
+		//return x coordinate of the center of a ball
+	double getBallY(int) const;
+		//return y coordinate of the center of a ball
+	double getBallRadius(int) const;
+		//return the radius of a ball
+	int getBallCount() const;
+		//return the number of balls
+	const BodyStore& getBodies() const;
+		//return the body storage of the balls
+	const BlockBody& getGoalBlock() const;
+		//return the goal block
+	const BlockBody& getBlock(int) const;
+		//return a level block that doesn't move
+	int getBlockCount() const;
+		//return the number of level blocks that don't move
+	const std::vector<BlockBody>& getDynamicBlocks() const;
+		//return the blocks with mass where they are, with their velocities
+	int getDynamicBlockCount() const;
+		//return the number of blocks with mass
+	BlockBody getMover(int, double) const;
+		//return a moving block where its path has it at a time, moving at the speed that takes it along its path over the next frame
+	const MoverData& getMoverPath(int) const;
+		//return the path of a moving block
+	int getMoverCount() const;
+		//return the number of moving blocks
+	const BVH& getMoverTree() const;
+		//return the bounding volume hierarchy over the moving blocks
+	double getTime() const;
+		//return the frames simulated since the level started, which says where the moving blocks are
+	void setTime(double);
+		//Set the frames simulated since the level started and put the moving blocks where their paths have them then, refitting the hierarchy over them
+	bool blockReachable(int, int, double) const;
+		//return whether a ball's trajectory over a portion of a frame gets past the borders of a level block (the test before the narrowphase)
+	bool detectBlock(int, int, double, Vec2D&, double&) const;
+		//Detect whether a ball collides with a level block within a portion of a frame, set the normal and the subportion to the collision (the narrowphase on its own)
+	const Material& getMaterial(int) const;
+		//return one of the level's block materials
+	int getMaterialCount() const;
+		//return the number of block materials (material 0 being the default)
+	const BVH& getBlockTree() const;
+		//return the bounding volume hierarchy over the level blocks
+	const SweepPolygon& getPolygon(int) const;
+		//return the corners, edge normals, bounds and outline of a convex polygon block
+	const BlockBody& getPolygonBounds(int) const;
+		//return the bounds (its outline included) and material of a convex polygon block
+	int getPolygonCount() const;
+		//return the number of convex polygon blocks
+	const BVH& getPolygonTree() const;
+		//return the bounding volume hierarchy over the convex polygon blocks
+	int getIslandCount() const;
+		//return the number of islands the balls were split into during the last step
+	void setThreadCount(int);
+		//Set the number of threads that solve the islands, 0 for one per core
+	int getThreadCount() const;
+		//return the number of threads that solve the islands
+	void setContactBudget(int);
+		//Set the most collisions resolved for one ball or island in a step before the rest of its step falls back to a cheaper approximation
+	int getContactBudget() const;
+		//return the most collisions resolved for one ball or island in a step
+	void setMinAdvance(double);
+		//Set the least portion of a frame every resolved collision uses up
+	double getMinAdvance() const;
+		//return the least portion of a frame every resolved collision uses up
+	void setParabolicSteps(bool);
+		//Set whether the balls move along exact parabolas within a step (and are swept along them), so a step of many frames cuts no corners of a fall; the parabolas pass through the places frame steps put a ball at whole frames but not the straight moves in between, so bounces (and which shots reach the goal) can come out differently from the game's frame steps even at a frame per step
+	bool isParabolicSteps() const;
+		//return whether the balls move along exact parabolas within a step
+	const ContactStats& getContactStats() const;
+		//return the collision counters since the world was created or the counters were reset
+	void resetContactStats();
+		//Set every collision counter back to 0
+	void setSolverIterations(int);
+		//Set the number of times the solver resolves every contact of the blocks with mass in a step
+	int getSolverIterations() const;
+		//return the number of times the solver resolves every contact of the blocks with mass in a step
+	int getSolverContactCount() const;
+		//return the number of contacts of the blocks with mass the solver resolved in the last step
+	void setBlockSleeping(bool);
+		//Set whether blocks with mass that have come to rest sleep (are left out of the step) until something can disturb them
+	bool isBlockSleeping() const;
+		//return whether blocks with mass that have come to rest sleep until something can disturb them
+	World();
+		//Constructor, empty world
+	~World();
+		//Destructor
+private:
+	struct Collision
+	{
+		bool projected;		//A collision will occur along projected trajectory
+		bool goal;			//projected collision is with the goalblock
+		double subPortion;	//The portion of the current trajectory until the ball collides with a block
+		Vec2D normal;		//normal of the collision
+		int material;		//material of the block the ball collides with
+		Vec2D velocity;		//velocity of the block the ball collides with
+		int dynamic;		//index of the block with mass the ball collides with, -1 for any other block
+		double elapsed;		//portion of the step gone by when the collision happens
+	};
+	struct Island
+	{
+		int firstBall;		//index of the island's first ball in islandBalls
+		int ballCount;		//number of balls in the island
+		int firstPair;		//index of the island's first pair in islandPairs
+		int pairCount;		//number of pairs in the island
+	};
+	struct WorkerState
+	{
+		std::vector<int> candidates;	//Scratch list of the level blocks a ball's trajectory can reach this frame
+		std::vector<double> hitPortions;//Scratch list of the subportion until every ball of the island being solved hits a block (above 1 for none)
+		bool goalReached;				//The playerBall hit the goal block in an island this thread solved
+		bool pushing;					//Balls push the blocks with mass they hit (not once an island is out of its contact budget)
+		std::vector<int> pushed;		//Blocks with mass the balls of the island being solved have pushed, which the hierarchy over them no longer holds
+		ContactStats stats;				//Collisions this thread resolved during the step
+	};
+	void addBlock(BlockBody&, const BlockData&);
+		//Convert block data to the collision bounds of a block body
+	void addPolygon(const PolygonData&);
+		//Add a convex polygon block, working out its edge normals and bounds once
+	void moveMovers(double);
+		//Put every moving block where it is at the start of a portion of a frame, moving at the speed that takes it where it is at the end, and refit the hierarchy over the ones that left their bounds
+	void solveBlocks(double);
+		//Pull the blocks with mass down and solve their contacts with each other and the other blocks over a portion of a frame, leaving every one at its start with the velocity the solver gave it
+	void addBlockContact(int, int, int, const BlockBody&, double);
+		//Add a contact between a block with mass and another block (of a kind, with its index) to the solver if they can touch during a portion of a frame
+	void addBallContact(int, int, double);
+		//Add a contact between a block with mass and a ball to the solver if the block can close in on the ball during a portion of a frame
+	void sweepDynamics(double);
+		//Give every block with mass the box it sweeps over a portion of a frame in the hierarchy over them
+	void moveDynamics(double);
+		//Move every block with mass along its velocity by a portion of a frame
+	bool wakeDynamics(double);
+		//Mark the blocks with mass that sleep through a portion of a frame (their island has rested long enough and nothing can move it), return true if any is awake
+	bool collisionPossible(const BallBody&, double, double, const BlockBody&) const;
+		//return whether the trajectory puts it passing an object
+	void setNormal(Collision&, const BlockBody&, Vec2D, double) const;
+		//set the parameters for the normal of the collision with a block and track that a collision happened
+	bool contactDetect(const BallBody&, const BlockBody&, Collision&) const;
+		//detect a ball already touching a block and moving into it, and set normal appropriately
+	bool collisionDetect(const BallBody&, const BlockBody&, double, Collision&) const;
+		//detect a collision with a block earlier than any found so far and set normal appropriately, return true if one was found
+	template<int Shape>
+	bool sweepDetect(const BallBody&, const typename ShapeType<Shape>::Type&, const BlockBody&, double, Collision&) const;
+		//detect a collision with a block of a kind of shape earlier than any found so far through the shape pair table and set normal appropriately, return true if one was found
+	SweepBox sweptBounds(const BallBody&, double) const;
+		//return the box the center of a ball sweeps over a portion of a frame, along its velocity or its parabola
+	double ballReach(int, double) const;
+		//return how far from where it starts a ball (its radius included) can get over a portion of a frame
+	void findIslands(double);
+		//Find the pairs of balls that can reach each other this frame and split the balls into islands that can't affect each other
+	int findRoot(int);
+		//return the lowest numbered ball of the island a ball has been joined to so far
+	int findDynamicRoot(int);
+		//return the lowest numbered block with mass of the island a block has been joined to so far this step
+	bool ballCollisionDetect(const BallPair&, double, double&) const;
+		//Detect whether two balls collide within a portion of a frame and set the subportion to the collision
+	void islandHandler(const Island&, double, WorkerState&);
+		//Detect and resolve every collision of the balls of an island during a portion of the frame
+	void groupHandler(const Island&, double, WorkerState&);
+		//Resolve the collisions among the balls of an island earliest first until the portion of the frame is used up or the contact budget runs out
+	void findCollision(int, double, Collision&, WorkerState&) const;
+		//Detect the earliest collision of a ball with the goal block or a level block its trajectory can reach
+	void findMoverCollision(const BallBody&, int, double, Collision&, WorkerState&) const;
+		//Detect a collision of a ball with a moving block or a block with mass earlier than any found so far, each block swept in its own frame of reference
+	void resolveCollision(int, double, const Collision&, WorkerState&);
+		//Move a ball along a portion of the frame to its collision and resolve it
+	void respond(int, const Collision&, WorkerState&);
+		//Bounce a ball off the block it collided with, pushing the block if it has mass
+	void pushBlock(int, const Collision&, WorkerState&);
+		//Bounce a ball off a block with mass in the block's frame of reference, sharing the change of their velocities by their masses
+	void collisionHandler(int, double, Collision&, int, WorkerState&);
+		//Resolve a ball's collisions one after the other, starting from one already found, until the portion of the frame is used up or a number of collisions (the contact budget it has left) runs out
+	double advanceBall(int, double, WorkerState&);
+		//Move a ball along its velocity for a portion of a frame, stopping short of the first block in its way, return the portion it moved
+	void slideBall(int, double, const Collision&, WorkerState&);
+		//Move a ball that ran out of contact budget along the surface of its last collision for the rest of a portion of the frame, leaving its speed into the surface to the next step
+	void countContacts(int, WorkerState&) const;
+		//Add the collisions resolved for one ball or island to a thread's counters
+	BodyStore bodies;				//The balls of the level (playerBall first)
+	BodyStore startBodies;			//The balls the way the level was loaded, for restarting it
+	std::vector<double> freePortion;//Portion of the frame each ball moves in the batch kernel because nothing is in its way
+	SweepAndPrune broadphase;		//Sorted axis list of the boxes the balls can reach this frame, kept from frame to frame
+	std::vector<BallPair> pairs;	//Pairs of balls that can reach each other this frame
+	std::vector<int> parent;		//Ball each ball was joined to while the islands are found
+	std::vector<int> islandIndex;	//Island each ball belongs to this frame
+	std::vector<Island> islands;	//Islands of balls that can reach each other this frame, ordered by their lowest numbered ball
+	std::vector<int> islandBalls;	//Balls of every island, island by island (ascending within an island)
+	std::vector<BallPair> islandPairs;//Pairs of every island, island by island (ascending within an island)
+	std::vector<int> batches;		//First island of every task handed to the thread pool, followed by the number of islands
+	ThreadPool pool;				//Work-stealing pool of threads that solves the islands
+	std::vector<WorkerState> workers;//Scratch space and results of every thread of the pool
+	int contactBudget;				//Most collisions resolved for one ball or island in a step
+	double minAdvance;				//Least portion of a frame every resolved collision uses up
+	bool parabolic;					//Balls move along exact parabolas within a step instead of along their velocities
+	ContactStats stats;				//Collision counters since the world was created or the counters were reset
+	BlockBody goalBlock;			//The Block that you're trying to hit
+	std::vector<BlockBody> blocks;	//The Blocks that make up the obstacles of the level
+	std::vector<Material> materials;//Materials of the blocks, material 0 being the default
+	SweepBoxes blockBoxes;			//Bounds of the level blocks in the layout the batch sweep test reads
+	BVH blockTree;					//Static bounding volume hierarchy over the level blocks, built when the level is loaded (or attached to the level's prebuilt one)
+	std::vector<BlockBody> polygons;//Bounds (their outline included) and material of the convex polygon blocks
+	std::vector<SweepPolygon> polygonShapes;//Corners, edge normals, bounds and outline of every convex polygon block, pointing into polygonPoints and polygonNormals
+	std::vector<Vec2D> polygonPoints;//Corners of every convex polygon block, polygon by polygon
+	std::vector<Vec2D> polygonNormals;//Outward unit normal of every edge of every convex polygon block, polygon by polygon
+	BVH polygonTree;				//Static bounding volume hierarchy over the convex polygon blocks, built when the level is loaded
+	std::vector<MoverData> moverPaths;//The paths of the moving blocks
+	std::vector<BlockBody> movers;	//The moving blocks where they are at the start of the step being taken, with the speed they move at during it
+	std::vector<SweepBox> moverBounds;//Bounds of every moving block in the moverTree, which hold it over a step and some margin
+	BVH moverTree;					//Bounding volume hierarchy over the moving blocks, refit over the ones that left their bounds every step
+	std::vector<BlockBody> dynamics;//The blocks with mass where they are at the start of the step being taken, with their velocities
+	std::vector<BlockBody> startDynamics;//The blocks with mass the way the level was loaded, for restarting it
+	BVH dynamicTree;				//Bounding volume hierarchy over the boxes the blocks with mass sweep during the step being taken
+	std::vector<int> dynamicBall;	//First ball that can reach every block with mass this step (-1 for none)
+	std::vector<int> dynamicIsland;	//Island of the balls that can reach every block with mass this step (-1 for none)
+	std::vector<int> solverCandidates;//Scratch list of the blocks a block with mass can reach this step
+	std::vector<int> dynamicParent;	//Block with mass each awake one was joined to by their contacts while the islands of the step are found
+	std::vector<unsigned char> dynamicAsleep;//Every block with mass sleeps through the step being taken
+	std::vector<int> wakeQueue;		//Scratch list of the awake blocks with mass whose reach is yet to be searched for sleeping ones
+	std::vector<double> dynamicRest;//Frames the island of every block with mass has been at rest for; from BLOCK_SLEEP_FRAMES on the island sleeps
+	ContactSolver solver;			//Sequential impulse solver for the contacts of the blocks with mass, with the impulses it keeps from step to step
+	double time;					//Frames simulated since the level started
+	double stepPortion;				//Portion of a frame the step being taken covers, which the time a ball has got to during it is counted back from
+	bool goalReached;				//The playerBall hit the goal block during the last step
+	bool blockSleeping;				//Blocks with mass that have come to rest sleep until something can disturb them
+};
+
+#endif //WORLD_H